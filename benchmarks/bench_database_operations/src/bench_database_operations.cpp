@@ -0,0 +1,581 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Database Operations Benchmark
+ *
+ *
+ * [FILE NAME]
+ *
+ * bench_database_operations.cpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file times every operation of the Database against a freshly seeded database of a chosen size, to catch performance regressions between releases.
+ * The same arguments always seed the same database and make the same calls (the random choices come from '--seed'), so two builds can be compared run for run.
+ *
+ * Each operation prints one JSON line on the standard output, for scripts to compare:
+ *
+ *     {"operation":"getVehicleByID","sailings":1000,"vehicles":10000,"profile":"default","iterations":2000,"failed":0,"ops_per_second":61234.5,"p50_microseconds":14.8,"p99_microseconds":40.1}
+ *
+ * Progress goes to the standard error.
+ *
+ * Usage: FerryFlow_bench [--sailings <n>] [--vehicles <n>] [--iterations <n>] [--seed <n>] [--profile default|terminal] [--database <path>]
+*/
+
+// ============================================================================
+// ============================================================================
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "command_line.hpp"
+#include "database.hpp"
+#include "global.hpp"
+#include "json.hpp"
+
+// The options of a run.
+struct BenchSettings
+{
+    int sailing_count = 1000;
+    int vehicle_count = 10000;
+    int iteration_count = 2000;
+    unsigned int seed = 1;
+    std::string profile_name = "default";
+    std::string database_path = "ferryflow_bench.db";
+};
+
+// The timings of one operation.
+struct BenchResult
+{
+    std::string operation;
+    int iteration_count = 0;
+    int failed_count = 0;
+    double ops_per_second = 0.0;
+    double p50_microseconds = 0.0;
+    double p99_microseconds = 0.0;
+};
+
+static const int c_hours_per_day = 24;
+static const int c_days_per_season = 28;
+static const int c_sailings_per_vessel = 20;
+
+// The terminal of a sailing: "AAA", "AAB", ... (one terminal holds every hour of a season).
+static std::string terminalName(
+    int terminal_index
+    )
+{
+    std::string terminal_name = "AAA";
+
+    for(int position = 2; position >= 0; --position)
+    {
+        terminal_name[position] = static_cast<char>('A' + terminal_index % 26);
+        terminal_index /= 26;
+    }
+
+    return(terminal_name);
+}
+
+static NamedSailing sailingKey(
+    int sailing_index,
+    int terminal_offset
+    )
+{
+    NamedSailing sailing;
+    sailing.vessel_name = "Vessel " + std::to_string(sailing_index / c_sailings_per_vessel + 1);
+    sailing.departure_terminal = terminalName(terminal_offset + sailing_index / (c_days_per_season * c_hours_per_day));
+    sailing.departure_day = (sailing_index / c_hours_per_day) % c_days_per_season + 1;
+    sailing.departure_hour = sailing_index % c_hours_per_day;
+
+    return(sailing);
+}
+
+static std::string licensePlate(
+    int vehicle_index
+    )
+{
+    return("BV" + std::to_string(vehicle_index));
+}
+
+static bool parseSettings(
+    int argc,
+    char *argv[],
+    BenchSettings& settings
+    )
+{
+    for(int index = 1; index < argc; ++index)
+    {
+        std::string flag = argv[index];
+
+        if(index + 1 >= argc)
+        {
+            return(false);
+        }
+
+        std::string value = argv[++index];
+
+        try
+        {
+            if(flag == "--sailings")
+            {
+                settings.sailing_count = std::stoi(value);
+            }
+
+            else if(flag == "--vehicles")
+            {
+                settings.vehicle_count = std::stoi(value);
+            }
+
+            else if(flag == "--iterations")
+            {
+                settings.iteration_count = std::stoi(value);
+            }
+
+            else if(flag == "--seed")
+            {
+                settings.seed = static_cast<unsigned int>(std::stoul(value));
+            }
+
+            else if(flag == "--profile")
+            {
+                settings.profile_name = value;
+            }
+
+            else if(flag == "--database")
+            {
+                settings.database_path = value;
+            }
+
+            else
+            {
+                return(false);
+            }
+        }
+
+        catch(...)
+        {
+            return(false);
+        }
+    }
+
+    return(settings.sailing_count > 0 && settings.vehicle_count > 1 && settings.iteration_count > 0);
+}
+
+// Times 'call_count' calls of an operation, one at a time. The call returns whether it succeeded.
+static BenchResult measure(
+    const std::string& operation,
+    int call_count,
+    const std::function<bool(int)>& call
+    )
+{
+    BenchResult result;
+    result.operation = operation;
+    result.iteration_count = call_count;
+
+    std::vector<double> latencies;
+    latencies.reserve(static_cast<std::size_t>(call_count));
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    for(int index = 0; index < call_count; ++index)
+    {
+        auto call_start_time = std::chrono::steady_clock::now();
+
+        if(!call(index))
+        {
+            ++result.failed_count;
+        }
+
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - call_start_time).count());
+    }
+
+    double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    if(call_count > 0)
+    {
+        std::sort(latencies.begin(), latencies.end());
+
+        result.ops_per_second = (elapsed_seconds > 0.0) ? call_count / elapsed_seconds : 0.0;
+        result.p50_microseconds = latencies[latencies.size() / 2];
+        result.p99_microseconds = latencies[std::min(latencies.size() - 1, (latencies.size() * 99) / 100)];
+    }
+
+    return(result);
+}
+
+static void printResult(
+    const BenchSettings& settings,
+    const BenchResult& result
+    )
+{
+    std::string line;
+    JsonWriter writer(line);
+
+    writer.beginObject();
+    writer.key("operation");
+    writer.string(result.operation);
+    writer.key("sailings");
+    writer.integer(settings.sailing_count);
+    writer.key("vehicles");
+    writer.integer(settings.vehicle_count);
+    writer.key("profile");
+    writer.string(settings.profile_name);
+    writer.key("iterations");
+    writer.integer(result.iteration_count);
+    writer.key("failed");
+    writer.integer(result.failed_count);
+    writer.key("ops_per_second");
+    writer.number(result.ops_per_second);
+    writer.key("p50_microseconds");
+    writer.number(result.p50_microseconds);
+    writer.key("p99_microseconds");
+    writer.number(result.p99_microseconds);
+    writer.endObject();
+
+    std::cout << line << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    BenchSettings settings;
+
+    if(!parseSettings(argc, argv, settings))
+    {
+        std::cerr << "Usage: FerryFlow_bench [--sailings <n>] [--vehicles <n>] [--iterations <n>] [--seed <n>] [--profile default|terminal] [--database <path>]" << std::endl;
+
+        return(1);
+    }
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    ConnectionProfile profile;
+
+    selectConnectionProfile(settings.profile_name, profile, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        std::cerr << outcome_message << std::endl;
+
+        return(1);
+    }
+
+    //  Section: Seeding
+    // ------------------------------------------------------------------------
+
+    // NOTE (SAVIZ): Every run starts from a new file, so that the timings of one run do not depend on what the previous one left behind.
+    std::remove(settings.database_path.c_str());
+    std::remove((settings.database_path + "-wal").c_str());
+    std::remove((settings.database_path + "-shm").c_str());
+
+    std::cerr << "Seeding " << settings.sailing_count << " sailings and " << settings.vehicle_count << " vehicles..." << std::endl;
+
+    Database database;
+
+    database.openConnection(settings.database_path, profile, is_successful, outcome_message);
+
+    int vessel_count = (settings.sailing_count + c_sailings_per_vessel - 1) / c_sailings_per_vessel;
+
+    std::vector<Vessel> seeded_vessels;
+    std::vector<NamedSailing> seeded_sailings;
+    std::vector<Vehicle> seeded_vehicles;
+    std::vector<bool> is_imported;
+
+    for(int index = 0; index < vessel_count; ++index)
+    {
+        seeded_vessels.push_back(Vessel(0, "Vessel " + std::to_string(index + 1), g_lane_max_length, g_lane_max_length));
+    }
+
+    for(int index = 0; index < settings.sailing_count; ++index)
+    {
+        seeded_sailings.push_back(sailingKey(index, 0));
+    }
+
+    // Every fourth vehicle is tall, so both lanes fill up:
+    for(int index = 0; index < settings.vehicle_count; ++index)
+    {
+        seeded_vehicles.push_back(Vehicle(0, licensePlate(index), "5550000000", 5.0, (index % 4 == 3) ? 2.5 : 1.5));
+    }
+
+    if(is_successful)
+    {
+        database.importVessels(seeded_vessels, is_imported, is_successful, outcome_message);
+    }
+
+    if(is_successful)
+    {
+        database.importSailings(seeded_sailings, is_imported, is_successful, outcome_message);
+    }
+
+    if(is_successful)
+    {
+        database.importVehicles(seeded_vehicles, is_imported, is_successful, outcome_message);
+    }
+
+    // The imports do not return the sailing IDs, which the reservations need:
+    std::vector<Sailing> sailings(seeded_sailings.size());
+
+    for(std::size_t index = 0; is_successful && index < seeded_sailings.size(); ++index)
+    {
+        database.getSailingByID(seeded_sailings[index].departure_terminal, seeded_sailings[index].departure_day, seeded_sailings[index].departure_hour, sailings[index], is_successful, outcome_message);
+    }
+
+    for(int index = 0; index < settings.vehicle_count; ++index)
+    {
+        seeded_vehicles[index].vehicle_id = index + 1;
+    }
+
+    // The first half of the vehicles is booked, round-robin over the sailings, in one transaction:
+    int booked_vehicle_count = settings.vehicle_count / 2;
+
+    if(is_successful)
+    {
+        GroupCommitSettings seeding_group_commit;
+        seeding_group_commit.max_operations = INT_MAX;
+        seeding_group_commit.max_delay_milliseconds = INT_MAX;
+
+        database.setGroupCommit(seeding_group_commit, is_successful, outcome_message);
+    }
+
+    for(int index = 0; is_successful && index < booked_vehicle_count; ++index)
+    {
+        Reservation reservation;
+        bool is_booked = false;
+
+        // A sailing that is full is left as it is:
+        database.addReservation(sailings[index % sailings.size()], seeded_vehicles[index], reservation, is_booked, outcome_message);
+    }
+
+    if(is_successful)
+    {
+        database.setGroupCommit(GroupCommitSettings(), is_successful, outcome_message);
+    }
+
+    if(!is_successful)
+    {
+        std::cerr << "Seeding failed: " << outcome_message << std::endl;
+
+        return(1);
+    }
+
+    // ------------------------------------------------------------------------
+
+
+
+    //  Section: Operations
+    // ------------------------------------------------------------------------
+
+    std::mt19937 random_engine(settings.seed);
+
+    auto random_index = [&random_engine](int count)
+    {
+        return(std::uniform_int_distribution<int>(0, count - 1)(random_engine));
+    };
+
+    int iteration_count = settings.iteration_count;
+    int free_vehicle_count = settings.vehicle_count - booked_vehicle_count;
+
+    std::vector<BenchResult> results;
+
+    // 1) Lookups and reports:
+    results.push_back(measure("getVesselByID", iteration_count, [&](int)
+    {
+        Vessel vessel;
+        database.getVesselByID(random_index(vessel_count) + 1, vessel, is_successful, outcome_message);
+
+        return(is_successful);
+    }));
+
+    PageCursor vessel_page;
+
+    results.push_back(measure("getVessels", iteration_count, [&](int)
+    {
+        std::vector<Vessel> vessels;
+        database.getVessels(g_list_length, PageDirection::Next, vessel_page, vessels, is_successful, outcome_message);
+
+        // Start over once the list is read:
+        if(is_successful && vessels.empty())
+        {
+            database.getVessels(g_list_length, PageDirection::First, vessel_page, vessels, is_successful, outcome_message);
+        }
+
+        return(is_successful);
+    }));
+
+    results.push_back(measure("getSailingByID", iteration_count, [&](int)
+    {
+        const NamedSailing& key = seeded_sailings[random_index(settings.sailing_count)];
+
+        Sailing sailing;
+        database.getSailingByID(key.departure_terminal, key.departure_day, key.departure_hour, sailing, is_successful, outcome_message);
+
+        return(is_successful);
+    }));
+
+    PageCursor sailing_page;
+
+    results.push_back(measure("getSailingReports", iteration_count, [&](int)
+    {
+        std::vector<SailingReport> sailing_reports;
+        database.getSailingReports(g_list_length, PageDirection::Next, sailing_page, sailing_reports, is_successful, outcome_message);
+
+        if(is_successful && sailing_reports.empty())
+        {
+            database.getSailingReports(g_list_length, PageDirection::First, sailing_page, sailing_reports, is_successful, outcome_message);
+        }
+
+        return(is_successful);
+    }));
+
+    results.push_back(measure("getSailingReportByID", iteration_count, [&](int)
+    {
+        SailingReport sailing_report;
+        database.getSailingReportByID(sailings[random_index(settings.sailing_count)], sailing_report, is_successful, outcome_message);
+
+        return(is_successful);
+    }));
+
+    results.push_back(measure("getVehicleByID", iteration_count, [&](int)
+    {
+        Vehicle vehicle;
+        database.getVehicleByID(licensePlate(random_index(settings.vehicle_count)), vehicle, is_successful, outcome_message);
+
+        return(is_successful);
+    }));
+
+    results.push_back(measure("getReportBounds", iteration_count, [&](int)
+    {
+        std::vector<std::string> departure_terminals;
+        int first_day = 0;
+        int last_day = 0;
+
+        database.getReportBounds(departure_terminals, first_day, last_day, is_successful, outcome_message);
+
+        return(is_successful);
+    }));
+
+    // NOTE (SAVIZ): A whole-season report is much slower than the rest, so it is timed on one day at a time.
+    results.push_back(measure("getEndOfDayReport", iteration_count, [&](int)
+    {
+        ReportPartition partition;
+        partition.first_day = random_index(c_days_per_season) + 1;
+        partition.last_day = partition.first_day;
+
+        std::vector<EndOfDayReportRow> rows;
+        database.getEndOfDayReport(partition, rows, is_successful, outcome_message);
+
+        return(is_successful);
+    }));
+
+    // 2) Writes, each one committed on its own (the new sailings use terminals past the seeded ones):
+    int seeded_terminal_count = (settings.sailing_count + c_days_per_season * c_hours_per_day - 1) / (c_days_per_season * c_hours_per_day);
+
+    results.push_back(measure("addVessel", iteration_count, [&](int index)
+    {
+        database.addVessel(Vessel(0, "Bench Vessel " + std::to_string(index), g_lane_max_length, g_lane_max_length), is_successful, outcome_message);
+
+        return(is_successful);
+    }));
+
+    std::vector<Sailing> added_sailings;
+
+    results.push_back(measure("addSailing", iteration_count, [&](int index)
+    {
+        NamedSailing key = sailingKey(index, seeded_terminal_count);
+        Sailing sailing(0, random_index(vessel_count) + 1, key.departure_terminal, key.departure_day, key.departure_hour, g_lane_max_length, g_lane_max_length);
+
+        database.addSailing(sailing, is_successful, outcome_message);
+
+        added_sailings.push_back(sailing);
+
+        return(is_successful);
+    }));
+
+    results.push_back(measure("addVehicle", iteration_count, [&](int index)
+    {
+        int vehicle_id = 0;
+        database.addVehicle(Vehicle(0, licensePlate(settings.vehicle_count + index), "5550000000", 5.0, 1.5), vehicle_id, is_successful, outcome_message);
+
+        return(is_successful);
+    }));
+
+    // Each vehicle that was not booked yet is booked once, then boarded or cancelled:
+    int reservation_count = std::min(iteration_count, free_vehicle_count);
+
+    std::vector<int> booked_sailings;
+
+    results.push_back(measure("addReservation", reservation_count, [&](int index)
+    {
+        int sailing_index = random_index(settings.sailing_count);
+
+        Reservation reservation;
+        database.addReservation(sailings[sailing_index], seeded_vehicles[booked_vehicle_count + index], reservation, is_successful, outcome_message);
+
+        booked_sailings.push_back(sailing_index);
+
+        return(is_successful);
+    }));
+
+    results.push_back(measure("completeBoarding", (reservation_count + 1) / 2, [&](int index)
+    {
+        database.completeBoarding(sailings[booked_sailings[2 * index]], seeded_vehicles[booked_vehicle_count + 2 * index], is_successful, outcome_message);
+
+        return(is_successful);
+    }));
+
+    results.push_back(measure("removeReservation", reservation_count / 2, [&](int index)
+    {
+        database.removeReservation(sailings[booked_sailings[2 * index + 1]], seeded_vehicles[booked_vehicle_count + 2 * index + 1], is_successful, outcome_message);
+
+        return(is_successful);
+    }));
+
+    // The sailings are removed by ID, which 'addSailing()' does not return:
+    for(Sailing& sailing : added_sailings)
+    {
+        database.getSailingByID(sailing.departure_terminal, sailing.departure_day, sailing.departure_hour, sailing, is_successful, outcome_message);
+    }
+
+    results.push_back(measure("removeSailing", static_cast<int>(added_sailings.size()), [&](int index)
+    {
+        database.removeSailing(added_sailings[index], is_successful, outcome_message);
+
+        return(is_successful);
+    }));
+
+    // ------------------------------------------------------------------------
+
+
+
+    //  Section: Output
+    // ------------------------------------------------------------------------
+
+    for(const BenchResult& result : results)
+    {
+        printResult(settings, result);
+    }
+
+    database.cutConnection(is_successful, outcome_message);
+
+    std::remove(settings.database_path.c_str());
+    std::remove((settings.database_path + "-wal").c_str());
+    std::remove((settings.database_path + "-shm").c_str());
+
+    // ------------------------------------------------------------------------
+
+    return(0);
+}
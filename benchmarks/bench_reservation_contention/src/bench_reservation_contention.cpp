@@ -0,0 +1,226 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Reservation Contention Benchmark
+ *
+ *
+ * [FILE NAME]
+ *
+ * bench_reservation_contention.cpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file simulates several terminal agents booking the same sailing at the same time, each through its own connection.
+ * It reports the booking rate and fails (non-zero exit code) if the sailing was ever oversold.
+ *
+ * Usage: Bench_Reservation_Contention [agents] [vehicles per agent] [database path]
+*/
+
+// ============================================================================
+// ============================================================================
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "database.hpp"
+
+// NOTE (SAVIZ): Each lane holds a whole number of vehicles (with their 0.5 meter gaps) and then exactly one vehicle length more, so the last booking attempted on a full lane fits the vehicle but not its gap. An oversold lane would end at -0.5 meters.
+static const double c_vehicle_length = 5.0;
+static const double c_lane_length = 36 * (c_vehicle_length + 0.5) + c_vehicle_length;
+
+int main(int argc, char *argv[])
+{
+    int agent_count = (argc > 1) ? std::stoi(argv[1]) : 8;
+    int vehicles_per_agent = (argc > 2) ? std::stoi(argv[2]) : 25;
+    std::string database_path = (argc > 3) ? argv[3] : "bench_reservation_contention.db";
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    // NOTE (SAVIZ): Agents share a file (not ':memory:'), since every connection to ':memory:' gets its own private database.
+    std::remove(database_path.c_str());
+    std::remove((database_path + "-wal").c_str());
+    std::remove((database_path + "-shm").c_str());
+
+    // Same settings as '--profile terminal':
+    ConnectionProfile profile;
+    profile.journal_mode = "WAL";
+    profile.synchronous = "NORMAL";
+    profile.busy_timeout = 10000;
+
+    //  Section: Setup
+    // ------------------------------------------------------------------------
+
+    Database setup_database;
+
+    setup_database.openConnection(database_path, profile, is_successful, outcome_message);
+
+    if(is_successful)
+    {
+        setup_database.addVessel(Vessel(0, "Contention", c_lane_length, c_lane_length), is_successful, outcome_message);
+    }
+
+    std::vector<Vessel> vessels;
+
+    if(is_successful)
+    {
+        PageCursor cursor;
+
+        setup_database.getVessels(1, PageDirection::First, cursor, vessels, is_successful, outcome_message);
+    }
+
+    if(is_successful)
+    {
+        setup_database.addSailing(Sailing(0, vessels.at(0).vessel_id, "BEN", 1, 1, c_lane_length, c_lane_length), is_successful, outcome_message);
+    }
+
+    Sailing sailing;
+
+    if(is_successful)
+    {
+        setup_database.getSailingByID("BEN", 1, 1, sailing, is_successful, outcome_message);
+    }
+
+    std::vector<std::vector<int>> vehicle_ids(agent_count);
+
+    for(int agent = 0; is_successful && agent < agent_count; ++agent)
+    {
+        for(int index = 0; is_successful && index < vehicles_per_agent; ++index)
+        {
+            int vehicle_id = 0;
+
+            // Half of the vehicles are tall, so both lanes are contended:
+            double height = (index % 2 == 0) ? 1.5 : 2.5;
+
+            setup_database.addVehicle(Vehicle(0, "B" + std::to_string(agent) + "-" + std::to_string(index), "5550000000", c_vehicle_length, height), vehicle_id, is_successful, outcome_message);
+
+            vehicle_ids[agent].push_back(vehicle_id);
+        }
+    }
+
+    if(!is_successful)
+    {
+        std::cout << "Setup failed: " << outcome_message << std::endl;
+
+        return(1);
+    }
+
+    // ------------------------------------------------------------------------
+
+
+
+    //  Section: Contention
+    // ------------------------------------------------------------------------
+
+    std::atomic<int> booked_count(0);
+    std::atomic<int> rejected_count(0);
+    std::atomic<int> error_count(0);
+
+    std::vector<std::thread> agents;
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    for(int agent = 0; agent < agent_count; ++agent)
+    {
+        agents.emplace_back([&, agent]()
+        {
+            bool is_agent_successful = false;
+            std::string agent_message = "";
+
+            Database database;
+
+            database.openConnection(database_path, profile, is_agent_successful, agent_message);
+
+            if(!is_agent_successful)
+            {
+                ++error_count;
+
+                return;
+            }
+
+            // Every agent starts from the same (soon stale) snapshot of the sailing, like a terminal that fetched it a while ago:
+            Sailing agent_sailing = sailing;
+
+            for(int index = 0; index < static_cast<int>(vehicle_ids[agent].size()); ++index)
+            {
+                Vehicle vehicle(vehicle_ids[agent][index], "", "", c_vehicle_length, (index % 2 == 0) ? 1.5 : 2.5);
+                Reservation reservation;
+
+                database.addReservation(agent_sailing, vehicle, reservation, is_agent_successful, agent_message);
+
+                if(is_agent_successful)
+                {
+                    ++booked_count;
+                }
+
+                else if(agent_message.find("not enough space") != std::string::npos)
+                {
+                    ++rejected_count;
+                }
+
+                else
+                {
+                    ++error_count;
+                }
+            }
+
+            database.cutConnection(is_agent_successful, agent_message);
+        });
+    }
+
+    for(std::thread& agent : agents)
+    {
+        agent.join();
+    }
+
+    double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    // ------------------------------------------------------------------------
+
+
+
+    //  Section: Verification
+    // ------------------------------------------------------------------------
+
+    setup_database.getSailingByID("BEN", 1, 1, sailing, is_successful, outcome_message);
+
+    // Every booking takes the vehicle's length plus the 0.5 meter gap, so the lanes must account for exactly the bookings made:
+    double used_length = (c_lane_length - sailing.low_remaining_length) + (c_lane_length - sailing.high_remaining_length);
+    double expected_length = booked_count.load() * (c_vehicle_length + 0.5);
+
+    bool is_oversold = sailing.low_remaining_length < 0.0 || sailing.high_remaining_length < 0.0;
+    bool is_consistent = used_length > expected_length - 0.001 && used_length < expected_length + 0.001;
+
+    std::cout << "Agents: " << agent_count << ", attempts: " << agent_count * vehicles_per_agent << "\n";
+    std::cout << "Booked: " << booked_count << ", rejected (full): " << rejected_count << ", errors: " << error_count << "\n";
+    std::cout << "Remaining: low " << sailing.low_remaining_length << " m, high " << sailing.high_remaining_length << " m\n";
+    std::cout << "Throughput: " << (agent_count * vehicles_per_agent) / elapsed_seconds << " bookings/s\n";
+
+    setup_database.cutConnection(is_successful, outcome_message);
+
+    if(!is_successful || is_oversold || !is_consistent || error_count > 0)
+    {
+        std::cout << "FAILED: the sailing was oversold or the lanes do not match the bookings." << std::endl;
+
+        return(1);
+    }
+
+    std::cout << "OK: no overselling." << std::endl;
+
+    // ------------------------------------------------------------------------
+
+    return(0);
+}
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/catch2-populate"
+  "CMakeFiles/catch2-populate-complete"
+  "catch2-populate-prefix/src/catch2-populate-stamp/catch2-populate-build"
+  "catch2-populate-prefix/src/catch2-populate-stamp/catch2-populate-configure"
+  "catch2-populate-prefix/src/catch2-populate-stamp/catch2-populate-download"
+  "catch2-populate-prefix/src/catch2-populate-stamp/catch2-populate-install"
+  "catch2-populate-prefix/src/catch2-populate-stamp/catch2-populate-mkdir"
+  "catch2-populate-prefix/src/catch2-populate-stamp/catch2-populate-patch"
+  "catch2-populate-prefix/src/catch2-populate-stamp/catch2-populate-test"
+  "catch2-populate-prefix/src/catch2-populate-stamp/catch2-populate-update"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/catch2-populate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
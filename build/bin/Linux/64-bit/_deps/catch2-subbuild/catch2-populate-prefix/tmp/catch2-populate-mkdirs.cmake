@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/build/bin/Linux/64-bit/_deps/catch2-src"
+  "/root/repo/build/bin/Linux/64-bit/_deps/catch2-build"
+  "/root/repo/build/bin/Linux/64-bit/_deps/catch2-subbuild/catch2-populate-prefix"
+  "/root/repo/build/bin/Linux/64-bit/_deps/catch2-subbuild/catch2-populate-prefix/tmp"
+  "/root/repo/build/bin/Linux/64-bit/_deps/catch2-subbuild/catch2-populate-prefix/src/catch2-populate-stamp"
+  "/root/repo/build/bin/Linux/64-bit/_deps/catch2-subbuild/catch2-populate-prefix/src"
+  "/root/repo/build/bin/Linux/64-bit/_deps/catch2-subbuild/catch2-populate-prefix/src/catch2-populate-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/build/bin/Linux/64-bit/_deps/catch2-subbuild/catch2-populate-prefix/src/catch2-populate-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/build/bin/Linux/64-bit/_deps/catch2-subbuild/catch2-populate-prefix/src/catch2-populate-stamp${cfgdir}") # cfgdir has leading slash
+endif()
@@ -0,0 +1,259 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Async Database Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * async_database.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides a Database that runs on its own worker thread, so that the states can keep prompting the operator while slow work (commits, big reports) is done.
+ * Requests are queued and run one at a time, in the order they were made. Each request hands back a 'std::future' for its result.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef ASYNC_DATABASE_HPP
+#define ASYNC_DATABASE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "database.hpp"
+
+// The outcome of a request made through the AsyncDatabase (the same pair every Database method reports through its out-parameters).
+struct OperationResult
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+};
+
+class AsyncDatabase
+{
+public:
+    // ----------------------------------------------------------------------------
+    explicit AsyncDatabase();
+
+    /*
+    *   [Description]
+    *   Constructor for the AsyncDatabase class. Won't do any heavy work (the worker thread is started by 'openConnection()').
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    ~AsyncDatabase();
+
+    /*
+    *   [Description]
+    *   Destructor for the AsyncDatabase class. If the connection is still open, the queued requests are finished and the connection is cut before the worker thread is joined.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+    // The worker thread refers back to this object, so it can be neither copied nor moved.
+    AsyncDatabase(const AsyncDatabase&) = delete;
+    AsyncDatabase& operator=(const AsyncDatabase&) = delete;
+
+public:
+    // ----------------------------------------------------------------------------
+    void openConnection(
+        const std::string& path,          // [IN]  | The path to the database file (shared with the program's other connection).
+        const ConnectionProfile& profile, // [IN]  | The tuning settings applied to the worker's connection.
+        bool& is_successful,              // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message      // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function starts the worker thread and opens its own connection to the database file on it. It waits until the connection is open.
+    *   NOTE (SAVIZ): The worker's connection sits beside the one used directly by the states, so both must be given a busy timeout (see 'main()'). An in-memory database cannot be shared this way.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Connection failure>
+    *       If the connection cannot be opened, the worker thread is stopped and the operation will terminate with the failure status and message of 'Database::openConnection()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void cutConnection(
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function waits for every queued request to finish, cuts the worker's connection and stops the worker thread.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Not open>
+    *       If the connection is not open, the operation will terminate with a failure status and provide an appropriate error message.
+    *   @ <Cut failure>
+    *       Otherwise, the status and message of 'Database::cutConnection()' are provided.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    template<typename Function>
+    std::future<std::invoke_result_t<Function, Database&>> submit(
+        Function function // [IN] | The work to be done, given the worker's Database. (It runs on the worker thread, so it must not touch data owned by the caller)
+        );
+
+    /*
+    *   [Description]
+    *   This function queues any work on the worker's Database and returns straight away.
+    *
+    *   [Return]
+    *   A future that becomes ready with the value returned by 'function', once it has run.
+    *
+    *   [Errors]
+    *   @ <Not open>
+    *       If the connection is not open, the work is never run and the future holds a 'std::future_error' (broken promise).
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    std::future<OperationResult> boardVehicle(
+        Sailing sailing, // [IN] | The sailing being boarded.
+        Vehicle vehicle, // [IN] | The vehicle being boarded (already saved, so its ID is known).
+        bool is_reserved // [IN] | Whether the vehicle is known to have a reservation already (e.g. from the 'SailingManifest'), which saves trying to make one.
+        );
+
+    /*
+    *   [Description]
+    *   This function queues the boarding of a vehicle: a reservation is made for it if it does not have one yet (unless 'is_reserved'), and then its fare is charged.
+    *   With group commit on, a successful boarding is only reported once its group has been committed, so a ready future always means the fare is on disk.
+    *
+    *   [Return]
+    *   A future that becomes ready with the outcome of 'Database::completeBoarding()' (or of the group commit, if that failed).
+    *
+    *   [Errors]
+    *   See 'Database::completeBoarding()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void setGroupCommit(
+        const GroupCommitSettings& settings, // [IN]  | How many writes may be grouped, and for how long.
+        bool& is_successful,                 // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message         // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function applies 'Database::setGroupCommit()' to the worker's connection, once the requests queued before it are done, and waits for the result.
+    *   The worker commits the open group when its deadline passes with nothing left in the queue, so a burst of boardings shares one commit while a lone boarding waits at most 'max_delay_milliseconds'.
+    *   NOTE (SAVIZ): Work given to 'submit()' reports straight away, even if its writes are still waiting in the group. Only 'boardVehicle()' holds its outcome back.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   See 'Database::setGroupCommit()'. If the connection is not open, a failure status is provided.
+    */
+    // ----------------------------------------------------------------------------
+
+private:
+    // A successful boarding whose group has not been committed yet.
+    struct AwaitingCommit
+    {
+        std::shared_ptr<std::promise<OperationResult>> promise;
+        OperationResult result;
+    };
+
+    // Runs queued requests until asked to stop (the body of the worker thread).
+    void run();
+
+    // Hands the held back boardings their outcome, once the group they joined has ended. (Worker thread only)
+    void settleAwaitingCommits();
+
+    // Adds a request to the queue and wakes up the worker.
+    void enqueue(
+        std::function<void()> request
+        );
+
+private:
+    // The worker's own connection. NOTE (SAVIZ): Only ever used on the worker thread.
+    Database m_database;
+
+    std::thread m_worker;
+
+    // Guards 'm_requests' and 'm_is_stopping'.
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    std::deque<std::function<void()>> m_requests;
+    bool m_is_stopping;
+
+    // Boardings held back until their group is committed. NOTE (SAVIZ): Only ever used on the worker thread, so it is not guarded.
+    std::vector<AwaitingCommit> m_awaiting_commit;
+};
+
+template<typename Function>
+std::future<std::invoke_result_t<Function, Database&>> AsyncDatabase::submit(
+    Function function
+    )
+{
+    using Result = std::invoke_result_t<Function, Database&>;
+
+    // NOTE (SAVIZ): 'std::function' must be copyable, but 'std::packaged_task' is not, so the task is shared with the queue entry.
+    auto task = std::make_shared<std::packaged_task<Result()>>(
+        [this, function = std::move(function)]() mutable
+        {
+            return(function(m_database));
+        });
+
+    std::future<Result> future = task->get_future();
+
+    enqueue([task]() { (*task)(); });
+
+    return(future);
+}
+
+#endif // ASYNC_DATABASE_HPP
@@ -28,8 +28,11 @@
 #ifndef BOARDING_STATE_HPP
 #define BOARDING_STATE_HPP
 
+#include <string>
 #include "state.hpp"
 
+struct ManifestEntry;
+
 class BoardingState : public State
 {
 public:
@@ -135,6 +138,26 @@ private:
     *   This method is designed to handle all errors internally, ensuring that external components do not need to manage exception handling for its operations.
     */
     // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    bool boardVehicle(
+        const std::string& license_plate,    // [IN] | The plate typed at the gate.
+        const ManifestEntry* manifest_entry  // [IN] | Its reservation from the sailing manifest, or 'nullptr' if it has none.
+        );
+
+    /*
+    *   [Description]
+    *   Boards one vehicle that has not boarded yet. A vehicle found in the manifest costs a single query (the fare), while any other one is looked up (or created) and reserved first.
+    *
+    *   [Return]
+    *   'false' if the vehicle could not be created and its plate must be asked for again, 'true' otherwise (the outcome of the boarding itself is printed).
+    *
+    *   [Errors]
+    *   This method is designed to handle all errors internally, ensuring that external components do not need to manage exception handling for its operations.
+    */
+    // ----------------------------------------------------------------------------
 };
 
 #endif // BOARDING_STATE_HPP
@@ -0,0 +1,298 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Capacity Engine Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * capacity_engine.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides the in-memory copy of the lane capacity of every sailing, loaded once at start-up.
+ * It answers "does this vehicle fit, and in which lane" without touching the database, and writes each reservation through to the Database so the two never drift apart.
+ * It also answers "which upcoming sailings from this terminal can still take this vehicle", through one 'ScheduleIndex' per terminal.
+ *
+ * Usage:
+ *
+ *     CapacityDecision decision;
+ *
+ *     capacity_engine->decide(sailing.sailing_id, vehicle.length, vehicle.height, decision, is_successful, outcome_message);
+ *
+ *     if(is_successful && decision.fits)
+ *     {
+ *         capacity_engine->reserve(*database, decision, sailing, vehicle, reservation, is_successful, outcome_message);
+ *     }
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef CAPACITY_ENGINE_HPP
+#define CAPACITY_ENGINE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "containers.hpp"
+#include "schedule_index.hpp"
+
+class Database;
+
+// The answer to "does this vehicle fit on this sailing", tied to the state of the sailing it was made on.
+struct CapacityDecision
+{
+    int sailing_id = 0;         // The sailing the decision is about.
+    bool fits = false;          // Whether the vehicle fits in either lane.
+    bool is_low_lane = false;   // The lane chosen for it (only meaningful if it fits).
+    std::uint32_t version = 0;  // The version of the sailing's capacity the decision was made on (see 'CapacityEngine::reserve()').
+};
+
+// A sailing that can still take a vehicle, as found by 'CapacityEngine::findAvailableSailings()'.
+struct AvailableSailing
+{
+    int sailing_id = 0;
+    int departure_day = 0;
+    int departure_hour = 0;
+    bool is_low_lane = false;           // The lane the vehicle would be placed in.
+    double low_remaining_length = 0.0;
+    double high_remaining_length = 0.0;
+};
+
+class CapacityEngine
+{
+public:
+    // ----------------------------------------------------------------------------
+    explicit CapacityEngine();
+
+    /*
+    *   [Description]
+    *   Constructor for the CapacityEngine class. The table starts empty until 'load()' is called.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    ~CapacityEngine();
+
+    /*
+    *   [Description]
+    *   Destructor for the CapacityEngine class, responsible for deallocating the object from memory.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+public:
+    // ----------------------------------------------------------------------------
+    void load(
+        Database& database,          // [IN]  | The database to read the sailings from.
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function replaces the table with the remaining lane lengths of every sailing in the database, streamed through a cursor.
+    *   It is meant to be called once at start-up, after the connection is open. From then on the engine is kept up to date by 'reserve()', 'refresh()' and 'forget()'.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Read failure>
+    *       If the sailings cannot be read, the table is left empty and the operation will terminate with the failure status and message of the cursor.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void decide(
+        int sailing_id,              // [IN]  | The sailing the vehicle wants to board.
+        double length,               // [IN]  | The length of the vehicle.
+        double height,               // [IN]  | The height of the vehicle.
+        CapacityDecision& decision,  // [OUT] | Whether (and where) the vehicle fits, and the version of the sailing it was decided on.
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        ) const;
+
+    /*
+    *   [Description]
+    *   This function decides whether a vehicle fits on a sailing, using the same rule as the database: vehicles up to 2 meters tall go in the low lane if there is room, every other vehicle goes in the high lane.
+    *   It only reads the in-memory table (a binary search over a contiguous array), so it is cheap enough to call on every keystroke.
+    *   A vehicle that does not fit is still a successful decision, with 'fits' set to false.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Unknown sailing>
+    *       If the sailing is not in the table, the operation will terminate with a failure status and provide an appropriate error message saying "Record does not exist!".
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void reserve(
+        Database& database,                // [IN]     | The database the reservation is written through to.
+        const CapacityDecision& decision,  // [IN]     | The decision made by 'decide()' for this vehicle.
+        Sailing& sailing,                  // [IN/OUT] | The sailing to reserve on. Its remaining lengths are updated to the committed values on success.
+        Vehicle vehicle,                   // [IN]     | The vehicle to reserve for (already saved, so its ID is known).
+        Reservation& reservation,          // [OUT]    | The reservation that was created.
+        bool& is_successful,               // [OUT]    | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message       // [OUT]    | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function makes a reservation that was decided on with 'decide()', through 'Database::addReservation()', and then applies the committed lane lengths to the table.
+    *   Every change to a sailing bumps its version. A decision made on an older version is refused without touching the database, since the vehicle may no longer fit where it was placed.
+    *   NOTE (SAVIZ): Other terminals write to the same file, so the table can still be behind the database. The database re-checks the space itself, and if it refuses, the sailing is re-read so the next decision is made on fresh numbers.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Stale decision>
+    *       If the sailing changed since the decision was made, the operation will terminate with a failure status and provide an appropriate error message asking for a new decision.
+    *   @ <Does not fit>
+    *       If the decision says the vehicle does not fit, the operation will terminate with a failure status and provide an appropriate error message saying "not enough space on sailing.".
+    *   @ <Database failure>
+    *       Otherwise, the failure status and message of 'Database::addReservation()' are provided.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void refresh(
+        Database& database,          // [IN]  | The database to re-read the sailing from.
+        const Sailing& sailing,      // [IN]  | The sailing to re-read, found by its terminal, day and hour.
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function re-reads one sailing from the database and stores it in the table (adding it if it is new), bumping its version.
+    *   Call it after anything that changes capacity outside of 'reserve()': a new sailing, a cancelled reservation, or a boarding made on another connection.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Read failure>
+    *       If the sailing cannot be read, the table is left unchanged and the operation will terminate with the failure status and message of 'Database::getSailingByID()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void forget(
+        int sailing_id // [IN] | The sailing that was removed.
+        );
+
+    /*
+    *   [Description]
+    *   This function drops a sailing from the table (nothing happens if it is not there).
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void findAvailableSailings(
+        const std::string& departure_terminal,   // [IN]  | The terminal to depart from.
+        int from_day,                            // [IN]  | The earliest departure day to consider.
+        int from_hour,                           // [IN]  | The earliest departure hour to consider (on 'from_day').
+        double length,                           // [IN]  | The length of the vehicle.
+        double height,                           // [IN]  | The height of the vehicle.
+        int count,                               // [IN]  | The most sailings to return.
+        std::vector<AvailableSailing>& sailings, // [OUT] | The sailings that can take the vehicle, earliest first, with the lane it would go in.
+        bool& is_successful,                     // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message             // [OUT] | A descriptive message explaining the result of the operation.
+        ) const;
+
+    /*
+    *   [Description]
+    *   This function finds the next sailings from a terminal, departing at or after the given time, that still have room for the vehicle.
+    *   The search runs on the segment tree of the terminal (see 'ScheduleIndex'), so it costs about 'count' * log(sailings) steps, however many sailings are full.
+    *   Like 'decide()', the answer reflects the in-memory table. Make the reservation through 'decide()' and 'reserve()' so it is checked again.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Nothing available>
+    *       If no sailing can take the vehicle, the operation will terminate with a failure status and provide an appropriate error message saying "No records available!".
+    */
+    // ----------------------------------------------------------------------------
+
+    // The number of sailings in the table.
+    std::size_t getSailingCount() const;
+
+private:
+    // One row of the table. NOTE (SAVIZ): Kept small and in one array sorted by ID, so that a lookup touches a handful of cache lines.
+    struct SailingCapacity
+    {
+        int sailing_id;
+        std::uint32_t version;
+        double low_remaining_length;
+        double high_remaining_length;
+        std::uint16_t schedule_index; // Position of the terminal's index in 'm_schedules'.
+        std::uint8_t departure_day;
+        std::uint8_t departure_hour;
+    };
+
+    // Returns the row of the sailing, or 'nullptr' if it is not in the table.
+    const SailingCapacity* findSailing(int sailing_id) const;
+    SailingCapacity* findSailing(int sailing_id);
+
+    // Adds or overwrites the row of a sailing (and its place in the schedule of its terminal), giving it a new version.
+    void storeSailing(int sailing_id, const std::string& departure_terminal, int departure_day, int departure_hour, double low_remaining_length, double high_remaining_length);
+
+    // Returns the position of the terminal's index in 'm_schedules', adding an empty one if needed.
+    std::uint16_t findSchedule(const std::string& departure_terminal);
+
+private:
+    // Every known sailing, sorted by 'sailing_id'.
+    std::vector<SailingCapacity> m_sailings;
+
+    // One index per terminal. Terminals are few, so they are simply searched in order.
+    std::vector<ScheduleIndex> m_schedules;
+
+    // The last version handed out. Versions come from one counter, so a sailing that is removed and added again never repeats an old version.
+    std::uint32_t m_last_version;
+};
+
+#endif // CAPACITY_ENGINE_HPP
@@ -0,0 +1,200 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Command Line Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * command_line.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file is responsible for turning the arguments given to the program (and the files they point to) into start-up options.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef COMMAND_LINE_HPP
+#define COMMAND_LINE_HPP
+
+#include <string>
+#include <vector>
+#include "database.hpp"
+#include "entity_cache.hpp"
+
+// The options that control how the program starts, filled in from the command line.
+struct CommandLineOptions
+{
+    std::string database_path = "database.db"; // The database file to open.
+    ConnectionProfile connection_profile;      // The tuning settings applied to the database connection.
+    bool is_busy_timeout_given = false;        // Whether the busy timeout was set (by '--set', a profile file or the "terminal" profile), rather than left for 'main()' to choose.
+    GroupCommitSettings group_commit;          // How boardings made through the AsyncDatabase are grouped into commits.
+    std::vector<std::string> import_paths;     // Files to import (the program exits once they are imported, without showing the menus).
+    int import_thread_count = 0;               // Threads parsing each import file ('0' means one per core).
+    std::string script_path;                   // Script of commands to run instead of the menus ("-" for the standard input, empty for none).
+    bool json_mode = false;                    // Whether JSON requests are answered on the standard input/output instead of showing the menus.
+    std::string server_socket_path;            // Unix domain socket to serve JSON requests on instead of showing the menus (empty for none).
+    int server_reader_count = 0;               // Read connections of the server ('0' means one per core).
+    std::string report_partitioning;           // Print the end-of-day report, partitioned by "terminal" or "days", instead of showing the menus (empty for none).
+    int report_thread_count = 0;               // Workers reading the partitions of the report ('0' means one per core).
+    EntityCacheSettings entity_cache{0, 0};    // How many vehicles and sailings the entity cache in front of the lookups keeps (off unless both are given).
+    bool use_plate_filter = false;             // Whether vehicle lookups are first checked against a Bloom filter of the known license plates.
+    bool show_connection_profile = false;      // Whether the effective connection settings are printed at start-up.
+    bool show_usage = false;                   // Whether the usage text was requested (the program exits after printing it).
+};
+
+// ----------------------------------------------------------------------------
+void parseCommandLine(
+    int argc,                     // [IN]  | The number of arguments, as given to 'main()'.
+    char* argv[],                 // [IN]  | The arguments, as given to 'main()'.
+    CommandLineOptions& options,  // [OUT] | The options obtained from the arguments.
+    bool& is_successful,          // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+    std::string& outcome_message  // [OUT] | A descriptive message explaining the result of the operation.
+    );
+
+/*
+*   [Description]
+*   This function walks through the program arguments from left to right and fills in the options.
+*   Flags accept their value either as the next argument ("--profile terminal") or after an equals sign ("--profile=terminal").
+*   Because settings are applied in order, later flags override earlier ones (for example, "--profile terminal --set synchronous=FULL").
+*
+*   [Return]
+*   void
+*
+*   [Errors]
+*   @ <Unknown flag>
+*       If an argument is not a recognized flag, the operation will terminate with a failure status and provide an appropriate error message naming the argument.
+*   @ <Missing value>
+*       If a flag that requires a value is the last argument, the operation will terminate with a failure status and provide an appropriate error message naming the flag.
+*   @ <Invalid setting>
+*       If a profile, profile file or setting cannot be applied, the operation will terminate with the failure status and message of the underlying function.
+*/
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+void selectConnectionProfile(
+    const std::string& profile_name, // [IN]  | The name of a built-in profile ("default" or "terminal").
+    ConnectionProfile& profile,      // [OUT] | The profile to be overwritten with the built-in settings.
+    bool& is_successful,             // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+    std::string& outcome_message     // [OUT] | A descriptive message explaining the result of the operation.
+    );
+
+/*
+*   [Description]
+*   This function replaces every setting of the profile with one of the built-in profiles.
+*   "default" leaves SQLite at its own defaults (rollback journal, synchronous=FULL).
+*   "terminal" is tuned for boarding terminals: WAL journal, synchronous=NORMAL, a larger page cache, memory-mapped reads, in-memory temporary storage, enforced foreign keys and a busy timeout.
+*
+*   [Return]
+*   void
+*
+*   [Errors]
+*   @ <Unknown profile>
+*       If the name does not match a built-in profile, the operation will terminate with a failure status and provide an appropriate error message saying "Unknown profile!".
+*/
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+void loadConnectionProfile(
+    const std::string& path,     // [IN]  | The path to a profile file made of "key = value" lines.
+    ConnectionProfile& profile,  // [OUT] | The profile that the settings in the file are applied to.
+    bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+    std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+    );
+
+/*
+*   [Description]
+*   This function reads a profile file and applies each setting on top of the given profile.
+*   Blank lines and lines starting with '#' are ignored. The line "profile = <name>" selects a built-in profile at that point in the file.
+*
+*   [Return]
+*   void
+*
+*   [Errors]
+*   @ <Unreadable file>
+*       If the file cannot be opened, the operation will terminate with a failure status and provide an appropriate error message naming the path.
+*   @ <Bad line>
+*       If a line is not of the form "key = value" or its setting cannot be applied, the operation will terminate with a failure status and provide an appropriate error message naming the line number.
+*/
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+void setConnectionProfileValue(
+    const std::string& key,      // [IN]  | The name of the setting, matching a member of 'ConnectionProfile' (e.g. "journal_mode").
+    const std::string& value,    // [IN]  | The new value of the setting in text form.
+    ConnectionProfile& profile,  // [OUT] | The profile to be changed.
+    bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+    std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+    );
+
+/*
+*   [Description]
+*   This function changes a single setting of the profile.
+*   Keyword settings are stored as given and validated by the Database when the connection is opened. Numeric settings are validated here.
+*   Boolean settings accept "on", "off", "true", "false", "1" and "0".
+*
+*   [Return]
+*   void
+*
+*   [Errors]
+*   @ <Unknown setting>
+*       If the key does not name a setting, the operation will terminate with a failure status and provide an appropriate error message naming the key.
+*   @ <Invalid value>
+*       If a numeric or boolean setting cannot be parsed, the operation will terminate with a failure status and provide an appropriate error message naming the key.
+*/
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+std::string getUsage();
+
+/*
+*   [Description]
+*   This function provides the usage text describing every flag the program accepts.
+*
+*   [Return]
+*   The usage text, ready to be printed.
+*
+*   [Errors]
+*   N/A
+*/
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+std::string describeConnectionProfile(
+    const ConnectionProfile& profile // [IN] | The profile to be described.
+    );
+
+/*
+*   [Description]
+*   This function formats every setting of the profile on a single line, in the same "key=value" form accepted by "--set".
+*
+*   [Return]
+*   The description of the profile.
+*
+*   [Errors]
+*   N/A
+*/
+// ----------------------------------------------------------------------------
+
+#endif // COMMAND_LINE_HPP
@@ -29,9 +29,101 @@
 #define DATABASE_HPP
 
 #include <sqlite3.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
+#include <unordered_map>
 #include "containers.hpp"
+#include "database_cursor.hpp"
+#include "entity_cache.hpp"
+#include "plate_filter.hpp"
+#include "sailing_key.hpp"
+
+// Connection level tuning applied through PRAGMA statements when a connection is opened.
+// The default values match what SQLite uses when nothing is configured.
+struct ConnectionProfile
+{
+    std::string journal_mode = "DELETE"; // One of: DELETE, TRUNCATE, PERSIST, MEMORY, WAL, OFF.
+    std::string synchronous = "FULL";    // One of: OFF, NORMAL, FULL, EXTRA.
+    int cache_size = -2000;              // Page cache size. (Positive values are pages, negative values are KiB)
+    long long mmap_size = 0;             // Bytes of the database file to memory-map ('0' disables memory-mapped I/O).
+    std::string temp_store = "DEFAULT";  // One of: DEFAULT, FILE, MEMORY.
+    bool foreign_keys = false;           // Whether foreign key constraints are enforced.
+    int busy_timeout = 0;                // Milliseconds to wait on a locked database before failing with SQLITE_BUSY.
+    int read_connections = 0;            // Read-only connections that serve lookups and reports beside the one that writes (WAL only, '0' for none).
+};
+
+// Counters describing how much work the prepared statement cache of a connection has saved.
+struct StatementCacheStatistics
+{
+    int prepared_count = 0; // Number of times SQL text had to be compiled with 'sqlite3_prepare_v3()'.
+    int reused_count = 0;   // Number of times a cached statement was reused instead (prepares avoided).
+};
+
+// Controls how many writes are committed together (see 'Database::setGroupCommit()').
+// The default values commit every write on its own, which is what SQLite does when nothing is configured.
+struct GroupCommitSettings
+{
+    int max_operations = 1;         // Writes committed together at most ('1' turns group commit off).
+    int max_delay_milliseconds = 0; // How long the first write of a group may wait for others before the group is committed.
+};
+
+// A sailing to be imported (see 'Database::importSailings()'). Its vessel is named rather than referred to by ID, the way an import file refers to it.
+struct NamedSailing
+{
+    std::string vessel_name;
+    std::string departure_terminal;
+    int departure_day = 0;
+    int departure_hour = 0;
+};
+
+// Which page of a list to retrieve, relative to the page described by a 'PageCursor'.
+enum class PageDirection
+{
+    First,    // The first page of the list (the cursor's content is ignored).
+    Next,     // The page right after the cursor's page.
+    Previous  // The page right before the cursor's page.
+};
+
+// Remembers where the page last shown by a list starts and ends, so the next or previous page can be found by seeking on the key (instead of skipping rows with 'OFFSET').
+// NOTE (SAVIZ): The content is filled in and read only by the Database. Callers just keep it between calls and hand it back.
+struct PageCursor
+{
+    bool has_page = false; // Whether the cursor describes a page yet.
+    int first_key[3] = {}; // Sort key of the first row on the page.
+    int last_key[3] = {};  // Sort key of the last row on the page.
+};
+
+// The sailings covered by one part of an end-of-day report: those of one terminal (or of every terminal) departing between two days, inclusive.
+struct ReportPartition
+{
+    std::string departure_terminal; // Empty for every terminal.
+    int first_day = 0;
+    int last_day = 0;
+};
+
+// One sailing of an end-of-day report.
+struct EndOfDayReportRow
+{
+    SailingReport sailing_report;
+    int boarded_count = 0; // Reservations that boarded (and paid their fare).
+    double revenue = 0.0;  // The fares paid at boarding.
+};
+
+// A reservation of a sailing's manifest, with its vehicle.
+struct ManifestEntry
+{
+    Vehicle vehicle;
+    bool reserved_for_low_lane = false;
+    bool is_boarded = false;  // Whether the fare has been charged.
+    double amount_paid = 0.0; // The fare charged at boarding.
+};
 
 class Database
 {
@@ -97,6 +189,62 @@ public:
 
 
 
+    // ----------------------------------------------------------------------------
+    void openConnection(
+        const std::string& path,             // [IN]  | The path to the database file where the connection is to be established.
+        const ConnectionProfile& profile,    // [IN]  | The tuning settings to apply to the connection before the schema is initialized.
+        bool& is_successful,                 // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message         // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function behaves exactly like the overload above, but applies the given connection profile (journal mode, synchronous level, cache size, etc.) right after the file is opened.
+    *   The overload above is equivalent to calling this one with a default constructed 'ConnectionProfile'.
+    *   Use 'getConnectionProfile()' afterwards to see which settings SQLite actually accepted (for example, in-memory databases cannot use WAL mode).
+    *
+    *   With 'read_connections' set, that many read-only connections are opened beside this one. Lookups and reports ('getVesselByID()', 'getVessels()', 'getSailingByID()', 'getSailingReports()', 'getSailingReportByID()', 'getVehicleByID()', the end-of-day report and the cursors) then run on them, and may be called from several threads at once.
+    *   Each call reads one snapshot, so a report is never half before and half after a commit, and it never waits on the writes (which keep to a single thread at a time).
+    *   NOTE (SAVIZ): A thread reads its own writes on the writing connection for as long as they are not committed (an open group, or an import), since no other connection can see them yet.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Invalid profile>
+    *       If a profile value is not one of the accepted keywords, the operation will terminate with a failure status and provide an appropriate error message naming the setting.
+    *   @ <Read connections without WAL>
+    *       If read connections are asked for, but the database is in memory or not in WAL mode, the operation will terminate with a failure status and provide an appropriate error message.
+    *   @ <Invalid path>
+    *       If the input path is missing, incomplete, or invalid, the operation will terminate with a failure status and provide an appropriate error message saying "Invalid path!".
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void getConnectionProfile(
+        ConnectionProfile& effective_profile, // [OUT] | The settings currently in effect on the connection.
+        bool& is_successful,                  // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message          // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function reads every setting of 'ConnectionProfile' back from the connection using PRAGMA queries.
+    *   It is important to call 'openConnection()' before invoking this method.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Query failure>
+    *       If one of the PRAGMA queries fails, the operation will terminate with a failure status and provide an appropriate error message for diagnosis.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
     // DONE
     // ----------------------------------------------------------------------------
     void cutConnection(
@@ -107,6 +255,7 @@ public:
     /*
     *   [Description]
     *   This function attempts to close the SQLite database connection to the file.
+    *   Writes still waiting in an open group are committed first (see 'setGroupCommit()'), and all cached prepared statements are finalized before the connection (and its read connections) is closed.
     *   It is important to call this function before closing the program to ensure all resources are freed.
     *
     *   [Return]
@@ -115,6 +264,10 @@ public:
     *   [Errors]
     *   @ <Connection does not exist>
     *       If this method is called without an existing connection, the operation will terminate with a failure status and provide an appropriate error message for diagnosis.
+    *   @ <Reads in flight>
+    *       If a cursor is still open, or another thread is still reading, the operation will terminate with a failure status and provide an appropriate error message.
+    *   @ <Group commit failure>
+    *       If the pending group cannot be committed, its writes are lost. The connection is still closed, but the operation will terminate with a failure status and provide the reason.
     */
     // ----------------------------------------------------------------------------
 
@@ -179,9 +332,10 @@ public:
     // DONE
     // ----------------------------------------------------------------------------
     void getVessels(
-        int count,                    // [IN]  | The number of vessels to be retrieved.
-        int offset,                   // [IN]  | Determines the starting point the retrieve query.
-        std::vector<Vessel>& vessels, // [OUT] | The list of vessels that were retrieved.
+        int count,                    // [IN]     | The number of vessels to be retrieved.
+        PageDirection direction,      // [IN]     | Which page to retrieve, relative to 'cursor'.
+        PageCursor& cursor,           // [IN/OUT] | The page shown last. Updated to the retrieved page, unless it is empty.
+        std::vector<Vessel>& vessels, // [OUT]    | The list of vessels that were retrieved, ordered by ID.
         bool& is_successful,          // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
         std::string& outcome_message  // [OUT] | A descriptive message explaining the result of the operation.
         );
@@ -189,16 +343,16 @@ public:
     /*
     *   [Description]
     *   This function attempts to retrieve a list of vessels (usually of length '5') using SQL queries.
+    *   Pages are found by seeking past the vessel ID stored in the cursor, so every page costs the same no matter how deep into the list it is.
+    *   If there are fewer than 'count' vessels before the current page, 'PageDirection::Previous' returns the first page instead.
     *   It is important to call 'openConnection()' before invoking this method.
     *
     *   [Return]
     *   void
     *
     *   [Errors]
-    *   @ <Empty table>
-    *       If the database contains no records in the vessel table, the operation will terminate with a failure status and provide an appropriate error message saying "No records available!".
-    *   @ <Empty list due to offset>
-    *       If the given offset results in no remaining vessels in the table and the returned list is empty, the operation will terminate with a failure status and provide an appropriate error message saying "Empty list!".
+    *   @ <Empty list>
+    *       If the table is empty or there are no more vessels in the requested direction, the returned list is empty and the cursor is left unchanged. This is not a failure; it is the responsibility of the calling code to handle it.
     */
     // ----------------------------------------------------------------------------
 
@@ -293,12 +447,37 @@ public:
 
 
 
+    // ----------------------------------------------------------------------------
+    void getSailingByID(
+        SailingKey sailing_key,      // [IN]  | The packed sailing ID (see 'sailing_key.hpp').
+        Sailing& sailing,            // [OUT] | The sailing object data to be stored.
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function is the same lookup as above, for a sailing ID already packed (for example by 'SailingKey::parse()' straight from the text), and is what the other overload calls.
+    *   The key is bound as a single integer and found through the 'sailings_by_key' index (see schema version 3).
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Invalid ID>
+    *       If a sailing with the exact provided ID does not exist in the database (or the key is empty), the operation will terminate with a failure status and provide an appropriate error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
     // DONE
     // ----------------------------------------------------------------------------
     void getSailingReports(
-        int count,                                   // [IN]  | The number of sailing reports to be retrieved.
-        int offset,                                  // [IN]  | Determines the starting point the retrieve query.
-        std::vector<SailingReport>& sailing_reports, // [OUT] | The list of sailing reports that were retrieved.
+        int count,                                   // [IN]     | The number of sailing reports to be retrieved.
+        PageDirection direction,                     // [IN]     | Which page to retrieve, relative to 'cursor'.
+        PageCursor& cursor,                          // [IN/OUT] | The page shown last. Updated to the retrieved page, unless it is empty.
+        std::vector<SailingReport>& sailing_reports, // [OUT]    | The list of sailing reports that were retrieved, ordered by departure day and hour.
         bool& is_successful,                         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
         std::string& outcome_message                 // [OUT] | A descriptive message explaining the result of the operation.
         );
@@ -306,16 +485,16 @@ public:
     /*
     *   [Description]
     *   This function attempts to retrieve a list of sailing reports (usually of length '5') using SQL queries.
+    *   Pages are found by seeking past the (departure day, departure hour, sailing ID) key stored in the cursor on the departure index, so every page costs the same no matter how deep into the list it is.
+    *   If there are fewer than 'count' sailings before the current page, 'PageDirection::Previous' returns the first page instead.
     *   It is important to call 'openConnection()' before invoking this method.
     *
     *   [Return]
     *   void
     *
     *   [Errors]
-    *   @ <Empty tables>
-    *       If the database contains no records for sailing report to be generated, the operation will terminate with a failure status and provide an appropriate error message saying "No records available!".
-    *   @ <Empty list due to offset>
-    *       If the given offset results in no remaining sailing reports in the table and the returned list is empty, the operation will terminate with a failure status and provide an appropriate error message saying "Empty list!".
+    *   @ <Empty list>
+    *       If there are no sailings or no more sailings in the requested direction, the returned list is empty and the cursor is left unchanged. This is not a failure; it is the responsibility of the calling code to handle it.
     */
     // ----------------------------------------------------------------------------
 
@@ -347,18 +526,73 @@ public:
 
 
 
+    // ----------------------------------------------------------------------------
+    void getReportBounds(
+        std::vector<std::string>& departure_terminals, // [OUT] | Every departure terminal, in order.
+        int& first_day,                                // [OUT] | The first departure day (0 when there are no sailings).
+        int& last_day,                                 // [OUT] | The last departure day (-1 when there are no sailings, so the range is empty).
+        bool& is_successful,                           // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message                   // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function finds what an end-of-day report can be partitioned by: the departure terminals, and the range of departure days.
+    *   It is important to call 'openConnection()' before invoking this method.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Query failure>
+    *       If a query fails, the operation will terminate with a failure status and provide the SQLite error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void getEndOfDayReport(
+        const ReportPartition& partition,     // [IN]  | The sailings to report on.
+        std::vector<EndOfDayReportRow>& rows, // [OUT] | One row per sailing, ordered by departure day, hour and sailing.
+        bool& is_successful,                  // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message          // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function reports on the sailings of one partition: their occupancy and vehicle counts, how many vehicles boarded and what they paid.
+    *   Like the other reads, it runs on a read connection when there are some, so partitions can be reported on from several threads at once (see 'ReportBuilder').
+    *   It is important to call 'openConnection()' before invoking this method.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Empty partition>
+    *       If no sailing falls in the partition, the list is empty. This is not a failure.
+    *   @ <Query failure>
+    *       If the query fails, the operation will terminate with a failure status and provide the SQLite error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
     // DONE
     // ----------------------------------------------------------------------------
     void addReservation(
-        Sailing sailing,             // [IN]  | The sailing that the new reservation will be associated to.
-        Vehicle vehicle,             // [IN]  | Data about the vehicle of the reservation.
-        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
-        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        Sailing& sailing,            // [IN/OUT] | The sailing that the new reservation will be associated to. On success, its remaining lengths are updated to the committed values.
+        Vehicle vehicle,             // [IN]     | Data about the vehicle of the reservation.
+        Reservation& reservation,    // [OUT]    | The reservation that was created, including the lane it was assigned to.
+        bool& is_successful,         // [OUT]    | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT]    | A descriptive message explaining the result of the operation.
         );
 
     /*
     *   [Description]
     *   This function attempts to create a reservation by using SQL queries.
+    *   The lane is chosen (low lane first, for vehicles up to 2 meters tall) and the vehicle's length deducted inside a single transaction, based on the remaining lengths currently committed in the database rather than the ones carried by 'sailing'.
+    *   This means two agents booking the same sailing at the same time can never oversell it, and the whole booking costs a single commit.
     *   Note that it is assumed that 'getVehicleByID()' and 'getSailingByID()' are successfully called before this.
     *   It is important to call 'openConnection()' before invoking this method.
     *
@@ -370,10 +604,12 @@ public:
     *       If the input sailing is missing, incomplete, or invalid (an unlikely scenario as validation is made in the input layer), the operation will terminate with a failure status and provide an appropriate error message saying "Invalid sailing!".
     *   @ <Invalid vehicle>
     *       If the input vehicle is missing, incomplete, or invalid (an unlikely scenario as validation is made in the input layer), the operation will terminate with a failure status and provide an appropriate error message saying "Invalid vehicle!".
-    *   @ <Reservation already exists>
-    *       If a reservation with the exact provided data already exists, the operation will terminate with a failure status and provide an appropriate error message saying "Record already exists!".
     *   @ <Not enough space>
-    *       If the database ever runs out of space (an unlikely scenario in this case), the operation will terminate with a failure status and provide an appropriate error message for diagnosis.
+    *       If neither lane has enough remaining length for the vehicle, nothing is changed and the operation will terminate with a failure status and provide an appropriate error message saying "not enough space on sailing.".
+    *   @ <Reservation already exists>
+    *       If the vehicle already has a reservation on the sailing, nothing is changed and the operation will terminate with a failure status and provide the SQLite constraint error message.
+    *   @ <Database busy>
+    *       If another connection holds the write lock for longer than the connection's busy timeout, the operation will terminate with a failure status and provide an appropriate error message for diagnosis.
     */
     // ----------------------------------------------------------------------------
 
@@ -409,6 +645,32 @@ public:
 
 
 
+    // ----------------------------------------------------------------------------
+    void getSailingManifest(
+        int sailing_id,                      // [IN]  | The sailing whose reservations are read.
+        std::vector<ManifestEntry>& entries, // [OUT] | Every reservation of the sailing, with its vehicle (in no particular order).
+        bool& is_successful,                 // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message         // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function reads the whole manifest of a sailing in one query, so that a boarding session can look vehicles up in memory (see 'SailingManifest').
+    *   It is important to call 'openConnection()' before invoking this method.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <No reservations>
+    *       If the sailing has no reservations (or does not exist), the list is empty. This is not a failure.
+    *   @ <Query failure>
+    *       If the query fails, the operation will terminate with a failure status and provide the SQLite error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
     // NEED HELP
     // ----------------------------------------------------------------------------
     void completeBoarding(
@@ -421,6 +683,8 @@ public:
     /*
     *   [Description]
     *   This function attempts to complete the boarding for a reservation by using SQL queries.
+    *   The fare is charged in a single guarded statement: short & low vehicles pay a flat $14, long vehicles (over 7 meters) pay $2 per meter and tall vehicles (over 2 meters) pay $3 per meter.
+    *   A reservation can only be boarded once. A second attempt changes nothing.
     *   Note that it is assumed that 'getVehicleByID()' and 'getSailingByID()' are successfully called before this.
     *   It is important to call 'openConnection()' before invoking this method.
     *
@@ -432,6 +696,10 @@ public:
     *       If an invalid sailing ID is provided, the operation will terminate with a failure status and provide an appropriate error message saying "Record does not exist!".
     *   @ <Invalid license plate>
     *       If an invalid license plate is provided, the operation will terminate with a failure status and provide an appropriate error message saying "Record does not exist!".
+    *   @ <No reservation>
+    *       If the vehicle has no reservation on the sailing, the operation will terminate with a failure status and provide an appropriate error message saying "No reserevation found.".
+    *   @ <Already boarded>
+    *       If the reservation was already boarded, nothing is charged and the operation will terminate with a failure status and provide an appropriate error message including the amount that was paid.
     */
     // ----------------------------------------------------------------------------
 
@@ -488,12 +756,760 @@ public:
     *       If an invalid license plate is provided, the operation will terminate with a failure status and provide an appropriate error message saying "Record does not exist!".
     *   @ <Empty tables>
     *       If the database contains no records for vehicles, the operation will terminate with a failure status and provide an appropriate error message saying "No records available!".
+    *   @ <Ruled out by the plate filter>
+    *       If a plate filter is set (see 'setPlateFilter()') and still rules the plate out after reading the vehicles created since it last looked, the operation terminates the same way as for a missing vehicle, without querying for the plate.
     */
     // ----------------------------------------------------------------------------
 
-private:
-    // The SQLite connection entity. (Used as a means to interact with the underlying database)
-    sqlite3* m_sqlite3;
+
+
+    // ----------------------------------------------------------------------------
+    void getVehiclePlates(
+        int first_vehicle_id,                     // [IN]  | The ID to start from ('0' for every vehicle).
+        std::vector<int>& vehicle_ids,            // [OUT] | The IDs of the vehicles from 'first_vehicle_id' on, in order.
+        std::vector<std::string>& license_plates, // [OUT] | Their license plates, in the same order.
+        bool& is_successful,                      // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message              // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function reads the license plates of the vehicles with an ID of at least 'first_vehicle_id', for building a 'PlateFilter'.
+    *   Vehicle IDs are never reused, so starting from the last ID seen gives exactly the vehicles created since.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Read failure>
+    *       If the vehicles cannot be read, both lists are left empty and the operation will terminate with a failure status and provide an appropriate error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+
+    // ----------------------------------------------------------------------------
+    void openVesselCursor(
+        RowCursor<VesselView>& cursor, // [OUT] | The cursor to be positioned before the first vessel.
+        bool& is_successful,           // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message   // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function opens a cursor over every vessel, ordered by ID. The rows are read one at a time as the cursor is iterated, in constant memory.
+    *   While the cursor is open it holds a read transaction, so it should be iterated (or closed) right away. It must be closed before 'cutConnection()'.
+    *   It is important to call 'openConnection()' before invoking this method.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Cursor already open>
+    *       If another cursor over vessels is still open on this connection, the operation will terminate with a failure status and provide an appropriate error message saying "another cursor over this query is still open.".
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void openSailingReportCursor(
+        RowCursor<SailingReportView>& cursor, // [OUT] | The cursor to be positioned before the first sailing report.
+        bool& is_successful,                  // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message          // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function opens a cursor over the report of every sailing, ordered by departure day and hour. The rows are read one at a time as the cursor is iterated, in constant memory.
+    *   While the cursor is open it holds a read transaction, so it should be iterated (or closed) right away. It must be closed before 'cutConnection()'.
+    *   It is important to call 'openConnection()' before invoking this method.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Cursor already open>
+    *       If another cursor over sailing reports is still open on this connection, the operation will terminate with a failure status and provide an appropriate error message saying "another cursor over this query is still open.".
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void getStatementCacheStatistics(
+        StatementCacheStatistics& statistics // [OUT] | The counters of the prepared statement cache.
+        );
+
+    /*
+    *   [Description]
+    *   This function provides the number of statements compiled and the number of compilations avoided by reusing cached statements since the object was created.
+    *   Useful for confirming that hot paths (boarding, reservations) are no longer re-parsing their SQL on every call.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void setEntityCache(
+        EntityCache* entity_cache,   // [IN]  | The cache to read through, or 'nullptr' for none. (Not owned, and may be shared with other Database objects on the same file)
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function puts an entity cache in front of 'getVehicleByID()', 'getSailingByID()', 'getVesselByID()' and 'getVessels()'. A lookup found in the cache does not touch SQLite at all.
+    *   Every write invalidates what it changes in the cache, and nothing is kept from a read made while a write is uncommitted (see 'entity_cache.hpp').
+    *   Any writes in an open group are committed first, so that the old cache (if any) is no longer held by an unfinished write.
+    *   NOTE (SAVIZ): The cache must outlive its use by this object. Writes made by anything that does not share the cache (another process, or the SQLite shell) are not seen until the entry is evicted.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Group commit failure>
+    *       If the writes grouped so far cannot be committed, the cache is left unchanged and the operation will terminate with the failure status and message of 'flushGroupCommit()'.
+    */
+    // ----------------------------------------------------------------------------
+
+    // ----------------------------------------------------------------------------
+    void setPlateFilter(
+        PlateFilter* plate_filter,   // [IN]  | The filter to consult, or 'nullptr' for none. (Not owned, and may be shared with other Database objects on the same file)
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function puts a plate filter in front of 'getVehicleByID()'. A plate the filter rules out is reported missing without querying for it, and 'addVehicle()' and 'importVehicles()' add the plates they create to the filter.
+    *   Before ruling a plate out, the filter reads the vehicles created since the last one it knows of (see 'PlateFilter::catchUp()'), so vehicles created by anything that does not share the filter (another process, or the SQLite shell) are still found.
+    *   NOTE (SAVIZ): The filter must outlive its use by this object.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void setGroupCommit(
+        const GroupCommitSettings& settings, // [IN]  | How many writes may be grouped, and for how long.
+        bool& is_successful,                 // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message         // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function turns group commit on or off. Group commit only affects 'addReservation()', 'completeBoarding()' and 'addVehicle()'.
+    *   When it is on, the first of these writes opens a transaction, and the writes that follow join it. The group is committed once it holds 'max_operations' writes, or at the end of the first write made after 'max_delay_milliseconds' have passed. A burst of boardings then costs one sync to disk instead of one per car.
+    *   Each write gets its own savepoint, so a write that fails undoes only its own changes and reports its own outcome.
+    *   A write that reports success is only durable once its group is committed. Until then it can still be lost (for example if the commit fails or the program dies).
+    *   NOTE (SAVIZ): The Database has no timer of its own. A caller that stops writing must call 'flushGroupCommit()' itself (see 'AsyncDatabase', which does this when its queue runs dry). Otherwise the open group keeps the write lock.
+    *   Any writes grouped under the old settings are committed first.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Invalid settings>
+    *       If 'max_operations' is below 1 or 'max_delay_milliseconds' is negative, the operation will terminate with a failure status and provide an appropriate error message.
+    *   @ <Group commit failure>
+    *       If the writes grouped so far cannot be committed, the settings are left unchanged and the operation will terminate with the failure status and message of 'flushGroupCommit()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void flushGroupCommit(
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function commits the writes in the open group, if there is one. Its outcome is also kept for 'getLastGroupCommitOutcome()'.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Commit failure>
+    *       If SQLite cannot commit, every write in the group is rolled back and the operation will terminate with a failure status and provide the SQLite error message.
+    *   @ <Group lost>
+    *       If an earlier error made SQLite roll the whole transaction back, the operation will terminate with a failure status and provide an appropriate error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    bool hasPendingWrites() const;
+
+    /*
+    *   [Description]
+    *   This function tells whether a group is open, i.e. whether writes are waiting for 'flushGroupCommit()'.
+    *
+    *   [Return]
+    *   Whether a group is open.
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    std::chrono::steady_clock::time_point getGroupCommitDeadline() const;
+
+    /*
+    *   [Description]
+    *   This function provides the time by which the open group should be committed ('max_delay_milliseconds' after its first write).
+    *
+    *   [Return]
+    *   The deadline of the open group (meaningless if 'hasPendingWrites()' is false).
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void getLastGroupCommitOutcome(
+        bool& is_successful,         // [OUT] | Whether the last group to end was committed.
+        std::string& outcome_message // [OUT] | The reason it was not (empty on success).
+        ) const;
+
+    /*
+    *   [Description]
+    *   This function reports how the last group ended. This is for callers that hold back the outcome of their writes until the group is durable.
+    *   A group can end inside a write (it reached 'max_operations', or the write lost the whole transaction), so such callers check 'hasPendingWrites()' after every write.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+    // ----------------------------------------------------------------------------
+    void importVessels(
+        const std::vector<Vessel>& vessels, // [IN]  | The vessels to create (their IDs are ignored).
+        std::vector<bool>& is_imported,     // [OUT] | For each vessel, whether it was created.
+        bool& is_successful,                // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message        // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function creates many vessels at once, for bulk imports. Vessels are inserted up to 'DatabaseQueries::c_import_batch_rows' per statement, inside a single transaction.
+    *   A vessel that breaks a constraint (its name is already taken, including earlier in the same list) is skipped rather than failing the whole list, and reported through 'is_imported'.
+    *   The values are expected to be validated by the caller, like for 'addVessel()'.
+    *   The transaction joins an open group when group commit is on, so a caller can spread one transaction over many calls (see 'setGroupCommit()').
+    *   It is important to call 'openConnection()' before invoking this method.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Import failure>
+    *       If a statement fails for any other reason, nothing from this call is kept and the operation will terminate with a failure status and provide the SQLite error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void importSailings(
+        const std::vector<NamedSailing>& sailings, // [IN]  | The sailings to create.
+        std::vector<bool>& is_imported,            // [OUT] | For each sailing, whether it was created.
+        bool& is_successful,                       // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message               // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function creates many sailings at once, like 'importVessels()'. Each sailing starts with the full lane lengths of its vessel, as in the sailing menu.
+    *   A sailing is skipped if its vessel does not exist or its sailing ID is already taken.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Import failure>
+    *       If a statement fails for any other reason, nothing from this call is kept and the operation will terminate with a failure status and provide the SQLite error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void importVehicles(
+        const std::vector<Vehicle>& vehicles, // [IN]  | The vehicles to create (their IDs are ignored).
+        std::vector<bool>& is_imported,       // [OUT] | For each vehicle, whether it was created.
+        bool& is_successful,                  // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message          // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function creates many vehicles at once, like 'importVessels()'. A vehicle is skipped if its license plate is already taken.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Import failure>
+    *       If a statement fails for any other reason, nothing from this call is kept and the operation will terminate with a failure status and provide the SQLite error message.
+    */
+    // ----------------------------------------------------------------------------
+
+private:
+    // NOTE (SAVIZ): Cursors borrow statements from the cache and give them back through 'lendStatement()' and 'returnStatement()'.
+    friend class StatementCursor;
+
+    // ----------------------------------------------------------------------------
+    void openCursor(
+        const char* sql_query,         // [IN]  | The SQL text of the query. (Must have static storage duration)
+        StatementCursor& cursor,       // [OUT] | The cursor to be opened over the query.
+        bool& is_successful,           // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message   // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function lends the cached statement of a query (without parameters) to a cursor.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Cursor already open>
+    *       If the statement is still being stepped by another cursor, the operation will terminate with a failure status.
+    */
+    // ----------------------------------------------------------------------------
+
+    void lendStatement(sqlite3_stmt* prepared_sql_statement);
+    void returnStatement(sqlite3_stmt* prepared_sql_statement);
+
+    // A read-only connection of the pool, with its own statement cache.
+    struct ReadConnection
+    {
+        sqlite3* handle = nullptr;
+        std::unordered_map<const char*, sqlite3_stmt*> prepared_statements;
+        std::vector<sqlite3_stmt*> lent_statements; // Lent to cursors, like 'm_lent_statements'.
+        std::thread::id lessee;                     // The thread using the connection, while 'lease_count' is above 0.
+        int lease_count = 0;                        // Leases held by that thread (reads nest, e.g. lookups while a cursor is open).
+    };
+
+    // The connection one read call runs on, leased for as long as the call lasts.
+    class ReadLease
+    {
+    public:
+        explicit ReadLease(Database* database) : m_database(database), m_read_connection(database->leaseReadConnection()) {}
+        ~ReadLease() { m_database->releaseReadConnection(m_read_connection); }
+
+        ReadLease(const ReadLease&) = delete;
+        ReadLease& operator=(const ReadLease&) = delete;
+
+        ReadConnection* getReadConnection() const { return(m_read_connection); }
+
+        // Whether this read is on a snapshot taken after the lease began (not one held over from an open cursor or transaction), which is what the entity cache may keep.
+        bool isFresh() const { return(m_read_connection != nullptr ? m_read_connection->lease_count == 1 : sqlite3_get_autocommit(m_database->m_sqlite3) != 0 && m_database->m_lent_statements.empty()); }
+        sqlite3* getHandle() const { return(m_read_connection != nullptr ? m_read_connection->handle : m_database->m_sqlite3); }
+
+    private:
+        Database* m_database;
+        ReadConnection* m_read_connection; // 'nullptr' when the call reads on the writing connection.
+    };
+
+
+
+    // One write call, as seen by the entity cache: the first write opens a write in the cache, which is ended once the connection is back in autocommit (here, or in 'flushGroupCommit()').
+    class EntityWrite
+    {
+    public:
+        explicit EntityWrite(Database* database);
+        ~EntityWrite();
+
+        EntityWrite(const EntityWrite&) = delete;
+        EntityWrite& operator=(const EntityWrite&) = delete;
+
+        // Takes a sailing out of the cache, to be put back with its new remaining lengths if the write commits on its own.
+        void takeSailing(int sailing_id);
+        void setWrittenLengths(double low_remaining_length, double high_remaining_length);
+
+    private:
+        Database* m_database;
+        bool m_has_sailing;
+        bool m_is_written;
+        SailingKey m_sailing_key;
+        Sailing m_sailing;
+    };
+
+    void endEntityWrite();
+
+    // Reads the whole vessel catalog into 'catalog' (and the entity cache) if it is no larger than the cache takes. Returns whether it was.
+    bool loadVesselCatalog(std::vector<Vessel>& catalog);
+
+
+
+    // ----------------------------------------------------------------------------
+    void openReadConnections(
+        const std::string& path,          // [IN]  | The path of the database file, as given to 'openConnection()'.
+        const ConnectionProfile& profile, // [IN]  | How many read connections to open, and their cache settings.
+        bool& is_successful,              // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message      // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function opens the read-only connections of the pool, once the writing connection has the schema in place.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Not in WAL mode>
+    *       If the database is in memory or not in WAL mode, the operation will terminate with a failure status and provide an appropriate error message.
+    *   @ <Connection failure>
+    *       If a read connection cannot be opened or tuned, the operation will terminate with a failure status and provide the SQLite error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    ReadConnection* leaseReadConnection();
+
+    /*
+    *   [Description]
+    *   This function takes a read connection from the pool for the calling thread, waiting for one to be free. A thread that already holds one gets the same one again.
+    *   The first lease opens a read transaction, so everything read until the last lease is released comes from one snapshot.
+    *
+    *   [Return]
+    *   The read connection, or 'nullptr' when the call must read on the writing connection (there is no pool, or the calling thread has writes that are not committed yet).
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void releaseReadConnection(
+        ReadConnection* read_connection // [IN] | The connection returned by 'leaseReadConnection()' (may be 'nullptr').
+        );
+
+    /*
+    *   [Description]
+    *   This function hands back one lease. The last one ends the read transaction, and puts the connection back in the pool.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    int acquireReadStatement(
+        ReadConnection* read_connection,       // [IN]  | The leased read connection, or 'nullptr' for the writing connection.
+        const char* sql_query,                 // [IN]  | The SQL text of a single statement. (Must have static storage duration, since its address is used as the cache key)
+        sqlite3_stmt*& prepared_sql_statement  // [OUT] | The prepared statement, ready for bindings.
+        );
+
+    /*
+    *   [Description]
+    *   This function behaves like 'acquireStatement()', but on the statement cache of the given read connection.
+    *   The statements of read connections are not counted in 'getStatementCacheStatistics()', which describes the writing connection.
+    *
+    *   [Return]
+    *   The SQLite result code of the preparation ('SQLITE_OK' on success).
+    *
+    *   [Errors]
+    *   @ <Invalid SQL>
+    *       If the SQL fails to compile, nothing is cached and the error code is returned so the caller can report 'sqlite3_errmsg()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void importRows(
+        const char* batch_sql_query,                                          // [IN]  | The import query for a full batch of rows. (Must have static storage duration)
+        const char* row_sql_query,                                            // [IN]  | The same query for a single row, used for what is left after the last full batch. (Must have static storage duration)
+        std::size_t row_count,                                                // [IN]  | The number of rows to import.
+        int column_count,                                                     // [IN]  | The number of parameters per row.
+        const std::function<void(sqlite3_stmt*, std::size_t, int)>& bind_row, // [IN]  | Binds a row, given the statement, the row and the index of its first parameter.
+        const std::function<std::string(std::size_t)>& get_row_key,           // [IN]  | Returns the unique key of a row.
+        const std::function<std::string(sqlite3_stmt*)>& get_returned_key,    // [IN]  | Returns the key of a row named by 'RETURNING'.
+        std::vector<bool>& is_imported,                                       // [OUT] | For each row, whether it was inserted.
+        bool& is_successful,                                                  // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message                                          // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function runs the import queries behind 'importVessels()', 'importSailings()' and 'importVehicles()' in one transaction, and matches the keys returned by each statement back to its rows.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Import failure>
+    *       If a statement fails, the transaction is rolled back and the operation will terminate with a failure status and provide the SQLite error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void applyConnectionProfile(
+        const ConnectionProfile& profile, // [IN]  | The tuning settings to apply.
+        bool& is_successful,              // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message      // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function validates the keyword settings of the profile and issues the matching PRAGMA statements on the open connection.
+    *   Keywords are checked against a fixed list since PRAGMA values cannot be bound as parameters.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Invalid profile>
+    *       If a keyword setting is not recognized, the operation will terminate with a failure status and provide an appropriate error message naming the setting.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void migrateSchema(
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function brings the schema of an open database up to date, by applying the migrations it has not been through yet (see 'DatabaseQueries::c_schema_migrations').
+    *   The number of migrations applied is stored in 'PRAGMA user_version'. Each migration is applied and recorded in a single transaction.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Migration failure>
+    *       If a migration fails, it is rolled back (leaving the database at the previous version) and the operation will terminate with a failure status and provide an appropriate error message naming the version.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void beginTransaction(
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function starts a transaction that holds the write lock from the start ("BEGIN IMMEDIATE").
+    *   With group commit on, it instead opens the group (if needed) and sets a savepoint for one write inside it.
+    *   Every successful call must be followed by either 'commitTransaction()' or 'rollbackTransaction()'.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Database busy>
+    *       If another connection holds the write lock for longer than the busy timeout, the operation will terminate with a failure status and provide the SQLite error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void commitTransaction(
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function commits the transaction started by 'beginTransaction()'.
+    *   If the commit fails, the transaction is rolled back so the connection is left in autocommit mode.
+    *   With group commit on, it instead releases the write's savepoint and commits the whole group if it is full or past its deadline.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Commit failure>
+    *       If SQLite cannot commit, the operation will terminate with a failure status and provide the SQLite error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void rollbackTransaction();
+
+    /*
+    *   [Description]
+    *   This function undoes the transaction started by 'beginTransaction()', if it is still open.
+    *   With group commit on, only the changes made since the write's savepoint are undone. If the error already rolled back the whole group, the group is ended as failed.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void executeStatement(
+        const char* sql_query,       // [IN]  | The SQL text of a single statement without parameters or result rows. (Must have static storage duration)
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function runs a single cached statement to completion. Used for transaction control statements.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Execution failure>
+    *       If the statement fails to compile or run, the operation will terminate with a failure status and provide the SQLite error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    int acquireStatement(
+        const char* sql_query,                 // [IN]  | The SQL text of a single statement. (Must have static storage duration, since its address is used as the cache key)
+        sqlite3_stmt*& prepared_sql_statement  // [OUT] | The prepared statement, ready for bindings.
+        );
+
+    /*
+    *   [Description]
+    *   This function looks up the prepared statement registered for the given SQL text.
+    *   On the first use the SQL is compiled and stored in the cache, every later use returns the same statement without compiling it again.
+    *   Every statement obtained through this function must be handed back with 'releaseStatement()'.
+    *
+    *   [Return]
+    *   The SQLite result code of the preparation ('SQLITE_OK' on success).
+    *
+    *   [Errors]
+    *   @ <Invalid SQL>
+    *       If the SQL fails to compile, nothing is cached and the error code is returned so the caller can report 'sqlite3_errmsg()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void releaseStatement(
+        sqlite3_stmt* prepared_sql_statement // [IN] | The statement previously obtained through 'acquireStatement()'.
+        );
+
+    /*
+    *   [Description]
+    *   This function resets the statement and clears its bindings so it can be reused by the next call.
+    *   This takes the place of 'sqlite3_finalize()', the statement itself stays in the cache.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void finalizeStatements();
+
+    /*
+    *   [Description]
+    *   This function finalizes every cached statement and empties the cache.
+    *   It must be called before the connection is closed.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+private:
+    // The SQLite connection entity. (Used as a means to interact with the underlying database)
+    sqlite3* m_sqlite3;
+
+    // Prepared statements owned by this connection, keyed by the address of the SQL text that produced them.
+    std::unordered_map<const char*, sqlite3_stmt*> m_prepared_statements;
+
+    // Counters for how often statements were compiled or reused.
+    StatementCacheStatistics m_statement_cache_statistics;
+
+    // The statements currently lent to cursors (the connection cannot be cut while any are out). Rarely more than one.
+    std::vector<sqlite3_stmt*> m_lent_statements;
+
+    // Group commit state: the settings, whether a group is open, how many writes it holds, when it is due, and how the last group ended.
+    GroupCommitSettings m_group_commit_settings;
+    bool m_is_group_open;
+    int m_group_operation_count;
+    std::chrono::steady_clock::time_point m_group_deadline;
+    bool m_last_group_is_successful;
+    std::string m_last_group_outcome_message;
+
+    // The thread that last began a transaction on the writing connection (its reads stay there while the transaction is open).
+    std::atomic<std::thread::id> m_writing_thread;
+
+    // The entity cache in front of the lookups (not owned), and the write this object has open in it, if any.
+    EntityCache* m_entity_cache;
+    bool m_is_entity_write_open;
+    std::uint64_t m_entity_write_generation;
+
+    // The filter of known license plates in front of 'getVehicleByID()' (not owned).
+    PlateFilter* m_plate_filter;
+
+    // The pool of read connections (fixed once open, so it can be searched without the lock). The lock guards who holds which connection.
+    std::vector<std::unique_ptr<ReadConnection>> m_read_connections;
+    std::mutex m_read_pool_mutex;
+    std::condition_variable m_read_pool_condition;
 };
 
 #endif // DATABASE_HPP
@@ -0,0 +1,224 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Database Cursor Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * database_cursor.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides cursors that walk over the rows of a query one at a time, straight from the SQLite statement.
+ * Unlike the 'get...()' methods of the Database, nothing is copied into containers, so a cursor reads any number of rows in constant memory.
+ *
+ * Usage:
+ *
+ *     RowCursor<VesselView> cursor;
+ *
+ *     database->openVesselCursor(cursor, is_successful, outcome_message);
+ *
+ *     for(const VesselView& vessel : cursor)
+ *     {
+ *         std::cout << vessel.vessel_name << "\n";
+ *     }
+ *
+ *     cursor.getOutcome(is_successful, outcome_message);
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef DATABASE_CURSOR_HPP
+#define DATABASE_CURSOR_HPP
+
+#include <string>
+#include <string_view>
+#include <sqlite3.h>
+
+class Database;
+
+// A vessel row, read in place.
+// NOTE (SAVIZ): Views point into the memory of the SQLite statement. They are only valid until the cursor moves to the next row, so copy what you need to keep (e.g. 'std::string(vessel.vessel_name)').
+struct VesselView
+{
+    int vessel_id = 0;
+    std::string_view vessel_name;
+    double low_ceiling_lane_length = 0.0;
+    double high_ceiling_lane_length = 0.0;
+
+    // Reads the columns of 'DatabaseQueries::c_select_all_vessels' from the current row.
+    void read(sqlite3_stmt* prepared_sql_statement);
+};
+
+// A sailing report row, read in place (see the note on 'VesselView').
+struct SailingReportView
+{
+    int sailing_id = 0;
+    std::string_view departure_terminal;
+    int departure_day = 0;
+    int departure_hour = 0;
+    double low_remaining_length = 0.0;
+    double high_remaining_length = 0.0;
+    std::string_view vessel_name;
+    int vehicle_count = 0;
+    double occupancy_percentage = 0.0;
+
+    // Reads the columns of 'DatabaseQueries::c_select_all_sailing_reports' from the current row.
+    void read(sqlite3_stmt* prepared_sql_statement);
+};
+
+// Steps through the rows of one statement borrowed from the statement cache of a Database, and hands it back when done.
+class StatementCursor
+{
+public:
+    explicit StatementCursor();
+    ~StatementCursor();
+
+    // A cursor owns a live statement, so it can be neither copied nor moved.
+    StatementCursor(const StatementCursor&) = delete;
+    StatementCursor& operator=(const StatementCursor&) = delete;
+
+public:
+    // ----------------------------------------------------------------------------
+    bool step();
+
+    /*
+    *   [Description]
+    *   This function moves the cursor to the next row. When the rows run out (or an error happens), the statement is handed back to the Database straight away.
+    *
+    *   [Return]
+    *   Whether the cursor is now on a row.
+    *
+    *   [Errors]
+    *   @ <Step failure>
+    *       If SQLite fails to produce the next row, false is returned and the error is kept for 'getOutcome()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void close();
+
+    /*
+    *   [Description]
+    *   This function hands the statement back to the Database, ending its read transaction. It is called by the destructor, so it only needs to be called directly to stop early.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void getOutcome(
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        ) const;
+
+    /*
+    *   [Description]
+    *   This function reports whether every row was read successfully. Call it after the loop, since a failure part way simply ends the loop.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Step failure>
+    *       If stepping failed, the failure status and the SQLite error message are provided.
+    */
+    // ----------------------------------------------------------------------------
+
+    sqlite3_stmt* getStatement() const;
+
+private:
+    friend class Database;
+
+    // Called by the Database once the statement has been acquired and bound.
+    void open(
+        Database* database,
+        sqlite3_stmt* prepared_sql_statement
+        );
+
+private:
+    Database* m_database;
+    sqlite3_stmt* m_prepared_sql_statement;
+    bool m_is_successful;
+    std::string m_outcome_message;
+};
+
+// A single-pass cursor over typed row views, usable in a range-for.
+template<typename RowView>
+class RowCursor
+{
+public:
+    class Iterator
+    {
+    public:
+        explicit Iterator(RowCursor* cursor) : m_cursor(cursor) {}
+
+        const RowView& operator*() const { return(m_cursor->m_row); }
+        const RowView* operator->() const { return(&m_cursor->m_row); }
+
+        Iterator& operator++()
+        {
+            if(!m_cursor->advance())
+            {
+                m_cursor = nullptr;
+            }
+
+            return(*this);
+        }
+
+        bool operator!=(const Iterator& other) const { return(m_cursor != other.m_cursor); }
+        bool operator==(const Iterator& other) const { return(m_cursor == other.m_cursor); }
+
+    private:
+        RowCursor* m_cursor; // 'nullptr' once the rows run out (which is what 'end()' holds).
+    };
+
+public:
+    // NOTE (SAVIZ): The rows are read as the loop goes, so 'begin()' can only be called once per opening.
+    Iterator begin() { return(advance() ? Iterator(this) : end()); }
+    Iterator end() { return(Iterator(nullptr)); }
+
+    void close() { m_statement_cursor.close(); }
+
+    void getOutcome(bool& is_successful, std::string& outcome_message) const { m_statement_cursor.getOutcome(is_successful, outcome_message); }
+
+    StatementCursor& getStatementCursor() { return(m_statement_cursor); }
+
+private:
+    bool advance()
+    {
+        if(!m_statement_cursor.step())
+        {
+            return(false);
+        }
+
+        m_row.read(m_statement_cursor.getStatement());
+
+        return(true);
+    }
+
+private:
+    StatementCursor m_statement_cursor;
+    RowView m_row;
+};
+
+#endif // DATABASE_CURSOR_HPP
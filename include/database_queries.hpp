@@ -0,0 +1,556 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Database Queries Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * database_queries.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file holds every SQL statement run by the Database, so that they can be reviewed (and their query plans tested) in one place.
+ * NOTE (SAVIZ): The Database caches prepared statements by the address of their SQL text, which is why these are single 'inline' constants and never copies.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef DATABASE_QUERIES_HPP
+#define DATABASE_QUERIES_HPP
+
+namespace DatabaseQueries
+{
+
+// Schema:
+// ****************************************************************************
+
+// The schema, run every time a connection is opened (tables and indexes are only created if missing).
+inline constexpr const char* c_create_schema = R"SQL(
+    BEGIN TRANSACTION;
+
+    -- VESSELS
+    CREATE TABLE IF NOT EXISTS vessels (
+        vessel_id_pk INTEGER PRIMARY KEY AUTOINCREMENT,
+        vessel_name TEXT NOT NULL UNIQUE,
+        low_ceiling_lane_length REAL NOT NULL,
+        high_ceiling_lane_length REAL NOT NULL
+    );
+
+    -- SAILINGS
+    CREATE TABLE IF NOT EXISTS sailings (
+        sailing_id_pk INTEGER PRIMARY KEY AUTOINCREMENT,
+        vessel_id_fk INTEGER NOT NULL,
+        departure_terminal TEXT NOT NULL,
+        departure_day INTEGER NOT NULL,
+        departure_hour INTEGER NOT NULL,
+        low_remaining_length REAL NOT NULL,
+        high_remaining_length REAL NOT NULL,
+
+        FOREIGN KEY(vessel_id_fk) REFERENCES vessels(vessel_id_pk),
+
+        -- Making the combination of the sailing ID unique:
+        UNIQUE(departure_terminal, departure_day, departure_hour)
+    );
+
+
+    -- VEHICLES
+    CREATE TABLE IF NOT EXISTS vehicles (
+        vehicle_id_pk INTEGER PRIMARY KEY AUTOINCREMENT,
+        license_plate TEXT NOT NULL UNIQUE,
+        phone_number TEXT NOT NULL,
+        length REAL NOT NULL,
+        height REAL NOT NULL
+    );
+
+    -- RESERVATIONS
+    -- (Many-to-Many relationship between SAILINGS and VEHICLES)
+    CREATE TABLE IF NOT EXISTS reservations (
+        sailing_id_fk INTEGER NOT NULL,
+        vehicle_id_fk INTEGER NOT NULL,
+        amount_paid INTEGER NOT NULL,
+        reserved_for_low_lane BOOLEAN NOT NULL,
+
+        PRIMARY KEY (sailing_id_fk, vehicle_id_fk),
+        FOREIGN KEY(sailing_id_fk) REFERENCES sailings(sailing_id_pk),
+        FOREIGN KEY(vehicle_id_fk) REFERENCES vehicles(vehicle_id_pk)
+    );
+
+    -- INDEXES
+    -- NOTE (SAVIZ): Every query has to be served by one of these (or a primary key / unique constraint), which is checked by 'Test_Database'.
+
+    -- Sailings are listed by departure time (the sailing ID is implicitly part of the index, which makes the key unique):
+    CREATE INDEX IF NOT EXISTS sailings_by_departure ON sailings(departure_day, departure_hour);
+
+    -- Reservations of a vehicle (the primary key only serves lookups by sailing). Covering, so it never touches the table:
+    CREATE INDEX IF NOT EXISTS reservations_by_vehicle ON reservations(vehicle_id_fk, sailing_id_fk);
+
+    COMMIT;
+)SQL";
+
+// Changes made to the schema after its first release, applied in order by 'Database::migrateSchema()'.
+// NOTE (SAVIZ): The database remembers how many of these it has been through in 'PRAGMA user_version'. Never edit a migration that was shipped; add a new one to the end instead.
+inline constexpr const char* c_schema_migrations[] =
+{
+    // Version 1: Sailings keep their vehicle count and occupancy up to date, instead of every report recounting them.
+    R"SQL(
+        ALTER TABLE sailings ADD COLUMN reserved_vehicle_count INTEGER NOT NULL DEFAULT 0;
+        ALTER TABLE sailings ADD COLUMN occupancy_percentage REAL NOT NULL DEFAULT 0;
+
+        -- Occupied length over total length, truncated to a whole percentage (0 if the vessel has no lanes).
+        -- TRUNC() is used instead of FLOOR(), which is the same for non-negative values and did not need extra build options:
+        UPDATE sailings SET
+            reserved_vehicle_count = (SELECT COUNT(*) FROM reservations WHERE reservations.sailing_id_fk = sailings.sailing_id_pk),
+            occupancy_percentage = COALESCE((
+                SELECT TRUNC(((vessels.low_ceiling_lane_length + vessels.high_ceiling_lane_length - sailings.low_remaining_length - sailings.high_remaining_length) / (vessels.low_ceiling_lane_length + vessels.high_ceiling_lane_length)) * 100.0)
+                FROM vessels WHERE vessels.vessel_id_pk = sailings.vessel_id_fk
+                ), 0);
+
+        CREATE TRIGGER reservations_count_on_insert AFTER INSERT ON reservations
+        BEGIN
+            UPDATE sailings SET reserved_vehicle_count = reserved_vehicle_count + 1 WHERE sailing_id_pk = NEW.sailing_id_fk;
+        END;
+
+        CREATE TRIGGER reservations_count_on_delete AFTER DELETE ON reservations
+        BEGIN
+            UPDATE sailings SET reserved_vehicle_count = reserved_vehicle_count - 1 WHERE sailing_id_pk = OLD.sailing_id_fk;
+        END;
+
+        CREATE TRIGGER reservations_count_on_move AFTER UPDATE OF sailing_id_fk ON reservations
+        BEGIN
+            UPDATE sailings SET reserved_vehicle_count = reserved_vehicle_count - 1 WHERE sailing_id_pk = OLD.sailing_id_fk;
+            UPDATE sailings SET reserved_vehicle_count = reserved_vehicle_count + 1 WHERE sailing_id_pk = NEW.sailing_id_fk;
+        END;
+
+        CREATE TRIGGER sailings_occupancy_on_insert AFTER INSERT ON sailings
+        BEGIN
+            UPDATE sailings SET occupancy_percentage = COALESCE((
+                SELECT TRUNC(((vessels.low_ceiling_lane_length + vessels.high_ceiling_lane_length - NEW.low_remaining_length - NEW.high_remaining_length) / (vessels.low_ceiling_lane_length + vessels.high_ceiling_lane_length)) * 100.0)
+                FROM vessels WHERE vessels.vessel_id_pk = NEW.vessel_id_fk
+                ), 0)
+            WHERE sailing_id_pk = NEW.sailing_id_pk;
+        END;
+
+        CREATE TRIGGER sailings_occupancy_on_update AFTER UPDATE OF low_remaining_length, high_remaining_length, vessel_id_fk ON sailings
+        BEGIN
+            UPDATE sailings SET occupancy_percentage = COALESCE((
+                SELECT TRUNC(((vessels.low_ceiling_lane_length + vessels.high_ceiling_lane_length - NEW.low_remaining_length - NEW.high_remaining_length) / (vessels.low_ceiling_lane_length + vessels.high_ceiling_lane_length)) * 100.0)
+                FROM vessels WHERE vessels.vessel_id_pk = NEW.vessel_id_fk
+                ), 0)
+            WHERE sailing_id_pk = NEW.sailing_id_pk;
+        END;
+    )SQL",
+
+    // Version 2: Vehicles are found by their plate packed into an integer (see 'packed_key.hpp'), instead of by the text.
+    // The key is a virtual column, so it only takes space in its index, and every insert (in SQL or not) gets it right. The text stays for display.
+    // SQLite cannot drop the UNIQUE constraint of the text column, so the table is copied out and created again (keeping the vehicle IDs).
+    // NOTE (SAVIZ): A plate that does not pack (written outside the program) gets a NULL key: it is kept, but cannot be looked up.
+    R"SQL(
+        -- With foreign keys on, dropping the table orphans the reservations until the vehicles are back, which is fine by the time of the commit:
+        PRAGMA defer_foreign_keys = ON;
+
+        CREATE TEMP TABLE vehicles_before_version_2 AS SELECT vehicle_id_pk, license_plate, phone_number, length, height FROM vehicles;
+
+        DROP TABLE vehicles;
+
+        CREATE TABLE vehicles (
+            vehicle_id_pk INTEGER PRIMARY KEY AUTOINCREMENT,
+            license_plate TEXT NOT NULL,
+            phone_number TEXT NOT NULL,
+            length REAL NOT NULL,
+            height REAL NOT NULL,
+
+            -- Each symbol is a base 39 digit, the first one the most significant, and '0' pads a shorter plate (the '~' padding is not a symbol):
+            license_plate_key INTEGER GENERATED ALWAYS AS (
+                CASE WHEN length(license_plate) BETWEEN 1 AND 10 AND trim(license_plate, ' -0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ') = '' THEN
+                    instr(' -0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ', substr(license_plate || '~~~~~~~~~', 1, 1)) * 208728361158759 +
+                    instr(' -0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ', substr(license_plate || '~~~~~~~~~', 2, 1)) * 5352009260481 +
+                    instr(' -0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ', substr(license_plate || '~~~~~~~~~', 3, 1)) * 137231006679 +
+                    instr(' -0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ', substr(license_plate || '~~~~~~~~~', 4, 1)) * 3518743761 +
+                    instr(' -0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ', substr(license_plate || '~~~~~~~~~', 5, 1)) * 90224199 +
+                    instr(' -0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ', substr(license_plate || '~~~~~~~~~', 6, 1)) * 2313441 +
+                    instr(' -0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ', substr(license_plate || '~~~~~~~~~', 7, 1)) * 59319 +
+                    instr(' -0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ', substr(license_plate || '~~~~~~~~~', 8, 1)) * 1521 +
+                    instr(' -0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ', substr(license_plate || '~~~~~~~~~', 9, 1)) * 39 +
+                    instr(' -0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ', substr(license_plate || '~~~~~~~~~', 10, 1)) * 1
+                END
+            ) VIRTUAL
+        );
+
+        INSERT INTO vehicles (vehicle_id_pk, license_plate, phone_number, length, height)
+        SELECT vehicle_id_pk, license_plate, phone_number, length, height FROM vehicles_before_version_2;
+
+        DROP TABLE vehicles_before_version_2;
+
+        CREATE UNIQUE INDEX vehicles_by_license_plate_key ON vehicles(license_plate_key);
+    )SQL",
+
+    // Version 3: Sailings are found by their sailing ID packed into an integer (see 'sailing_key.hpp'), instead of by terminal, day and hour.
+    // Like the plate key, it is a virtual column that only takes space in its index. The unique (terminal, day, hour) constraint stays, as dropping it would mean copying the table and its triggers.
+    // NOTE (SAVIZ): A sailing that does not pack (written outside the program) gets a NULL key: it is kept, but cannot be looked up.
+    R"SQL(
+        -- Each letter is 1 to 26 in 5 bits, then the day and the hour take 7 bits each:
+        ALTER TABLE sailings ADD COLUMN sailing_key INTEGER GENERATED ALWAYS AS (
+            CASE WHEN departure_terminal GLOB '[A-Z][A-Z][A-Z]' AND departure_day BETWEEN 0 AND 99 AND departure_hour BETWEEN 0 AND 99 THEN
+                (unicode(substr(departure_terminal, 1, 1)) - 64) * 16777216 +
+                (unicode(substr(departure_terminal, 2, 1)) - 64) * 524288 +
+                (unicode(substr(departure_terminal, 3, 1)) - 64) * 16384 +
+                departure_day * 128 +
+                departure_hour
+            END
+        ) VIRTUAL;
+
+        CREATE UNIQUE INDEX sailings_by_key ON sailings(sailing_key);
+    )SQL"
+};
+
+// The version a database is at once every migration has been applied.
+inline constexpr int c_schema_version = static_cast<int>(sizeof(c_schema_migrations) / sizeof(c_schema_migrations[0]));
+
+// Reads and (inside the migration transaction) records the schema version.
+inline constexpr const char* c_select_schema_version = "PRAGMA user_version;";
+
+// Transactions:
+// ****************************************************************************
+
+// Takes the write lock at the start (see 'Database::beginTransaction()').
+inline constexpr const char* c_begin_transaction = "BEGIN IMMEDIATE;";
+
+inline constexpr const char* c_commit_transaction = "COMMIT;";
+
+// Holds one snapshot across the reads of a read connection (see 'Database::leaseReadConnection()').
+inline constexpr const char* c_begin_read_transaction = "BEGIN DEFERRED;";
+
+inline constexpr const char* c_rollback_transaction = "ROLLBACK;";
+
+// Group commit: each write inside an open group runs under its own savepoint (see 'Database::setGroupCommit()').
+inline constexpr const char* c_savepoint_operation = "SAVEPOINT operation;";
+
+inline constexpr const char* c_release_operation = "RELEASE operation;";
+
+// Undoes the write but keeps the savepoint, so it is still released afterwards.
+inline constexpr const char* c_rollback_to_operation = "ROLLBACK TO operation;";
+
+// Vessels:
+// ****************************************************************************
+
+// Creates a vessel.
+inline constexpr const char* c_insert_vessel = R"SQL(
+    INSERT INTO vessels (vessel_name, low_ceiling_lane_length, high_ceiling_lane_length)
+    VALUES (?, ?, ?);
+)SQL";
+
+// Finds a vessel by ID.
+inline constexpr const char* c_select_vessel_by_id = R"SQL(
+    SELECT vessel_name, low_ceiling_lane_length, high_ceiling_lane_length FROM vessels
+    WHERE vessel_id_pk = ?;
+)SQL";
+
+// A page of vessels after a vessel ID.
+inline constexpr const char* c_select_vessels_next = R"SQL(
+    SELECT vessel_id_pk, vessel_name, low_ceiling_lane_length, high_ceiling_lane_length FROM vessels
+    WHERE vessel_id_pk > ?
+    ORDER BY vessel_id_pk
+    LIMIT ?;
+)SQL";
+
+// A page of vessels before a vessel ID, walking backwards.
+inline constexpr const char* c_select_vessels_previous = R"SQL(
+    SELECT vessel_id_pk, vessel_name, low_ceiling_lane_length, high_ceiling_lane_length FROM vessels
+    WHERE vessel_id_pk < ?
+    ORDER BY vessel_id_pk DESC
+    LIMIT ?;
+)SQL";
+
+// Every vessel, ordered by ID (read through a cursor).
+inline constexpr const char* c_select_all_vessels = R"SQL(
+    SELECT vessel_id_pk, vessel_name, low_ceiling_lane_length, high_ceiling_lane_length FROM vessels
+    ORDER BY vessel_id_pk;
+)SQL";
+
+// Sailings:
+// ****************************************************************************
+
+// Creates a sailing.
+inline constexpr const char* c_insert_sailing = R"SQL(
+    INSERT INTO sailings (vessel_id_fk, departure_terminal, departure_day, departure_hour, low_remaining_length, high_remaining_length)
+    VALUES (?, ?, ?, ?, ?, ?);
+)SQL";
+
+// Deletes every reservation of a sailing.
+inline constexpr const char* c_delete_sailing_reservations = R"SQL(
+    DELETE FROM reservations
+    WHERE sailing_id_fk = ?;
+)SQL";
+
+// Deletes a sailing.
+inline constexpr const char* c_delete_sailing = R"SQL(
+    DELETE FROM sailings
+    WHERE sailing_id_pk = ?;
+)SQL";
+
+// Finds a sailing by its packed sailing ID (see 'sailing_key.hpp').
+inline constexpr const char* c_select_sailing_by_id = R"SQL(
+    SELECT sailing_id_pk, vessel_id_fk, departure_terminal, departure_day, departure_hour, low_remaining_length, high_remaining_length FROM sailings
+    WHERE sailing_key = ?
+    LIMIT 1;
+)SQL";
+
+// A page of sailing reports after a (day, hour, sailing ID) key.
+inline constexpr const char* c_select_sailing_reports_next = R"SQL(
+    SELECT sailings.sailing_id_pk, sailings.departure_terminal, sailings.departure_day, sailings.departure_hour, sailings.low_remaining_length, sailings.high_remaining_length, vessels.vessel_name, sailings.reserved_vehicle_count, sailings.occupancy_percentage
+    FROM sailings
+    JOIN vessels ON sailings.vessel_id_fk = vessels.vessel_id_pk
+    WHERE (sailings.departure_day, sailings.departure_hour, sailings.sailing_id_pk) > (?1, ?2, ?3)
+    ORDER BY sailings.departure_day, sailings.departure_hour, sailings.sailing_id_pk
+
+    LIMIT ?4;
+)SQL";
+
+// A page of sailing reports before a (day, hour, sailing ID) key, walking backwards.
+inline constexpr const char* c_select_sailing_reports_previous = R"SQL(
+    SELECT sailings.sailing_id_pk, sailings.departure_terminal, sailings.departure_day, sailings.departure_hour, sailings.low_remaining_length, sailings.high_remaining_length, vessels.vessel_name, sailings.reserved_vehicle_count, sailings.occupancy_percentage
+    FROM sailings
+    JOIN vessels ON sailings.vessel_id_fk = vessels.vessel_id_pk
+    WHERE (sailings.departure_day, sailings.departure_hour, sailings.sailing_id_pk) < (?1, ?2, ?3)
+    ORDER BY sailings.departure_day DESC, sailings.departure_hour DESC, sailings.sailing_id_pk DESC
+
+    LIMIT ?4;
+)SQL";
+
+// Every sailing report, ordered by departure (read through a cursor).
+inline constexpr const char* c_select_all_sailing_reports = R"SQL(
+    SELECT sailings.sailing_id_pk, sailings.departure_terminal, sailings.departure_day, sailings.departure_hour, sailings.low_remaining_length, sailings.high_remaining_length, vessels.vessel_name, sailings.reserved_vehicle_count, sailings.occupancy_percentage
+    FROM sailings
+    JOIN vessels ON sailings.vessel_id_fk = vessels.vessel_id_pk
+    ORDER BY sailings.departure_day, sailings.departure_hour, sailings.sailing_id_pk;
+)SQL";
+
+// The report of a single sailing, found by its packed sailing ID (see 'sailing_key.hpp').
+inline constexpr const char* c_select_sailing_report_by_id = R"SQL(
+    SELECT sailings.departure_terminal, sailings.departure_day, sailings.departure_hour, sailings.low_remaining_length, sailings.high_remaining_length, vessels.vessel_name, sailings.reserved_vehicle_count, sailings.occupancy_percentage
+    FROM sailings
+    JOIN vessels ON sailings.vessel_id_fk = vessels.vessel_id_pk
+
+    WHERE sailings.sailing_key = ?;
+)SQL";
+
+// End-of-day reports:
+// ****************************************************************************
+
+// Every departure terminal, in order (a walk over the terminal column of the unique sailing key, without touching the table).
+inline constexpr const char* c_select_departure_terminals = R"SQL(
+    SELECT DISTINCT departure_terminal FROM sailings
+    ORDER BY departure_terminal;
+)SQL";
+
+// The first and last departure days, as two rows (each one a single seek on the departure index).
+inline constexpr const char* c_select_departure_day_range = R"SQL(
+    SELECT MIN(departure_day) FROM sailings
+    UNION ALL
+    SELECT MAX(departure_day) FROM sailings;
+)SQL";
+
+// The report of every sailing departing between two days (inclusive), with what its reservations paid at boarding.
+// NOTE (SAVIZ): The revenue comes from the reservations, read through their primary key (sailing first), so each sailing costs two short seeks.
+inline constexpr const char* c_select_end_of_day_report_by_days = R"SQL(
+    SELECT sailings.sailing_id_pk, sailings.departure_terminal, sailings.departure_day, sailings.departure_hour, sailings.low_remaining_length, sailings.high_remaining_length, vessels.vessel_name, sailings.reserved_vehicle_count, sailings.occupancy_percentage,
+        (SELECT COUNT(*) FROM reservations WHERE reservations.sailing_id_fk = sailings.sailing_id_pk AND reservations.amount_paid > 0),
+        (SELECT TOTAL(amount_paid) FROM reservations WHERE reservations.sailing_id_fk = sailings.sailing_id_pk)
+    FROM sailings
+    JOIN vessels ON sailings.vessel_id_fk = vessels.vessel_id_pk
+    WHERE sailings.departure_day BETWEEN ?1 AND ?2
+    ORDER BY sailings.departure_day, sailings.departure_hour, sailings.sailing_id_pk;
+)SQL";
+
+// The same, for the sailings of one terminal (served by the unique terminal, day and hour key).
+inline constexpr const char* c_select_end_of_day_report_by_terminal = R"SQL(
+    SELECT sailings.sailing_id_pk, sailings.departure_terminal, sailings.departure_day, sailings.departure_hour, sailings.low_remaining_length, sailings.high_remaining_length, vessels.vessel_name, sailings.reserved_vehicle_count, sailings.occupancy_percentage,
+        (SELECT COUNT(*) FROM reservations WHERE reservations.sailing_id_fk = sailings.sailing_id_pk AND reservations.amount_paid > 0),
+        (SELECT TOTAL(amount_paid) FROM reservations WHERE reservations.sailing_id_fk = sailings.sailing_id_pk)
+    FROM sailings
+    JOIN vessels ON sailings.vessel_id_fk = vessels.vessel_id_pk
+    WHERE sailings.departure_terminal = ?3 AND sailings.departure_day BETWEEN ?1 AND ?2
+    ORDER BY sailings.departure_day, sailings.departure_hour;
+)SQL";
+
+// Reservations:
+// ****************************************************************************
+
+// Creates a reservation only if the vehicle fits with its 0.5 meter gap, choosing the lane (low lane first, for vehicles up to 2 meters tall).
+inline constexpr const char* c_insert_reservation = R"SQL(
+    INSERT INTO reservations (sailing_id_fk, vehicle_id_fk, amount_paid, reserved_for_low_lane)
+    SELECT sailing_id_pk, ?2, 0, (?4 <= 2.0 AND low_remaining_length >= ?3 + 0.5)
+    FROM sailings
+    WHERE sailing_id_pk = ?1 AND ((?4 <= 2.0 AND low_remaining_length >= ?3 + 0.5) OR high_remaining_length >= ?3 + 0.5)
+    RETURNING reserved_for_low_lane;
+)SQL";
+
+// Deducts a reserved vehicle (plus the 0.5 meter gap) from the lane chosen for it, never going below zero.
+inline constexpr const char* c_update_sailing_reserve = R"SQL(
+    UPDATE sailings SET
+        low_remaining_length = low_remaining_length - CASE WHEN ?3 THEN ?2 + 0.5 ELSE 0 END,
+        high_remaining_length = high_remaining_length - CASE WHEN ?3 THEN 0 ELSE ?2 + 0.5 END
+    WHERE sailing_id_pk = ?1 AND (CASE WHEN ?3 THEN low_remaining_length ELSE high_remaining_length END) >= ?2 + 0.5
+    RETURNING low_remaining_length, high_remaining_length;
+)SQL";
+
+// The lane of a reservation.
+inline constexpr const char* c_select_reservation_lane = R"SQL(
+    SELECT reserved_for_low_lane FROM reservations
+    WHERE sailing_id_fk = ? AND vehicle_id_fk = ?
+    LIMIT 1;
+)SQL";
+
+// The manifest of a sailing: every reserved vehicle, with its lane and what it paid at boarding (through the reservation primary key, then the vehicle's).
+inline constexpr const char* c_select_sailing_manifest = R"SQL(
+    SELECT vehicles.vehicle_id_pk, vehicles.license_plate, vehicles.phone_number, vehicles.length, vehicles.height, reservations.reserved_for_low_lane, reservations.amount_paid
+    FROM reservations
+    JOIN vehicles ON vehicles.vehicle_id_pk = reservations.vehicle_id_fk
+    WHERE reservations.sailing_id_fk = ?1;
+)SQL";
+
+// Deletes a reservation.
+inline constexpr const char* c_delete_reservation = R"SQL(
+    DELETE FROM reservations
+    WHERE sailing_id_fk = ? AND vehicle_id_fk = ?;
+)SQL";
+
+// Gives the length of a cancelled reservation (plus the 0.5 meter gap) back to the low lane.
+inline constexpr const char* c_update_sailing_release_low = "UPDATE sailings SET low_remaining_length = low_remaining_length + ? WHERE sailing_id_pk = ?;";
+
+// Gives the length of a cancelled reservation (plus the 0.5 meter gap) back to the high lane.
+inline constexpr const char* c_update_sailing_release_high = "UPDATE sailings SET high_remaining_length = high_remaining_length + ? WHERE sailing_id_pk = ?;";
+
+// Charges the fare of a reservation, only if it has not been boarded yet.
+inline constexpr const char* c_update_reservation_boarding = R"SQL(
+    UPDATE reservations SET amount_paid =
+        CASE
+            -- Long vehicles pay $2 per meter and tall vehicles pay $3 per meter (both, if long and tall):
+            WHEN ?3 > 7.0 OR ?4 > 2.0 THEN
+                (CASE WHEN ?3 > 7.0 THEN ?3 * 2.0 ELSE 0.0 END) +
+                (CASE WHEN ?4 > 2.0 THEN ?3 * 3.0 ELSE 0.0 END)
+
+            -- Short & low vehicles pay a flat fee:
+            ELSE 14.0
+        END
+    WHERE sailing_id_fk = ?1 AND vehicle_id_fk = ?2 AND amount_paid = 0
+    RETURNING amount_paid;
+)SQL";
+
+// The amount paid for a reservation.
+inline constexpr const char* c_select_reservation_amount_paid = R"SQL(
+    SELECT amount_paid FROM reservations
+    WHERE sailing_id_fk = ? AND vehicle_id_fk = ?
+    LIMIT 1;
+)SQL";
+
+// Vehicles:
+// ****************************************************************************
+
+// Creates a vehicle.
+inline constexpr const char* c_insert_vehicle = R"SQL(
+    INSERT INTO vehicles (license_plate, phone_number, length, height)
+    VALUES (?, ?, ?, ?);
+)SQL";
+
+// Finds a vehicle by license plate, through its packed key (see 'packed_key.hpp').
+inline constexpr const char* c_select_vehicle_by_license_plate = R"SQL(
+    SELECT vehicle_id_pk, license_plate, phone_number, length, height FROM vehicles
+    WHERE license_plate_key = ?;
+)SQL";
+
+// Plates of the vehicles from an ID on, in ID order (the IDs only grow, so this is what was created since). Walks the table's own key, so it never sorts.
+inline constexpr const char* c_select_vehicle_plates_from = R"SQL(
+    SELECT vehicle_id_pk, license_plate FROM vehicles
+    WHERE vehicle_id_pk >= ?1
+    ORDER BY vehicle_id_pk;
+)SQL";
+
+// Import:
+// ****************************************************************************
+
+// NOTE (SAVIZ): Each import query is a head, a row placeholder repeated once per imported row (comma separated) and a tail, put together once by the Database (see 'Database::importVessels()').
+// Rows that break a constraint are skipped ('OR IGNORE'), and 'RETURNING' names the rows that went in, so the others can be reported as rejected.
+
+// The most rows per import statement (5 columns * 100 rows stays below SQLite's historic limit of 999 parameters).
+inline constexpr int c_import_batch_rows = 100;
+
+// Creates vessels.
+inline constexpr const char* c_import_vessels_head = "INSERT OR IGNORE INTO vessels (vessel_name, low_ceiling_lane_length, high_ceiling_lane_length) VALUES ";
+inline constexpr const char* c_import_vessels_row = "(?, ?, ?)";
+inline constexpr const char* c_import_vessels_tail = " RETURNING vessel_name;";
+
+// Creates sailings, each on the vessel with the given name and starting with the vessel's full lane lengths.
+inline constexpr const char* c_import_sailings_head = R"SQL(
+    INSERT OR IGNORE INTO sailings (vessel_id_fk, departure_terminal, departure_day, departure_hour, low_remaining_length, high_remaining_length)
+    SELECT vessel_id_pk, batch.column2, batch.column3, batch.column4, low_ceiling_lane_length, high_ceiling_lane_length
+    FROM (VALUES )SQL";
+inline constexpr const char* c_import_sailings_row = "(?, ?, ?, ?)";
+inline constexpr const char* c_import_sailings_tail = R"SQL() AS batch
+    JOIN vessels ON vessels.vessel_name = batch.column1
+    RETURNING departure_terminal, departure_day, departure_hour;
+)SQL";
+
+// Creates vehicles.
+inline constexpr const char* c_import_vehicles_head = "INSERT OR IGNORE INTO vehicles (license_plate, phone_number, length, height) VALUES ";
+inline constexpr const char* c_import_vehicles_row = "(?, ?, ?, ?)";
+inline constexpr const char* c_import_vehicles_tail = " RETURNING license_plate;";
+
+// Catalog:
+// ****************************************************************************
+
+// A query together with its name, for tools and tests that go through every query.
+struct NamedQuery
+{
+    const char* name;
+    const char* sql;
+    bool reads_whole_table = false; // Meant to visit every row (in index order), so a scan is expected.
+};
+
+// Every single-statement query above (the schema script and transaction control are left out).
+inline constexpr NamedQuery c_all_queries[] =
+{
+    {"c_insert_vessel", c_insert_vessel},
+    {"c_select_vessel_by_id", c_select_vessel_by_id},
+    {"c_select_vessels_next", c_select_vessels_next},
+    {"c_select_vessels_previous", c_select_vessels_previous},
+    {"c_select_all_vessels", c_select_all_vessels, true},
+    {"c_insert_sailing", c_insert_sailing},
+    {"c_delete_sailing_reservations", c_delete_sailing_reservations},
+    {"c_delete_sailing", c_delete_sailing},
+    {"c_select_sailing_by_id", c_select_sailing_by_id},
+    {"c_select_sailing_reports_next", c_select_sailing_reports_next},
+    {"c_select_sailing_reports_previous", c_select_sailing_reports_previous},
+    {"c_select_all_sailing_reports", c_select_all_sailing_reports, true},
+    {"c_select_sailing_report_by_id", c_select_sailing_report_by_id},
+    {"c_select_departure_terminals", c_select_departure_terminals, true},
+    {"c_select_departure_day_range", c_select_departure_day_range},
+    {"c_select_end_of_day_report_by_days", c_select_end_of_day_report_by_days},
+    {"c_select_end_of_day_report_by_terminal", c_select_end_of_day_report_by_terminal},
+    {"c_insert_reservation", c_insert_reservation},
+    {"c_update_sailing_reserve", c_update_sailing_reserve},
+    {"c_select_reservation_lane", c_select_reservation_lane},
+    {"c_select_sailing_manifest", c_select_sailing_manifest},
+    {"c_delete_reservation", c_delete_reservation},
+    {"c_update_sailing_release_low", c_update_sailing_release_low},
+    {"c_update_sailing_release_high", c_update_sailing_release_high},
+    {"c_update_reservation_boarding", c_update_reservation_boarding},
+    {"c_select_reservation_amount_paid", c_select_reservation_amount_paid},
+    {"c_insert_vehicle", c_insert_vehicle},
+    {"c_select_vehicle_by_license_plate", c_select_vehicle_by_license_plate},
+    {"c_select_vehicle_plates_from", c_select_vehicle_plates_from},
+};
+}
+
+#endif // DATABASE_QUERIES_HPP
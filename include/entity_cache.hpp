@@ -0,0 +1,272 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Entity Cache Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * entity_cache.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides a read-through cache of the rows the menus look up over and over: vehicles by license plate, sailings by "TTT-dd-hh" ID, and the whole vessel catalog.
+ * Vehicles and sailings are each kept in a least recently used list of a fixed size, and the catalog is only kept while the fleet fits in its limit, so the memory used stays bounded.
+ *
+ * A Database given a cache (see 'Database::setEntityCache()') answers 'getVehicleByID()', 'getSailingByID()', 'getVesselByID()' and 'getVessels()' from it when it can, fills it from what it reads, and invalidates it from every write.
+ * One cache may be shared by several Database objects on the same file (the menus and the AsyncDatabase, for example), so that the writes of each one invalidate it for all.
+ *
+ * Usage:
+ *
+ *     EntityCache entity_cache(EntityCacheSettings{});
+ *
+ *     database->setEntityCache(&entity_cache, is_successful, outcome_message);
+ *     ...
+ *     entity_cache.getStatistics(statistics);
+ *
+ * NOTE (SAVIZ): Only writes made through a Database that uses the cache invalidate it. Another process writing to the same file is not seen until the entry is evicted.
+ * Nothing read while a write is still uncommitted is kept, so a cache never holds a row that a rollback could take back.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef ENTITY_CACHE_HPP
+#define ENTITY_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "containers.hpp"
+#include "sailing_key.hpp"
+
+// How much an EntityCache may hold ('0' turns that part of the cache off).
+struct EntityCacheSettings
+{
+    int vehicle_capacity = 4096; // Vehicles kept, the least recently used being dropped first.
+    int sailing_capacity = 1024; // Sailings kept, the least recently used being dropped first.
+    int vessel_capacity = 1024;  // The vessel catalog is only kept while there are no more vessels than this.
+};
+
+// Counters describing how well an EntityCache is sized. A miss is a lookup that had to go to the database.
+struct EntityCacheStatistics
+{
+    long long vehicle_hits = 0;
+    long long vehicle_misses = 0;
+    long long sailing_hits = 0;
+    long long sailing_misses = 0;
+    long long vessel_hits = 0;
+    long long vessel_misses = 0;
+    long long eviction_count = 0;     // Entries dropped to make room.
+    long long invalidation_count = 0; // Entries (or catalogs) dropped because a write changed them.
+};
+
+// A map that keeps at most a fixed number of entries, dropping the least recently used one to make room.
+template<typename Key, typename Value>
+class LruMap
+{
+public:
+    explicit LruMap(std::size_t capacity) : m_capacity(capacity) {}
+
+    // Finds an entry, and makes it the most recently used.
+    Value* find(const Key& key)
+    {
+        auto position = m_positions.find(key);
+
+        if(position == m_positions.end())
+        {
+            return(nullptr);
+        }
+
+        m_entries.splice(m_entries.begin(), m_entries, position->second);
+
+        return(&position->second->second);
+    }
+
+    // Adds or replaces an entry. Returns whether another entry was dropped for it (and hands that entry back).
+    bool insert(const Key& key, const Value& value, Value& evicted_value)
+    {
+        auto position = m_positions.find(key);
+
+        if(position != m_positions.end())
+        {
+            position->second->second = value;
+            m_entries.splice(m_entries.begin(), m_entries, position->second);
+
+            return(false);
+        }
+
+        m_entries.emplace_front(key, value);
+        m_positions[key] = m_entries.begin();
+
+        if(m_entries.size() <= m_capacity)
+        {
+            return(false);
+        }
+
+        evicted_value = std::move(m_entries.back().second);
+
+        m_positions.erase(m_entries.back().first);
+        m_entries.pop_back();
+
+        return(true);
+    }
+
+    bool erase(const Key& key)
+    {
+        auto position = m_positions.find(key);
+
+        if(position == m_positions.end())
+        {
+            return(false);
+        }
+
+        m_entries.erase(position->second);
+        m_positions.erase(position);
+
+        return(true);
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_positions.clear();
+    }
+
+    std::size_t getCapacity() const { return(m_capacity); }
+
+private:
+    std::size_t m_capacity;
+    std::list<std::pair<Key, Value>> m_entries; // Most recently used first.
+    std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator> m_positions;
+};
+
+class EntityCache
+{
+public:
+    // ----------------------------------------------------------------------------
+    explicit EntityCache(
+        const EntityCacheSettings& settings // [IN] | How much the cache may hold.
+        );
+
+    /*
+    *   [Description]
+    *   Constructor for the EntityCache class. The cache starts empty.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    ~EntityCache();
+
+    /*
+    *   [Description]
+    *   Destructor for the EntityCache class, responsible for deallocating the object from memory. Every Database using the cache must be given another one (or none) first.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+public:
+    // ----------------------------------------------------------------------------
+    void getStatistics(
+        EntityCacheStatistics& statistics // [OUT] | The counters of the cache since it was created.
+        );
+
+    /*
+    *   [Description]
+    *   This function provides the hits, misses, evictions and invalidations of the cache. Many evictions with a low hit rate mean the cache is too small for the fleet.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+    // NOTE (SAVIZ): The functions below are what a Database uses the cache through. Each one is safe to call from any thread.
+
+    // Lookups. A hit fills in the entity and returns true. Vehicles go by their packed plate (see 'packed_key.hpp'), and sailings by their packed ID (see 'sailing_key.hpp').
+    bool findVehicle(std::int64_t license_plate_key, Vehicle& vehicle);
+    bool findSailing(SailingKey sailing_key, Sailing& sailing);
+
+    // The vessel lookups are answered from the whole catalog, so they hit whenever it is loaded (even if the vessel does not exist, see 'is_found').
+    bool findVessel(int vessel_id, Vessel& vessel, bool& is_found);
+    bool findVessels(int key, int count, bool is_previous, std::vector<Vessel>& vessels);
+
+    // The same lookups over a catalog in ID order, for a reader that has just loaded one. A page is the 'count' vessels after 'key', or before it when 'is_previous' (in ID order either way), like 'Database::getVessels()'.
+    static bool findInCatalog(const std::vector<Vessel>& catalog, int vessel_id, Vessel& vessel);
+    static void pageCatalog(const std::vector<Vessel>& catalog, int key, int count, bool is_previous, std::vector<Vessel>& vessels);
+
+    // A reader takes the generation before its read, and hands it back with what it read. What is read across a write (or while one is uncommitted) is not kept.
+    std::uint64_t getGeneration();
+    void insertVehicle(std::int64_t license_plate_key, const Vehicle& vehicle, std::uint64_t read_generation);
+    void insertSailing(SailingKey sailing_key, const Sailing& sailing, std::uint64_t read_generation);
+    void insertVessels(const std::vector<Vessel>& vessels, std::uint64_t read_generation); // More vessels than the capacity stops the catalog being loaded until the next vessel write.
+
+    // A writer brackets its (committed or rolled back) writes, and invalidates what they change in between. 'beginWrite()' returns the generation the write began at.
+    std::uint64_t beginWrite();
+    void endWrite();
+    void invalidateVehicle(std::int64_t license_plate_key);
+    void invalidateSailing(int sailing_id);
+    void invalidateSailing(SailingKey sailing_key);
+    void invalidateVessels();
+    void invalidateAll();
+
+    // A write that changes a sailing it knows the new state of takes the cached one out (instead of invalidating it), and puts it back once committed on its own.
+    // It is only put back when no other write began or ended since 'write_generation', as the commits could otherwise have landed in another order.
+    bool takeSailing(int sailing_id, SailingKey& sailing_key, Sailing& sailing);
+    void insertWrittenSailing(SailingKey sailing_key, const Sailing& sailing, std::uint64_t write_generation);
+
+    // The most vessels a catalog may hold to be kept ('0' when the catalog is not cached, or is known to be too large).
+    std::size_t getVesselCapacity();
+
+private:
+    // What was read may only be kept if no write is under way and none has happened since the read began.
+    bool isInsertAllowed(std::uint64_t read_generation) const;
+
+private:
+    std::mutex m_mutex;
+
+    EntityCacheSettings m_settings;
+    EntityCacheStatistics m_statistics;
+
+    LruMap<std::int64_t, Vehicle> m_vehicles; // By packed license plate (see 'packed_key.hpp').
+    LruMap<SailingKey, Sailing> m_sailings;   // By packed sailing ID (see 'sailing_key.hpp').
+    std::unordered_map<int, SailingKey> m_sailing_keys; // Sailing ID to packed sailing ID, for the writes that only know the former.
+
+    bool m_has_vessels;
+    bool m_is_vessel_catalog_too_large;
+    std::vector<Vessel> m_vessels; // The whole catalog, in ID order (while 'm_has_vessels').
+
+    std::uint64_t m_generation; // Moves on whenever a write begins or ends.
+    int m_writer_count;         // Database objects with a write under way.
+};
+
+#endif // ENTITY_CACHE_HPP
@@ -29,6 +29,7 @@
 #ifndef GLOBAL_HPP
 #define GLOBAL_HPP
 
+#include <regex>
 #include <string>
 #include <vector>
 
@@ -59,4 +60,22 @@ extern double g_vehicle_min_height;
 // Maximum allowed height in meters of vehicles, used to validate user input
 extern double g_vehicle_max_height;
 
+// Minimum allowed length in meters of a vessel's lanes, used to validate user input
+extern double g_lane_min_length;
+
+// Maximum allowed length in meters of a vessel's lanes, used to validate user input
+extern double g_lane_max_length;
+
+// Sailing IDs in the TTT-dd-hh form (terminal, day, hour), used to validate user input
+extern const std::regex g_sailing_id_pattern;
+
+// Vessel names: 1-25 letters, digits, underscores or spaces, used to validate user input
+extern const std::regex g_vessel_name_pattern;
+
+// License plates: 2-10 capital letters, digits, spaces or hyphens, used to validate user input
+extern const std::regex g_license_plate_pattern;
+
+// Phone numbers: 8-14 digits, used to validate user input
+extern const std::regex g_phone_number_pattern;
+
 #endif // GLOBAL_H
@@ -0,0 +1,276 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Importer Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * importer.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides the bulk import behind "FerryFlow --import <file>", used to seed a season without going through the menus.
+ * The file is read one line at a time, every record is checked with the same rules as the prompts (see 'global.hpp'), and the records that pass are written in multi-row batches inside large transactions.
+ *
+ * An import file is CSV, one record per line, where the first field names the kind of record:
+ *
+ *     # Blank lines and lines starting with '#' are ignored.
+ *     vessel,Queen of Surrey,120,300              (name, low ceiling lane length, high ceiling lane length)
+ *     sailing,AHS-22-10,Queen of Surrey           (sailing ID, vessel name)
+ *     vehicle,A76-2H4,5551234567,5,1.5            (license plate, phone number, length, height)
+ *     reservation,AHS-22-10,A76-2H4               (sailing ID, license plate)
+ *
+ * Fields may be quoted ("Queen of Surrey"), with "" standing for a quote inside them. A quoted field cannot span lines.
+ * Records are written in file order, so a record may refer to anything defined above it.
+ *
+ * Checking records (splitting fields, matching patterns, parsing numbers) costs more than writing them, so a file can be parsed by several threads at once.
+ * It is then split into chunks, each parsed by one of the threads, and the parsed chunks are handed in file order to the calling thread, the only one that writes (see 'OrderedQueue').
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef IMPORTER_HPP
+#define IMPORTER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "containers.hpp"
+#include "database.hpp"
+
+// Counters describing an import, filled in by 'Importer::importFile()'.
+struct ImportStatistics
+{
+    long long line_count = 0;       // Lines read, including blank lines and comments.
+    long long record_count = 0;     // Records found.
+    long long imported_count = 0;   // Records written to the database.
+    long long rejected_count = 0;   // Records that failed validation or were refused by the database.
+    double elapsed_seconds = 0.0;   // Time spent on the whole import.
+};
+
+// Controls how an import file is parsed.
+struct ImportSettings
+{
+    int parser_count = 1;                 // Threads parsing the file ('1' parses on the calling thread, between writes).
+    std::size_t chunk_bytes = 1 << 20;    // Size of the pieces a file is split into for the parsing threads.
+};
+
+class Importer
+{
+public:
+    // ----------------------------------------------------------------------------
+    explicit Importer(
+        Database* database,             // [IN] | The open database to import into.
+        std::ostream& report_stream,    // [IN] | Where progress and rejected records are reported.
+        const ImportSettings& settings  // [IN] | How files are parsed.
+        );
+
+    /*
+    *   [Description]
+    *   Constructor for the Importer class.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    ~Importer();
+
+    /*
+    *   [Description]
+    *   Destructor for the Importer class, responsible for deallocating the object from memory.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+public:
+    // ----------------------------------------------------------------------------
+    void importFile(
+        const std::string& path,        // [IN]  | The import file.
+        ImportStatistics& statistics,   // [OUT] | What was read, imported and rejected.
+        bool& is_successful,            // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message    // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function imports every record of a file (see the top of this file for the format).
+    *   Each rejected record is reported with its line number and reason, and the import goes on. Progress and the rate in records per second are reported every 'sc_progress_records' records.
+    *   Valid records of the same kind are buffered and written together through 'Database::importVessels()', 'importSailings()' and 'importVehicles()'. Reservations are written one by one through 'Database::addReservation()', which places each vehicle in a lane.
+    *   NOTE (SAVIZ): Writes are grouped into one transaction per 'sc_records_per_transaction' records, through group commit. The database's group commit settings are reset to the defaults when the import ends.
+    *   With more than one parser, the file is parsed by that many threads while the calling thread writes. The outcome, statistics and report are the same as with a single parser.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Unreadable file>
+    *       If the file cannot be opened, the operation will terminate with a failure status and provide an appropriate error message naming the path.
+    *   @ <Database failure>
+    *       If a write fails for a reason other than the record itself, the import stops there and the operation will terminate with a failure status and provide the database's error message. The records written before it are kept, unless their transaction could not be committed (which 'statistics' reflects).
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void importStream(
+        std::istream& stream,           // [IN]  | The records to import, in the import file format.
+        ImportStatistics& statistics,   // [OUT] | What was read, imported and rejected.
+        bool& is_successful,            // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message    // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function is 'importFile()' for records that are already in a stream. A stream is always parsed on the calling thread.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Database failure>
+    *       See 'importFile()'.
+    */
+    // ----------------------------------------------------------------------------
+
+private:
+    enum class RecordKind
+    {
+        None,
+        Vessel,
+        Sailing,
+        Vehicle,
+        Reservation
+    };
+
+    // A reservation waiting to be written, by the IDs found in the file.
+    struct PendingReservation
+    {
+        std::string departure_terminal;
+        int departure_day = 0;
+        int departure_hour = 0;
+        std::string license_plate;
+    };
+
+    // One record of any kind, as read from the file.
+    struct ImportRecord
+    {
+        RecordKind kind = RecordKind::None;
+        Vessel vessel;
+        NamedSailing sailing;
+        Vehicle vehicle;
+        PendingReservation reservation;
+    };
+
+    // A line holding a record, parsed by a parsing thread.
+    struct ParsedLine
+    {
+        long long line_index = 0;       // Position of the line in its chunk (from 0).
+        ImportRecord record;
+        std::string rejection_reason;   // Empty if the record is valid.
+    };
+
+    // The records of one chunk of the file, in order.
+    struct ParsedChunk
+    {
+        std::vector<ParsedLine> lines;
+        long long line_count = 0;       // Lines in the chunk, including blank lines and comments.
+        bool is_read = false;           // Whether the chunk could be read from the file.
+    };
+
+    // Returns whether a line holds a record (rather than being blank or a comment).
+    static bool isRecordLine(const std::string& line);
+
+    // Splits and checks one record. Returns the reason it was rejected, or an empty string. (Safe to call from any thread)
+    static std::string parseLine(const std::string& line, std::vector<std::string>& fields, ImportRecord& record);
+
+    // Checks the fields of one record. Returns the reason it was rejected, or an empty string.
+    static std::string readRecord(const std::vector<std::string>& fields, ImportRecord& record);
+
+    // Parses the lines that start in the byte range ['begin', 'end') of the file. (Runs on a parsing thread)
+    static void parseChunk(const std::string& path, long long begin, long long end, ParsedChunk& chunk);
+
+    // Parses the file on 'parser_count' threads and writes the records on the calling thread.
+    void importFileInParallel(const std::string& path, long long file_size, bool& is_successful, std::string& outcome_message);
+
+    // Starts an import: resets the statistics and opens the import's transactions.
+    void beginImport(bool& is_successful, std::string& outcome_message);
+
+    // Takes the next record of the file (in file order) and writes it when its batch is full.
+    void acceptRecord(const ImportRecord& record, const std::string& rejection_reason, long long line_number, bool& is_successful, std::string& outcome_message);
+
+    // Ends an import: commits what is left, restores the group commit settings and provides the statistics and summary.
+    void endImport(ImportStatistics& statistics, bool& is_successful, std::string& outcome_message);
+
+    // Adds a valid record to the buffer of its kind.
+    void bufferRecord(const ImportRecord& record, long long line_number);
+
+    // Writes every buffered record.
+    void writeRecords(bool& is_successful, std::string& outcome_message);
+
+    // Writes the buffered reservations, one by one.
+    void writeReservations(bool& is_successful, std::string& outcome_message);
+
+    // Counts the records of a batch as imported or rejected, reporting the rejected ones.
+    void countRecords(const std::vector<bool>& is_imported, const std::string& reason);
+
+    // Commits everything written so far.
+    void commitRecords(bool& is_successful, std::string& outcome_message);
+
+    void reportRejection(long long line_number, const std::string& reason);
+    void reportProgress();
+
+    // The records per second so far.
+    double getRate() const;
+
+private:
+    // How often progress is reported, and how many records go into one transaction.
+    static constexpr long long sc_progress_records = 10000;
+    static constexpr long long sc_records_per_transaction = 50000;
+
+    Database* m_database;
+    std::ostream& m_report_stream;
+    ImportSettings m_settings;
+
+    // The buffered records (only one kind at a time, in file order), with the line each came from.
+    RecordKind m_pending_kind;
+    std::vector<Vessel> m_pending_vessels;
+    std::vector<NamedSailing> m_pending_sailings;
+    std::vector<Vehicle> m_pending_vehicles;
+    std::vector<PendingReservation> m_pending_reservations;
+    std::vector<long long> m_pending_line_numbers;
+
+    ImportStatistics m_statistics;
+    std::chrono::steady_clock::time_point m_start_time;
+
+    // Records counted as imported that are not committed yet.
+    long long m_uncommitted_count;
+};
+
+#endif // IMPORTER_HPP
@@ -0,0 +1,176 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * JSON Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * json.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides the little JSON that the machine mode needs (see 'json_session.hpp'): reading a flat request object, and writing responses.
+ * Both are built to run once per request without allocating: the reader hands out views into the request line, and the writer appends to a string that the caller reuses.
+ *
+ * Usage:
+ *
+ *     JsonObject request;
+ *     std::string error_message;
+ *
+ *     if(request.parse(R"({"op": "getSailingReportByID", "sailing_id": "AHS-22-10"})", error_message))
+ *     {
+ *         const JsonValue* op = request.find("op");   // op->type == JsonType::String, op->text == "getSailingReportByID"
+ *     }
+ *
+ *     std::string response;
+ *     JsonWriter writer(response);
+ *
+ *     writer.beginObject();
+ *     writer.key("ok");
+ *     writer.boolean(true);
+ *     writer.endObject();                             // response == R"({"ok":true})"
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef JSON_HPP
+#define JSON_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+enum class JsonType
+{
+    Null,
+    Boolean,
+    Number,
+    String
+};
+
+// A value of a request. Its text points into the request line (or into the object's scratch space for strings with escapes).
+struct JsonValue
+{
+    JsonType type = JsonType::Null;
+    std::string_view text;      // The string (unescaped), or the number as written.
+    double number = 0.0;
+    bool boolean = false;
+};
+
+// A flat JSON object: values may be strings, numbers, booleans or null, but not objects or arrays.
+class JsonObject
+{
+public:
+    explicit JsonObject();
+    ~JsonObject();
+
+    // The fields point into the line and into this object, so a copy would point into the wrong scratch space.
+    JsonObject(const JsonObject&) = delete;
+    JsonObject& operator=(const JsonObject&) = delete;
+
+public:
+    // ----------------------------------------------------------------------------
+    bool parse(
+        std::string_view text,      // [IN]  | One JSON object. It must outlive the use of the fields.
+        std::string& error_message  // [OUT] | Why the text is not a flat JSON object (empty on success).
+        );
+
+    /*
+    *   [Description]
+    *   This function reads the fields of an object, replacing whatever was read before.
+    *
+    *   [Return]
+    *   Whether the text is a single flat JSON object.
+    *
+    *   [Errors]
+    *   @ <Invalid JSON>
+    *       If the text is not valid JSON, or holds a nested object or array, false is returned with the reason and the position in 'error_message'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    const JsonValue* find(
+        std::string_view key // [IN] | The name of the field.
+        ) const;
+
+    /*
+    *   [Description]
+    *   This function looks up a field. When a key appears twice, the last one wins (like most JSON readers).
+    *
+    *   [Return]
+    *   The value of the field, or 'nullptr' if there is no such field.
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+private:
+    // Reads a string starting after its opening quote, and moves 'position' past its closing quote.
+    bool parseString(std::string_view text, std::size_t& position, std::string_view& value, std::string& error_message);
+
+private:
+    std::vector<std::pair<std::string_view, JsonValue>> m_fields;
+
+    // The unescaped strings (reserved up front to the size of the text, so the views into it stay valid).
+    std::string m_scratch;
+};
+
+// Writes JSON into a string, adding the commas. The caller is responsible for balancing the objects and arrays.
+class JsonWriter
+{
+public:
+    explicit JsonWriter(
+        std::string& output // [IN] | The text is appended here.
+        );
+
+public:
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    // Writes the name of the next field (the value written next belongs to it).
+    void key(std::string_view name);
+
+    void string(std::string_view value);
+    void number(double value);
+    void integer(long long value);
+    void boolean(bool value);
+    void null();
+
+    // Writes text that is already JSON (for example a value copied from a request).
+    void raw(std::string_view json);
+
+private:
+    // Adds the comma needed before a value (unless it follows a key).
+    void separate();
+    void appendString(std::string_view value);
+    void open(char bracket);
+    void close(char bracket);
+
+private:
+    static constexpr std::size_t sc_max_depth = 16;
+
+    std::string& m_output;
+    std::size_t m_depth;
+    bool m_has_items[sc_max_depth];     // Whether something was already written at each depth.
+    bool m_is_after_key;
+};
+
+#endif // JSON_HPP
@@ -0,0 +1,245 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * JSON Session Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * json_session.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides the machine mode behind "FerryFlow --json", for programs that drive FerryFlow instead of people.
+ * Each line read is one JSON request, and each request gets exactly one JSON response line, in order. A request names a Database operation in "op", and may carry an "id" that is copied into its response:
+ *
+ *     {"id": 1, "op": "addReservation", "sailing_id": "AHS-22-10", "license_plate": "A76-2H4"}
+ *     {"id":1,"ok":true,"reserved_for_low_lane":true,"low_remaining_length":94.5,"high_remaining_length":200}
+ *
+ *     {"id": 2, "op": "removeSailing", "sailing_id": "XYZ-01-01"}
+ *     {"id":2,"ok":false,"error":"Record does not exist!"}
+ *
+ * The operations and their fields (the field names are those of 'containers.hpp', and a sailing is always named by its "TTT-dd-hh" ID):
+ *
+ *     addVessel              vessel_name, low_ceiling_lane_length, high_ceiling_lane_length
+ *     getVessels                                                              -> vessels: [...]
+ *     addSailing             sailing_id, vessel_id
+ *     removeSailing          sailing_id
+ *     getSailingReports                                                       -> sailing_reports: [...]
+ *     getSailingReportByID   sailing_id                                       -> sailing_report: {...}
+ *     addVehicle             license_plate, phone_number, length, height      -> vehicle_id
+ *     getVehicleByID         license_plate                                    -> vehicle: {...}
+ *     addReservation         sailing_id, license_plate [, phone_number, length, height]
+ *                                                                             -> reserved_for_low_lane, low_remaining_length, high_remaining_length
+ *     removeReservation      sailing_id, license_plate
+ *     completeBoarding       sailing_id, license_plate
+ *     flushGroupCommit
+ *
+ * 'addReservation' creates the vehicle first when it is not known yet and its details are given.
+ *
+ * NOTE (SAVIZ): Responses are gathered in a buffer, which is only written out once it is large or once no more requests are waiting to be read.
+ * A parent process can therefore pipeline thousands of requests and read the responses as they come, while one that waits for each response still gets it straight away.
+ * With group commit on, the open group is committed right before the buffer is written, so a write is durable by the time its response can be read.
+ * If that commit fails, a response line without an "id" says so: every write answered since the previous response was read has then been rolled back.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef JSON_SESSION_HPP
+#define JSON_SESSION_HPP
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "containers.hpp"
+#include "database.hpp"
+#include "json.hpp"
+
+// Counters describing a session, filled in by 'JsonSession::run()'.
+struct JsonSessionStatistics
+{
+    long long request_count = 0;    // Requests answered (blank lines are skipped).
+    long long failed_count = 0;     // Requests answered with "ok": false.
+    double elapsed_seconds = 0.0;   // Time spent on the whole session.
+};
+
+class JsonSession
+{
+public:
+    // ----------------------------------------------------------------------------
+    explicit JsonSession(
+        Database* database  // [IN] | The open database the requests run against.
+        );
+
+    /*
+    *   [Description]
+    *   Constructor for the JsonSession class.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    ~JsonSession();
+
+    /*
+    *   [Description]
+    *   Destructor for the JsonSession class, responsible for deallocating the object from memory.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+public:
+    // ----------------------------------------------------------------------------
+    void run(
+        std::istream& request_stream,       // [IN]  | The requests, one JSON object per line.
+        std::ostream& response_stream,      // [IN]  | Where the responses are written.
+        JsonSessionStatistics& statistics,  // [OUT] | How many requests were answered, and how many failed.
+        bool& is_successful,                // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message        // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function answers every request of the stream, in order, until the stream ends (see the top of this file for the protocol). Every response is written by the time it returns.
+    *   A request that fails is answered with "ok": false and the session goes on.
+    *   NOTE (SAVIZ): For the responses to flow while the parent is still writing, a stream such as 'std::cin' must not be synchronized with C I/O (see 'std::ios::sync_with_stdio()'), or it never reports waiting input.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Group commit failure>
+    *       If the last group of writes cannot be committed, it is answered with an error line (without an "id") and the operation will terminate with the failure status and message of 'Database::flushGroupCommit()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    bool handleRequest(
+        std::string_view request,   // [IN]  | One request line.
+        std::string& response       // [OUT] | The response is appended here, as one line ending with '\n'.
+        );
+
+    /*
+    *   [Description]
+    *   This function answers a single request, without touching the response stream or the statistics.
+    *
+    *   [Return]
+    *   Whether the request succeeded.
+    *
+    *   [Errors]
+    *   N/A (a failed request is reported in its response)
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void answerWithError(
+        std::string_view request,           // [IN]  | One request line.
+        const std::string& outcome_message, // [IN]  | Why the request failed.
+        std::string& response               // [OUT] | The response is appended here, as one line ending with '\n'.
+        );
+
+    /*
+    *   [Description]
+    *   This function answers a request with an error without running it, for example when a write it made is later lost with its group (see 'Server').
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    static bool isWriteOperation(
+        std::string_view op // [IN] | The "op" of a request.
+        );
+
+    /*
+    *   [Description]
+    *   This function tells whether an operation writes to the database. Every other operation (including unknown ones) only reads, and can run on any connection.
+    *
+    *   [Return]
+    *   Whether the operation writes.
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+private:
+    // The operations. Each one writes its result fields (after "ok": true), or sets 'is_successful' to false and provides the reason.
+    void addVessel(JsonWriter& writer, bool& is_successful, std::string& outcome_message);
+    void getVessels(JsonWriter& writer, bool& is_successful, std::string& outcome_message);
+    void addSailing(JsonWriter& writer, bool& is_successful, std::string& outcome_message);
+    void removeSailing(JsonWriter& writer, bool& is_successful, std::string& outcome_message);
+    void getSailingReports(JsonWriter& writer, bool& is_successful, std::string& outcome_message);
+    void getSailingReportByID(JsonWriter& writer, bool& is_successful, std::string& outcome_message);
+    void addVehicle(JsonWriter& writer, bool& is_successful, std::string& outcome_message);
+    void getVehicleByID(JsonWriter& writer, bool& is_successful, std::string& outcome_message);
+    void addReservation(JsonWriter& writer, bool& is_successful, std::string& outcome_message);
+    void removeReservation(JsonWriter& writer, bool& is_successful, std::string& outcome_message);
+    void completeBoarding(JsonWriter& writer, bool& is_successful, std::string& outcome_message);
+    void flushGroupCommit(JsonWriter& writer, bool& is_successful, std::string& outcome_message);
+
+    // Reads a field of the current request, failing if it is missing or of another type.
+    bool getString(std::string_view key, std::string_view& value, std::string& outcome_message) const;
+    bool getNumber(std::string_view key, double& value, std::string& outcome_message) const;
+
+    // Finds the sailing named by the "sailing_id" field.
+    void findSailing(Sailing& sailing, bool& is_successful, std::string& outcome_message);
+
+    // Finds the vehicle named by the "license_plate" field.
+    void findVehicle(Vehicle& vehicle, bool& is_successful, std::string& outcome_message);
+
+    // Checks the vehicle fields of the current request. Returns the reason they were rejected, or an empty string.
+    std::string readVehicle(Vehicle& vehicle) const;
+
+    // Writes the start of a response ("id" and "ok") for the current request.
+    void beginResponse(JsonWriter& writer, bool is_ok) const;
+
+    // Commits the open group (if any) and writes the buffered responses.
+    void flushResponses(std::ostream& response_stream);
+
+private:
+    // The buffered responses are written once they reach this size.
+    static constexpr std::size_t sc_response_buffer_bytes = 1 << 16;
+
+    Database* m_database;
+    std::string m_responses;
+
+    // The request being answered (reused, so that parsing does not allocate once the session is under way).
+    JsonObject m_request;
+};
+
+#endif // JSON_SESSION_HPP
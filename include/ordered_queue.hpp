@@ -0,0 +1,230 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Ordered Queue Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * ordered_queue.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides a bounded queue that hands items to a single consumer in sequence order, whatever order the producers finish them in.
+ * Item 's' always goes through slot 's % capacity', so producers never compete for a slot and no lock is needed: each slot only holds an atomic state that says which item it is free for, or holds.
+ * A producer that runs 'capacity' items ahead of the consumer waits for its slot to be freed, which keeps memory bounded.
+ *
+ * Usage:
+ *
+ *     OrderedQueue<Chunk> queue(8);
+ *
+ *     // Producers (any thread, any order):
+ *     queue.push(sequence, std::move(chunk));
+ *
+ *     // Consumer (one thread, in order):
+ *     for(long long sequence = 0; sequence < chunk_count; ++sequence)
+ *     {
+ *         queue.pop(sequence, chunk);
+ *     }
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef ORDERED_QUEUE_HPP
+#define ORDERED_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+template<typename Item>
+class OrderedQueue
+{
+public:
+    // ----------------------------------------------------------------------------
+    explicit OrderedQueue(
+        std::size_t capacity // [IN] | The most items held at once (at least 1).
+        ) :
+        m_capacity(capacity < 1 ? 1 : capacity),
+        m_slots(std::make_unique<Slot[]>(m_capacity))
+    {
+        for(std::size_t index = 0; index < m_capacity; ++index)
+        {
+            m_slots[index].state.store(freeState(static_cast<long long>(index)), std::memory_order_relaxed);
+        }
+    }
+
+    /*
+    *   [Description]
+    *   Constructor for the OrderedQueue class. The first item expected is item 0.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+public:
+    // ----------------------------------------------------------------------------
+    bool push(
+        long long sequence, // [IN] | The position of the item in the sequence. Each position is pushed exactly once.
+        Item&& item         // [IN] | The item, moved into the queue.
+        )
+    {
+        Slot& slot = getSlot(sequence);
+
+        if(!waitForState(slot, freeState(sequence)))
+        {
+            return(false);
+        }
+
+        slot.item = std::move(item);
+
+        // Publish the item (the release makes it visible to the consumer's acquire), unless the queue was closed meanwhile:
+        long long expected_state = freeState(sequence);
+
+        if(!slot.state.compare_exchange_strong(expected_state, heldState(sequence), std::memory_order_release, std::memory_order_relaxed))
+        {
+            return(false);
+        }
+
+        slot.state.notify_all();
+
+        return(true);
+    }
+
+    /*
+    *   [Description]
+    *   This function places an item in the queue, first waiting until the consumer is less than 'capacity' items behind it.
+    *
+    *   [Return]
+    *   Whether the item was placed, which is false once the queue is closed.
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    bool pop(
+        long long sequence, // [IN]  | The position of the item wanted, which must be the one after the last popped item.
+        Item& item          // [OUT] | The item, moved out of the queue.
+        )
+    {
+        Slot& slot = getSlot(sequence);
+
+        if(!waitForState(slot, heldState(sequence)))
+        {
+            return(false);
+        }
+
+        item = std::move(slot.item);
+
+        // Free the slot for the item 'capacity' positions later:
+        long long expected_state = heldState(sequence);
+
+        if(!slot.state.compare_exchange_strong(expected_state, freeState(sequence + static_cast<long long>(m_capacity)), std::memory_order_release, std::memory_order_relaxed))
+        {
+            return(false);
+        }
+
+        slot.state.notify_all();
+
+        return(true);
+    }
+
+    /*
+    *   [Description]
+    *   This function takes the next item out of the queue, waiting until it has been pushed.
+    *
+    *   [Return]
+    *   Whether an item was taken, which is false once the queue is closed.
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void close()
+    {
+        for(std::size_t index = 0; index < m_capacity; ++index)
+        {
+            m_slots[index].state.store(sc_closed_state, std::memory_order_release);
+            m_slots[index].state.notify_all();
+        }
+    }
+
+    /*
+    *   [Description]
+    *   This function wakes every waiting producer and consumer and makes every later call fail. Used to abandon the sequence early (for example when the consumer hits an error).
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+private:
+    // A slot holds either nothing (free for item 's', state 2s) or item 's' (state 2s + 1).
+    struct Slot
+    {
+        std::atomic<long long> state{0};
+        Item item{};
+    };
+
+    static constexpr long long sc_closed_state = -1;
+
+    static long long freeState(long long sequence) { return(2 * sequence); }
+    static long long heldState(long long sequence) { return(2 * sequence + 1); }
+
+    Slot& getSlot(long long sequence) { return(m_slots[static_cast<std::size_t>(sequence) % m_capacity]); }
+
+    // Waits (without spinning) until the slot reaches the state. Returns false if the queue is closed instead.
+    static bool waitForState(
+        Slot& slot,
+        long long expected_state
+        )
+    {
+        long long state = slot.state.load(std::memory_order_acquire);
+
+        while(state != expected_state)
+        {
+            if(state == sc_closed_state)
+            {
+                return(false);
+            }
+
+            slot.state.wait(state, std::memory_order_acquire);
+
+            state = slot.state.load(std::memory_order_acquire);
+        }
+
+        return(true);
+    }
+
+private:
+    std::size_t m_capacity;
+    std::unique_ptr<Slot[]> m_slots;
+};
+
+#endif // ORDERED_QUEUE_HPP
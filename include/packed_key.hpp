@@ -0,0 +1,144 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Packed Key Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * packed_key.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file packs a license plate into a single 64-bit integer, the key vehicles are indexed and looked up by (in the database, the entity cache and the sailing manifest).
+ * A plate is at most 10 characters out of 38 symbols (space, hyphen, digits and capital letters, see 'g_license_plate_pattern'), so each character is one digit of a base 39 number, with '0' marking the end of a shorter plate.
+ * The symbols are numbered in ASCII order and the first character is the most significant digit, so comparing two keys gives the same order as comparing the plates as text.
+ *
+ * Usage:
+ *
+ *     std::int64_t key = 0;
+ *
+ *     if(PackedKey::packLicensePlate("ABC-123", key))
+ *     {
+ *         std::string license_plate = PackedKey::unpackLicensePlate(key); // "ABC-123"
+ *     }
+ *
+ * NOTE (SAVIZ): The database computes the same key in SQL ('DatabaseQueries::c_schema_migrations', version 2). Both must change together, and 'Test_Database' checks that they agree.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef PACKED_KEY_HPP
+#define PACKED_KEY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace PackedKey
+{
+    // The symbols a plate may hold, numbered from 1 in this order (ASCII order).
+    inline constexpr std::string_view c_license_plate_symbols = " -0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    inline constexpr std::size_t c_license_plate_max_length = 10;
+    inline constexpr std::int64_t c_license_plate_base = static_cast<std::int64_t>(c_license_plate_symbols.size()) + 1;
+
+    // Packs a plate of 1 to 10 symbols. Returns false (and leaves the key alone) for anything else.
+    constexpr bool packLicensePlate(
+        std::string_view license_plate,
+        std::int64_t& key
+        )
+    {
+        if(license_plate.empty() || license_plate.size() > c_license_plate_max_length)
+        {
+            return(false);
+        }
+
+        std::int64_t packed_key = 0;
+
+        for(std::size_t index = 0; index < c_license_plate_max_length; ++index)
+        {
+            std::int64_t digit = 0;
+
+            if(index < license_plate.size())
+            {
+                std::size_t position = c_license_plate_symbols.find(license_plate[index]);
+
+                if(position == std::string_view::npos)
+                {
+                    return(false);
+                }
+
+                digit = static_cast<std::int64_t>(position) + 1;
+            }
+
+            packed_key = packed_key * c_license_plate_base + digit;
+        }
+
+        key = packed_key;
+
+        return(true);
+    }
+
+    // The plate a key was packed from (an empty string if it is not a packed plate).
+    inline std::string unpackLicensePlate(
+        std::int64_t key
+        )
+    {
+        if(key <= 0)
+        {
+            return(std::string());
+        }
+
+        char characters[c_license_plate_max_length] = {};
+
+        for(std::size_t index = c_license_plate_max_length; index > 0; --index)
+        {
+            std::int64_t digit = key % c_license_plate_base;
+
+            characters[index - 1] = digit == 0 ? '\0' : c_license_plate_symbols[static_cast<std::size_t>(digit - 1)];
+            key /= c_license_plate_base;
+        }
+
+        std::size_t length = 0;
+
+        while(length < c_license_plate_max_length && characters[length] != '\0')
+        {
+            length += 1;
+        }
+
+        // Only trailing digits may mark the end, and nothing may be left over:
+        for(std::size_t index = length; index < c_license_plate_max_length; ++index)
+        {
+            if(characters[index] != '\0')
+            {
+                return(std::string());
+            }
+        }
+
+        return(key == 0 ? std::string(characters, length) : std::string());
+    }
+
+    // Spreads a key over the bits a power of two sized table uses (the low digits of plates are often alike).
+    constexpr std::uint64_t hashKey(
+        std::int64_t key
+        )
+    {
+        std::uint64_t hash = static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ULL;
+
+        return(hash ^ (hash >> 32));
+    }
+}
+
+#endif // PACKED_KEY_HPP
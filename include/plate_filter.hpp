@@ -0,0 +1,240 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Plate Filter Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * plate_filter.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides a Bloom filter over the license plates of the vehicles table, so that a plate never seen before (a walk-up at the gate) is known to be new without a query.
+ * Each plate sets 'sc_hash_count' bits of a bit array sized for about 10 bits per plate, so a plate that is not in the table still passes the filter about 1% of the time (a false positive, which costs the usual lookup). A plate that is in the table always passes.
+ *
+ * A Database given a filter (see 'Database::setPlateFilter()') answers 'getVehicleByID()' for a plate the filter rules out without touching SQLite, and adds every vehicle it creates to the filter.
+ *
+ * The filter is kept beside the database file ("database.db.plates") between runs. Loading it only reads the vehicles created since it was saved, instead of the whole table.
+ *
+ * Usage:
+ *
+ *     PlateFilter plate_filter;
+ *
+ *     plate_filter.load(*database, PlateFilter::getFilePath("database.db"), is_successful, outcome_message);
+ *     database->setPlateFilter(&plate_filter, is_successful, outcome_message);
+ *     ...
+ *     plate_filter.save(PlateFilter::getFilePath("database.db"), is_successful, outcome_message);
+ *
+ * NOTE (SAVIZ): Only vehicles created through a Database that uses the filter are added to it while the program runs. A vehicle created by another process would be ruled out until the filter is loaded again, so only one process should write the vehicles while the filter is in use.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef PLATE_FILTER_HPP
+#define PLATE_FILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Database;
+
+// Counters describing how well a PlateFilter works. A false positive is a plate that passed the filter but was not found by the query.
+struct PlateFilterStatistics
+{
+    long long plate_count = 0;          // Plates added to the filter (counted again if added twice).
+    long long bit_count = 0;            // Size of the bit array.
+    long long ruled_out_count = 0;      // Lookups answered without querying for the plate.
+    long long found_count = 0;          // Lookups that passed the filter and found the vehicle.
+    long long false_positive_count = 0; // Lookups that passed the filter and found nothing.
+    double estimated_false_positive_rate = 0.0; // What the bits set so far predict for a plate that is not in the table.
+
+    // The share of the lookups for a missing plate that still went to the database ('0' before there are any).
+    double getFalsePositiveRate() const
+    {
+        long long missing_count = ruled_out_count + false_positive_count;
+
+        return(missing_count == 0 ? 0.0 : static_cast<double>(false_positive_count) / static_cast<double>(missing_count));
+    }
+};
+
+class PlateFilter
+{
+public:
+    // ----------------------------------------------------------------------------
+    explicit PlateFilter();
+
+    /*
+    *   [Description]
+    *   Constructor for the PlateFilter class. The filter starts empty, and rules out every plate until 'build()' or 'load()' is called.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    ~PlateFilter();
+
+    /*
+    *   [Description]
+    *   Destructor for the PlateFilter class, responsible for deallocating the object from memory. Every Database using the filter must be given another one (or none) first.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+public:
+    // ----------------------------------------------------------------------------
+    void build(
+        Database& database,          // [IN]  | The database to read the plates from.
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function replaces the filter with one holding every plate of the vehicles table, sized with room for the table to double.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Read failure>
+    *       If the plates cannot be read, the filter is left empty and the operation will terminate with the failure status and message of 'Database::getVehiclePlates()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void load(
+        Database& database,           // [IN]  | The database the filter was saved for.
+        const std::string& file_path, // [IN]  | The file written by 'save()'.
+        bool& is_successful,          // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message  // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function reads a filter saved by 'save()', and adds the vehicles created since then.
+    *   The saved filter is only used if the last vehicle it knows of is still in the database under the same ID and plate, and if it still has room for the table. Otherwise (or if there is no file) the filter is built from the table with 'build()', and the outcome message says so.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Read failure>
+    *       If the plates cannot be read, the filter is left empty and the operation will terminate with the failure status and message of 'Database::getVehiclePlates()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void save(
+        const std::string& file_path, // [IN]  | Where to write the filter (replaced if it exists).
+        bool& is_successful,          // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message  // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function writes the filter to a file, for 'load()' to read on the next run. The file is written beside the target first and then renamed over it, so a crash never leaves half a filter behind.
+    *   NOTE (SAVIZ): The bit array is written in the byte order of the machine, so the file is not meant to be copied to another kind of machine (it is then simply rebuilt).
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Write failure>
+    *       If the file cannot be written, the operation will terminate with a failure status and provide an appropriate error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void getStatistics(
+        PlateFilterStatistics& statistics // [OUT] | The counters of the filter since it was built or loaded.
+        );
+
+    /*
+    *   [Description]
+    *   This function provides how many lookups the filter answered, and its false positive rate (both observed and estimated). A rate well above 1% means the table has outgrown the filter, which the next 'load()' fixes by building a larger one.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+    // NOTE (SAVIZ): The functions below are what a Database uses the filter through. Each one is safe to call from any thread.
+
+    // Adds a plate (adding it again is harmless).
+    void insert(const std::string& license_plate);
+
+    // Whether the plate may be in the table, as far as the vehicles read so far go. 'false' is certain for those.
+    bool mayContain(const std::string& license_plate);
+
+    // Adds the plates of the vehicles created since the last one it read (by another process, say), with 'Database::getVehiclePlates()'. Fails with its outcome if they cannot be read.
+    void catchUp(Database& database, bool& is_successful, std::string& outcome_message);
+
+    // Counts the outcome of a lookup: ruled out by the filter, or a query made for a plate that passed it.
+    void recordRuledOut();
+    void recordLookup(bool is_found);
+
+    // The file kept beside a database.
+    static std::string getFilePath(const std::string& database_path) { return(database_path + ".plates"); }
+
+private:
+    // Empties the filter, sized for the given number of plates.
+    void reset(std::size_t plate_capacity);
+
+    // Sets (or tests) the bits of a plate. The caller holds the lock.
+    void setBits(const std::string& license_plate);
+    bool testBits(const std::string& license_plate) const;
+
+    // A hash that does not change between builds or runs (unlike 'std::hash'), as the bits are saved.
+    static std::uint64_t hashPlate(const std::string& license_plate);
+
+private:
+    static constexpr int sc_hash_count = 7;
+    static constexpr std::size_t sc_bits_per_plate = 10;
+    static constexpr std::size_t sc_minimum_capacity = 4096;
+
+    std::mutex m_mutex;
+
+    std::vector<std::uint64_t> m_words; // The bit array. Always a power of two number of bits.
+    std::size_t m_plate_capacity;       // Plates the array was sized for.
+    int m_last_vehicle_id;              // The last vehicle read from the table (later ones are read by 'catchUp()' or the next 'load()').
+    std::string m_last_license_plate;   // Its plate, to recognize the same database on the next 'load()'.
+
+    PlateFilterStatistics m_statistics;
+};
+
+#endif // PLATE_FILTER_HPP
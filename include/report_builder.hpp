@@ -0,0 +1,170 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Report Builder Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * report_builder.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides the end-of-day report behind "FerryFlow --report <terminal|days>": every sailing with its occupancy, vehicle count, boardings and revenue, with totals per terminal (or per range of days) and for the whole season.
+ *
+ * The sailings are split into partitions, by departure terminal or by range of departure days, which a pool of workers reads at once.
+ * Each worker reads on a read connection of its own (see 'ConnectionProfile::read_connections'), so on an N-core server a report takes about 1/N of the time it takes one thread, and the writes carry on meanwhile.
+ * The partitions are then merged back into departure order.
+ *
+ * NOTE (SAVIZ): Each partition is read from one snapshot, but the partitions are read at slightly different moments. A report made while boarding goes on may therefore count a boarding in one terminal that happened after another terminal was read.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef REPORT_BUILDER_HPP
+#define REPORT_BUILDER_HPP
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "containers.hpp"
+#include "database.hpp"
+
+// How the sailings of a report are split between the workers.
+enum class ReportPartitioning
+{
+    ByTerminal, // One partition per departure terminal.
+    ByDayRange  // Ranges of departure days, a few per worker (which balances better when terminals differ in size).
+};
+
+// Controls how a report is built.
+struct ReportSettings
+{
+    ReportPartitioning partitioning = ReportPartitioning::ByDayRange;
+    int worker_count = 1; // Threads reading partitions at once (no more than the database has read connections).
+};
+
+// The totals of a partition, or of the whole report.
+struct ReportSummary
+{
+    std::string label;                         // The terminal, the range of days, or "Total".
+    int sailing_count = 0;
+    long long vehicle_count = 0;
+    long long boarded_count = 0;
+    double revenue = 0.0;
+    double average_occupancy_percentage = 0.0; // Over the sailings of the partition.
+};
+
+// An end-of-day report, filled in by 'ReportBuilder::build()'.
+struct EndOfDayReport
+{
+    std::vector<EndOfDayReportRow> rows;   // Every sailing, ordered by departure day, hour and sailing.
+    std::vector<ReportSummary> partitions; // One per partition, in order.
+    ReportSummary total;
+    int worker_count = 0;                  // Workers that read the partitions.
+    double elapsed_seconds = 0.0;          // Time spent on the whole report.
+};
+
+class ReportBuilder
+{
+public:
+    // ----------------------------------------------------------------------------
+    explicit ReportBuilder(
+        Database* database,             // [IN] | The open database to report on.
+        const ReportSettings& settings  // [IN] | How the report is partitioned, and by how many workers it is read.
+        );
+
+    /*
+    *   [Description]
+    *   Constructor for the ReportBuilder class.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    ~ReportBuilder();
+
+    /*
+    *   [Description]
+    *   Destructor for the ReportBuilder class, responsible for deallocating the object from memory.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+public:
+    // ----------------------------------------------------------------------------
+    void build(
+        EndOfDayReport& report,      // [OUT] | The report.
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function builds the report of every sailing. The workers only run beside each other when the database has read connections, otherwise the calling thread reads every partition.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Query failure>
+    *       If a partition cannot be read, the operation will terminate with a failure status and provide the error message of 'Database::getEndOfDayReport()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    static void printReport(
+        const EndOfDayReport& report, // [IN] | The report to print.
+        std::ostream& output_stream   // [IN] | Where to print it.
+        );
+
+    /*
+    *   [Description]
+    *   This function prints a report as a table of sailings (in the layout of the sailing report menu), followed by the totals.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+private:
+    // Adds the rows to a summary (the average occupancy is worked out once every row is in, see 'finishSummary()').
+    static void addToSummary(const std::vector<EndOfDayReportRow>& rows, ReportSummary& summary);
+    static void finishSummary(ReportSummary& summary);
+
+private:
+    // Day ranges cut per worker. More, smaller ranges keep every worker busy until the end when some days are busier than others.
+    static constexpr int sc_day_ranges_per_worker = 4;
+
+    Database* m_database;
+    ReportSettings m_settings;
+};
+
+#endif // REPORT_BUILDER_HPP
@@ -156,6 +156,25 @@ private:
     *   This method is designed to handle all errors internally, ensuring that external components do not need to manage exception handling for its operations.
     */
     // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void findAvailableSailings();
+
+    /*
+    *   [Description]
+    *   Lists the next sailings from a terminal that still have room for a vehicle of the given length and height, with the lane it would go in.
+    *   Obtains and validates input with the help of input module.
+    *   The answer comes from the capacity engine, so no sailing has to be tried one by one.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   This method is designed to handle all errors internally, ensuring that external components do not need to manage exception handling for its operations.
+    */
+    // ----------------------------------------------------------------------------
 };
 
 #endif // RESERVATION_MANAGEMENT_STATE_HPP
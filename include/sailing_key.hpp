@@ -0,0 +1,190 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Sailing Key Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * sailing_key.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file packs a sailing ID ("TTT-dd-hh": terminal, departure day and departure hour) into a single 32-bit integer, the key sailings are indexed and looked up by (in the database and the entity cache).
+ * Each letter of the terminal takes 5 bits (A = 1 to Z = 26), and the day and the hour take 7 bits each (0 to 99), from the most significant end in that order. Comparing two keys therefore gives the same order as comparing the IDs as text, and '0' is never a valid key.
+ * A key is formatted and parsed without streams or allocations, which is what the report rendering and the lookups of every sailing ID typed or scripted go through.
+ *
+ * Usage:
+ *
+ *     SailingKey sailing_key;
+ *
+ *     if(SailingKey::parse("AHS-22-10", sailing_key))
+ *     {
+ *         database->getSailingByID(sailing_key, sailing, is_successful, outcome_message);
+ *     }
+ *
+ *     char sailing_id[SailingKey::c_text_length];
+ *     sailing_key.format(sailing_id); // "AHS-22-10", not terminated
+ *
+ * NOTE (SAVIZ): The database computes the same key in SQL ('DatabaseQueries::c_schema_migrations', version 3). Both must change together, and 'Test_Database' checks that they agree.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef SAILING_KEY_HPP
+#define SAILING_KEY_HPP
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include "packed_key.hpp"
+
+class SailingKey
+{
+public:
+    static constexpr std::size_t c_terminal_length = 3;
+    static constexpr std::size_t c_text_length = 9; // "TTT-dd-hh"
+    static constexpr int c_max_day = 99;
+    static constexpr int c_max_hour = 99;
+
+    // An empty key (matches no sailing).
+    constexpr SailingKey() : m_value(0) {}
+
+    // Packs a terminal of 3 capital letters, a day and an hour of 0 to 99. Returns false (and leaves the key alone) for anything else.
+    static constexpr bool create(
+        std::string_view terminal,
+        int departure_day,
+        int departure_hour,
+        SailingKey& sailing_key
+        )
+    {
+        if(terminal.size() != c_terminal_length || departure_day < 0 || departure_day > c_max_day || departure_hour < 0 || departure_hour > c_max_hour)
+        {
+            return(false);
+        }
+
+        std::uint32_t value = 0;
+
+        for(char letter : terminal)
+        {
+            if(letter < 'A' || letter > 'Z')
+            {
+                return(false);
+            }
+
+            value = (value << sc_letter_bits) | static_cast<std::uint32_t>(letter - 'A' + 1);
+        }
+
+        value = (value << sc_number_bits) | static_cast<std::uint32_t>(departure_day);
+        value = (value << sc_number_bits) | static_cast<std::uint32_t>(departure_hour);
+
+        sailing_key.m_value = value;
+
+        return(true);
+    }
+
+    // Packs a sailing ID of the form "TTT-dd-hh" (exactly, see 'g_sailing_id_pattern'). Returns false (and leaves the key alone) for anything else.
+    static constexpr bool parse(
+        std::string_view sailing_id,
+        SailingKey& sailing_key
+        )
+    {
+        if(sailing_id.size() != c_text_length || sailing_id[3] != '-' || sailing_id[6] != '-')
+        {
+            return(false);
+        }
+
+        if(!isDigit(sailing_id[4]) || !isDigit(sailing_id[5]) || !isDigit(sailing_id[7]) || !isDigit(sailing_id[8]))
+        {
+            return(false);
+        }
+
+        int departure_day = (sailing_id[4] - '0') * 10 + (sailing_id[5] - '0');
+        int departure_hour = (sailing_id[7] - '0') * 10 + (sailing_id[8] - '0');
+
+        return(create(sailing_id.substr(0, c_terminal_length), departure_day, departure_hour, sailing_key));
+    }
+
+    // Writes the "TTT-dd-hh" ID (without a terminating zero). An empty key writes "???-00-00".
+    constexpr void format(
+        char (&sailing_id)[c_text_length]
+        ) const
+    {
+        sailing_id[0] = getLetter(0);
+        sailing_id[1] = getLetter(1);
+        sailing_id[2] = getLetter(2);
+        sailing_id[3] = '-';
+        sailing_id[4] = static_cast<char>('0' + getDepartureDay() / 10);
+        sailing_id[5] = static_cast<char>('0' + getDepartureDay() % 10);
+        sailing_id[6] = '-';
+        sailing_id[7] = static_cast<char>('0' + getDepartureHour() / 10);
+        sailing_id[8] = static_cast<char>('0' + getDepartureHour() % 10);
+    }
+
+    std::string toString() const
+    {
+        char sailing_id[c_text_length];
+
+        format(sailing_id);
+
+        return(std::string(sailing_id, c_text_length));
+    }
+
+    std::string getTerminal() const
+    {
+        return(std::string{getLetter(0), getLetter(1), getLetter(2)});
+    }
+
+    constexpr int getDepartureDay() const { return(static_cast<int>((m_value >> sc_number_bits) & sc_number_mask)); }
+    constexpr int getDepartureHour() const { return(static_cast<int>(m_value & sc_number_mask)); }
+    constexpr std::uint32_t getValue() const { return(m_value); }
+    constexpr bool isEmpty() const { return(m_value == 0); }
+
+    constexpr auto operator<=>(const SailingKey&) const = default;
+
+private:
+    static constexpr bool isDigit(char character) { return(character >= '0' && character <= '9'); }
+
+    // The letter at a position of the terminal ('?' for an empty key).
+    constexpr char getLetter(
+        int position
+        ) const
+    {
+        std::uint32_t letter = (m_value >> (2 * sc_number_bits + (2 - position) * sc_letter_bits)) & sc_letter_mask;
+
+        return(letter >= 1 && letter <= 26 ? static_cast<char>('A' + letter - 1) : '?');
+    }
+
+private:
+    static constexpr int sc_letter_bits = 5;
+    static constexpr int sc_number_bits = 7;
+    static constexpr std::uint32_t sc_letter_mask = (1u << sc_letter_bits) - 1;
+    static constexpr std::uint32_t sc_number_mask = (1u << sc_number_bits) - 1;
+
+    std::uint32_t m_value;
+};
+
+// Lets a SailingKey be the key of 'std::unordered_map' (and 'LruMap'), spread like the packed plates.
+template<>
+struct std::hash<SailingKey>
+{
+    std::size_t operator()(const SailingKey& sailing_key) const noexcept
+    {
+        return(static_cast<std::size_t>(PackedKey::hashKey(static_cast<std::int64_t>(sailing_key.getValue()))));
+    }
+};
+
+#endif // SAILING_KEY_HPP
@@ -0,0 +1,188 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Sailing Manifest Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * sailing_manifest.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides the manifest of the sailing being boarded: every reservation with its vehicle, loaded in one query when the boarding session starts.
+ * The entries are found by license plate in an open addressing hash table (linear probing over a power of two number of slots, kept at most half full), so each plate typed at the gate costs no query until its fare is charged.
+ * The table holds the packed plates (see 'packed_key.hpp'), so a probe compares integers rather than strings.
+ *
+ * Usage:
+ *
+ *     manifest.load(*database, sailing, is_successful, outcome_message);
+ *
+ *     const ManifestEntry* entry = manifest.find(license_plate);
+ *
+ *     if(entry != nullptr && !entry->is_boarded)
+ *     {
+ *         database->completeBoarding(sailing, entry->vehicle, is_successful, outcome_message);
+ *
+ *         if(is_successful) manifest.setBoarded(entry->vehicle);
+ *     }
+ *
+ * NOTE (SAVIZ): Other terminals may book or board the same sailing meanwhile, so the manifest can be behind the database. A plate it does not know goes through the usual lookups, and a boarding it missed is still refused by 'Database::completeBoarding()'.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef SAILING_MANIFEST_HPP
+#define SAILING_MANIFEST_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "containers.hpp"
+#include "database.hpp"
+
+class SailingManifest
+{
+public:
+    // ----------------------------------------------------------------------------
+    explicit SailingManifest();
+
+    /*
+    *   [Description]
+    *   Constructor for the SailingManifest class. The manifest starts empty until 'load()' is called.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    ~SailingManifest();
+
+    /*
+    *   [Description]
+    *   Destructor for the SailingManifest class, responsible for deallocating the object from memory.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+public:
+    // ----------------------------------------------------------------------------
+    void load(
+        Database& database,          // [IN]  | The database to read the manifest from.
+        const Sailing& sailing,      // [IN]  | The sailing being boarded.
+        bool& is_successful,         // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function replaces the manifest with every reservation of the sailing, read through 'Database::getSailingManifest()'.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Read failure>
+    *       If the manifest cannot be read, it is left empty and the operation will terminate with the failure status and message of 'Database::getSailingManifest()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    const ManifestEntry* find(
+        const std::string& license_plate // [IN] | The plate of the vehicle.
+        ) const;
+
+    /*
+    *   [Description]
+    *   This function finds the reservation of a vehicle on the sailing, in constant time on average.
+    *
+    *   [Return]
+    *   The entry, or 'nullptr' if the vehicle has no reservation in the manifest. It stays valid until the next 'load()' or 'setBoarded()'.
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void setBoarded(
+        const Vehicle& vehicle // [IN] | The vehicle that boarded.
+        );
+
+    /*
+    *   [Description]
+    *   This function records that a vehicle has boarded, once its fare is charged. A walk-up vehicle (reserved at the gate) is added to the manifest.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void clear();
+
+    /*
+    *   [Description]
+    *   This function empties the manifest (at the end of a boarding session).
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+    int getSailingID() const { return(m_sailing_id); }
+    std::size_t getSize() const { return(m_entries.size()); }
+
+private:
+    // Adds an entry that is not in the table yet.
+    void insert(std::int64_t license_plate_key, ManifestEntry entry);
+
+    // Finds the slot holding the packed plate, or the empty slot where it would go.
+    std::size_t findSlot(std::int64_t license_plate_key) const;
+
+    // Doubles the slots (or makes the first ones) and places every entry again.
+    void grow();
+
+private:
+    static constexpr std::int32_t sc_empty_slot = -1;
+
+    int m_sailing_id;
+    std::vector<ManifestEntry> m_entries; // In the order they were added.
+    std::vector<std::int64_t> m_keys;     // The packed plate of each entry (kept apart, so that probing stays within a few cache lines).
+    std::vector<std::int32_t> m_slots;    // Index into 'm_entries', or 'sc_empty_slot'. Always a power of two in size.
+};
+
+#endif // SAILING_MANIFEST_HPP
@@ -0,0 +1,189 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Schedule Index Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * schedule_index.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides the index behind "which sailings from this terminal can still take this vehicle".
+ * The sailings of one terminal are kept in departure order, with a segment tree over them that holds the most room left in each lane for every range of sailings.
+ * A search skips every range in which no sailing has enough room, so finding the next K sailings costs about K * log(n) steps instead of a scan.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef SCHEDULE_INDEX_HPP
+#define SCHEDULE_INDEX_HPP
+
+#include <string>
+#include <vector>
+
+class ScheduleIndex
+{
+public:
+    // ----------------------------------------------------------------------------
+    explicit ScheduleIndex(
+        const std::string& departure_terminal // [IN] | The terminal whose sailings are indexed.
+        );
+
+    /*
+    *   [Description]
+    *   Constructor for the ScheduleIndex class. The index starts without any sailings.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+public:
+    // ----------------------------------------------------------------------------
+    void insert(
+        int sailing_id,               // [IN] | The sailing to add.
+        int departure_day,            // [IN] | Its departure day.
+        int departure_hour,           // [IN] | Its departure hour.
+        double low_remaining_length,  // [IN] | The room left in its low ceiling lane.
+        double high_remaining_length  // [IN] | The room left in its high ceiling lane.
+        );
+
+    /*
+    *   [Description]
+    *   This function adds a sailing in its place in the departure order. The tree is rebuilt, which costs linear time, but sailings are created rarely compared to how often they are searched.
+    *   Use 'reserve()' and 'build()' when adding many sailings at once.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void update(
+        int departure_day,            // [IN] | The departure day of the sailing to change.
+        int departure_hour,           // [IN] | The departure hour of the sailing to change.
+        double low_remaining_length,  // [IN] | The new room left in its low ceiling lane.
+        double high_remaining_length  // [IN] | The new room left in its high ceiling lane.
+        );
+
+    /*
+    *   [Description]
+    *   This function changes the room left on one sailing, in logarithmic time (nothing happens if there is no sailing at that time).
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void erase(
+        int departure_day, // [IN] | The departure day of the sailing to remove.
+        int departure_hour // [IN] | The departure hour of the sailing to remove.
+        );
+
+    /*
+    *   [Description]
+    *   This function removes a sailing (nothing happens if there is no sailing at that time). The tree is rebuilt, like in 'insert()'.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void findAvailable(
+        int from_day,                 // [IN]  | The earliest departure day to consider.
+        int from_hour,                // [IN]  | The earliest departure hour to consider (on 'from_day').
+        double length,                // [IN]  | The length of the vehicle.
+        double height,                // [IN]  | The height of the vehicle.
+        int count,                    // [IN]  | The most sailings to return.
+        std::vector<int>& sailing_ids // [OUT] | The sailings that can take the vehicle, in departure order.
+        ) const;
+
+    /*
+    *   [Description]
+    *   This function finds the first 'count' sailings departing at or after the given time that can take the vehicle.
+    *   A sailing can take it if it fits in the low lane (vehicles up to 2 meters tall only) or in the high lane, the same rule the database uses.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+    // Makes room for a number of sailings to be added with 'append()' before a single 'build()'. (Used when loading)
+    void reserve(std::size_t sailing_count);
+    void append(int sailing_id, int departure_day, int departure_hour, double low_remaining_length, double high_remaining_length);
+    void build();
+
+    const std::string& getDepartureTerminal() const;
+    std::size_t getSailingCount() const;
+
+private:
+    // A sailing of the terminal. NOTE (SAVIZ): The remaining lengths live in the leaves of the tree, not here.
+    struct ScheduledSailing
+    {
+        int sailing_id;
+        int departure_day;
+        int departure_hour;
+    };
+
+    // Returns the position of the first sailing departing at or after the given time.
+    std::size_t findPosition(int departure_day, int departure_hour) const;
+
+    // Returns the first position at or after 'from' (within the node's range) whose sailing can take the vehicle, or -1.
+    int findFirst(std::size_t node, std::size_t node_first, std::size_t node_last, std::size_t from, double length, double height) const;
+
+    // Whether any sailing under the node can take the vehicle.
+    bool canTake(std::size_t node, double length, double height) const;
+
+private:
+    std::string m_departure_terminal;
+
+    // The sailings, in departure order.
+    std::vector<ScheduledSailing> m_sailings;
+
+    // The remaining lengths given to 'append()', waiting for 'build()'.
+    std::vector<double> m_pending_low_lengths;
+    std::vector<double> m_pending_high_lengths;
+
+    // The segment tree, stored as an array: node 1 is the root, node n has children 2n and 2n + 1, and the leaves start at 'm_leaf_count'.
+    // Each node holds the most room left in each lane among the sailings under it. Unused leaves hold -1, which nothing fits in.
+    std::size_t m_leaf_count;
+    std::vector<double> m_max_low_lengths;
+    std::vector<double> m_max_high_lengths;
+};
+
+#endif // SCHEDULE_INDEX_HPP
@@ -0,0 +1,219 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Script Runner Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * script_runner.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides the scripted mode behind "FerryFlow --script <file>", used by load tests and ticketing scripts instead of piping keystrokes through the menus.
+ * A script holds one command per line. Each command is checked with the same rules as the prompts (see 'global.hpp') and then maps straight to one or two calls of the Database API, without going through the states.
+ *
+ * The commands are (words are separated by spaces, and a word holding spaces is quoted: "Queen of Surrey"):
+ *
+ *     # Blank lines and lines starting with '#' are ignored.
+ *     vessel <name> <low lane length> <high lane length>
+ *     vessels                                                     (lists every vessel with its ID)
+ *     sailing <sailing ID> <vessel ID>
+ *     remove-sailing <sailing ID>
+ *     vehicle <license plate> <phone number> <length> <height>
+ *     reserve <sailing ID> <license plate> [<phone number> <length> <height>]
+ *     cancel <sailing ID> <license plate>
+ *     board <sailing ID> <license plate> [<phone number> <length> <height>]
+ *     report [<sailing ID>]                                       (one sailing, or every sailing)
+ *
+ * 'reserve' and 'board' create the vehicle first when it is not known yet and its details are given. 'board' makes a reservation for walk-up vehicles, like the boarding menu.
+ *
+ * Every command answers with one line starting with "ok" or "error" ('vessels' and 'report' print their rows before it):
+ *
+ *     ok reserve AHS-22-10 A76-2H4 low
+ *     error line 7: Reservation creation failed: Not enough space!
+ *
+ * The answers are gathered in a buffer and written in large pieces, so the output stream is never the limit.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef SCRIPT_RUNNER_HPP
+#define SCRIPT_RUNNER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "containers.hpp"
+#include "database.hpp"
+
+// Counters describing a script run, filled in by 'ScriptRunner::runFile()'.
+struct ScriptStatistics
+{
+    long long line_count = 0;       // Lines read, including blank lines and comments.
+    long long command_count = 0;    // Commands run.
+    long long failed_count = 0;     // Commands that answered with an error.
+    double elapsed_seconds = 0.0;   // Time spent on the whole script.
+};
+
+class ScriptRunner
+{
+public:
+    // ----------------------------------------------------------------------------
+    explicit ScriptRunner(
+        Database* database,         // [IN] | The open database the commands run against.
+        std::ostream& output_stream // [IN] | Where the answers are written.
+        );
+
+    /*
+    *   [Description]
+    *   Constructor for the ScriptRunner class.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    ~ScriptRunner();
+
+    /*
+    *   [Description]
+    *   Destructor for the ScriptRunner class, responsible for deallocating the object from memory. Any answers still buffered are written out.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+public:
+    // ----------------------------------------------------------------------------
+    void runFile(
+        const std::string& path,        // [IN]  | The script file, or "-" for the standard input.
+        ScriptStatistics& statistics,   // [OUT] | How many commands were run, and how many failed.
+        bool& is_successful,            // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message    // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function runs every command of a script (see the top of this file for the commands), in order.
+    *   A command that fails answers with an error naming its line, and the script goes on: a failed command is an answer, not a failure of the run.
+    *   NOTE (SAVIZ): With group commit on (see 'Database::setGroupCommit()'), the writes of a burst of commands share one transaction. Whatever is still grouped is committed when the script ends.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Unreadable file>
+    *       If the file cannot be opened, the operation will terminate with a failure status and provide an appropriate error message naming the path.
+    *   @ <Group commit failure>
+    *       If the writes still grouped at the end cannot be committed, the operation will terminate with the failure status and message of 'Database::flushGroupCommit()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void runStream(
+        std::istream& stream,           // [IN]  | The commands to run, one per line.
+        ScriptStatistics& statistics,   // [OUT] | How many commands were run, and how many failed.
+        bool& is_successful,            // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message    // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function is 'runFile()' for commands that are already in a stream.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Group commit failure>
+    *       See 'runFile()'.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    bool runCommand(
+        const std::string& line, // [IN]  | One line of a script.
+        long long line_number,   // [IN]  | The number of the line (from 1), named by an error answer.
+        std::string& answer      // [OUT] | The answer is appended here, one or more lines each ending with '\n' (nothing for a blank line or a comment).
+        );
+
+    /*
+    *   [Description]
+    *   This function runs a single command, without touching the output stream or the statistics.
+    *
+    *   [Return]
+    *   Whether the command succeeded (true for a blank line or a comment).
+    *
+    *   [Errors]
+    *   N/A (a failed command is reported in its answer)
+    */
+    // ----------------------------------------------------------------------------
+
+private:
+    // Splits a line into words. Returns false if a quote is never closed.
+    static bool splitWords(const std::string& line, std::vector<std::string>& words);
+
+    // The commands. Each one returns the text of its "ok" line, or sets 'is_successful' to false and provides the reason.
+    std::string addVessel(const std::vector<std::string>& words, bool& is_successful, std::string& outcome_message);
+    std::string listVessels(std::string& answer, bool& is_successful, std::string& outcome_message);
+    std::string addSailing(const std::vector<std::string>& words, bool& is_successful, std::string& outcome_message);
+    std::string removeSailing(const std::vector<std::string>& words, bool& is_successful, std::string& outcome_message);
+    std::string addVehicle(const std::vector<std::string>& words, bool& is_successful, std::string& outcome_message);
+    std::string reserve(const std::vector<std::string>& words, bool& is_successful, std::string& outcome_message);
+    std::string cancel(const std::vector<std::string>& words, bool& is_successful, std::string& outcome_message);
+    std::string board(const std::vector<std::string>& words, bool& is_successful, std::string& outcome_message);
+    std::string report(const std::vector<std::string>& words, std::string& answer, bool& is_successful, std::string& outcome_message);
+
+    // Reads and finds the sailing named by a sailing ID word.
+    void findSailing(const std::string& sailing_id, Sailing& sailing, bool& is_successful, std::string& outcome_message);
+
+    // Finds the vehicle named by 'words[2]', creating it from 'words[3..5]' if it is not known yet and they are given.
+    void findOrAddVehicle(const std::vector<std::string>& words, Vehicle& vehicle, bool& is_successful, std::string& outcome_message);
+
+    // Checks the details of a vehicle (from 'words[first]' on: license plate, phone number, length, height).
+    static std::string readVehicle(const std::vector<std::string>& words, std::size_t first, Vehicle& vehicle);
+
+    // Commits the open group (see 'Database::setGroupCommit()'), then writes the buffered answers to the output stream. A group that cannot be committed is answered with an error line after them, and fails the operation.
+    void flushOutput(bool& is_successful, std::string& outcome_message);
+
+private:
+    // The buffered answers are written once they reach this size.
+    static constexpr std::size_t sc_output_buffer_bytes = 1 << 16;
+
+    Database* m_database;
+    std::ostream& m_output_stream;
+    std::string m_output;
+
+    // The words of the current command (kept between commands, so short words are split without allocating).
+    std::vector<std::string> m_words;
+};
+
+#endif // SCRIPT_RUNNER_HPP
@@ -0,0 +1,277 @@
+// ============================================================================
+// ============================================================================
+
+/*
+ * [MODULE]
+ *
+ * Server Module
+ *
+ *
+ * [FILE NAME]
+ *
+ * server.hpp
+ *
+ *
+ * [REVISION HISTORY]
+ *
+ * Rev 1 - 2025/08 Original by Saviz Mohammadi, Ethan Scott, Henry Nguyen, Karanveer
+ *
+ *
+ * [PURPOSE]
+ *
+ * This file provides the server mode behind "FerryFlow --server <socket>", so that every booking agent and gate on a machine shares one FerryFlow process (and one database file) instead of running their own.
+ * Clients connect to a Unix domain socket and speak the JSON-lines protocol of 'json_session.hpp': one request per line, one response line per request, in order.
+ *
+ * One thread multiplexes every client with epoll. It only moves bytes, and hands each request to a worker:
+ *
+ *     - Writes go to the single writer, which owns the one connection that writes. Concurrent bookings are therefore serialized in the process, and never wait on SQLITE_BUSY.
+ *       With group commit on, the writer groups the writes of every client, and answers them once their group is committed.
+ *     - Reads go to a pool of reader threads, which run them on the read connections of the same Database (see 'ConnectionProfile::read_connections'). In WAL mode readers never wait on the writer (or on each other), so reads scale with the cores.
+ *
+ * A client has one request in flight at a time (the next one is taken from its input once the previous one is answered). Its responses therefore keep their order, and a client always reads its own writes.
+ * Many clients are served at once, which is where the throughput comes from.
+ *
+ * NOTE (SAVIZ): Linux only (epoll and eventfd). Elsewhere 'open()' fails with an explanation.
+*/
+
+// ============================================================================
+// ============================================================================
+
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "database.hpp"
+#include "json.hpp"
+#include "json_session.hpp"
+
+// Controls how the server listens and how many readers it runs.
+struct ServerSettings
+{
+    std::string socket_path = "ferryflow.sock"; // Where the Unix domain socket is created.
+    int reader_count = 1;                       // Threads answering reads (at most one per read connection is ever busy).
+};
+
+// Counters describing a server run, filled in by 'Server::run()'.
+struct ServerStatistics
+{
+    long long connection_count = 0; // Clients accepted.
+    long long request_count = 0;    // Requests answered.
+};
+
+class Server
+{
+public:
+    // ----------------------------------------------------------------------------
+    explicit Server();
+
+    /*
+    *   [Description]
+    *   Constructor for the Server class.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    ~Server();
+
+    /*
+    *   [Description]
+    *   Destructor for the Server class, responsible for deallocating the object from memory. A server that is still open is closed.
+    *
+    *   [Return]
+    *   N/A
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+public:
+    // ----------------------------------------------------------------------------
+    void open(
+        Database* database,                 // [IN]  | The open database, with read connections (it must stay open until 'close()', and must not be used by anything else meanwhile).
+        const ServerSettings& settings,     // [IN]  | Where to listen, and how many readers to run.
+        bool& is_successful,                // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message        // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function starts the writer and the readers, and starts listening on the socket.
+    *   A socket file left behind by a server that is gone is replaced. One that a running server still listens on is not.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Unsupported platform>
+    *       If the platform has no epoll, the operation will terminate with a failure status and provide an appropriate error message.
+    *   @ <No read connections>
+    *       If the database was opened without read connections (the readers would then share the writing one), the operation will terminate with a failure status and provide an appropriate error message.
+    *   @ <Socket failure>
+    *       If the socket cannot be created (the path is too long, in use, or not writable), the operation will terminate with a failure status and provide an appropriate error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void run(
+        ServerStatistics& statistics,   // [OUT] | How many clients were accepted, and how many requests answered.
+        bool& is_successful,            // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message    // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function serves clients on the calling thread until 'requestStop()' is called.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   @ <Not open>
+    *       If 'open()' did not succeed, the operation will terminate with a failure status and provide an appropriate error message.
+    *   @ <Event failure>
+    *       If waiting for events fails, the operation will terminate with a failure status and provide the system's error message.
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void requestStop();
+
+    /*
+    *   [Description]
+    *   This function makes 'run()' return soon. It may be called from any thread, and from a signal handler.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+
+
+    // ----------------------------------------------------------------------------
+    void close(
+        bool& is_successful,            // [OUT] | The outcome status of the operation, indicating whether it was successful or not.
+        std::string& outcome_message    // [OUT] | A descriptive message explaining the result of the operation.
+        );
+
+    /*
+    *   [Description]
+    *   This function disconnects every client and removes the socket, and lets the writer and readers finish the requests they were given.
+    *   Whatever the writer still has grouped is committed. The database is left open, for its owner to cut.
+    *
+    *   [Return]
+    *   void
+    *
+    *   [Errors]
+    *   N/A
+    */
+    // ----------------------------------------------------------------------------
+
+private:
+    // A request handed to a worker, and its response once answered.
+    struct Job
+    {
+        unsigned long long client_key = 0;
+        std::string request;
+        std::string response;
+    };
+
+    // A queue of jobs, shared by the threads that take from it.
+    struct JobQueue
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<Job> jobs;
+        bool is_stopping = false;
+    };
+
+    // A connected client.
+    struct Client
+    {
+        int socket = -1;
+        std::string input;                  // Bytes read and not yet handed to a worker.
+        std::string output;                 // Bytes to send.
+        std::size_t output_offset = 0;      // How much of 'output' was sent.
+        bool is_busy = false;               // Whether a request of this client is with a worker.
+        bool is_peer_closed = false;        // Whether the client will send nothing more.
+        bool is_waiting_to_send = false;    // Whether the socket is watched for room to send.
+    };
+
+    // The threads that run requests.
+    void runWriter();
+    void runReader();
+
+    // Hands a finished job back to the event loop.
+    void complete(Job&& job);
+
+    // Takes a job from a queue, waiting until there is one. Returns false once the queue is stopping and empty.
+    static bool takeJob(JobQueue& queue, Job& job);
+
+    // Event loop steps.
+    void acceptClients(ServerStatistics& statistics);
+    void readFromClient(unsigned long long client_key);
+    void deliverCompletions(ServerStatistics& statistics);
+    void dispatchNextRequest(unsigned long long client_key);
+    void sendToClient(unsigned long long client_key);
+    void closeClient(unsigned long long client_key);
+
+private:
+    // A request line longer than this is refused (and its client disconnected), so that one client cannot exhaust memory.
+    static constexpr std::size_t sc_max_request_bytes = 1 << 20;
+
+    // The epoll keys of the listening socket and of the wake-up event. Clients count up from 'sc_first_client_key'.
+    static constexpr unsigned long long sc_listener_key = 0;
+    static constexpr unsigned long long sc_wake_key = 1;
+    static constexpr unsigned long long sc_first_client_key = 2;
+
+    bool m_is_open;
+    std::string m_socket_path;
+
+    int m_listener;
+    int m_epoll;
+    int m_wake_event;   // Signalled when jobs are completed or a stop is requested.
+
+    std::atomic<bool> m_is_stop_requested;
+
+    Database* m_database;
+
+    JobQueue m_writer_queue;
+    JobQueue m_reader_queue;
+    std::thread m_writer;
+    std::vector<std::thread> m_readers;
+
+    // Jobs answered by the workers, waiting for the event loop.
+    std::mutex m_completed_mutex;
+    std::vector<Job> m_completed_jobs;
+
+    // Used by the event loop only.
+    std::unordered_map<unsigned long long, Client> m_clients;
+    unsigned long long m_next_client_key;
+    JsonObject m_request;
+};
+
+#endif // SERVER_HPP
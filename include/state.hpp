@@ -30,6 +30,8 @@
 
 class StateManager;
 class Database;
+class AsyncDatabase;
+class CapacityEngine;
 
 class State
 {
@@ -73,7 +75,9 @@ public:
     // ----------------------------------------------------------------------------
     void init(
         StateManager* state_manager,
-        Database* database
+        Database* database,
+        AsyncDatabase* async_database,
+        CapacityEngine* capacity_engine
         );
 
     /*
@@ -149,6 +153,12 @@ protected:
 
     // A pointer to the 'Database', providing access to underlying database functionality.
     Database* m_database;
+
+    // A pointer to the 'AsyncDatabase', for work that can run while the operator keeps typing. May be 'nullptr' (e.g. for an in-memory database), in which case 'm_database' is used directly.
+    AsyncDatabase* m_async_database;
+
+    // A pointer to the 'CapacityEngine', which decides where vehicles fit and writes reservations through to 'm_database'.
+    CapacityEngine* m_capacity_engine;
 };
 
 #endif // STATE_HPP
@@ -36,6 +36,8 @@
 #include "boarding_state.hpp"
 
 class Database;
+class AsyncDatabase;
+class CapacityEngine;
 
 // An enum used to refer to each State when attempting to make a transition.
 enum class States
@@ -87,7 +89,9 @@ public:
 public:
     // ----------------------------------------------------------------------------
     void init(
-        Database* database // [IN] | A pointer to the database instance that each underlying State will require.
+        Database* database,              // [IN] | A pointer to the database instance that each underlying State will require.
+        AsyncDatabase* async_database,   // [IN] | A pointer to the asynchronous database instance for work that can overlap with input. (May be 'nullptr')
+        CapacityEngine* capacity_engine  // [IN] | A pointer to the loaded capacity engine that every reservation goes through.
         );
 
     /*
@@ -30,6 +30,7 @@
 #define UTILITIES_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <sstream>
 #include <limits>
@@ -41,15 +42,17 @@ namespace Utilities
 {
     std::string getLocalDateAndTime();
 
+    // Splits a "TTT-dd-hh" sailing ID (see 'SailingKey::parse()' to pack one instead).
     void extractSailingID(
-        std::string& sailing_id, 
+        std::string_view sailing_id, 
         std::string& terminal, 
         int& departure_day, 
         int& departure_hour
         ); 
 
+    // Writes the "TTT-dd-hh" sailing ID, the day and hour padded to 2 digits. Reusing 'output_sailing_id' allocates nothing.
     void createSailingID(
-        const std::string& terminal, 
+        std::string_view terminal, 
         const int departure_day, 
         const int departure_hour,
         std::string& output_sailing_id
@@ -60,6 +63,19 @@ namespace Utilities
         double second_number,
         double epsilon = std::numeric_limits<double>::epsilon()
         );
+
+    // Parses the whole text as a finite real number.
+    bool parseReal(
+        const std::string& text,
+        double& number
+        );
+
+    // Returns whether the number is within the range accepted by the prompts (bounds included, like 'promptForReal()').
+    bool isInRange(
+        double number,
+        double min,
+        double max
+        );
 }
 
 #endif // UTILITIES_HPP
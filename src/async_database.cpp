@@ -0,0 +1,284 @@
+#include "async_database.hpp"
+
+AsyncDatabase::AsyncDatabase() :
+    m_database(),
+    m_worker(),
+    m_mutex(),
+    m_condition(),
+    m_requests(),
+    m_is_stopping(false),
+    m_awaiting_commit()
+{
+}
+
+AsyncDatabase::~AsyncDatabase()
+{
+    if(m_worker.joinable())
+    {
+        bool is_successful = false;
+        std::string outcome_message = "";
+
+        cutConnection(is_successful, outcome_message);
+    }
+}
+
+void AsyncDatabase::openConnection(
+    const std::string& path,
+    const ConnectionProfile& profile,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    if(m_worker.joinable())
+    {
+        is_successful = false;
+        outcome_message = std::string("Connection request failed: ") + std::string("the worker's connection is already open.");
+
+        return;
+    }
+
+    m_is_stopping = false;
+    m_worker = std::thread(&AsyncDatabase::run, this);
+
+    // The connection is opened on the worker thread, which is the only one that will ever use it:
+    std::future<OperationResult> future = submit([path, profile](Database& database)
+    {
+        OperationResult result;
+
+        database.openConnection(path, profile, result.is_successful, result.outcome_message);
+
+        return(result);
+    });
+
+    OperationResult result = future.get();
+
+    is_successful = result.is_successful;
+    outcome_message = result.outcome_message;
+
+    if(!is_successful)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_is_stopping = true;
+        }
+
+        m_condition.notify_one();
+        m_worker.join();
+    }
+}
+
+void AsyncDatabase::cutConnection(
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    if(!m_worker.joinable())
+    {
+        is_successful = false;
+        outcome_message = std::string("Cut connection request failed: ") + std::string("the worker's connection is not open.");
+
+        return;
+    }
+
+    // Queued behind every earlier request, so all of them are finished first:
+    std::future<OperationResult> future = submit([](Database& database)
+    {
+        OperationResult result;
+
+        database.cutConnection(result.is_successful, result.outcome_message);
+
+        return(result);
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_is_stopping = true;
+    }
+
+    m_condition.notify_one();
+
+    OperationResult result = future.get();
+
+    m_worker.join();
+
+    is_successful = result.is_successful;
+    outcome_message = result.outcome_message;
+}
+
+std::future<OperationResult> AsyncDatabase::boardVehicle(
+    Sailing sailing,
+    Vehicle vehicle,
+    bool is_reserved
+    )
+{
+    // NOTE (SAVIZ): Not a plain 'submit()', since the promise may have to outlive the request (see 'settleAwaitingCommits()').
+    auto promise = std::make_shared<std::promise<OperationResult>>();
+
+    std::future<OperationResult> future = promise->get_future();
+
+    enqueue([this, promise, sailing, vehicle, is_reserved]() mutable
+    {
+        OperationResult result;
+
+        // NOTE (SAVIZ): Walk-up vehicles have no reservation yet. If one already exists this simply fails, which is fine since boarding is what matters:
+        if(!is_reserved)
+        {
+            Reservation reservation;
+
+            m_database.addReservation(sailing, vehicle, reservation, result.is_successful, result.outcome_message);
+
+            // The reservation may have filled (and so committed) a group that earlier boardings are waiting on:
+            settleAwaitingCommits();
+        }
+
+        m_database.completeBoarding(sailing, vehicle, result.is_successful, result.outcome_message);
+
+        if(result.is_successful && m_database.hasPendingWrites())
+        {
+            m_awaiting_commit.push_back(AwaitingCommit{ promise, result });
+
+            return;
+        }
+
+        settleAwaitingCommits();
+
+        promise->set_value(result);
+    });
+
+    return(future);
+}
+
+void AsyncDatabase::setGroupCommit(
+    const GroupCommitSettings& settings,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    std::future<OperationResult> future = submit([this, settings](Database& database)
+    {
+        OperationResult result;
+
+        database.setGroupCommit(settings, result.is_successful, result.outcome_message);
+
+        // Turning group commit on or off commits what was grouped so far:
+        settleAwaitingCommits();
+
+        return(result);
+    });
+
+    try
+    {
+        OperationResult result = future.get();
+
+        is_successful = result.is_successful;
+        outcome_message = result.outcome_message;
+    }
+
+    catch(const std::future_error&)
+    {
+        is_successful = false;
+        outcome_message = std::string("Group commit request failed: ") + std::string("the worker's connection is not open.");
+    }
+}
+
+void AsyncDatabase::run()
+{
+    while(true)
+    {
+        std::function<void()> request;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            auto has_work = [this]() { return(m_is_stopping || !m_requests.empty()); };
+
+            // An open group waits for more writes only until its deadline:
+            if(m_database.hasPendingWrites())
+            {
+                m_condition.wait_until(lock, m_database.getGroupCommitDeadline(), has_work);
+            }
+
+            else
+            {
+                m_condition.wait(lock, has_work);
+            }
+
+            if(m_requests.empty())
+            {
+                // The queue ran dry (the deadline passed, or we are stopping), so nothing else will join the group. Commit it:
+                if(m_database.hasPendingWrites())
+                {
+                    lock.unlock();
+
+                    bool is_successful = false;
+                    std::string outcome_message = "";
+
+                    m_database.flushGroupCommit(is_successful, outcome_message);
+
+                    settleAwaitingCommits();
+
+                    continue;
+                }
+
+                // Stop only once the queue is empty, so that no accepted request is lost:
+                return;
+            }
+
+            request = std::move(m_requests.front());
+            m_requests.pop_front();
+        }
+
+        request();
+
+        // Any request may end a group (including the cut, which commits it):
+        settleAwaitingCommits();
+    }
+}
+
+void AsyncDatabase::settleAwaitingCommits()
+{
+    if(m_awaiting_commit.empty() || m_database.hasPendingWrites())
+    {
+        return;
+    }
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    m_database.getLastGroupCommitOutcome(is_successful, outcome_message);
+
+    for(AwaitingCommit& awaiting_commit : m_awaiting_commit)
+    {
+        // The boarding itself went through, but it was lost with its group:
+        if(!is_successful)
+        {
+            awaiting_commit.result.is_successful = false;
+            awaiting_commit.result.outcome_message = std::string("Boarding failed: ") + outcome_message;
+        }
+
+        awaiting_commit.promise->set_value(awaiting_commit.result);
+    }
+
+    m_awaiting_commit.clear();
+}
+
+void AsyncDatabase::enqueue(
+    std::function<void()> request
+    )
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Nothing would run it. Dropping the request breaks its promise, which the caller sees through the future:
+        if(!m_worker.joinable() || m_is_stopping)
+        {
+            return;
+        }
+
+        m_requests.push_back(std::move(request));
+    }
+
+    m_condition.notify_one();
+}
@@ -8,8 +8,10 @@
 #include "input.hpp"
 #include "containers.hpp"
 #include "database.hpp"
+#include "async_database.hpp"
+#include "capacity_engine.hpp"
+#include "sailing_manifest.hpp"
 #include "global.hpp"
-#include "utilities.hpp"
 
 // static container for storing Vehicle info when creating a reservation
 static Vehicle s_vehicle;
@@ -20,6 +22,40 @@ static Sailing s_sailing;
 // static container for storing the users single character responses
 static char s_user_choice;
 
+// every reservation of the sailing being boarded, so that plates are looked up in memory
+static SailingManifest s_manifest;
+
+// the boarding still being committed by the AsyncDatabase (and the vehicle it is for), while the operator moves on to the next vehicle
+static std::future<OperationResult> s_pending_boarding;
+static Vehicle s_pending_vehicle;
+
+// waits for the pending boarding (if any) and prints how it went
+static void finishPendingBoarding(CapacityEngine* capacity_engine, Database* database)
+{
+    if (!s_pending_boarding.valid())
+    {
+        return;
+    }
+
+    OperationResult result = s_pending_boarding.get();
+
+    //the reservation (if one was made) was written on the AsyncDatabase's connection, so the capacity engine has to read it back
+    bool is_refreshed = false;
+    std::string refresh_message;
+    capacity_engine->refresh(*database, s_sailing, is_refreshed, refresh_message);
+
+    if (result.is_successful)
+    {
+        s_manifest.setBoarded(s_pending_vehicle);
+
+        std::cout << s_pending_vehicle.license_plate << ": Boarding completed!" << "\n\n";
+    }
+    else
+    {
+        std::cout << s_pending_vehicle.license_plate << ": " << result.outcome_message << "\n\n";
+    }
+}
+
 // ----------------------------------------------------------------------------
 BoardingState::BoardingState()
 {
@@ -45,16 +81,14 @@ void BoardingState::onProcess()
     std::string sailing_id;
     continuouslyPromptForString(
         "Please enter the ID of the sailing [TTT-dd-hh]: ",
-        std::regex(R"([A-Z]{3}-\d\d-\d\d)"),
+        g_sailing_id_pattern,
         sailing_id
     );
 
-    std::string terminal_id;
-    int departure_day;
-    int departure_hour;
-    Utilities::extractSailingID(sailing_id, terminal_id, departure_day, departure_hour);
+    SailingKey sailing_key;
+    SailingKey::parse(sailing_id, sailing_key);
 
-    m_database->getSailingByID(terminal_id, departure_day, departure_hour, s_sailing, g_is_successful, g_outcome_message);
+    m_database->getSailingByID(sailing_key, s_sailing, g_is_successful, g_outcome_message);
 
     if (!g_is_successful) 
     {
@@ -62,13 +96,24 @@ void BoardingState::onProcess()
         return;
     }
 
+    // one query for the whole sailing, instead of a few per vehicle
+    s_manifest.load(*m_database, s_sailing, g_is_successful, g_outcome_message);
+
+    if (!g_is_successful)
+    {
+        std::cout << "\n\n" << g_outcome_message << "\n\n";
+        return;
+    }
+
     startBoarding();
 }
 
 // ----------------------------------------------------------------------------
 void BoardingState::onExit()
 {
-    
+    finishPendingBoarding(m_capacity_engine, m_database);
+
+    s_manifest.clear();
 }
 
 // ----------------------------------------------------------------------------
@@ -81,67 +126,20 @@ void BoardingState::startBoarding()
         std::string license_plate;
         continuouslyPromptForString(
             "Please enter the license plate of the vehicle: ",
-            std::regex(R"([A-Z\d -]{2,10})"), //regex pattern : 2-10 capital letters, digits, spaces, hyphens
+            g_license_plate_pattern, //regex pattern : 2-10 capital letters, digits, spaces, hyphens
             license_plate
         );
 
-        // try to get vehicle info
-        m_database->getVehicleByID(license_plate, s_vehicle, g_is_successful, g_outcome_message);
+        const ManifestEntry* manifest_entry = s_manifest.find(license_plate);
 
-        // didnt find the vehicle, create a new one
-        if (!g_is_successful) 
+        // boarded already (by this session, or before it started): nothing to ask the database
+        if (manifest_entry != nullptr && manifest_entry->is_boarded)
         {
-#ifdef DEBUG_MODE
-            std::cout << "[DEBUG] didn't find vehicle record. Asking for information to create one." << std::endl;
-#endif
-
-            s_vehicle.license_plate = license_plate;
-            continuouslyPromptForString(
-                "Please enter the phone number of the owner: ",
-                std::regex(R"(\d{8,14})"), //regex pattern : 8-14 digits
-                s_vehicle.phone_number
-            );
-            continuouslyPromptForReal(
-                "Please enter the length of the vehicle [0-99.9]: ",
-                g_vehicle_min_length,
-                g_vehicle_max_length,
-                s_vehicle.length
-            );
-            continuouslyPromptForReal(
-                "Please enter the height of the vehicle [0-9.9]: ",
-                g_vehicle_min_height,
-                g_vehicle_max_height,
-                s_vehicle.height
-            );
-
-            //write vehicle to database so we can use it in a reservation
-            int vehicle_id;
-            m_database->addVehicle(s_vehicle, vehicle_id, g_is_successful, g_outcome_message);
-            s_vehicle.vehicle_id = vehicle_id; //since we didnt get s_vehicle from the database, we must fill in this
-                                               //value before using s_vehicle to create a reservation or board
-
-            if (!g_is_successful) //something went wrong, ask for vehicle info again
-            {
-                std::cout << g_outcome_message << "\n\n";
-                continue;
-            }
+            std::cout << "\n\n" << license_plate << ": Already boarded!" << "\n\n";
         }
-        std::cout << "\n\n";
-
-        //try to create a reservation for this vehicle and sailing in case it didnt exist.
-        //if one already exists then this will fail
-        m_database->addReservation(s_sailing, s_vehicle, g_is_successful, g_outcome_message);
-
-        //complete the boarding for this vehicle
-        m_database->completeBoarding(s_sailing, s_vehicle, g_is_successful, g_outcome_message);
-
-        if (g_is_successful) 
+        else if (!boardVehicle(license_plate, manifest_entry))
         {
-            std::cout << "Boarding completed!" << "\n\n";
-        }
-        else
-        {
-            std::cout << g_outcome_message << "\n\n";
+            continue;
         }
 
         promptForCharacter(
@@ -163,7 +161,106 @@ void BoardingState::startBoarding()
 
         if (user_wants_to_break)
         {
+            finishPendingBoarding(m_capacity_engine, m_database);
             break;
         }
     }
-}
\ No newline at end of file
+}
+
+// ----------------------------------------------------------------------------
+bool BoardingState::boardVehicle(const std::string& license_plate, const ManifestEntry* manifest_entry)
+{
+    // a reserved vehicle is already known from the manifest
+    if (manifest_entry != nullptr)
+    {
+        s_vehicle = manifest_entry->vehicle;
+        g_is_successful = true;
+    }
+    else
+    {
+        // try to get vehicle info
+        m_database->getVehicleByID(license_plate, s_vehicle, g_is_successful, g_outcome_message);
+    }
+
+    // didnt find the vehicle, create a new one
+    if (!g_is_successful) 
+    {
+#ifdef DEBUG_MODE
+        std::cout << "[DEBUG] didn't find vehicle record. Asking for information to create one." << std::endl;
+#endif
+
+        s_vehicle.license_plate = license_plate;
+        continuouslyPromptForString(
+            "Please enter the phone number of the owner: ",
+            g_phone_number_pattern, //regex pattern : 8-14 digits
+            s_vehicle.phone_number
+        );
+        continuouslyPromptForReal(
+            "Please enter the length of the vehicle [0-99.9]: ",
+            g_vehicle_min_length,
+            g_vehicle_max_length,
+            s_vehicle.length
+        );
+        continuouslyPromptForReal(
+            "Please enter the height of the vehicle [0-9.9]: ",
+            g_vehicle_min_height,
+            g_vehicle_max_height,
+            s_vehicle.height
+        );
+
+        //write vehicle to database so we can use it in a reservation
+        int vehicle_id;
+        m_database->addVehicle(s_vehicle, vehicle_id, g_is_successful, g_outcome_message);
+        s_vehicle.vehicle_id = vehicle_id; //since we didnt get s_vehicle from the database, we must fill in this
+                                           //value before using s_vehicle to create a reservation or board
+
+        if (!g_is_successful) //something went wrong, ask for vehicle info again
+        {
+            std::cout << g_outcome_message << "\n\n";
+            return(false);
+        }
+    }
+    std::cout << "\n\n";
+
+    if (m_async_database != nullptr)
+    {
+        //the previous vehicle was committed while this one was being entered, so report it before queueing this one
+        finishPendingBoarding(m_capacity_engine, m_database);
+
+        //reserve (in case it didnt exist) and board in the background, so the next plate can be typed right away
+        s_pending_boarding = m_async_database->boardVehicle(s_sailing, s_vehicle, manifest_entry != nullptr);
+        s_pending_vehicle = s_vehicle;
+    }
+    else
+    {
+        //try to create a reservation for this vehicle and sailing in case it didnt exist (the manifest knows of those that do).
+        if (manifest_entry == nullptr)
+        {
+            Reservation reservation;
+            CapacityDecision decision;
+
+            m_capacity_engine->decide(s_sailing.sailing_id, s_vehicle.length, s_vehicle.height, decision, g_is_successful, g_outcome_message);
+
+            if (g_is_successful)
+            {
+                m_capacity_engine->reserve(*m_database, decision, s_sailing, s_vehicle, reservation, g_is_successful, g_outcome_message);
+            }
+        }
+
+        //complete the boarding for this vehicle (the only query a reserved vehicle costs)
+        m_database->completeBoarding(s_sailing, s_vehicle, g_is_successful, g_outcome_message);
+
+        if (g_is_successful) 
+        {
+            s_manifest.setBoarded(s_vehicle);
+
+            std::cout << "Boarding completed!" << "\n\n";
+        }
+        else
+        {
+            std::cout << g_outcome_message << "\n\n";
+        }
+    }
+
+    return(true);
+}
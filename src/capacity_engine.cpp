@@ -0,0 +1,311 @@
+#include <algorithm>
+#include "capacity_engine.hpp"
+#include "database.hpp"
+
+CapacityEngine::CapacityEngine() :
+    m_sailings(),
+    m_schedules(),
+    m_last_version(0)
+{
+}
+
+CapacityEngine::~CapacityEngine()
+{
+}
+
+void CapacityEngine::load(
+    Database& database,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    m_sailings.clear();
+    m_schedules.clear();
+
+    RowCursor<SailingReportView> cursor;
+
+    database.openSailingReportCursor(cursor, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    // NOTE (SAVIZ): The cursor walks the sailings in departure order, so each terminal's index is filled in order and built once at the end.
+    for(const SailingReportView& report : cursor)
+    {
+        std::uint16_t schedule_index = findSchedule(std::string(report.departure_terminal));
+
+        m_schedules[schedule_index].append(report.sailing_id, report.departure_day, report.departure_hour, report.low_remaining_length, report.high_remaining_length);
+
+        m_sailings.push_back(SailingCapacity{ report.sailing_id, ++m_last_version, report.low_remaining_length, report.high_remaining_length, schedule_index, static_cast<std::uint8_t>(report.departure_day), static_cast<std::uint8_t>(report.departure_hour) });
+    }
+
+    cursor.getOutcome(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        m_sailings.clear();
+        m_schedules.clear();
+
+        return;
+    }
+
+    for(ScheduleIndex& schedule : m_schedules)
+    {
+        schedule.build();
+    }
+
+    // Lookups are by ID:
+    std::sort(m_sailings.begin(), m_sailings.end(), [](const SailingCapacity& left, const SailingCapacity& right) { return(left.sailing_id < right.sailing_id); });
+
+    is_successful = true;
+    outcome_message = std::string("Capacity loaded for ") + std::to_string(m_sailings.size()) + " sailing(s)";
+}
+
+void CapacityEngine::decide(
+    int sailing_id,
+    double length,
+    double height,
+    CapacityDecision& decision,
+    bool& is_successful,
+    std::string& outcome_message
+    ) const
+{
+    const SailingCapacity* capacity = findSailing(sailing_id);
+
+    if(capacity == nullptr)
+    {
+        is_successful = false;
+        outcome_message = std::string("Capacity check failed: ") + std::string("Record does not exist!");
+
+        return;
+    }
+
+    // NOTE (SAVIZ): This must stay in step with 'DatabaseQueries::c_insert_reservation', otherwise the lane chosen here and the one written by the database would differ.
+    // A lane takes the vehicle only with room for its 0.5 meter gap as well, so an exact fit never leaves it below zero:
+    bool fits_low_lane = height <= 2.0 && capacity->low_remaining_length >= length + 0.5;
+    bool fits_high_lane = capacity->high_remaining_length >= length + 0.5;
+
+    decision.sailing_id = sailing_id;
+    decision.fits = fits_low_lane || fits_high_lane;
+    decision.is_low_lane = fits_low_lane;
+    decision.version = capacity->version;
+
+    is_successful = true;
+    outcome_message = "";
+}
+
+void CapacityEngine::reserve(
+    Database& database,
+    const CapacityDecision& decision,
+    Sailing& sailing,
+    Vehicle vehicle,
+    Reservation& reservation,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // 1) Refuse decisions that no longer describe the sailing:
+    const SailingCapacity* capacity = findSailing(decision.sailing_id);
+
+    if(capacity == nullptr || decision.sailing_id != sailing.sailing_id || capacity->version != decision.version)
+    {
+        is_successful = false;
+        outcome_message = std::string("Reservation creation failed: ") + std::string("the sailing changed since its capacity was checked, please try again.");
+
+        return;
+    }
+
+    if(!decision.fits)
+    {
+        is_successful = false;
+        outcome_message = std::string("Reservation creation failed: ") + std::string("not enough space on sailing.");
+
+        return;
+    }
+
+    // 2) Write through. The database checks the space again against what is committed:
+    database.addReservation(sailing, vehicle, reservation, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        // Another connection may have taken the space, so the next decision should not be made on our old numbers:
+        bool is_refreshed = false;
+        std::string refresh_message = "";
+
+        refresh(database, sailing, is_refreshed, refresh_message);
+
+        return;
+    }
+
+    // 3) Keep what was committed:
+    storeSailing(sailing.sailing_id, sailing.departure_terminal, sailing.departure_day, sailing.departure_hour, sailing.low_remaining_length, sailing.high_remaining_length);
+}
+
+void CapacityEngine::refresh(
+    Database& database,
+    const Sailing& sailing,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    Sailing stored_sailing;
+
+    database.getSailingByID(sailing.departure_terminal, sailing.departure_day, sailing.departure_hour, stored_sailing, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    storeSailing(stored_sailing.sailing_id, stored_sailing.departure_terminal, stored_sailing.departure_day, stored_sailing.departure_hour, stored_sailing.low_remaining_length, stored_sailing.high_remaining_length);
+
+    is_successful = true;
+    outcome_message = std::string("Capacity refreshed");
+}
+
+void CapacityEngine::forget(
+    int sailing_id
+    )
+{
+    auto position = std::lower_bound(m_sailings.begin(), m_sailings.end(), sailing_id, [](const SailingCapacity& capacity, int id) { return(capacity.sailing_id < id); });
+
+    if(position != m_sailings.end() && position->sailing_id == sailing_id)
+    {
+        m_schedules[position->schedule_index].erase(position->departure_day, position->departure_hour);
+
+        m_sailings.erase(position);
+    }
+}
+
+void CapacityEngine::findAvailableSailings(
+    const std::string& departure_terminal,
+    int from_day,
+    int from_hour,
+    double length,
+    double height,
+    int count,
+    std::vector<AvailableSailing>& sailings,
+    bool& is_successful,
+    std::string& outcome_message
+    ) const
+{
+    sailings.clear();
+
+    std::vector<int> sailing_ids;
+
+    for(const ScheduleIndex& schedule : m_schedules)
+    {
+        if(schedule.getDepartureTerminal() == departure_terminal)
+        {
+            schedule.findAvailable(from_day, from_hour, length, height, count, sailing_ids);
+
+            break;
+        }
+    }
+
+    if(sailing_ids.empty())
+    {
+        is_successful = false;
+        outcome_message = std::string("Available sailings retrieval failed: ") + std::string("No records available!");
+
+        return;
+    }
+
+    sailings.reserve(sailing_ids.size());
+
+    for(int sailing_id : sailing_ids)
+    {
+        const SailingCapacity* capacity = findSailing(sailing_id);
+
+        AvailableSailing sailing;
+
+        sailing.sailing_id = sailing_id;
+        sailing.departure_day = capacity->departure_day;
+        sailing.departure_hour = capacity->departure_hour;
+        sailing.is_low_lane = height <= 2.0 && capacity->low_remaining_length >= length + 0.5;
+        sailing.low_remaining_length = capacity->low_remaining_length;
+        sailing.high_remaining_length = capacity->high_remaining_length;
+
+        sailings.push_back(sailing);
+    }
+
+    is_successful = true;
+    outcome_message = std::string("Available sailings retrieval succeeded");
+}
+
+std::size_t CapacityEngine::getSailingCount() const
+{
+    return(m_sailings.size());
+}
+
+const CapacityEngine::SailingCapacity* CapacityEngine::findSailing(
+    int sailing_id
+    ) const
+{
+    auto position = std::lower_bound(m_sailings.begin(), m_sailings.end(), sailing_id, [](const SailingCapacity& capacity, int id) { return(capacity.sailing_id < id); });
+
+    if(position == m_sailings.end() || position->sailing_id != sailing_id)
+    {
+        return(nullptr);
+    }
+
+    return(&*position);
+}
+
+CapacityEngine::SailingCapacity* CapacityEngine::findSailing(
+    int sailing_id
+    )
+{
+    return(const_cast<SailingCapacity*>(static_cast<const CapacityEngine*>(this)->findSailing(sailing_id)));
+}
+
+void CapacityEngine::storeSailing(
+    int sailing_id,
+    const std::string& departure_terminal,
+    int departure_day,
+    int departure_hour,
+    double low_remaining_length,
+    double high_remaining_length
+    )
+{
+    SailingCapacity* capacity = findSailing(sailing_id);
+
+    if(capacity != nullptr)
+    {
+        capacity->version = ++m_last_version;
+        capacity->low_remaining_length = low_remaining_length;
+        capacity->high_remaining_length = high_remaining_length;
+
+        m_schedules[capacity->schedule_index].update(capacity->departure_day, capacity->departure_hour, low_remaining_length, high_remaining_length);
+
+        return;
+    }
+
+    // A new sailing (IDs only grow, so this is nearly always an append):
+    std::uint16_t schedule_index = findSchedule(departure_terminal);
+
+    m_schedules[schedule_index].insert(sailing_id, departure_day, departure_hour, low_remaining_length, high_remaining_length);
+
+    auto position = std::lower_bound(m_sailings.begin(), m_sailings.end(), sailing_id, [](const SailingCapacity& capacity, int id) { return(capacity.sailing_id < id); });
+
+    m_sailings.insert(position, SailingCapacity{ sailing_id, ++m_last_version, low_remaining_length, high_remaining_length, schedule_index, static_cast<std::uint8_t>(departure_day), static_cast<std::uint8_t>(departure_hour) });
+}
+
+std::uint16_t CapacityEngine::findSchedule(
+    const std::string& departure_terminal
+    )
+{
+    for(std::size_t index = 0; index < m_schedules.size(); ++index)
+    {
+        if(m_schedules[index].getDepartureTerminal() == departure_terminal)
+        {
+            return(static_cast<std::uint16_t>(index));
+        }
+    }
+
+    m_schedules.push_back(ScheduleIndex(departure_terminal));
+
+    return(static_cast<std::uint16_t>(m_schedules.size() - 1));
+}
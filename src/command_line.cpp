@@ -0,0 +1,591 @@
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include "command_line.hpp"
+
+// Removes leading and trailing white space.
+static std::string trim(
+    const std::string& text
+    )
+{
+    const char* white_space = " \t\r\n";
+
+    std::size_t first = text.find_first_not_of(white_space);
+
+    if(first == std::string::npos)
+    {
+        return("");
+    }
+
+    std::size_t last = text.find_last_not_of(white_space);
+
+    return(text.substr(first, last - first + 1));
+}
+
+// Returns the lower case version of the text.
+static std::string toLower(
+    const std::string& text
+    )
+{
+    std::string lower_text = text;
+
+    std::transform(lower_text.begin(), lower_text.end(), lower_text.begin(), [](unsigned char character) { return(static_cast<char>(std::tolower(character))); });
+
+    return(lower_text);
+}
+
+// Parses the whole text as a number (no remainder allowed), in the same way as the input module.
+template<typename Number>
+static bool parseNumber(
+    const std::string& text,
+    Number& number
+    )
+{
+    std::stringstream string_stream(text);
+    char remainder = '\0';
+
+    return((string_stream >> number) && !(string_stream >> remainder));
+}
+
+// Splits a "key=value" pair.
+static bool splitKeyValue(
+    const std::string& text,
+    std::string& key,
+    std::string& value
+    )
+{
+    std::size_t separator = text.find('=');
+
+    if(separator == std::string::npos)
+    {
+        return(false);
+    }
+
+    key = trim(text.substr(0, separator));
+    value = trim(text.substr(separator + 1));
+
+    return(!key.empty());
+}
+
+void parseCommandLine(
+    int argc,
+    char* argv[],
+    CommandLineOptions& options,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    for(int index = 1; index < argc; ++index)
+    {
+        std::string flag = argv[index];
+        std::string value;
+        bool has_inline_value = false;
+
+        // Accept both "--flag value" and "--flag=value":
+        std::size_t separator = flag.find('=');
+
+        if(flag.rfind("--", 0) == 0 && separator != std::string::npos)
+        {
+            value = flag.substr(separator + 1);
+            flag = flag.substr(0, separator);
+            has_inline_value = true;
+        }
+
+        // Flags without a value:
+        // ****************************************************************************
+
+        if(flag == "--help" || flag == "-h")
+        {
+            options.show_usage = true;
+
+            continue;
+        }
+
+        if(flag == "--json")
+        {
+            options.json_mode = true;
+
+            continue;
+        }
+
+        if(flag == "--plate-filter")
+        {
+            options.use_plate_filter = true;
+
+            continue;
+        }
+
+        if(flag == "--show-profile")
+        {
+            options.show_connection_profile = true;
+
+            continue;
+        }
+
+        // Flags with a value:
+        // ****************************************************************************
+
+        bool is_known_flag =
+            flag == "--database" ||
+            flag == "--entity-cache" ||
+            flag == "--group-commit" ||
+            flag == "--import" ||
+            flag == "--import-threads" ||
+            flag == "--profile" ||
+            flag == "--profile-file" ||
+            flag == "--report" ||
+            flag == "--report-threads" ||
+            flag == "--script" ||
+            flag == "--server" ||
+            flag == "--server-readers" ||
+            flag == "--set";
+
+        if(!is_known_flag)
+        {
+            is_successful = false;
+            outcome_message = std::string("Invalid arguments: ") + "unknown flag '" + argv[index] + "'.";
+
+            return;
+        }
+
+        if(!has_inline_value)
+        {
+            if(index + 1 >= argc)
+            {
+                is_successful = false;
+                outcome_message = std::string("Invalid arguments: ") + "missing value for '" + flag + "'.";
+
+                return;
+            }
+
+            value = argv[++index];
+        }
+
+        if(flag == "--database")
+        {
+            options.database_path = value;
+            is_successful = true;
+        }
+
+        else if(flag == "--group-commit")
+        {
+            // "<operations>,<milliseconds>":
+            std::size_t comma = value.find(',');
+
+            GroupCommitSettings group_commit;
+
+            if(comma == std::string::npos ||
+               !parseNumber(trim(value.substr(0, comma)), group_commit.max_operations) ||
+               !parseNumber(trim(value.substr(comma + 1)), group_commit.max_delay_milliseconds) ||
+               group_commit.max_operations < 1 ||
+               group_commit.max_delay_milliseconds < 0)
+            {
+                is_successful = false;
+                outcome_message = std::string("Invalid arguments: ") + "'--group-commit' expects <operations>,<milliseconds>, got '" + value + "'.";
+
+                return;
+            }
+
+            options.group_commit = group_commit;
+            is_successful = true;
+        }
+
+        else if(flag == "--entity-cache")
+        {
+            // "<vehicles>,<sailings>":
+            std::size_t comma = value.find(',');
+
+            EntityCacheSettings entity_cache = options.entity_cache;
+
+            if(comma == std::string::npos ||
+               !parseNumber(trim(value.substr(0, comma)), entity_cache.vehicle_capacity) ||
+               !parseNumber(trim(value.substr(comma + 1)), entity_cache.sailing_capacity) ||
+               entity_cache.vehicle_capacity < 0 ||
+               entity_cache.sailing_capacity < 0)
+            {
+                is_successful = false;
+                outcome_message = std::string("Invalid arguments: ") + "'--entity-cache' expects <vehicles>,<sailings>, got '" + value + "'.";
+
+                return;
+            }
+
+            options.entity_cache = entity_cache;
+            is_successful = true;
+        }
+
+        else if(flag == "--import")
+        {
+            // May be given more than once, the files are imported in order:
+            options.import_paths.push_back(value);
+            is_successful = true;
+        }
+
+        else if(flag == "--import-threads")
+        {
+            if(!parseNumber(trim(value), options.import_thread_count) || options.import_thread_count < 1)
+            {
+                is_successful = false;
+                outcome_message = std::string("Invalid arguments: ") + "'--import-threads' expects a positive number, got '" + value + "'.";
+
+                return;
+            }
+
+            is_successful = true;
+        }
+
+        else if(flag == "--script")
+        {
+            options.script_path = value;
+            is_successful = true;
+        }
+
+        else if(flag == "--server")
+        {
+            options.server_socket_path = value;
+            is_successful = true;
+        }
+
+        else if(flag == "--server-readers")
+        {
+            if(!parseNumber(trim(value), options.server_reader_count) || options.server_reader_count < 1)
+            {
+                is_successful = false;
+                outcome_message = std::string("Invalid arguments: ") + "'--server-readers' expects a positive number, got '" + value + "'.";
+
+                return;
+            }
+
+            is_successful = true;
+        }
+
+        else if(flag == "--report")
+        {
+            std::string partitioning = toLower(trim(value));
+
+            if(partitioning != "terminal" && partitioning != "days")
+            {
+                is_successful = false;
+                outcome_message = std::string("Invalid arguments: ") + "'--report' expects 'terminal' or 'days', got '" + value + "'.";
+
+                return;
+            }
+
+            options.report_partitioning = partitioning;
+            is_successful = true;
+        }
+
+        else if(flag == "--report-threads")
+        {
+            if(!parseNumber(trim(value), options.report_thread_count) || options.report_thread_count < 1)
+            {
+                is_successful = false;
+                outcome_message = std::string("Invalid arguments: ") + "'--report-threads' expects a positive number, got '" + value + "'.";
+
+                return;
+            }
+
+            is_successful = true;
+        }
+
+        else if(flag == "--profile")
+        {
+            selectConnectionProfile(value, options.connection_profile, is_successful, outcome_message);
+
+            // A built-in profile replaces every setting, and only "terminal" chooses a busy timeout:
+            options.is_busy_timeout_given = options.connection_profile.busy_timeout != 0;
+        }
+
+        else if(flag == "--profile-file")
+        {
+            // A file can never set a negative timeout, so one left in place means the file did not set it:
+            int busy_timeout = options.connection_profile.busy_timeout;
+
+            options.connection_profile.busy_timeout = -1;
+
+            loadConnectionProfile(value, options.connection_profile, is_successful, outcome_message);
+
+            if(options.connection_profile.busy_timeout < 0)
+            {
+                options.connection_profile.busy_timeout = busy_timeout;
+            }
+
+            else
+            {
+                options.is_busy_timeout_given = true;
+            }
+        }
+
+        else if(flag == "--set")
+        {
+            std::string key;
+            std::string setting_value;
+
+            if(!splitKeyValue(value, key, setting_value))
+            {
+                is_successful = false;
+                outcome_message = std::string("Invalid arguments: ") + "'--set' expects key=value, got '" + value + "'.";
+
+                return;
+            }
+
+            setConnectionProfileValue(key, setting_value, options.connection_profile, is_successful, outcome_message);
+
+            if(toLower(key) == "busy_timeout")
+            {
+                options.is_busy_timeout_given = true;
+            }
+        }
+
+        if(!is_successful)
+        {
+            return;
+        }
+    }
+
+    is_successful = true;
+    outcome_message = std::string("Command line parsed");
+}
+
+void selectConnectionProfile(
+    const std::string& profile_name,
+    ConnectionProfile& profile,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    std::string name = toLower(profile_name);
+
+    if(name == "default")
+    {
+        profile = ConnectionProfile();
+    }
+
+    else if(name == "terminal")
+    {
+        // NOTE (SAVIZ): In WAL mode, synchronous=NORMAL only syncs at checkpoints, so a commit no longer pays a full fsync while staying safe against corruption.
+        profile = ConnectionProfile();
+        profile.journal_mode = "WAL";
+        profile.synchronous = "NORMAL";
+        profile.cache_size = -16000;        // 16 MiB page cache
+        profile.mmap_size = 268435456;      // 256 MiB memory-mapped reads
+        profile.temp_store = "MEMORY";
+        profile.foreign_keys = true;
+        profile.busy_timeout = 5000;
+    }
+
+    else
+    {
+        is_successful = false;
+        outcome_message = std::string("Unknown profile! ") + "Expected 'default' or 'terminal', got '" + profile_name + "'.";
+
+        return;
+    }
+
+    is_successful = true;
+    outcome_message = std::string("Profile selected: ") + name;
+}
+
+void loadConnectionProfile(
+    const std::string& path,
+    ConnectionProfile& profile,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    std::ifstream file(path);
+
+    if(!file.is_open())
+    {
+        is_successful = false;
+        outcome_message = std::string("Load profile failed: ") + "could not open '" + path + "'.";
+
+        return;
+    }
+
+    std::string line;
+    int line_number = 0;
+
+    while(std::getline(file, line))
+    {
+        ++line_number;
+
+        line = trim(line);
+
+        // Skip blank lines and comments:
+        if(line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        std::string key;
+        std::string value;
+
+        if(!splitKeyValue(line, key, value))
+        {
+            is_successful = false;
+            outcome_message = std::string("Load profile failed: ") + path + ":" + std::to_string(line_number) + " is not of the form 'key = value'.";
+
+            return;
+        }
+
+        if(toLower(key) == "profile")
+        {
+            selectConnectionProfile(value, profile, is_successful, outcome_message);
+        }
+
+        else
+        {
+            setConnectionProfileValue(key, value, profile, is_successful, outcome_message);
+        }
+
+        if(!is_successful)
+        {
+            outcome_message = std::string("Load profile failed: ") + path + ":" + std::to_string(line_number) + ": " + outcome_message;
+
+            return;
+        }
+    }
+
+    is_successful = true;
+    outcome_message = std::string("Load profile succeeded");
+}
+
+void setConnectionProfileValue(
+    const std::string& key,
+    const std::string& value,
+    ConnectionProfile& profile,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    std::string setting = toLower(key);
+
+    bool is_valid_value = true;
+
+    if(setting == "journal_mode")
+    {
+        profile.journal_mode = value;
+    }
+
+    else if(setting == "synchronous")
+    {
+        profile.synchronous = value;
+    }
+
+    else if(setting == "temp_store")
+    {
+        profile.temp_store = value;
+    }
+
+    else if(setting == "cache_size")
+    {
+        is_valid_value = parseNumber(value, profile.cache_size);
+    }
+
+    else if(setting == "mmap_size")
+    {
+        is_valid_value = parseNumber(value, profile.mmap_size) && profile.mmap_size >= 0;
+    }
+
+    else if(setting == "busy_timeout")
+    {
+        is_valid_value = parseNumber(value, profile.busy_timeout) && profile.busy_timeout >= 0;
+    }
+
+    else if(setting == "read_connections")
+    {
+        is_valid_value = parseNumber(value, profile.read_connections) && profile.read_connections >= 0;
+    }
+
+    else if(setting == "foreign_keys")
+    {
+        std::string flag = toLower(value);
+
+        if(flag == "on" || flag == "true" || flag == "1")
+        {
+            profile.foreign_keys = true;
+        }
+
+        else if(flag == "off" || flag == "false" || flag == "0")
+        {
+            profile.foreign_keys = false;
+        }
+
+        else
+        {
+            is_valid_value = false;
+        }
+    }
+
+    else
+    {
+        is_successful = false;
+        outcome_message = std::string("Unknown setting '") + key + "'.";
+
+        return;
+    }
+
+    if(!is_valid_value)
+    {
+        is_successful = false;
+        outcome_message = std::string("Invalid value '") + value + "' for setting '" + key + "'.";
+
+        return;
+    }
+
+    is_successful = true;
+    outcome_message = "";
+}
+
+std::string getUsage()
+{
+    return(
+        "Usage: FerryFlow [options]\n"
+        "\n"
+        "  --database <path>        Database file to open (default: database.db).\n"
+        "  --profile <name>         Built-in connection profile: 'default' or 'terminal'.\n"
+        "  --profile-file <path>    Apply the 'key = value' settings found in a file.\n"
+        "  --set <key>=<value>      Override one setting: journal_mode, synchronous, cache_size,\n"
+        "                           mmap_size, temp_store, foreign_keys, busy_timeout,\n"
+        "                           read_connections.\n"
+        "  --group-commit <n>,<ms>  Commit boardings in groups of up to <n>, waiting at most <ms>\n"
+        "                           milliseconds for a group to fill (off by default).\n"
+        "  --entity-cache <v>,<s>   Keep up to <v> vehicles and <s> sailings (and the vessel catalog)\n"
+        "                           in memory for lookups, e.g. 4096,1024 (off by default).\n"
+        "  --plate-filter           Rule out unknown license plates in memory (a Bloom filter kept in\n"
+        "                           <database>.plates between runs) before querying (off by default).\n"
+        "  --import <path>          Import the vessels, sailings, vehicles and reservations of a CSV\n"
+        "                           file, then exit (may be given more than once).\n"
+        "  --import-threads <n>     Threads parsing each import file (default: one per core).\n"
+        "  --script <path>          Run the commands of a script (\"-\" for the standard input)\n"
+        "                           instead of showing the menus, then exit.\n"
+        "  --json                   Answer JSON requests (one per line) from the standard input on\n"
+        "                           the standard output instead of showing the menus.\n"
+        "  --server <socket>        Answer JSON requests from many clients on a Unix domain socket\n"
+        "                           instead of showing the menus, until interrupted (WAL journal).\n"
+        "  --server-readers <n>     Read connections of the server (default: one per core).\n"
+        "  --report <terminal|days> Print the end-of-day report, read in parallel by terminal or by\n"
+        "                           range of days, then exit (WAL journal).\n"
+        "  --report-threads <n>     Workers reading the report (default: one per core).\n"
+        "  --show-profile           Print the connection settings in effect after start-up (a busy\n"
+        "                           timeout that was not set defaults to 5000 milliseconds).\n"
+        "  --help                   Print this text and exit.\n"
+        );
+}
+
+std::string describeConnectionProfile(
+    const ConnectionProfile& profile
+    )
+{
+    return(
+        "journal_mode=" + profile.journal_mode +
+        " synchronous=" + profile.synchronous +
+        " cache_size=" + std::to_string(profile.cache_size) +
+        " mmap_size=" + std::to_string(profile.mmap_size) +
+        " temp_store=" + profile.temp_store +
+        " foreign_keys=" + (profile.foreign_keys ? "ON" : "OFF") +
+        " busy_timeout=" + std::to_string(profile.busy_timeout) +
+        " read_connections=" + std::to_string(profile.read_connections)
+        );
+}
@@ -1,9 +1,32 @@
 #include <iostream>
+#include <algorithm>
+#include <cctype>
 #include "database.hpp"
+#include "database_queries.hpp"
+#include "packed_key.hpp"
+#include "utilities.hpp"
 
 // WARNING (SAVIZ): When using 'sqlite3_prepare_v2()' with 'nullptr' as the final parameter transactions will not work because it counts as multiple statements. If you wish to use this with multiple statements, then you need to bind to a call-back and loop thourgh it.
 
-Database::Database() : m_sqlite3(nullptr)
+Database::Database() :
+    m_sqlite3(nullptr),
+    m_prepared_statements(),
+    m_statement_cache_statistics(),
+    m_lent_statements(),
+    m_group_commit_settings(),
+    m_is_group_open(false),
+    m_group_operation_count(0),
+    m_group_deadline(),
+    m_last_group_is_successful(true),
+    m_last_group_outcome_message(""),
+    m_writing_thread(),
+    m_entity_cache(nullptr),
+    m_is_entity_write_open(false),
+    m_entity_write_generation(0),
+    m_plate_filter(nullptr),
+    m_read_connections(),
+    m_read_pool_mutex(),
+    m_read_pool_condition()
 {
 #ifdef DEBUG_MODE
     std::cout << "Constructor called: Database()" << "\n";
@@ -15,10 +38,141 @@ Database::~Database()
 #ifdef DEBUG_MODE
     std::cout << "Destructor called: ~Database()" << "\n";
 #endif
+
+    // NOTE: Statements keep the connection alive, so any that are left over (if 'cutConnection()' was never called) must be freed here.
+    finalizeStatements();
+
+    // Writes still uncommitted are rolled back by the close, so the cache can take new reads again:
+    endEntityWrite();
+
+    // The read connections are ours alone, so they are closed as well:
+    for(std::unique_ptr<ReadConnection>& read_connection : m_read_connections)
+    {
+        for(auto& [sql_query, prepared_sql_statement] : read_connection->prepared_statements)
+        {
+            sqlite3_finalize(prepared_sql_statement);
+        }
+
+        sqlite3_close(read_connection->handle);
+    }
+}
+
+// Returns the upper case version of a PRAGMA keyword so that user supplied settings are case insensitive.
+static std::string toUpperKeyword(
+    const std::string& keyword
+    )
+{
+    std::string upper_keyword = keyword;
+
+    std::transform(upper_keyword.begin(), upper_keyword.end(), upper_keyword.begin(), [](unsigned char character) { return(static_cast<char>(std::toupper(character))); });
+
+    return(upper_keyword);
+}
+
+// Returns whether the keyword is present in the list of accepted PRAGMA values.
+static bool isAcceptedKeyword(
+    const std::string& keyword,
+    const std::vector<std::string>& accepted_keywords
+    )
+{
+    return(std::find(accepted_keywords.begin(), accepted_keywords.end(), toUpperKeyword(keyword)) != accepted_keywords.end());
+}
+
+// Runs a single PRAGMA query and returns the first column of its first row as text.
+static int queryPragma(
+    sqlite3* connection,
+    const char* sql_query,
+    std::string& value
+    )
+{
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    int return_code = sqlite3_prepare_v2(connection, sql_query, -1, &prepared_sql_statement, nullptr);
+
+    if(return_code != SQLITE_OK)
+    {
+        return(return_code);
+    }
+
+    return_code = sqlite3_step(prepared_sql_statement);
+
+    if(return_code == SQLITE_ROW)
+    {
+        const unsigned char* value_column_data = sqlite3_column_text(prepared_sql_statement, 0);
+
+        value = value_column_data ? reinterpret_cast<const char*>(value_column_data) : "";
+        return_code = SQLITE_OK;
+    }
+
+    // Some PRAGMAs return no row at all when the setting does not apply (e.g. 'mmap_size' on an in-memory database):
+    else if(return_code == SQLITE_DONE)
+    {
+        value = "";
+        return_code = SQLITE_OK;
+    }
+
+    sqlite3_finalize(prepared_sql_statement);
+
+    return(return_code);
+}
+
+// Puts an import query together: the head, the row placeholder once per row (comma separated), and the tail (see 'DatabaseQueries::c_import_batch_rows').
+static std::string buildImportQuery(
+    const char* head,
+    const char* row,
+    const char* tail,
+    int row_count
+    )
+{
+    std::string sql_query = head;
+
+    for(int index = 0; index < row_count; ++index)
+    {
+        sql_query += (index == 0 ? "" : ", ");
+        sql_query += row;
+    }
+
+    sql_query += tail;
+
+    return(sql_query);
+}
+
+// NOTE (SAVIZ): Built once, so that their text keeps the same address for the statement cache.
+static const std::string s_import_vessels_batch = buildImportQuery(DatabaseQueries::c_import_vessels_head, DatabaseQueries::c_import_vessels_row, DatabaseQueries::c_import_vessels_tail, DatabaseQueries::c_import_batch_rows);
+static const std::string s_import_vessels_row = buildImportQuery(DatabaseQueries::c_import_vessels_head, DatabaseQueries::c_import_vessels_row, DatabaseQueries::c_import_vessels_tail, 1);
+static const std::string s_import_sailings_batch = buildImportQuery(DatabaseQueries::c_import_sailings_head, DatabaseQueries::c_import_sailings_row, DatabaseQueries::c_import_sailings_tail, DatabaseQueries::c_import_batch_rows);
+static const std::string s_import_sailings_row = buildImportQuery(DatabaseQueries::c_import_sailings_head, DatabaseQueries::c_import_sailings_row, DatabaseQueries::c_import_sailings_tail, 1);
+static const std::string s_import_vehicles_batch = buildImportQuery(DatabaseQueries::c_import_vehicles_head, DatabaseQueries::c_import_vehicles_row, DatabaseQueries::c_import_vehicles_tail, DatabaseQueries::c_import_batch_rows);
+static const std::string s_import_vehicles_row = buildImportQuery(DatabaseQueries::c_import_vehicles_head, DatabaseQueries::c_import_vehicles_row, DatabaseQueries::c_import_vehicles_tail, 1);
+
+// Returns a text column, or an empty string for NULL.
+static std::string columnText(
+    sqlite3_stmt* prepared_sql_statement,
+    int column
+    )
+{
+    const unsigned char* column_data = sqlite3_column_text(prepared_sql_statement, column);
+
+    return(column_data ? reinterpret_cast<const char*>(column_data) : "");
+}
+
+void Database::openConnection(
+    const std::string &path,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    openConnection(
+        path,
+        ConnectionProfile(),
+        is_successful,
+        outcome_message
+        );
 }
 
 void Database::openConnection(
     const std::string &path,
+    const ConnectionProfile& profile,
     bool& is_successful,
     std::string& outcome_message
     )
@@ -33,75 +187,167 @@ void Database::openConnection(
         return;
     }
 
-    const char* sql_query = R"SQL(
-        BEGIN TRANSACTION;
+    // NOTE (SAVIZ): The profile must be applied before the schema script runs, so that the journal mode is already in place for the very first write.
+    applyConnectionProfile(profile, is_successful, outcome_message);
 
-        -- VESSELS
-        CREATE TABLE IF NOT EXISTS vessels (
-            vessel_id_pk INTEGER PRIMARY KEY AUTOINCREMENT,
-            vessel_name TEXT NOT NULL UNIQUE,
-            low_ceiling_lane_length REAL NOT NULL,
-            high_ceiling_lane_length REAL NOT NULL
-        );
+    if(!is_successful)
+    {
+        return;
+    }
 
-        -- SAILINGS
-        CREATE TABLE IF NOT EXISTS sailings (
-            sailing_id_pk INTEGER PRIMARY KEY AUTOINCREMENT,
-            vessel_id_fk INTEGER NOT NULL,
-            departure_terminal TEXT NOT NULL,
-            departure_day INTEGER NOT NULL,
-            departure_hour INTEGER NOT NULL,
-            low_remaining_length REAL NOT NULL,
-            high_remaining_length REAL NOT NULL,
+    const char* sql_query = DatabaseQueries::c_create_schema;
 
-            FOREIGN KEY(vessel_id_fk) REFERENCES vessels(vessel_id_pk),
+    char* error_message = nullptr;
 
-            -- Making the combination of the sailing ID unique:
-            UNIQUE(departure_terminal, departure_day, departure_hour)
-        );
+    // Since we are just creating tables (no SELECT statements), we don’t need a 'callback' or 'user-data', so we pass 'nullptr' for both:
+    return_code = sqlite3_exec(m_sqlite3, sql_query, nullptr, nullptr, &error_message);
 
-        -- VEHICLES
-        CREATE TABLE IF NOT EXISTS vehicles (
-            vehicle_id_pk INTEGER PRIMARY KEY AUTOINCREMENT,
-            license_plate TEXT NOT NULL UNIQUE,
-            phone_number TEXT NOT NULL,
-            length REAL NOT NULL,
-            height REAL NOT NULL
-        );
+    if (return_code != SQLITE_OK)
+    {
+        is_successful = false;
+        outcome_message = std::string("Connection request failed: ") + std::string(error_message);
 
-        -- RESERVATIONS
-        -- (Many-to-Many relationship between SAILINGS and VEHICLES)
-        CREATE TABLE IF NOT EXISTS reservations (
-            sailing_id_fk INTEGER NOT NULL,
-            vehicle_id_fk INTEGER NOT NULL,
-            amount_paid INTEGER NOT NULL,
-            reserved_for_low_lane BOOLEAN NOT NULL,
+        sqlite3_free(error_message);
 
-            PRIMARY KEY (sailing_id_fk, vehicle_id_fk),
-            FOREIGN KEY(sailing_id_fk) REFERENCES sailings(sailing_id_pk),
-            FOREIGN KEY(vehicle_id_fk) REFERENCES vehicles(vehicle_id_pk)
-        );
+        return;
+    }
+
+    migrateSchema(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Connection request failed: ") + outcome_message;
+
+        return;
+    }
+
+    // NOTE (SAVIZ): The read connections come last, since a read-only connection can neither create the schema nor change the journal mode.
+    if(profile.read_connections > 0)
+    {
+        openReadConnections(path, profile, is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            outcome_message = std::string("Connection request failed: ") + outcome_message;
+
+            return;
+        }
+    }
+
+    is_successful = true;
+    outcome_message = std::string("Connection request succeeded");
+}
+
+void Database::getConnectionProfile(
+    ConnectionProfile& effective_profile,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // NOTE (SAVIZ): SQLite reports 'synchronous' and 'temp_store' as numbers, so we map them back to the keywords used in the profile:
+    const std::vector<std::string> synchronous_keywords = { "OFF", "NORMAL", "FULL", "EXTRA" };
+    const std::vector<std::string> temp_store_keywords = { "DEFAULT", "FILE", "MEMORY" };
+
+    std::string journal_mode, synchronous, cache_size, mmap_size, temp_store, foreign_keys, busy_timeout;
+
+    int return_code = SQLITE_OK;
+
+    if((return_code = queryPragma(m_sqlite3, "PRAGMA journal_mode;", journal_mode)) != SQLITE_OK ||
+       (return_code = queryPragma(m_sqlite3, "PRAGMA synchronous;", synchronous)) != SQLITE_OK ||
+       (return_code = queryPragma(m_sqlite3, "PRAGMA cache_size;", cache_size)) != SQLITE_OK ||
+       (return_code = queryPragma(m_sqlite3, "PRAGMA mmap_size;", mmap_size)) != SQLITE_OK ||
+       (return_code = queryPragma(m_sqlite3, "PRAGMA temp_store;", temp_store)) != SQLITE_OK ||
+       (return_code = queryPragma(m_sqlite3, "PRAGMA foreign_keys;", foreign_keys)) != SQLITE_OK ||
+       (return_code = queryPragma(m_sqlite3, "PRAGMA busy_timeout;", busy_timeout)) != SQLITE_OK)
+    {
+        is_successful = false;
+        outcome_message = std::string("Get connection profile failed: ") + sqlite3_errmsg(m_sqlite3);
+
+        return;
+    }
+
+    int synchronous_level = std::stoi(synchronous.empty() ? "2" : synchronous);
+    int temp_store_level = std::stoi(temp_store.empty() ? "0" : temp_store);
+
+    effective_profile.journal_mode = toUpperKeyword(journal_mode);
+    effective_profile.synchronous = (synchronous_level >= 0 && synchronous_level <= 3) ? synchronous_keywords[synchronous_level] : synchronous;
+    effective_profile.cache_size = cache_size.empty() ? 0 : std::stoi(cache_size);
+    effective_profile.mmap_size = mmap_size.empty() ? 0 : std::stoll(mmap_size);
+    effective_profile.temp_store = (temp_store_level >= 0 && temp_store_level <= 2) ? temp_store_keywords[temp_store_level] : temp_store;
+    effective_profile.foreign_keys = (foreign_keys == "1");
+    effective_profile.busy_timeout = busy_timeout.empty() ? 0 : std::stoi(busy_timeout);
+    effective_profile.read_connections = static_cast<int>(m_read_connections.size());
+
+    is_successful = true;
+    outcome_message = std::string("Get connection profile succeeded");
+}
+
+void Database::applyConnectionProfile(
+    const ConnectionProfile& profile,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // 1) Validate keywords (PRAGMA values cannot be bound, so only known keywords may ever reach the SQL text):
+    if(!isAcceptedKeyword(profile.journal_mode, { "DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF" }))
+    {
+        is_successful = false;
+        outcome_message = std::string("Connection request failed: ") + "invalid journal_mode '" + profile.journal_mode + "'.";
+
+        return;
+    }
 
-        COMMIT;
-    )SQL";
+    if(!isAcceptedKeyword(profile.synchronous, { "OFF", "NORMAL", "FULL", "EXTRA" }))
+    {
+        is_successful = false;
+        outcome_message = std::string("Connection request failed: ") + "invalid synchronous '" + profile.synchronous + "'.";
+
+        return;
+    }
+
+    if(!isAcceptedKeyword(profile.temp_store, { "DEFAULT", "FILE", "MEMORY" }))
+    {
+        is_successful = false;
+        outcome_message = std::string("Connection request failed: ") + "invalid temp_store '" + profile.temp_store + "'.";
+
+        return;
+    }
+
+    if(profile.mmap_size < 0 || profile.busy_timeout < 0)
+    {
+        is_successful = false;
+        outcome_message = std::string("Connection request failed: ") + "mmap_size and busy_timeout cannot be negative.";
+
+        return;
+    }
+
+    // 2) Apply all settings in one go:
+    const std::string sql_query =
+        "PRAGMA journal_mode = " + toUpperKeyword(profile.journal_mode) + ";"
+        "PRAGMA synchronous = " + toUpperKeyword(profile.synchronous) + ";"
+        "PRAGMA cache_size = " + std::to_string(profile.cache_size) + ";"
+        "PRAGMA mmap_size = " + std::to_string(profile.mmap_size) + ";"
+        "PRAGMA temp_store = " + toUpperKeyword(profile.temp_store) + ";"
+        "PRAGMA foreign_keys = " + (profile.foreign_keys ? "ON" : "OFF") + ";";
 
     char* error_message = nullptr;
 
-    // Since we are just creating tables (no SELECT statements), we don’t need a 'callback' or 'user-data', so we pass 'nullptr' for both:
-    return_code = sqlite3_exec(m_sqlite3, sql_query, nullptr, nullptr, &error_message);
+    int return_code = sqlite3_exec(m_sqlite3, sql_query.c_str(), nullptr, nullptr, &error_message);
 
-    if (return_code != SQLITE_OK)
+    if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Connection request failed: ") + std::string(error_message);
+        outcome_message = std::string("Connection request failed: ") + std::string(error_message ? error_message : sqlite3_errmsg(m_sqlite3));
 
         sqlite3_free(error_message);
 
         return;
     }
 
+    sqlite3_busy_timeout(m_sqlite3, profile.busy_timeout);
+
     is_successful = true;
-    outcome_message = std::string("Connection request succeeded");
+    outcome_message = std::string("Connection profile applied");
 }
 
 void Database::cutConnection(
@@ -109,6 +355,52 @@ void Database::cutConnection(
     std::string& outcome_message
     )
 {
+    // A cursor still holds one of the cached statements, which would be left dangling:
+    if(!m_lent_statements.empty())
+    {
+        is_successful = false;
+        outcome_message = std::string("Cut connection request failed: ") + std::to_string(m_lent_statements.size()) + " cursor(s) still open.";
+
+        return;
+    }
+
+    // ...and the same goes for a read connection that a cursor (or another thread) is still reading on:
+    {
+        std::lock_guard<std::mutex> lock(m_read_pool_mutex);
+
+        for(std::unique_ptr<ReadConnection>& read_connection : m_read_connections)
+        {
+            if(read_connection->lease_count > 0)
+            {
+                is_successful = false;
+                outcome_message = std::string("Cut connection request failed: ") + "a read connection is still in use (" + std::to_string(read_connection->lent_statements.size()) + " cursor(s) open).";
+
+                return;
+            }
+        }
+    }
+
+    // Writes waiting in an open group are committed before anything is closed:
+    bool is_flushed = false;
+    std::string flush_message = "";
+
+    flushGroupCommit(is_flushed, flush_message);
+
+    // NOTE (SAVIZ): 'sqlite3_close()' refuses to close a connection that still has unfinalized statements, so the cache has to be emptied first.
+    finalizeStatements();
+
+    for(std::unique_ptr<ReadConnection>& read_connection : m_read_connections)
+    {
+        for(auto& [sql_query, prepared_sql_statement] : read_connection->prepared_statements)
+        {
+            sqlite3_finalize(prepared_sql_statement);
+        }
+
+        sqlite3_close(read_connection->handle);
+    }
+
+    m_read_connections.clear();
+
     int return_code = sqlite3_close(this->m_sqlite3);
 
     if(return_code != SQLITE_OK)
@@ -119,6 +411,17 @@ void Database::cutConnection(
         return;
     }
 
+    this->m_sqlite3 = nullptr;
+
+    // The connection is gone either way, but the caller must hear about writes that were lost:
+    if(!is_flushed)
+    {
+        is_successful = false;
+        outcome_message = std::string("Cut connection request failed: ") + flush_message;
+
+        return;
+    }
+
     is_successful = true;
     outcome_message = std::string("Cut connection request succeeded");
 }
@@ -129,21 +432,33 @@ void Database::addVessel(
     std::string& outcome_message
     )
 {
+    // The cached catalog is stale from here on (see 'setEntityCache()'):
+    EntityWrite entity_write(this);
+
+    if(m_entity_cache != nullptr)
+    {
+        m_entity_cache->invalidateVessels();
+    }
+
+    // NOTE (SAVIZ): A single statement, but it goes through 'beginTransaction()' so that it can join an open group (see 'setGroupCommit()').
+    beginTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Vessel creation failed: ") + outcome_message;
+
+        return;
+    }
+
     // 1) Creating the SQL query command:
-    const char* sql_query = R"SQL(
-        INSERT INTO vessels (vessel_name, low_ceiling_lane_length, high_ceiling_lane_length)
-        VALUES (?, ?, ?);
-    )SQL";
+    const char* sql_query = DatabaseQueries::c_insert_vessel;
 
     // 2) Preparing the statement with bindings:
     sqlite3_stmt* prepared_sql_statement = nullptr;
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
-        sql_query,
-        -1,                      // Tells SQLite how many bytes of your SQL buffer it should scan and compile ('-1' means read everything until the '\0' character for the end of the string)
-        &prepared_sql_statement,
-        nullptr                  // Useful if your buffer contains multiple SQL statements back-to-back ('nullptr' means: "I only have one statement in my string")
+    int return_code = acquireStatement(
+        sql_query,               // Must have static storage duration, as its address is the key of the statement cache
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
@@ -151,6 +466,8 @@ void Database::addVessel(
         is_successful = false;
         outcome_message = std::string("Vessel creation failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
 
+        rollbackTransaction();
+
         return;
     }
 
@@ -183,16 +500,27 @@ void Database::addVessel(
         is_successful = false;
         outcome_message = std::string("Vessel creation failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
 
-        sqlite3_finalize(prepared_sql_statement);
+        releaseStatement(prepared_sql_statement);
+
+        rollbackTransaction();
+
+        return;
+    }
+
+    // 4) Clean up, and commit:
+    releaseStatement(prepared_sql_statement);
+
+    commitTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Vessel creation failed: ") + outcome_message;
 
         return;
     }
 
     is_successful = true;
     outcome_message = std::string("Vessel creation succeeded");
-
-    // 4) Clean up:
-    sqlite3_finalize(prepared_sql_statement);
 }
 
 void Database::getVesselByID(
@@ -202,27 +530,48 @@ void Database::getVesselByID(
     std::string& outcome_message
     )
 {
+    // 0) The whole catalog is kept by the entity cache while it fits (so a vessel missing from it does not exist):
+    if(m_entity_cache != nullptr)
+    {
+        bool is_found = false;
+        bool is_catalog_read = m_entity_cache->findVessel(vessel_id, vessel, is_found);
+
+        std::vector<Vessel> catalog;
+
+        if(!is_catalog_read && loadVesselCatalog(catalog))
+        {
+            is_found = EntityCache::findInCatalog(catalog, vessel_id, vessel);
+            is_catalog_read = true;
+        }
+
+        if(is_catalog_read)
+        {
+            is_successful = is_found;
+            outcome_message = is_found ? std::string("Vessel get by ID succeeded.") : std::string("Vessel get by ID failed: ") + std::string("No vessel found with ID = ") + std::to_string(vessel_id);
+
+            return;
+        }
+    }
+
     // 1) Creating the SQL query command:
-    const char* sql_query = R"SQL(
-        SELECT vessel_name, low_ceiling_lane_length, high_ceiling_lane_length FROM vessels
-        WHERE vessel_id_pk = ?;
-    )SQL";
+    const char* sql_query = DatabaseQueries::c_select_vessel_by_id;
 
     // 2) Preparing the statement with bindings:
     sqlite3_stmt* prepared_sql_statement = nullptr;
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
+    // Reads run on a connection of the pool, if there is one (see 'openConnection()'):
+    ReadLease read_lease(this);
+
+    int return_code = acquireReadStatement(
+        read_lease.getReadConnection(),
         sql_query,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Vessel get by ID failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
+        outcome_message = std::string("Vessel get by ID failed: ") + std::string(sqlite3_errmsg(read_lease.getHandle()));
 
         return;
     }
@@ -271,105 +620,219 @@ void Database::getVesselByID(
     else
     {
         is_successful = false;
-        outcome_message = std::string("Vessel get by ID failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
+        outcome_message = std::string("Vessel get by ID failed: ") + std::string(sqlite3_errmsg(read_lease.getHandle()));
     }
 
     // 4) Clean up:
-    sqlite3_finalize(prepared_sql_statement);
+    releaseStatement(prepared_sql_statement);
+}
+
+// Reads a row of the vessel pages ('c_select_vessels_next' and 'c_select_vessels_previous').
+static void readVesselRow(
+    sqlite3_stmt* prepared_sql_statement,
+    Vessel& vessel
+    )
+{
+    vessel.vessel_id = sqlite3_column_int(
+        prepared_sql_statement,
+        0);
+
+    const unsigned char* vessel_name_column_data = sqlite3_column_text(
+        prepared_sql_statement,
+        1);
+
+    vessel.vessel_name = vessel_name_column_data ? reinterpret_cast<const char*>(vessel_name_column_data) : "";
+
+    vessel.low_ceiling_lane_length = sqlite3_column_double(
+        prepared_sql_statement,
+        2);
+
+    vessel.high_ceiling_lane_length = sqlite3_column_double(
+        prepared_sql_statement,
+        3);
 }
 
 void Database::getVessels(
     int count,
-    int offset,
+    PageDirection direction,
+    PageCursor& cursor,
     std::vector<Vessel>& vessels,
     bool& is_successful,
     std::string& outcome_message
     )
 {
-    // 1) Creating the SQL query command:
-    const char* sql_query = R"SQL(
-        SELECT vessel_id_pk, vessel_name, low_ceiling_lane_length, high_ceiling_lane_length FROM vessels
-        LIMIT ? OFFSET ?;
-    )SQL";
+    // NOTE (SAVIZ): 'OFFSET' makes SQLite walk over every skipped row, so instead we seek straight past the last (or before the first) ID shown.
 
-    // 2) Preparing the statement with bindings:
-    sqlite3_stmt* prepared_sql_statement = nullptr;
+    bool is_previous = (direction == PageDirection::Previous && cursor.has_page);
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
-        sql_query,
-        -1,
-        &prepared_sql_statement,
-        nullptr
-        );
+    int key = 0; // IDs start from 1, so the first page is everything after 0.
 
-    if(return_code != SQLITE_OK)
+    if(direction != PageDirection::First && cursor.has_page)
     {
-        is_successful = false;
-        outcome_message = std::string("Get vessels failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
-
-        return;
+        key = is_previous ? cursor.first_key[0] : cursor.last_key[0];
     }
 
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        1,
-        count
-        );
+    // 0) A fleet small enough for the entity cache is paged from the catalog in memory:
+    bool is_catalog_read = false;
 
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        2,
-        offset
-        );
+    if(m_entity_cache != nullptr)
+    {
+        is_catalog_read = m_entity_cache->findVessels(key, count, is_previous, vessels);
 
-    // 3) Executing:
-    vessels.clear();
+        std::vector<Vessel> catalog;
 
-    while((return_code = sqlite3_step(prepared_sql_statement)) == SQLITE_ROW)
+        if(!is_catalog_read && loadVesselCatalog(catalog))
+        {
+            EntityCache::pageCatalog(catalog, key, count, is_previous, vessels);
+
+            is_catalog_read = true;
+        }
+    }
+
+    if(!is_catalog_read)
     {
-        Vessel vessel;
+        // 1) Creating the SQL query command:
+        const char* sql_query_next = DatabaseQueries::c_select_vessels_next;
 
-        vessel.vessel_id = sqlite3_column_int(
-            prepared_sql_statement,
-            0);
+        // Walks backwards from the cursor (the rows are put back in order below):
+        const char* sql_query_previous = DatabaseQueries::c_select_vessels_previous;
 
-        const unsigned char* vessel_name_column_data = sqlite3_column_text(
-            prepared_sql_statement,
-            1);
+        // 2) Preparing the statement with bindings:
+        sqlite3_stmt* prepared_sql_statement = nullptr;
 
-        vessel.vessel_name = vessel_name_column_data ? reinterpret_cast<const char*>(vessel_name_column_data) : "";
+        ReadLease read_lease(this);
 
-        vessel.low_ceiling_lane_length = sqlite3_column_double(
+        int return_code = acquireReadStatement(
+            read_lease.getReadConnection(),
+            is_previous ? sql_query_previous : sql_query_next,
+            prepared_sql_statement
+            );
+
+        if(return_code != SQLITE_OK)
+        {
+            is_successful = false;
+            outcome_message = std::string("Get vessels failed: ") + std::string(sqlite3_errmsg(read_lease.getHandle()));
+
+            return;
+        }
+
+        sqlite3_bind_int(
             prepared_sql_statement,
-            2);
+            1,
+            key
+            );
 
-        vessel.high_ceiling_lane_length = sqlite3_column_double(
+        sqlite3_bind_int(
             prepared_sql_statement,
-            3);
+            2,
+            count
+            );
 
-        // TODO (SAVIZ): Might be worth to look at 'emplace_back()' for vector to increase performance:
-        vessels.push_back(vessel);
+        // 3) Executing:
+        vessels.clear();
+
+        while((return_code = sqlite3_step(prepared_sql_statement)) == SQLITE_ROW)
+        {
+            Vessel vessel;
+
+            readVesselRow(prepared_sql_statement, vessel);
+
+            // TODO (SAVIZ): Might be worth to look at 'emplace_back()' for vector to increase performance:
+            vessels.push_back(vessel);
+        }
+
+        // 4.a) Operation completed, but row was not found:
+        if(return_code != SQLITE_DONE)
+        {
+            is_successful = false;
+            outcome_message = std::string("Get vessels failed: ") + std::string(sqlite3_errmsg(read_lease.getHandle()));
+
+            releaseStatement(prepared_sql_statement);
+
+            return;
+        }
+
+        releaseStatement(prepared_sql_statement);
+
+        if(is_previous)
+        {
+            std::reverse(vessels.begin(), vessels.end());
+        }
     }
 
-    // 4.a) Operation completed, but row was not found:
-    if(return_code != SQLITE_DONE)
+    // 4.b) Going back from a page that did not start on a page boundary (rows were added or removed) leaves a short page, so show the first page instead:
+    if(is_previous && static_cast<int>(vessels.size()) < count)
     {
-        is_successful = false;
-        outcome_message = std::string("Get vessels failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
-
-        sqlite3_finalize(prepared_sql_statement);
+        getVessels(count, PageDirection::First, cursor, vessels, is_successful, outcome_message);
 
         return;
     }
 
-    // 4.b) It is the responsibility of the calling code to handle cases where no records are returned based on the size of the vector.
+    // 4.c) It is the responsibility of the calling code to handle cases where no records are returned based on the size of the vector (the cursor stays where it was).
+    if(!vessels.empty())
+    {
+        cursor.has_page = true;
+        cursor.first_key[0] = vessels.front().vessel_id;
+        cursor.last_key[0] = vessels.back().vessel_id;
+    }
 
-    // 4.c) Successful:
+    // 4.d) Successful:
     is_successful = true;
     outcome_message = std::string("Get vessels succeeded.");
+}
 
-    sqlite3_finalize(prepared_sql_statement);
+bool Database::loadVesselCatalog(
+    std::vector<Vessel>& catalog
+    )
+{
+    std::size_t vessel_capacity = m_entity_cache->getVesselCapacity();
+
+    if(vessel_capacity == 0)
+    {
+        return(false);
+    }
+
+    std::uint64_t read_generation = m_entity_cache->getGeneration();
+
+    // One vessel more than the cache takes is enough to tell that the fleet does not fit:
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    ReadLease read_lease(this);
+
+    if(acquireReadStatement(read_lease.getReadConnection(), DatabaseQueries::c_select_vessels_next, prepared_sql_statement) != SQLITE_OK)
+    {
+        return(false);
+    }
+
+    sqlite3_bind_int(prepared_sql_statement, 1, 0);
+    sqlite3_bind_int(prepared_sql_statement, 2, static_cast<int>(vessel_capacity + 1));
+
+    catalog.clear();
+
+    int return_code = SQLITE_OK;
+
+    while((return_code = sqlite3_step(prepared_sql_statement)) == SQLITE_ROW)
+    {
+        Vessel vessel;
+
+        readVesselRow(prepared_sql_statement, vessel);
+
+        catalog.push_back(vessel);
+    }
+
+    releaseStatement(prepared_sql_statement);
+
+    if(return_code != SQLITE_DONE)
+    {
+        return(false);
+    }
+
+    if(read_lease.isFresh())
+    {
+        m_entity_cache->insertVessels(catalog, read_generation);
+    }
+
+    return(catalog.size() <= vessel_capacity);
 }
 
 void Database::addSailing(
@@ -378,21 +841,43 @@ void Database::addSailing(
     std::string& outcome_message
     )
 {
+    // Sailings are keyed by the packed sailing ID, so one that does not pack could never be found again:
+    SailingKey sailing_key;
+
+    if(!SailingKey::create(sailing.departure_terminal, sailing.departure_day, sailing.departure_hour, sailing_key))
+    {
+        is_successful = false;
+        outcome_message = std::string("Sailing creation failed: ") + "Invalid sailing!";
+
+        return;
+    }
+
+    EntityWrite entity_write(this);
+
+    if(m_entity_cache != nullptr)
+    {
+        m_entity_cache->invalidateSailing(sailing_key);
+    }
+
+    // NOTE (SAVIZ): A single statement, but it goes through 'beginTransaction()' so that it can join an open group (see 'setGroupCommit()').
+    beginTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Sailing creation failed: ") + outcome_message;
+
+        return;
+    }
+
     // 1) Creating the SQL query command:
-    const char* sql_query = R"SQL(
-        INSERT INTO sailings (vessel_id_fk, departure_terminal, departure_day, departure_hour, low_remaining_length, high_remaining_length)
-        VALUES (?, ?, ?, ?, ?, ?);
-    )SQL";
+    const char* sql_query = DatabaseQueries::c_insert_sailing;
 
     // 2) Preparing the statement with bindings:
     sqlite3_stmt* prepared_sql_statement = nullptr;
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
+    int return_code = acquireStatement(
         sql_query,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
@@ -400,6 +885,8 @@ void Database::addSailing(
         is_successful = false;
         outcome_message = std::string("Sailing creation failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
 
+        rollbackTransaction();
+
         return;
     }
 
@@ -449,16 +936,27 @@ void Database::addSailing(
         is_successful = false;
         outcome_message = std::string("Sailing creation failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
 
-        sqlite3_finalize(prepared_sql_statement);
+        releaseStatement(prepared_sql_statement);
+
+        rollbackTransaction();
+
+        return;
+    }
+
+    // 4) Clean up, and commit:
+    releaseStatement(prepared_sql_statement);
+
+    commitTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Sailing creation failed: ") + outcome_message;
 
         return;
     }
 
     is_successful = true;
     outcome_message = std::string("Sailing creation succeeded");
-
-    // 4) Clean up:
-    sqlite3_finalize(prepared_sql_statement);
 }
 
 void Database::removeSailing(
@@ -467,20 +965,31 @@ void Database::removeSailing(
     std::string& outcome_message
     )
 {
+    EntityWrite entity_write(this);
+
+    if(m_entity_cache != nullptr)
+    {
+        m_entity_cache->invalidateSailing(sailing.sailing_id);
+    }
+
+    // NOTE (SAVIZ): Both deletes are one transaction (or one savepoint of an open group), so a failure on the sailing row puts its reservations back.
+    beginTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Sailing deletion failed: ") + outcome_message;
+
+        return;
+    }
+
     // 1) Delete all reservations for this sailing
-    const char* sql_query_delete_reservations = R"SQL(
-        DELETE FROM reservations
-        WHERE sailing_id_fk = ?;
-    )SQL";
+    const char* sql_query_delete_reservations = DatabaseQueries::c_delete_sailing_reservations;
 
     sqlite3_stmt* prepared_sql_statement = nullptr;
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
+    int return_code = acquireStatement(
         sql_query_delete_reservations,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
@@ -488,6 +997,8 @@ void Database::removeSailing(
         is_successful = false;
         outcome_message = std::string("Sailing deletion failed: ") + sqlite3_errmsg(m_sqlite3);
 
+        rollbackTransaction();
+
         return;
     }
 
@@ -499,28 +1010,24 @@ void Database::removeSailing(
 
     return_code = sqlite3_step(prepared_sql_statement);
 
-    sqlite3_finalize(prepared_sql_statement);
+    releaseStatement(prepared_sql_statement);
 
     if(return_code != SQLITE_DONE)
     {
         is_successful = false;
         outcome_message = std::string("Sailing deletion failed: ") + sqlite3_errmsg(m_sqlite3);
 
+        rollbackTransaction();
+
         return;
     }
 
     // 2) Delete the sailing record
-    const char* sql_query_delete_sail = R"SQL(
-        DELETE FROM sailings
-        WHERE sailing_id_pk = ?;
-    )SQL";
+    const char* sql_query_delete_sail = DatabaseQueries::c_delete_sailing;
 
-    return_code = sqlite3_prepare_v2(
-        m_sqlite3,
+    return_code = acquireStatement(
         sql_query_delete_sail,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
@@ -528,6 +1035,8 @@ void Database::removeSailing(
         is_successful = false;
         outcome_message = std::string("Sailing deletion failed: ") + sqlite3_errmsg(m_sqlite3);
 
+        rollbackTransaction();
+
         return;
     }
 
@@ -539,13 +1048,25 @@ void Database::removeSailing(
 
     return_code = sqlite3_step(prepared_sql_statement);
 
-    sqlite3_finalize(prepared_sql_statement);
+    releaseStatement(prepared_sql_statement);
 
     if(return_code != SQLITE_DONE)
     {
         is_successful = false;
         outcome_message = std::string("Sailing deletion failed: ") + sqlite3_errmsg(m_sqlite3);
 
+        rollbackTransaction();
+
+        return;
+    }
+
+    // 3) Commit
+    commitTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Sailing deletion failed: ") + outcome_message;
+
         return;
     }
 
@@ -563,50 +1084,69 @@ void Database::getSailingByID(
     std::string &outcome_message
     )
 {
+    // Sailings are keyed by the packed sailing ID (see 'sailing_key.hpp'). One that does not pack cannot be in the table:
+    SailingKey sailing_key;
+
+    if(!SailingKey::create(departure_terminal, departure_day, departure_hour, sailing_key))
+    {
+        is_successful = false;
+        outcome_message = std::string("Get sailing by ID failed: ") + std::string("No sailing found for ID of ") + departure_terminal + "-" + std::to_string(departure_day) + "-" + std::to_string(departure_hour);
+
+        return;
+    }
+
+    getSailingByID(sailing_key, sailing, is_successful, outcome_message);
+}
+
+void Database::getSailingByID(
+    SailingKey sailing_key,
+    Sailing& sailing,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // 0) Check the entity cache first (see 'setEntityCache()'):
+    std::uint64_t read_generation = 0;
+
+    if(m_entity_cache != nullptr)
+    {
+        if(m_entity_cache->findSailing(sailing_key, sailing))
+        {
+            is_successful = true;
+            outcome_message = "Get sailing by ID succeeded.";
+
+            return;
+        }
+
+        read_generation = m_entity_cache->getGeneration();
+    }
+
     // 1) Prepare the SELECT statement
-    const char* sql_query = R"SQL(
-        SELECT sailing_id_pk, vessel_id_fk, departure_terminal, departure_day, departure_hour, low_remaining_length, high_remaining_length FROM sailings
-        WHERE departure_terminal = ? AND departure_day = ? AND departure_hour = ?
-        LIMIT 1;
-    )SQL";
+    const char* sql_query = DatabaseQueries::c_select_sailing_by_id;
 
     sqlite3_stmt* prepared_sql_statement = nullptr;
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
+    ReadLease read_lease(this);
+
+    int return_code = acquireReadStatement(
+        read_lease.getReadConnection(),
         sql_query,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Get sailing by ID failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Get sailing by ID failed: ") + sqlite3_errmsg(read_lease.getHandle());
 
         return;
     }
 
     // 2) Bind parameters
-    sqlite3_bind_text(
+    sqlite3_bind_int64(
         prepared_sql_statement,
         1,
-        departure_terminal.c_str(),
-        -1,
-        SQLITE_TRANSIENT
-        );
-
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        2,
-        departure_day
-        );
-
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        3,
-        departure_hour
+        static_cast<sqlite3_int64>(sailing_key.getValue())
         );
 
     // 3) Execute and fetch
@@ -653,84 +1193,91 @@ void Database::getSailingByID(
 
         is_successful = true;
         outcome_message = "Get sailing by ID succeeded.";
+
+        if(m_entity_cache != nullptr && read_lease.isFresh())
+        {
+            m_entity_cache->insertSailing(sailing_key, sailing, read_generation);
+        }
     }
 
     else if(return_code == SQLITE_DONE)
     {
         is_successful = false;
-        outcome_message = std::string("Get sailing by ID failed: ") + std::string("No sailing found for ID of ") + departure_terminal + "-" + std::to_string(departure_day) + "-" + std::to_string(departure_hour);
+        outcome_message = std::string("Get sailing by ID failed: ") + std::string("No sailing found for ID of ") + sailing_key.toString();
     }
 
     else
     {
         is_successful = false;
-        outcome_message = std::string("Get sailing by ID failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Get sailing by ID failed: ") + sqlite3_errmsg(read_lease.getHandle());
     }
 
     // 4) Finalize
-    sqlite3_finalize(prepared_sql_statement);
+    releaseStatement(prepared_sql_statement);
 }
 
 void Database::getSailingReports(
     int count,
-    int offset,
+    PageDirection direction,
+    PageCursor& cursor,
     std::vector<SailingReport>& sailing_reports,
     bool& is_successful,
     std::string& outcome_message
     )
 {
-    // NOTE (SAVIZ): I was planning to use the FLOOR() function in SQLite, but enabling it proved to be somewhat troublesome. So, I decided to use TRUNC() instead, as it achieves the same result (as we don't have negative values).
+    // NOTE (SAVIZ): Pages are found by seeking on the 'sailings_by_departure' index with a row value, instead of 'OFFSET' (which grouped and then threw away every earlier sailing).
+    // The vehicle count and occupancy are kept up to date on each sailing by triggers (see schema version 1), so a page is a plain range read.
 
     // 1) Creating the SQL query command:
-    const char* sql_query_sailing_reports = R"SQL(
-        SELECT sailings.departure_terminal, sailings.departure_day, sailings.departure_hour, sailings.low_remaining_length, sailings.high_remaining_length, vessels.vessel_name,
+    const char* sql_query_next = DatabaseQueries::c_select_sailing_reports_next;
 
-        COUNT(reservations.vehicle_id_fk) AS reserved_vehicle_count,
-        TRUNC
-        (
-            (
-            (vessels.low_ceiling_lane_length + vessels.high_ceiling_lane_length - sailings.low_remaining_length - sailings.high_remaining_length) / (vessels.low_ceiling_lane_length + vessels.high_ceiling_lane_length)
-            ) * 100.0
-        ) AS occupancy_percentage
+    // Walks backwards from the cursor (the rows are put back in order below):
+    const char* sql_query_previous = DatabaseQueries::c_select_sailing_reports_previous;
 
-        FROM sailings
+    bool is_previous = (direction == PageDirection::Previous && cursor.has_page);
 
-        JOIN vessels ON sailings.vessel_id_fk = vessels.vessel_id_pk
-        LEFT JOIN reservations ON reservations.sailing_id_fk = sailings.sailing_id_pk
-        GROUP BY sailings.sailing_id_pk ORDER BY sailings.departure_day, sailings.departure_hour
+    // Days, hours and IDs are never negative, so the first page is everything after (-1, -1, -1):
+    int key[3] = {-1, -1, -1};
 
-        LIMIT ? OFFSET ?;
-    )SQL";
+    if(direction != PageDirection::First && cursor.has_page)
+    {
+        const int* cursor_key = is_previous ? cursor.first_key : cursor.last_key;
+
+        std::copy(cursor_key, cursor_key + 3, key);
+    }
 
     // 2) Preparing the statement with bindings:
     sqlite3_stmt* prepared_sql_statement = nullptr;
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
-        sql_query_sailing_reports,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+    ReadLease read_lease(this);
+
+    int return_code = acquireReadStatement(
+        read_lease.getReadConnection(),
+        is_previous ? sql_query_previous : sql_query_next,
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Get sailing reports failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Get sailing reports failed: ") + sqlite3_errmsg(read_lease.getHandle());
 
         return;
     }
 
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        1,
-        count
-        );
+    for(int index = 0; index < 3; ++index)
+    {
+        sqlite3_bind_int(
+            prepared_sql_statement,
+            index + 1,
+            key[index]
+            );
+    }
 
     sqlite3_bind_int(
         prepared_sql_statement,
-        2,
-        offset
+        4,
+        count
         );
 
     // 3) Executing and populating results:
@@ -740,30 +1287,28 @@ void Database::getSailingReports(
     {
         SailingReport sailing_report;
 
-        const unsigned char* departure_terminal_column_data = sqlite3_column_text(
+        sailing_report.sailing.sailing_id = sqlite3_column_int(
             prepared_sql_statement,
             0
             );
 
-        sailing_report.sailing.departure_terminal = departure_terminal_column_data ? reinterpret_cast<const char*>(departure_terminal_column_data) : "";
-
-        sailing_report.sailing.departure_day = sqlite3_column_int(
+        const unsigned char* departure_terminal_column_data = sqlite3_column_text(
             prepared_sql_statement,
             1
             );
 
-        sailing_report.sailing.departure_hour = sqlite3_column_int(
+        sailing_report.sailing.departure_terminal = departure_terminal_column_data ? reinterpret_cast<const char*>(departure_terminal_column_data) : "";
+
+        sailing_report.sailing.departure_day = sqlite3_column_int(
             prepared_sql_statement,
             2
             );
 
-        const unsigned char* vessel_name_column_data = sqlite3_column_text(
+        sailing_report.sailing.departure_hour = sqlite3_column_int(
             prepared_sql_statement,
             3
             );
 
-        sailing_report.vessel.vessel_name = vessel_name_column_data ? reinterpret_cast<const char*>(vessel_name_column_data) : "";
-
         sailing_report.sailing.low_remaining_length = sqlite3_column_double(
             prepared_sql_statement,
             4
@@ -774,16 +1319,23 @@ void Database::getSailingReports(
             5
             );
 
-        sailing_report.vehicle_count = sqlite3_column_int(
+        const unsigned char* vessel_name_column_data = sqlite3_column_text(
             prepared_sql_statement,
             6
             );
 
-        sailing_report.occupancy_percentage = sqlite3_column_double(
+        sailing_report.vessel.vessel_name = vessel_name_column_data ? reinterpret_cast<const char*>(vessel_name_column_data) : "";
+
+        sailing_report.vehicle_count = sqlite3_column_int(
             prepared_sql_statement,
             7
             );
 
+        sailing_report.occupancy_percentage = sqlite3_column_double(
+            prepared_sql_statement,
+            8
+            );
+
         // TODO (SAVIZ): Might be worth to look at 'emplace_back()' for vector to increase performance:
         sailing_reports.push_back(sailing_report);
     }
@@ -792,89 +1344,97 @@ void Database::getSailingReports(
     if(return_code != SQLITE_DONE)
     {
         is_successful = false;
-        outcome_message = std::string("Get sailing reports failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Get sailing reports failed: ") + sqlite3_errmsg(read_lease.getHandle());
 
-        sqlite3_finalize(prepared_sql_statement);
+        releaseStatement(prepared_sql_statement);
 
         return;
     }
 
-    // 4.b) Success
-    is_successful = true;
-    outcome_message = std::string("Get sailing reports succeeded");
+    releaseStatement(prepared_sql_statement);
 
-    sqlite3_finalize(prepared_sql_statement);
-}
+    // 4.b) Going back from a page that did not start on a page boundary (rows were added or removed) leaves a short page, so show the first page instead:
+    if(is_previous && static_cast<int>(sailing_reports.size()) < count)
+    {
+        getSailingReports(count, PageDirection::First, cursor, sailing_reports, is_successful, outcome_message);
 
-void Database::getSailingReportByID(
-    Sailing sailing,
-    SailingReport& sailing_report,
-    bool& is_successful,
-    std::string& outcome_message
-    )
-{
-    // NOTE (SAVIZ): I was planning to use the FLOOR() function in SQLite, but enabling it proved to be somewhat troublesome. So, I decided to use TRUNC() instead, as it achieves the same result (as we don't have negative values).
+        return;
+    }
 
-    // 1) Creating the SQL query command:
-    const char* sql_query_sailing_report = R"SQL(
-        SELECT sailings.departure_terminal, sailings.departure_day, sailings.departure_hour, sailings.low_remaining_length, sailings.high_remaining_length, vessels.vessel_name,
+    if(is_previous)
+    {
+        std::reverse(sailing_reports.begin(), sailing_reports.end());
+    }
+
+    // 4.c) Remember where this page starts and ends (an empty page leaves the cursor where it was):
+    if(!sailing_reports.empty())
+    {
+        const Sailing& first_sailing = sailing_reports.front().sailing;
+        const Sailing& last_sailing = sailing_reports.back().sailing;
+
+        cursor.has_page = true;
 
-        COUNT(reservations.vehicle_id_fk) AS reserved_vehicle_count,
-        TRUNC
-        (
-            (
-            (vessels.low_ceiling_lane_length + vessels.high_ceiling_lane_length - sailings.low_remaining_length - sailings.high_remaining_length) / (vessels.low_ceiling_lane_length + vessels.high_ceiling_lane_length)
-            ) * 100.0
-        ) AS occupancy_percentage
+        cursor.first_key[0] = first_sailing.departure_day;
+        cursor.first_key[1] = first_sailing.departure_hour;
+        cursor.first_key[2] = first_sailing.sailing_id;
+
+        cursor.last_key[0] = last_sailing.departure_day;
+        cursor.last_key[1] = last_sailing.departure_hour;
+        cursor.last_key[2] = last_sailing.sailing_id;
+    }
+
+    // 4.d) Success
+    is_successful = true;
+    outcome_message = std::string("Get sailing reports succeeded");
+}
+
+void Database::getSailingReportByID(
+    Sailing sailing,
+    SailingReport& sailing_report,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // NOTE (SAVIZ): The vehicle count and occupancy are kept up to date on each sailing by triggers (see schema version 1).
 
-        FROM sailings
+    // 0) The sailing is found by its packed sailing ID (see 'sailing_key.hpp'):
+    SailingKey sailing_key;
 
-        JOIN vessels ON sailings.vessel_id_fk = vessels.vessel_id_pk
-        LEFT JOIN reservations ON reservations.sailing_id_fk = sailings.sailing_id_pk
+    if(!SailingKey::create(sailing.departure_terminal, sailing.departure_day, sailing.departure_hour, sailing_key))
+    {
+        is_successful = false;
+        outcome_message = std::string("Get sailing report by ID failed: ") + std::string("No sailing found for given ID.");
 
-        WHERE sailings.departure_terminal = ? AND sailings.departure_day = ? AND sailings.departure_hour = ?
+        return;
+    }
 
-        GROUP BY sailings.sailing_id_pk;
-    )SQL";
+    // 1) Creating the SQL query command:
+    const char* sql_query_sailing_report = DatabaseQueries::c_select_sailing_report_by_id;
 
     // 2) Prepare statement:
     sqlite3_stmt* prepared_sql_statement = nullptr;
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
+    ReadLease read_lease(this);
+
+    int return_code = acquireReadStatement(
+        read_lease.getReadConnection(),
         sql_query_sailing_report,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Get sailing report by ID failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
+        outcome_message = std::string("Get sailing report by ID failed: ") + std::string(sqlite3_errmsg(read_lease.getHandle()));
 
         return;
     }
 
     // 3) Bind key parameters:
-    sqlite3_bind_text(
+    sqlite3_bind_int64(
         prepared_sql_statement,
         1,
-        sailing.departure_terminal.c_str(),
-        -1,
-        SQLITE_TRANSIENT
-        );
-
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        2,
-        sailing.departure_day
-        );
-
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        3,
-        sailing.departure_hour
+        static_cast<sqlite3_int64>(sailing_key.getValue())
         );
 
     // 4) Execute:
@@ -935,190 +1495,219 @@ void Database::getSailingReportByID(
     else
     {
         is_successful = false;
-        outcome_message = std::string("Get sailing report by ID failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
+        outcome_message = std::string("Get sailing report by ID failed: ") + std::string(sqlite3_errmsg(read_lease.getHandle()));
     }
 
-    sqlite3_finalize(prepared_sql_statement);
+    releaseStatement(prepared_sql_statement);
 }
 
-void Database::addReservation(
-    Sailing sailing,
-    Vehicle vehicle,
+void Database::getReportBounds(
+    std::vector<std::string>& departure_terminals,
+    int& first_day,
+    int& last_day,
     bool& is_successful,
     std::string& outcome_message
     )
 {
-    // 1) Check space and choose a lane:
-    double new_low_remaining_length = sailing.low_remaining_length;
-    double new_high_remaining_length = sailing.high_remaining_length;
-    bool reserved_for_low_lane = false;
+    departure_terminals.clear();
+    first_day = 0;
+    last_day = -1;
 
-    if(vehicle.length <= sailing.low_remaining_length && vehicle.height <= 2)
-    {
-        reserved_for_low_lane = true;
-        new_low_remaining_length = sailing.low_remaining_length - vehicle.length - 0.5;
-    }
+    // Both come from one snapshot, so the terminals and days agree with each other:
+    ReadLease read_lease(this);
 
-    else if(vehicle.length <= sailing.high_remaining_length)
-    {
-        reserved_for_low_lane = false;
-        new_high_remaining_length = sailing.high_remaining_length - vehicle.length - 0.5;
-    }
+    // 1) The terminals:
+    sqlite3_stmt* prepared_sql_statement = nullptr;
 
-    else
+    int return_code = acquireReadStatement(
+        read_lease.getReadConnection(),
+        DatabaseQueries::c_select_departure_terminals,
+        prepared_sql_statement
+        );
+
+    if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Reservation creation failed: ") + std::string("not enough space on sailing.");
+        outcome_message = std::string("Get report bounds failed: ") + sqlite3_errmsg(read_lease.getHandle());
 
         return;
     }
 
-    // 2) Update sailings table to deduct the vehicle’s length:
-    const char* sql_query_update_sailing = R"SQL(
-        UPDATE sailings SET low_remaining_length = ?, high_remaining_length = ?
-        WHERE sailing_id_pk = ?;
-    )SQL";
-
-    sqlite3_stmt* prepared_sql_statement = nullptr;
+    while((return_code = sqlite3_step(prepared_sql_statement)) == SQLITE_ROW)
+    {
+        departure_terminals.push_back(columnText(prepared_sql_statement, 0));
+    }
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
-        sql_query_update_sailing,
-        -1,
-        &prepared_sql_statement,
-        nullptr
-        );
+    releaseStatement(prepared_sql_statement);
 
-    if(return_code != SQLITE_OK)
+    if(return_code != SQLITE_DONE)
     {
         is_successful = false;
-        outcome_message = std::string("Reservation creation failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Get report bounds failed: ") + sqlite3_errmsg(read_lease.getHandle());
 
         return;
     }
 
-    sqlite3_bind_double(
-        prepared_sql_statement,
-        1,
-        new_low_remaining_length
-        );
-
-    sqlite3_bind_double(
-        prepared_sql_statement,
-        2,
-        new_high_remaining_length
+    // 2) The days (both NULL when there are no sailings, which leaves the range empty):
+    return_code = acquireReadStatement(
+        read_lease.getReadConnection(),
+        DatabaseQueries::c_select_departure_day_range,
+        prepared_sql_statement
         );
 
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        3,
-        sailing.sailing_id
-        );
+    if(return_code == SQLITE_OK && (return_code = sqlite3_step(prepared_sql_statement)) == SQLITE_ROW)
+    {
+        bool has_sailings = (sqlite3_column_type(prepared_sql_statement, 0) != SQLITE_NULL);
+        int lowest_day = sqlite3_column_int(prepared_sql_statement, 0);
 
-    return_code = sqlite3_step(prepared_sql_statement);
+        if((return_code = sqlite3_step(prepared_sql_statement)) == SQLITE_ROW)
+        {
+            if(has_sailings)
+            {
+                first_day = lowest_day;
+                last_day = sqlite3_column_int(prepared_sql_statement, 0);
+            }
 
-    sqlite3_finalize(prepared_sql_statement);
+            return_code = SQLITE_OK;
+        }
+    }
 
-    if(return_code != SQLITE_DONE)
+    if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Reservation creation failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Get report bounds failed: ") + sqlite3_errmsg(read_lease.getHandle());
+
+        releaseStatement(prepared_sql_statement);
 
         return;
     }
 
-    // 3) Insert reservation record:
-    const char* sql_query_insert_reservation = R"SQL(
-        INSERT INTO reservations (sailing_id_fk, vehicle_id_fk, amount_paid, reserved_for_low_lane)
-        VALUES (?, ?, ?, ?);
-    )SQL";
+    releaseStatement(prepared_sql_statement);
 
-    return_code = sqlite3_prepare_v2(
-        m_sqlite3,
-        sql_query_insert_reservation,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+    is_successful = true;
+    outcome_message = std::string("Get report bounds succeeded");
+}
+
+void Database::getEndOfDayReport(
+    const ReportPartition& partition,
+    std::vector<EndOfDayReportRow>& rows,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // 1) Creating the SQL query command (a terminal is found through the unique sailing key, a range of days through the departure index):
+    const char* sql_query = partition.departure_terminal.empty() ? DatabaseQueries::c_select_end_of_day_report_by_days : DatabaseQueries::c_select_end_of_day_report_by_terminal;
+
+    // 2) Preparing the statement with bindings:
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    ReadLease read_lease(this);
+
+    int return_code = acquireReadStatement(
+        read_lease.getReadConnection(),
+        sql_query,
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Reservation creation failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
+        outcome_message = std::string("Get end-of-day report failed: ") + sqlite3_errmsg(read_lease.getHandle());
 
         return;
     }
 
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        1,
-        sailing.sailing_id
-        );
-
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        2,
-        vehicle.vehicle_id
-        );
-
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        3,
-        0 // NOTE (SAVIZ): When making a reservation, the starting amount should always be '0'.
-        );
+    sqlite3_bind_int(prepared_sql_statement, 1, partition.first_day);
+    sqlite3_bind_int(prepared_sql_statement, 2, partition.last_day);
 
-    // NOTE (SAVIZ): There simply isn’t a 'sqlite3_bind_bool()' in the API. Booleans in SQL are just integers:
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        4,
-        reserved_for_low_lane ? 1 : 0
-        );
+    if(!partition.departure_terminal.empty())
+    {
+        sqlite3_bind_text(prepared_sql_statement, 3, partition.departure_terminal.c_str(), -1, SQLITE_TRANSIENT);
+    }
 
-    return_code = sqlite3_step(prepared_sql_statement);
+    // 3) Executing and populating results:
+    rows.clear();
 
-    sqlite3_finalize(prepared_sql_statement);
+    while((return_code = sqlite3_step(prepared_sql_statement)) == SQLITE_ROW)
+    {
+        EndOfDayReportRow row;
+        SailingReport& sailing_report = row.sailing_report;
+
+        sailing_report.sailing.sailing_id = sqlite3_column_int(prepared_sql_statement, 0);
+        sailing_report.sailing.departure_terminal = columnText(prepared_sql_statement, 1);
+        sailing_report.sailing.departure_day = sqlite3_column_int(prepared_sql_statement, 2);
+        sailing_report.sailing.departure_hour = sqlite3_column_int(prepared_sql_statement, 3);
+        sailing_report.sailing.low_remaining_length = sqlite3_column_double(prepared_sql_statement, 4);
+        sailing_report.sailing.high_remaining_length = sqlite3_column_double(prepared_sql_statement, 5);
+        sailing_report.vessel.vessel_name = columnText(prepared_sql_statement, 6);
+        sailing_report.vehicle_count = sqlite3_column_int(prepared_sql_statement, 7);
+        sailing_report.occupancy_percentage = sqlite3_column_double(prepared_sql_statement, 8);
+
+        row.boarded_count = sqlite3_column_int(prepared_sql_statement, 9);
+        row.revenue = sqlite3_column_double(prepared_sql_statement, 10);
+
+        rows.push_back(std::move(row));
+    }
 
+    // 4.a) Check for errors in stepping:
     if(return_code != SQLITE_DONE)
     {
         is_successful = false;
-        outcome_message = std::string("Reservation creation failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
+        outcome_message = std::string("Get end-of-day report failed: ") + sqlite3_errmsg(read_lease.getHandle());
+
+        releaseStatement(prepared_sql_statement);
 
         return;
     }
 
-    // 4) Success
+    releaseStatement(prepared_sql_statement);
+
+    // 4.b) Success:
     is_successful = true;
-    outcome_message = std::string("Reservation creation succeeded");
+    outcome_message = std::string("Get end-of-day report succeeded");
 }
 
-void Database::removeReservation(
-    Sailing sailing,
+void Database::addReservation(
+    Sailing& sailing,
     Vehicle vehicle,
+    Reservation& reservation,
     bool& is_successful,
     std::string& outcome_message
     )
 {
-    // 1) Check 'reserved_for_low_lane' flag before deleting
-    const char* sql_query_check = R"SQL(
-        SELECT reserved_for_low_lane FROM reservations
-        WHERE sailing_id_fk = ? AND vehicle_id_fk = ?
-        LIMIT 1;
-    )SQL";
+    // NOTE (SAVIZ): The remaining lengths inside 'sailing' may be stale (another agent could have booked since it was fetched), so the lane is chosen by SQLite from the committed values, never from the snapshot.
+
+    // The cached sailing is taken out until the new remaining lengths are committed, then put back with them:
+    EntityWrite entity_write(this);
+
+    entity_write.takeSailing(sailing.sailing_id);
+
+    // 1) Take the write lock up front, so that both statements below see (and change) the same state of the sailing:
+    beginTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Reservation creation failed: ") + outcome_message;
+
+        return;
+    }
+
+    // 2) Insert the reservation only if the vehicle fits with its 0.5 meter gap, choosing the lane in the same step (low lane first, for vehicles up to 2 meters tall):
+    const char* sql_query_insert_reservation = DatabaseQueries::c_insert_reservation;
 
     sqlite3_stmt* prepared_sql_statement = nullptr;
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
-        sql_query_check,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+    int return_code = acquireStatement(
+        sql_query_insert_reservation,
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Reservation deletion failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Reservation creation failed: ") + sqlite3_errmsg(m_sqlite3);
+
+        rollbackTransaction();
 
         return;
     }
@@ -1135,48 +1724,73 @@ void Database::removeReservation(
         vehicle.vehicle_id
         );
 
+    sqlite3_bind_double(
+        prepared_sql_statement,
+        3,
+        vehicle.length
+        );
+
+    sqlite3_bind_double(
+        prepared_sql_statement,
+        4,
+        vehicle.height
+        );
+
     return_code = sqlite3_step(prepared_sql_statement);
 
-    int reserved_low = 0;
+    bool reserved_for_low_lane = false;
 
-    if (return_code == SQLITE_ROW)
+    if(return_code == SQLITE_ROW)
     {
-        reserved_low = sqlite3_column_int(
+        reserved_for_low_lane = sqlite3_column_int(
             prepared_sql_statement,
             0
-            );
+            ) != 0;
+
+        // NOTE (SAVIZ): A RETURNING statement only completes its change once it is stepped to the end.
+        return_code = sqlite3_step(prepared_sql_statement);
     }
 
-    else
+    else if(return_code == SQLITE_DONE)
     {
-        sqlite3_finalize(prepared_sql_statement);
+        releaseStatement(prepared_sql_statement);
 
         is_successful = false;
-        outcome_message = std::string("Reservation deletion failed: ") + std::string("reservation not found!");
+        outcome_message = std::string("Reservation creation failed: ") + std::string("not enough space on sailing.");
+
+        rollbackTransaction();
 
         return;
     }
 
-    sqlite3_finalize(prepared_sql_statement);
+    if(return_code != SQLITE_DONE)
+    {
+        is_successful = false;
+        outcome_message = std::string("Reservation creation failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
 
-    // 2) Delete the reservation record
-    const char* sql_query_delete_reservation = R"SQL(
-        DELETE FROM reservations
-        WHERE sailing_id_fk = ? AND vehicle_id_fk = ?;
-    )SQL";
+        releaseStatement(prepared_sql_statement);
 
-    return_code = sqlite3_prepare_v2(
-        m_sqlite3,
-        sql_query_delete_reservation,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+        rollbackTransaction();
+
+        return;
+    }
+
+    releaseStatement(prepared_sql_statement);
+
+    // 3) Deduct the vehicle's length (plus the 0.5 meter gap) from the chosen lane, guarded so it can never go below what was just checked:
+    const char* sql_query_update_sailing = DatabaseQueries::c_update_sailing_reserve;
+
+    return_code = acquireStatement(
+        sql_query_update_sailing,
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Reservation deletion failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Reservation creation failed: ") + sqlite3_errmsg(m_sqlite3);
+
+        rollbackTransaction();
 
         return;
     }
@@ -1187,112 +1801,126 @@ void Database::removeReservation(
         sailing.sailing_id
         );
 
-    sqlite3_bind_int(
+    sqlite3_bind_double(
         prepared_sql_statement,
         2,
-        vehicle.vehicle_id
+        vehicle.length
+        );
+
+    // NOTE (SAVIZ): There simply isn’t a 'sqlite3_bind_bool()' in the API. Booleans in SQL are just integers:
+    sqlite3_bind_int(
+        prepared_sql_statement,
+        3,
+        reserved_for_low_lane ? 1 : 0
         );
 
     return_code = sqlite3_step(prepared_sql_statement);
 
-    sqlite3_finalize(prepared_sql_statement);
+    double new_low_remaining_length = 0.0;
+    double new_high_remaining_length = 0.0;
 
-    if(return_code != SQLITE_DONE)
+    if(return_code == SQLITE_ROW)
     {
-        is_successful = false;
-        outcome_message = std::string("Reservation deletion failed: ") + sqlite3_errmsg(m_sqlite3);
-
-        return;
-    }
+        new_low_remaining_length = sqlite3_column_double(
+            prepared_sql_statement,
+            0
+            );
 
-    // 3) Return length to sailing lanes:
-    double amount = vehicle.length + 0.5;
+        new_high_remaining_length = sqlite3_column_double(
+            prepared_sql_statement,
+            1
+            );
 
-    const char* sql_query_update_sailing = nullptr;
+        return_code = sqlite3_step(prepared_sql_statement);
+    }
 
-    if (reserved_low)
+    else if(return_code == SQLITE_DONE)
     {
-        sql_query_update_sailing = "UPDATE sailings SET low_remaining_length = low_remaining_length + ? WHERE sailing_id_pk = ?;";
+        // This really shouldn’t happen, since we hold the write lock and just checked the space, but check anyway:
+        return_code = SQLITE_CONSTRAINT;
     }
 
-    else
+    if(return_code != SQLITE_DONE)
     {
-        sql_query_update_sailing = "UPDATE sailings SET high_remaining_length = high_remaining_length + ? WHERE sailing_id_pk = ?;";
-    }
+        is_successful = false;
+        outcome_message = std::string("Reservation creation failed: ") + (return_code == SQLITE_CONSTRAINT ? std::string("not enough space on sailing.") : std::string(sqlite3_errmsg(m_sqlite3)));
 
-    return_code = sqlite3_prepare_v2(
-        m_sqlite3,
-        sql_query_update_sailing,
-        -1,
-        &prepared_sql_statement,
-        nullptr
-        );
+        releaseStatement(prepared_sql_statement);
 
-    if(return_code != SQLITE_OK)
-    {
-        is_successful = false;
-        outcome_message = std::string("Reservation deletion failed: ") + sqlite3_errmsg(m_sqlite3);
+        rollbackTransaction();
 
         return;
     }
 
-    sqlite3_bind_double(
-        prepared_sql_statement,
-        1,
-        amount
-        );
-
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        2,
-        sailing.sailing_id
-        );
-
-    return_code = sqlite3_step(prepared_sql_statement);
+    releaseStatement(prepared_sql_statement);
 
-    sqlite3_finalize(prepared_sql_statement);
+    // 4) Make both changes durable together:
+    commitTransaction(is_successful, outcome_message);
 
-    if(return_code != SQLITE_DONE)
+    if(!is_successful)
     {
-        is_successful = false;
-        outcome_message = std::string("Reservation deletion failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Reservation creation failed: ") + outcome_message;
 
         return;
     }
 
-    // 4) Success
+    // 5) Success (hand back what was committed)
+    sailing.low_remaining_length = new_low_remaining_length;
+    sailing.high_remaining_length = new_high_remaining_length;
+
+    entity_write.setWrittenLengths(new_low_remaining_length, new_high_remaining_length);
+
+    reservation = Reservation(
+        sailing.sailing_id,
+        vehicle.vehicle_id,
+        0,
+        reserved_for_low_lane
+        );
+
     is_successful = true;
-    outcome_message = std::string("Reservation deletion succeeded: ") + "returned length = " + std::to_string(amount);
+    outcome_message = std::string("Reservation creation succeeded");
 }
 
-void Database::completeBoarding(
+void Database::removeReservation(
     Sailing sailing,
     Vehicle vehicle,
-    bool &is_successful,
-    std::string &outcome_message
+    bool& is_successful,
+    std::string& outcome_message
     )
 {
-    // 1) Check reservation exists:
-    const char* sql_query_check = R"SQL(
-        SELECT 1 FROM reservations
-        WHERE sailing_id_fk = ? AND vehicle_id_fk = ?
-        LIMIT 1;
-    )SQL";
+    EntityWrite entity_write(this);
+
+    if(m_entity_cache != nullptr)
+    {
+        m_entity_cache->invalidateSailing(sailing.sailing_id);
+    }
+
+    // NOTE (SAVIZ): The lane is read, the reservation deleted and its length given back in one transaction (or one savepoint of an open group), so a failure part way undoes all of it.
+    beginTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Reservation deletion failed: ") + outcome_message;
+
+        return;
+    }
+
+    // 1) Check 'reserved_for_low_lane' flag before deleting
+    const char* sql_query_check = DatabaseQueries::c_select_reservation_lane;
 
     sqlite3_stmt* prepared_sql_statement = nullptr;
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
+    int return_code = acquireStatement(
         sql_query_check,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Boarding failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Reservation deletion failed: ") + sqlite3_errmsg(m_sqlite3);
+
+        rollbackTransaction();
 
         return;
     }
@@ -1311,35 +1939,44 @@ void Database::completeBoarding(
 
     return_code = sqlite3_step(prepared_sql_statement);
 
-    sqlite3_finalize(prepared_sql_statement);
+    int reserved_low = 0;
+
+    if (return_code == SQLITE_ROW)
+    {
+        reserved_low = sqlite3_column_int(
+            prepared_sql_statement,
+            0
+            );
+    }
 
-    if(return_code != SQLITE_ROW)
+    else
     {
+        releaseStatement(prepared_sql_statement);
+
         is_successful = false;
-        outcome_message = std::string("Boarding failed: ") + std::string("No reserevation found.");
+        outcome_message = std::string("Reservation deletion failed: ") + std::string("reservation not found!");
+
+        rollbackTransaction();
 
         return;
     }
 
-    // 2) Check if vehicle is already boarded:
-    const char* sql_query_paid = R"SQL(
-        SELECT amount_paid FROM reservations
-        WHERE sailing_id_fk = ? AND vehicle_id_fk = ?
-        LIMIT 1;
-    )SQL";
+    releaseStatement(prepared_sql_statement);
 
-    return_code = sqlite3_prepare_v2(
-        m_sqlite3,
-        sql_query_paid,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+    // 2) Delete the reservation record
+    const char* sql_query_delete_reservation = DatabaseQueries::c_delete_reservation;
+
+    return_code = acquireStatement(
+        sql_query_delete_reservation,
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Boarding failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
+        outcome_message = std::string("Reservation deletion failed: ") + sqlite3_errmsg(m_sqlite3);
+
+        rollbackTransaction();
 
         return;
     }
@@ -1358,78 +1995,44 @@ void Database::completeBoarding(
 
     return_code = sqlite3_step(prepared_sql_statement);
 
-    if(return_code == SQLITE_ROW)
-    {
-        double already_paid = sqlite3_column_double(
-            prepared_sql_statement,
-            0
-            );
-
-        sqlite3_finalize(prepared_sql_statement);
-
-        if(already_paid != 0.0)
-        {
-            is_successful = false;
-            outcome_message = std::string("Boarding failed: ") + std::string("vehicle has already been boarded (amount_paid = ") + std::to_string(already_paid) + ").";
-
-            return;
-        }
-    }
+    releaseStatement(prepared_sql_statement);
 
-    else
+    if(return_code != SQLITE_DONE)
     {
-        // This really shouldn’t happen, since we just saw the row, but check anyway:
-        sqlite3_finalize(prepared_sql_statement);
-
         is_successful = false;
-        outcome_message = std::string("Boarding failed: ") + std::string("could not verify prior payment status.");
+        outcome_message = std::string("Reservation deletion failed: ") + sqlite3_errmsg(m_sqlite3);
+
+        rollbackTransaction();
 
         return;
     }
 
-    // 3) Calculate amount to be paid:
-    double amount = 0.0;
-
-    bool is_not_tall_and_not_long = false;
+    // 3) Return length to sailing lanes:
+    double amount = vehicle.length + 0.5;
 
-    // Long vehicles pay $2 per meter:
-    if(vehicle.length > 7.0)
-    {
-        amount += vehicle.length * 2.0;
-        is_not_tall_and_not_long = true;
-    }
+    const char* sql_query_update_sailing = nullptr;
 
-    // Tall vehicles pay $3 per meter:
-    if(vehicle.height > 2.0)
+    if (reserved_low)
     {
-        amount += vehicle.length * 3.0;
-        is_not_tall_and_not_long = true;
+        sql_query_update_sailing = DatabaseQueries::c_update_sailing_release_low;
     }
 
-    // Short & low vehicles pay a flat fee
-    if(is_not_tall_and_not_long)
+    else
     {
-        amount = 14.0;
+        sql_query_update_sailing = DatabaseQueries::c_update_sailing_release_high;
     }
 
-    // 4) Update amount_paid in reservations
-    const char* sql_query_update = R"SQL(
-        UPDATE reservations SET amount_paid = ?
-        WHERE sailing_id_fk = ? AND vehicle_id_fk = ?;
-    )SQL";
-
-    return_code = sqlite3_prepare_v2(
-        m_sqlite3,
-        sql_query_update,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+    return_code = acquireStatement(
+        sql_query_update_sailing,
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
     {
-        is_successful  = false;
-        outcome_message = std::string("Boarding failed: ") + sqlite3_errmsg(m_sqlite3);
+        is_successful = false;
+        outcome_message = std::string("Reservation deletion failed: ") + sqlite3_errmsg(m_sqlite3);
+
+        rollbackTransaction();
 
         return;
     }
@@ -1446,164 +2049,492 @@ void Database::completeBoarding(
         sailing.sailing_id
         );
 
-    sqlite3_bind_int(
-        prepared_sql_statement,
-        3,
-        vehicle.vehicle_id
-        );
-
     return_code = sqlite3_step(prepared_sql_statement);
 
-    sqlite3_finalize(prepared_sql_statement);
+    releaseStatement(prepared_sql_statement);
 
     if(return_code != SQLITE_DONE)
     {
         is_successful = false;
-        outcome_message = std::string("Boarding failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Reservation deletion failed: ") + sqlite3_errmsg(m_sqlite3);
+
+        rollbackTransaction();
+
+        return;
+    }
+
+    // 4) Commit
+    commitTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Reservation deletion failed: ") + outcome_message;
 
         return;
     }
 
     // 5) Success
     is_successful = true;
-    outcome_message = std::string("Boarding complete: amount_paid = ") + std::to_string(amount);
+    outcome_message = std::string("Reservation deletion succeeded: ") + "returned length = " + std::to_string(amount);
 }
 
-void Database::addVehicle(
-    Vehicle vehicle,
-    int& vehicle_id,
+void Database::getSailingManifest(
+    int sailing_id,
+    std::vector<ManifestEntry>& entries,
     bool& is_successful,
     std::string& outcome_message
     )
 {
-    // 1) Prepare INSERT INTO vehicles
-    const char* sql_query_add_vehicle = R"SQL(
-        INSERT INTO vehicles (license_plate, phone_number, length, height)
-        VALUES (?, ?, ?, ?);
-    )SQL";
-
+    // 1) Preparing the statement with bindings:
     sqlite3_stmt* prepared_sql_statement = nullptr;
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
-        sql_query_add_vehicle,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+    ReadLease read_lease(this);
+
+    int return_code = acquireReadStatement(
+        read_lease.getReadConnection(),
+        DatabaseQueries::c_select_sailing_manifest,
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Vehicle creation failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Get sailing manifest failed: ") + sqlite3_errmsg(read_lease.getHandle());
 
         return;
     }
 
-    // 2) Bind parameters: license_plate, phone_number, length
-    sqlite3_bind_text(
-        prepared_sql_statement,
-        1,
-        vehicle.license_plate.c_str(),
-        -1,
-        SQLITE_TRANSIENT
-        );
-
-    sqlite3_bind_text(
-        prepared_sql_statement,
-        2,
-        vehicle.phone_number.c_str(),
-        -1,
-        SQLITE_TRANSIENT
-        );
-
-    sqlite3_bind_double(
-        prepared_sql_statement,
-        3,
-        vehicle.length
-        );
-
-    sqlite3_bind_double(
-        prepared_sql_statement,
-        4,
-        vehicle.height
-        );
+    sqlite3_bind_int(prepared_sql_statement, 1, sailing_id);
 
-    // 3) Execute insertion
-    return_code = sqlite3_step(prepared_sql_statement);
+    // 2) Executing and populating results:
+    entries.clear();
 
-    sqlite3_finalize(prepared_sql_statement);
+    while((return_code = sqlite3_step(prepared_sql_statement)) == SQLITE_ROW)
+    {
+        ManifestEntry entry;
+
+        entry.vehicle.vehicle_id = sqlite3_column_int(prepared_sql_statement, 0);
+        entry.vehicle.license_plate = columnText(prepared_sql_statement, 1);
+        entry.vehicle.phone_number = columnText(prepared_sql_statement, 2);
+        entry.vehicle.length = sqlite3_column_double(prepared_sql_statement, 3);
+        entry.vehicle.height = sqlite3_column_double(prepared_sql_statement, 4);
+        entry.reserved_for_low_lane = sqlite3_column_int(prepared_sql_statement, 5) != 0;
+        entry.amount_paid = sqlite3_column_double(prepared_sql_statement, 6);
+        entry.is_boarded = entry.amount_paid > 0.0;
+
+        entries.push_back(std::move(entry));
+    }
 
-    if (return_code != SQLITE_DONE)
+    // 3.a) Check for errors in stepping:
+    if(return_code != SQLITE_DONE)
     {
         is_successful = false;
-        outcome_message = std::string("Vehicle creation failed: ") + sqlite3_errmsg(m_sqlite3);
+        outcome_message = std::string("Get sailing manifest failed: ") + sqlite3_errmsg(read_lease.getHandle());
+
+        releaseStatement(prepared_sql_statement);
 
         return;
     }
 
-    // 4) Retrieve new vehicle ID
-    vehicle_id = static_cast<int>(sqlite3_last_insert_rowid(m_sqlite3));
+    releaseStatement(prepared_sql_statement);
 
+    // 3.b) Success:
     is_successful = true;
-    outcome_message = std::string("Vehicle created succeeded");
+    outcome_message = std::string("Get sailing manifest succeeded");
 }
 
-void Database::getVehicleByID(
-    std::string license_plate,
-    Vehicle& vehicle,
-    bool& is_successful,
-    std::string& outcome_message
+void Database::completeBoarding(
+    Sailing sailing,
+    Vehicle vehicle,
+    bool &is_successful,
+    std::string &outcome_message
     )
 {
-    // 1) Creating the SQL query command:
-    const char* sql_query = R"SQL(
-        SELECT vehicle_id_pk, license_plate, phone_number, length, height FROM vehicles
-        WHERE license_plate = ?
-    )SQL";
+    // NOTE (SAVIZ): Boarding happens once per car, so it is done in a single statement (one lookup, one commit).
+    // The fare is computed by SQLite from the bound length and height, and the 'amount_paid = 0' guard makes sure a vehicle is never charged twice.
+    // The statement still goes through 'beginTransaction()', so that with group commit on it joins the open group under its own savepoint.
+    beginTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Boarding failed: ") + outcome_message;
+
+        return;
+    }
+
+    // 1) Charge the fare, only if the reservation exists and has not been boarded yet:
+    const char* sql_query_board = DatabaseQueries::c_update_reservation_boarding;
 
-    // 2) Preparing the statement with bindings:
     sqlite3_stmt* prepared_sql_statement = nullptr;
 
-    int return_code = sqlite3_prepare_v2(
-        m_sqlite3,
-        sql_query,
-        -1,
-        &prepared_sql_statement,
-        nullptr
+    int return_code = acquireStatement(
+        sql_query_board,
+        prepared_sql_statement
         );
 
     if(return_code != SQLITE_OK)
     {
         is_successful = false;
-        outcome_message = std::string("Get vehicle by ID failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
+        outcome_message = std::string("Boarding failed: ") + sqlite3_errmsg(m_sqlite3);
+
+        rollbackTransaction();
 
         return;
     }
 
-    sqlite3_bind_text(
+    sqlite3_bind_int(
         prepared_sql_statement,
         1,
-        license_plate.c_str(),
-        -1,
-        SQLITE_TRANSIENT
+        sailing.sailing_id
+        );
+
+    sqlite3_bind_int(
+        prepared_sql_statement,
+        2,
+        vehicle.vehicle_id
+        );
+
+    sqlite3_bind_double(
+        prepared_sql_statement,
+        3,
+        vehicle.length
+        );
+
+    sqlite3_bind_double(
+        prepared_sql_statement,
+        4,
+        vehicle.height
         );
 
-    // 3) Executing:
     return_code = sqlite3_step(prepared_sql_statement);
 
-    // Row found! Extract each column by index:
-    if (return_code == SQLITE_ROW)
+    bool is_boarded = false;
+    double amount = 0.0;
+
+    if(return_code == SQLITE_ROW)
     {
-        vehicle.vehicle_id = sqlite3_column_int(
+        is_boarded = true;
+
+        amount = sqlite3_column_double(
             prepared_sql_statement,
             0
             );
 
-        const unsigned char* license_plate_data_column = sqlite3_column_text(
-            prepared_sql_statement,
-            1
-            );
+        // NOTE (SAVIZ): A RETURNING statement only completes its change once it is stepped to the end.
+        return_code = sqlite3_step(prepared_sql_statement);
+    }
+
+    if(return_code != SQLITE_DONE)
+    {
+        is_successful = false;
+        outcome_message = std::string("Boarding failed: ") + sqlite3_errmsg(m_sqlite3);
+
+        releaseStatement(prepared_sql_statement);
+
+        rollbackTransaction();
+
+        return;
+    }
+
+    releaseStatement(prepared_sql_statement);
+
+    if(is_boarded)
+    {
+        commitTransaction(is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            outcome_message = std::string("Boarding failed: ") + outcome_message;
+
+            return;
+        }
+
+        // 2) Success
+        is_successful = true;
+        outcome_message = std::string("Boarding complete: amount_paid = ") + std::to_string(amount);
+
+        return;
+    }
+
+    // Nothing was changed, so there is nothing to keep:
+    rollbackTransaction();
+
+    // 3) Nothing was changed. Only now (the uncommon path) find out whether the reservation is missing or already boarded:
+    const char* sql_query_paid = DatabaseQueries::c_select_reservation_amount_paid;
+
+    return_code = acquireStatement(
+        sql_query_paid,
+        prepared_sql_statement
+        );
+
+    if(return_code != SQLITE_OK)
+    {
+        is_successful = false;
+        outcome_message = std::string("Boarding failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
+
+        return;
+    }
+
+    sqlite3_bind_int(
+        prepared_sql_statement,
+        1,
+        sailing.sailing_id
+        );
+
+    sqlite3_bind_int(
+        prepared_sql_statement,
+        2,
+        vehicle.vehicle_id
+        );
+
+    return_code = sqlite3_step(prepared_sql_statement);
+
+    if(return_code == SQLITE_ROW)
+    {
+        double already_paid = sqlite3_column_double(
+            prepared_sql_statement,
+            0
+            );
+
+        is_successful = false;
+        outcome_message = std::string("Boarding failed: ") + std::string("vehicle has already been boarded (amount_paid = ") + std::to_string(already_paid) + ").";
+    }
+
+    else if(return_code == SQLITE_DONE)
+    {
+        is_successful = false;
+        outcome_message = std::string("Boarding failed: ") + std::string("No reserevation found.");
+    }
+
+    else
+    {
+        is_successful = false;
+        outcome_message = std::string("Boarding failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
+    }
+
+    releaseStatement(prepared_sql_statement);
+}
+
+void Database::addVehicle(
+    Vehicle vehicle,
+    int& vehicle_id,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // Vehicles are keyed by the packed plate, so a plate that does not pack could never be found again:
+    std::int64_t license_plate_key = 0;
+
+    if(!PackedKey::packLicensePlate(vehicle.license_plate, license_plate_key))
+    {
+        is_successful = false;
+        outcome_message = std::string("Vehicle creation failed: ") + "Invalid vehicle!";
+
+        return;
+    }
+
+    EntityWrite entity_write(this);
+
+    if(m_entity_cache != nullptr)
+    {
+        m_entity_cache->invalidateVehicle(license_plate_key);
+    }
+
+    // NOTE (SAVIZ): A single statement, but it goes through 'beginTransaction()' so that it can join an open group (see 'setGroupCommit()').
+    beginTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Vehicle creation failed: ") + outcome_message;
+
+        return;
+    }
+
+    // 1) Prepare INSERT INTO vehicles
+    const char* sql_query_add_vehicle = DatabaseQueries::c_insert_vehicle;
+
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    int return_code = acquireStatement(
+        sql_query_add_vehicle,
+        prepared_sql_statement
+        );
+
+    if(return_code != SQLITE_OK)
+    {
+        is_successful = false;
+        outcome_message = std::string("Vehicle creation failed: ") + sqlite3_errmsg(m_sqlite3);
+
+        rollbackTransaction();
+
+        return;
+    }
+
+    // 2) Bind parameters: license_plate, phone_number, length
+    sqlite3_bind_text(
+        prepared_sql_statement,
+        1,
+        vehicle.license_plate.c_str(),
+        -1,
+        SQLITE_TRANSIENT
+        );
+
+    sqlite3_bind_text(
+        prepared_sql_statement,
+        2,
+        vehicle.phone_number.c_str(),
+        -1,
+        SQLITE_TRANSIENT
+        );
+
+    sqlite3_bind_double(
+        prepared_sql_statement,
+        3,
+        vehicle.length
+        );
+
+    sqlite3_bind_double(
+        prepared_sql_statement,
+        4,
+        vehicle.height
+        );
+
+    // 3) Execute insertion
+    return_code = sqlite3_step(prepared_sql_statement);
+
+    releaseStatement(prepared_sql_statement);
+
+    if (return_code != SQLITE_DONE)
+    {
+        is_successful = false;
+        outcome_message = std::string("Vehicle creation failed: ") + sqlite3_errmsg(m_sqlite3);
+
+        rollbackTransaction();
+
+        return;
+    }
+
+    // 4) Retrieve new vehicle ID (before the commit, which could run other statements)
+    int new_vehicle_id = static_cast<int>(sqlite3_last_insert_rowid(m_sqlite3));
+
+    // NOTE (SAVIZ): Added before the commit, as a plate too many only costs a lookup, but a plate missing from the filter would hide the vehicle.
+    if(m_plate_filter != nullptr)
+    {
+        m_plate_filter->insert(vehicle.license_plate);
+    }
+
+    commitTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Vehicle creation failed: ") + outcome_message;
+
+        return;
+    }
+
+    vehicle_id = new_vehicle_id;
+
+    is_successful = true;
+    outcome_message = std::string("Vehicle created succeeded");
+}
+
+void Database::getVehicleByID(
+    std::string license_plate,
+    Vehicle& vehicle,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // 0) Vehicles are keyed by the packed plate (see 'packed_key.hpp'). A plate that does not pack cannot be in the table:
+    std::int64_t license_plate_key = 0;
+
+    if(!PackedKey::packLicensePlate(license_plate, license_plate_key))
+    {
+        is_successful = false;
+        outcome_message = std::string("Get vehicle by failed: ") + std::string("No vehicle found with license plate = ") + license_plate;
+
+        return;
+    }
+
+    // A vehicle looked up before is answered from the entity cache (see 'setEntityCache()'):
+    std::uint64_t read_generation = 0;
+
+    if(m_entity_cache != nullptr)
+    {
+        if(m_entity_cache->findVehicle(license_plate_key, vehicle))
+        {
+            is_successful = true;
+            outcome_message = std::string("Get vehicle by ID succeeded.");
+
+            return;
+        }
+
+        read_generation = m_entity_cache->getGeneration();
+    }
+
+    // A plate the filter has never seen (a walk-up, usually) is not in the table either, once the filter has read the vehicles created since it last looked (see 'setPlateFilter()'):
+    if(m_plate_filter != nullptr && !m_plate_filter->mayContain(license_plate))
+    {
+        bool is_caught_up = false;
+        std::string catch_up_message = "";
+
+        m_plate_filter->catchUp(*this, is_caught_up, catch_up_message);
+
+        // If the new vehicles cannot be read, the plate is looked up as if there were no filter:
+        if(is_caught_up && !m_plate_filter->mayContain(license_plate))
+        {
+            m_plate_filter->recordRuledOut();
+
+            is_successful = false;
+            outcome_message = std::string("Get vehicle by failed: ") + std::string("No vehicle found with license plate = ") + license_plate;
+
+            return;
+        }
+    }
+
+    // 1) Creating the SQL query command:
+    const char* sql_query = DatabaseQueries::c_select_vehicle_by_license_plate;
+
+    // 2) Preparing the statement with bindings:
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    ReadLease read_lease(this);
+
+    int return_code = acquireReadStatement(
+        read_lease.getReadConnection(),
+        sql_query,
+        prepared_sql_statement
+        );
+
+    if(return_code != SQLITE_OK)
+    {
+        is_successful = false;
+        outcome_message = std::string("Get vehicle by ID failed: ") + std::string(sqlite3_errmsg(read_lease.getHandle()));
+
+        return;
+    }
+
+    sqlite3_bind_int64(
+        prepared_sql_statement,
+        1,
+        license_plate_key
+        );
+
+    // 3) Executing:
+    return_code = sqlite3_step(prepared_sql_statement);
+
+    // Row found! Extract each column by index:
+    if (return_code == SQLITE_ROW)
+    {
+        vehicle.vehicle_id = sqlite3_column_int(
+            prepared_sql_statement,
+            0
+            );
+
+        const unsigned char* license_plate_data_column = sqlite3_column_text(
+            prepared_sql_statement,
+            1
+            );
 
         vehicle.license_plate = license_plate_data_column ? reinterpret_cast<const char*>(license_plate_data_column) : std::string();
 
@@ -1626,6 +2557,11 @@ void Database::getVehicleByID(
 
         is_successful = true;
         outcome_message = std::string("Get vehicle by ID succeeded.");
+
+        if(m_entity_cache != nullptr && read_lease.isFresh())
+        {
+            m_entity_cache->insertVehicle(license_plate_key, vehicle, read_generation);
+        }
     }
 
     // Operation completed, but row was not found:
@@ -1639,9 +2575,1095 @@ void Database::getVehicleByID(
     else
     {
         is_successful = false;
-        outcome_message = std::string("Get vehicle by failed: ") + std::string(sqlite3_errmsg(m_sqlite3));
+        outcome_message = std::string("Get vehicle by failed: ") + std::string(sqlite3_errmsg(read_lease.getHandle()));
     }
 
     // 4) Clean up:
-    sqlite3_finalize(prepared_sql_statement);
+    releaseStatement(prepared_sql_statement);
+
+    // Tells the filter how often it let a missing plate through:
+    if(m_plate_filter != nullptr && (return_code == SQLITE_ROW || return_code == SQLITE_DONE))
+    {
+        m_plate_filter->recordLookup(return_code == SQLITE_ROW);
+    }
+}
+
+void Database::getVehiclePlates(
+    int first_vehicle_id,
+    std::vector<int>& vehicle_ids,
+    std::vector<std::string>& license_plates,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    vehicle_ids.clear();
+    license_plates.clear();
+
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    ReadLease read_lease(this);
+
+    int return_code = acquireReadStatement(
+        read_lease.getReadConnection(),
+        DatabaseQueries::c_select_vehicle_plates_from,
+        prepared_sql_statement
+        );
+
+    if(return_code != SQLITE_OK)
+    {
+        is_successful = false;
+        outcome_message = std::string("Get vehicle plates failed: ") + std::string(sqlite3_errmsg(read_lease.getHandle()));
+
+        return;
+    }
+
+    sqlite3_bind_int(prepared_sql_statement, 1, first_vehicle_id);
+
+    while((return_code = sqlite3_step(prepared_sql_statement)) == SQLITE_ROW)
+    {
+        vehicle_ids.push_back(sqlite3_column_int(prepared_sql_statement, 0));
+        license_plates.push_back(columnText(prepared_sql_statement, 1));
+    }
+
+    if(return_code != SQLITE_DONE)
+    {
+        vehicle_ids.clear();
+        license_plates.clear();
+
+        is_successful = false;
+        outcome_message = std::string("Get vehicle plates failed: ") + std::string(sqlite3_errmsg(read_lease.getHandle()));
+
+        releaseStatement(prepared_sql_statement);
+
+        return;
+    }
+
+    releaseStatement(prepared_sql_statement);
+
+    is_successful = true;
+    outcome_message = std::string("Get vehicle plates succeeded");
+}
+
+void Database::migrateSchema(
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // NOTE (SAVIZ): Each migration runs in its own write transaction and re-reads the version inside it, so two terminals starting at the same time cannot both apply the same migration.
+    while(true)
+    {
+        beginTransaction(is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            return;
+        }
+
+        std::string version_text;
+
+        int return_code = queryPragma(m_sqlite3, DatabaseQueries::c_select_schema_version, version_text);
+
+        if(return_code != SQLITE_OK)
+        {
+            is_successful = false;
+            outcome_message = std::string("could not read the schema version: ") + sqlite3_errmsg(m_sqlite3);
+
+            rollbackTransaction();
+
+            return;
+        }
+
+        int version = std::stoi(version_text);
+
+        // Up to date (or created by a newer version of the program, which we leave alone):
+        if(version >= DatabaseQueries::c_schema_version)
+        {
+            rollbackTransaction();
+
+            is_successful = true;
+            outcome_message = std::string("Schema is at version ") + std::to_string(version);
+
+            return;
+        }
+
+        // NOTE (SAVIZ): PRAGMA values cannot be bound as parameters, so the new version is written into the text (it is a number we produced ourselves).
+        std::string sql_query = std::string(DatabaseQueries::c_schema_migrations[version]) + "PRAGMA user_version = " + std::to_string(version + 1) + ";";
+
+        char* error_message = nullptr;
+
+        return_code = sqlite3_exec(m_sqlite3, sql_query.c_str(), nullptr, nullptr, &error_message);
+
+        if(return_code != SQLITE_OK)
+        {
+            is_successful = false;
+            outcome_message = std::string("migration to schema version ") + std::to_string(version + 1) + " failed: " + (error_message ? error_message : sqlite3_errmsg(m_sqlite3));
+
+            sqlite3_free(error_message);
+
+            rollbackTransaction();
+
+            return;
+        }
+
+        commitTransaction(is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            return;
+        }
+    }
+}
+
+void Database::beginTransaction(
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // Until this transaction ends, the reads of this thread must see its writes (see 'leaseReadConnection()'):
+    m_writing_thread.store(std::this_thread::get_id());
+
+    if(m_group_commit_settings.max_operations <= 1)
+    {
+        // NOTE (SAVIZ): 'IMMEDIATE' takes the write lock at the start. A plain 'BEGIN' would only upgrade when it first writes, and two connections upgrading at the same time deadlock into SQLITE_BUSY.
+        executeStatement(DatabaseQueries::c_begin_transaction, is_successful, outcome_message);
+
+        return;
+    }
+
+    // 1) The first write of a group opens the transaction that the following ones join:
+    if(!m_is_group_open)
+    {
+        executeStatement(DatabaseQueries::c_begin_transaction, is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            return;
+        }
+
+        m_is_group_open = true;
+        m_group_operation_count = 0;
+        m_group_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_group_commit_settings.max_delay_milliseconds);
+    }
+
+    // 2) Each write gets its own savepoint, so it can be undone without touching the rest of the group:
+    executeStatement(DatabaseQueries::c_savepoint_operation, is_successful, outcome_message);
+}
+
+void Database::commitTransaction(
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    if(!m_is_group_open)
+    {
+        executeStatement(DatabaseQueries::c_commit_transaction, is_successful, outcome_message);
+
+        // If the commit itself failed (e.g. disk I/O error), the transaction is still open and must not leak into the next call:
+        if(!is_successful && sqlite3_get_autocommit(m_sqlite3) == 0)
+        {
+            rollbackTransaction();
+        }
+
+        return;
+    }
+
+    // 1) Keep the write's changes in the group:
+    executeStatement(DatabaseQueries::c_release_operation, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        rollbackTransaction();
+
+        return;
+    }
+
+    ++m_group_operation_count;
+
+    // 2) Commit the group once it is full or has waited long enough. The write that triggers the commit reports its outcome:
+    if(m_group_operation_count >= m_group_commit_settings.max_operations || std::chrono::steady_clock::now() >= m_group_deadline)
+    {
+        flushGroupCommit(is_successful, outcome_message);
+    }
+}
+
+void Database::rollbackTransaction()
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    // NOTE (SAVIZ): Some errors roll the transaction back on their own, in which case there is nothing left to undo.
+    if(sqlite3_get_autocommit(m_sqlite3) != 0)
+    {
+        // ...but inside a group, the writes that came before were lost with it, which must be reported:
+        if(m_is_group_open)
+        {
+            flushGroupCommit(is_successful, outcome_message);
+        }
+
+        return;
+    }
+
+    if(m_is_group_open)
+    {
+        executeStatement(DatabaseQueries::c_rollback_to_operation, is_successful, outcome_message);
+        executeStatement(DatabaseQueries::c_release_operation, is_successful, outcome_message);
+
+        return;
+    }
+
+    executeStatement(DatabaseQueries::c_rollback_transaction, is_successful, outcome_message);
+}
+
+void Database::setGroupCommit(
+    const GroupCommitSettings& settings,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    if(settings.max_operations < 1 || settings.max_delay_milliseconds < 0)
+    {
+        is_successful = false;
+        outcome_message = std::string("Group commit request failed: ") + "max_operations must be at least 1 and max_delay_milliseconds cannot be negative.";
+
+        return;
+    }
+
+    // Whatever was grouped under the old settings is committed under them:
+    flushGroupCommit(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Group commit request failed: ") + outcome_message;
+
+        return;
+    }
+
+    m_group_commit_settings = settings;
+
+    is_successful = true;
+    outcome_message = std::string("Group commit request succeeded");
+}
+
+void Database::flushGroupCommit(
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    if(!m_is_group_open)
+    {
+        is_successful = true;
+        outcome_message = std::string("No writes to commit");
+
+        return;
+    }
+
+    m_is_group_open = false;
+    m_group_operation_count = 0;
+
+    if(sqlite3_get_autocommit(m_sqlite3) != 0)
+    {
+        is_successful = false;
+        outcome_message = std::string("Group commit failed: ") + std::string("an earlier error rolled back every write in the group.");
+    }
+
+    else
+    {
+        executeStatement(DatabaseQueries::c_commit_transaction, is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            outcome_message = std::string("Group commit failed: ") + outcome_message;
+
+            // The group is closed at this point, so this is a plain rollback of the whole transaction:
+            rollbackTransaction();
+        }
+
+        else
+        {
+            outcome_message = std::string("Group commit succeeded");
+        }
+    }
+
+    m_last_group_is_successful = is_successful;
+    m_last_group_outcome_message = is_successful ? std::string("") : outcome_message;
+
+    // Committed or rolled back, the group is over:
+    endEntityWrite();
+}
+
+bool Database::hasPendingWrites() const
+{
+    return(m_is_group_open);
+}
+
+std::chrono::steady_clock::time_point Database::getGroupCommitDeadline() const
+{
+    return(m_group_deadline);
+}
+
+void Database::getLastGroupCommitOutcome(
+    bool& is_successful,
+    std::string& outcome_message
+    ) const
+{
+    is_successful = m_last_group_is_successful;
+    outcome_message = m_last_group_outcome_message;
+}
+
+void Database::importVessels(
+    const std::vector<Vessel>& vessels,
+    std::vector<bool>& is_imported,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    importRows(
+        s_import_vessels_batch.c_str(),
+        s_import_vessels_row.c_str(),
+        vessels.size(),
+        3,
+        [&vessels](sqlite3_stmt* prepared_sql_statement, std::size_t row, int parameter)
+        {
+            sqlite3_bind_text(prepared_sql_statement, parameter, vessels[row].vessel_name.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_double(prepared_sql_statement, parameter + 1, vessels[row].low_ceiling_lane_length);
+            sqlite3_bind_double(prepared_sql_statement, parameter + 2, vessels[row].high_ceiling_lane_length);
+        },
+        [&vessels](std::size_t row) { return(vessels[row].vessel_name); },
+        [](sqlite3_stmt* prepared_sql_statement) { return(columnText(prepared_sql_statement, 0)); },
+        is_imported,
+        is_successful,
+        outcome_message
+        );
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Vessel import failed: ") + outcome_message;
+
+        return;
+    }
+
+    outcome_message = std::string("Vessel import succeeded");
+}
+
+void Database::importSailings(
+    const std::vector<NamedSailing>& sailings,
+    std::vector<bool>& is_imported,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // The key of a sailing is its sailing ID, which is what the UNIQUE constraint is on:
+    auto make_key = [](const std::string& departure_terminal, int departure_day, int departure_hour)
+    {
+        return(departure_terminal + "-" + std::to_string(departure_day) + "-" + std::to_string(departure_hour));
+    };
+
+    importRows(
+        s_import_sailings_batch.c_str(),
+        s_import_sailings_row.c_str(),
+        sailings.size(),
+        4,
+        [&sailings](sqlite3_stmt* prepared_sql_statement, std::size_t row, int parameter)
+        {
+            sqlite3_bind_text(prepared_sql_statement, parameter, sailings[row].vessel_name.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(prepared_sql_statement, parameter + 1, sailings[row].departure_terminal.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int(prepared_sql_statement, parameter + 2, sailings[row].departure_day);
+            sqlite3_bind_int(prepared_sql_statement, parameter + 3, sailings[row].departure_hour);
+        },
+        [&sailings, &make_key](std::size_t row) { return(make_key(sailings[row].departure_terminal, sailings[row].departure_day, sailings[row].departure_hour)); },
+        [&make_key](sqlite3_stmt* prepared_sql_statement) { return(make_key(columnText(prepared_sql_statement, 0), sqlite3_column_int(prepared_sql_statement, 1), sqlite3_column_int(prepared_sql_statement, 2))); },
+        is_imported,
+        is_successful,
+        outcome_message
+        );
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Sailing import failed: ") + outcome_message;
+
+        return;
+    }
+
+    outcome_message = std::string("Sailing import succeeded");
+}
+
+void Database::importVehicles(
+    const std::vector<Vehicle>& vehicles,
+    std::vector<bool>& is_imported,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    importRows(
+        s_import_vehicles_batch.c_str(),
+        s_import_vehicles_row.c_str(),
+        vehicles.size(),
+        4,
+        [&vehicles](sqlite3_stmt* prepared_sql_statement, std::size_t row, int parameter)
+        {
+            sqlite3_bind_text(prepared_sql_statement, parameter, vehicles[row].license_plate.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(prepared_sql_statement, parameter + 1, vehicles[row].phone_number.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_double(prepared_sql_statement, parameter + 2, vehicles[row].length);
+            sqlite3_bind_double(prepared_sql_statement, parameter + 3, vehicles[row].height);
+        },
+        [&vehicles](std::size_t row) { return(vehicles[row].license_plate); },
+        [](sqlite3_stmt* prepared_sql_statement) { return(columnText(prepared_sql_statement, 0)); },
+        is_imported,
+        is_successful,
+        outcome_message
+        );
+
+    // Whatever was imported joins the plate filter (rows ignored as duplicates are in it already):
+    if(m_plate_filter != nullptr)
+    {
+        for(std::size_t row = 0; row < vehicles.size(); ++row)
+        {
+            if(is_imported[row])
+            {
+                m_plate_filter->insert(vehicles[row].license_plate);
+            }
+        }
+    }
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Vehicle import failed: ") + outcome_message;
+
+        return;
+    }
+
+    outcome_message = std::string("Vehicle import succeeded");
+}
+
+void Database::importRows(
+    const char* batch_sql_query,
+    const char* row_sql_query,
+    std::size_t row_count,
+    int column_count,
+    const std::function<void(sqlite3_stmt*, std::size_t, int)>& bind_row,
+    const std::function<std::string(std::size_t)>& get_row_key,
+    const std::function<std::string(sqlite3_stmt*)>& get_returned_key,
+    std::vector<bool>& is_imported,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // An import can touch any number of rows, so the whole entity cache is dropped:
+    EntityWrite entity_write(this);
+
+    if(m_entity_cache != nullptr)
+    {
+        m_entity_cache->invalidateAll();
+    }
+
+    is_imported.assign(row_count, false);
+
+    beginTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    std::size_t first_row = 0;
+
+    while(first_row < row_count)
+    {
+        // 1) Full batches while there are enough rows left, then one row at a time:
+        bool is_full_batch = row_count - first_row >= static_cast<std::size_t>(DatabaseQueries::c_import_batch_rows);
+
+        std::size_t batch_row_count = is_full_batch ? static_cast<std::size_t>(DatabaseQueries::c_import_batch_rows) : 1;
+
+        sqlite3_stmt* prepared_sql_statement = nullptr;
+
+        int return_code = acquireStatement(
+            is_full_batch ? batch_sql_query : row_sql_query,
+            prepared_sql_statement
+            );
+
+        if(return_code != SQLITE_OK)
+        {
+            is_successful = false;
+            outcome_message = std::string(sqlite3_errmsg(m_sqlite3));
+
+            rollbackTransaction();
+            is_imported.assign(row_count, false);
+
+            return;
+        }
+
+        // 2) Bind every row of the batch, remembering which rows carry which key:
+        std::unordered_map<std::string, std::vector<std::size_t>> rows_by_key;
+
+        for(std::size_t offset = 0; offset < batch_row_count; ++offset)
+        {
+            bind_row(prepared_sql_statement, first_row + offset, static_cast<int>(offset) * column_count + 1);
+
+            rows_by_key[get_row_key(first_row + offset)].push_back(first_row + offset);
+        }
+
+        // 3) Every returned key marks the first row of the batch carrying it. NOTE (SAVIZ): Only one of two rows with the same key can go in, so a key is never returned twice.
+        while((return_code = sqlite3_step(prepared_sql_statement)) == SQLITE_ROW)
+        {
+            auto position = rows_by_key.find(get_returned_key(prepared_sql_statement));
+
+            if(position != rows_by_key.end() && !position->second.empty())
+            {
+                is_imported[position->second.front()] = true;
+
+                position->second.erase(position->second.begin());
+            }
+        }
+
+        if(return_code != SQLITE_DONE)
+        {
+            is_successful = false;
+            outcome_message = std::string(sqlite3_errmsg(m_sqlite3));
+
+            releaseStatement(prepared_sql_statement);
+
+            rollbackTransaction();
+            is_imported.assign(row_count, false);
+
+            return;
+        }
+
+        releaseStatement(prepared_sql_statement);
+
+        first_row += batch_row_count;
+    }
+
+    commitTransaction(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        is_imported.assign(row_count, false);
+    }
+}
+
+void Database::executeStatement(
+    const char* sql_query,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    int return_code = acquireStatement(
+        sql_query,
+        prepared_sql_statement
+        );
+
+    if(return_code != SQLITE_OK)
+    {
+        is_successful = false;
+        outcome_message = std::string(sqlite3_errmsg(m_sqlite3));
+
+        return;
+    }
+
+    return_code = sqlite3_step(prepared_sql_statement);
+
+    if(return_code != SQLITE_DONE)
+    {
+        is_successful = false;
+        outcome_message = std::string(sqlite3_errmsg(m_sqlite3));
+
+        releaseStatement(prepared_sql_statement);
+
+        return;
+    }
+
+    releaseStatement(prepared_sql_statement);
+
+    is_successful = true;
+    outcome_message = "";
+}
+
+void Database::getStatementCacheStatistics(
+    StatementCacheStatistics& statistics
+    )
+{
+    statistics = m_statement_cache_statistics;
+}
+
+void Database::setPlateFilter(
+    PlateFilter* plate_filter,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    m_plate_filter = plate_filter;
+
+    is_successful = true;
+    outcome_message = std::string("Plate filter request succeeded");
+}
+
+void Database::setEntityCache(
+    EntityCache* entity_cache,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    flushGroupCommit(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Entity cache request failed: ") + outcome_message;
+
+        return;
+    }
+
+    m_entity_cache = entity_cache;
+
+    is_successful = true;
+    outcome_message = std::string("Entity cache request succeeded");
+}
+
+Database::EntityWrite::EntityWrite(
+    Database* database
+    ) :
+    m_database(database),
+    m_has_sailing(false),
+    m_is_written(false),
+    m_sailing_key(),
+    m_sailing()
+{
+    if(m_database->m_entity_cache != nullptr && !m_database->m_is_entity_write_open)
+    {
+        m_database->m_entity_write_generation = m_database->m_entity_cache->beginWrite();
+        m_database->m_is_entity_write_open = true;
+    }
+}
+
+Database::EntityWrite::~EntityWrite()
+{
+    // NOTE (SAVIZ): Inside a group the write is not committed yet, so the cache stays closed to new reads until 'flushGroupCommit()'.
+    if(!m_database->m_is_entity_write_open || sqlite3_get_autocommit(m_database->m_sqlite3) == 0)
+    {
+        return;
+    }
+
+    if(m_has_sailing && m_is_written)
+    {
+        m_database->m_entity_cache->insertWrittenSailing(m_sailing_key, m_sailing, m_database->m_entity_write_generation);
+    }
+
+    m_database->endEntityWrite();
+}
+
+void Database::EntityWrite::takeSailing(
+    int sailing_id
+    )
+{
+    if(m_database->m_entity_cache != nullptr)
+    {
+        m_has_sailing = m_database->m_entity_cache->takeSailing(sailing_id, m_sailing_key, m_sailing);
+    }
+}
+
+void Database::EntityWrite::setWrittenLengths(
+    double low_remaining_length,
+    double high_remaining_length
+    )
+{
+    m_sailing.low_remaining_length = low_remaining_length;
+    m_sailing.high_remaining_length = high_remaining_length;
+
+    m_is_written = true;
+}
+
+void Database::endEntityWrite()
+{
+    if(!m_is_entity_write_open)
+    {
+        return;
+    }
+
+    m_is_entity_write_open = false;
+
+    m_entity_cache->endWrite();
+}
+
+void Database::openVesselCursor(
+    RowCursor<VesselView>& cursor,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    openCursor(DatabaseQueries::c_select_all_vessels, cursor.getStatementCursor(), is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Open vessel cursor failed: ") + outcome_message;
+    }
+}
+
+void Database::openSailingReportCursor(
+    RowCursor<SailingReportView>& cursor,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    openCursor(DatabaseQueries::c_select_all_sailing_reports, cursor.getStatementCursor(), is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Open sailing report cursor failed: ") + outcome_message;
+    }
+}
+
+void Database::openCursor(
+    const char* sql_query,
+    StatementCursor& cursor,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // Reopening a cursor hands back whatever it held before (which may well be this very statement):
+    cursor.close();
+
+    // The cursor holds its read connection (and so its snapshot) until it is closed, see 'returnStatement()':
+    ReadConnection* read_connection = leaseReadConnection();
+
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    int return_code = acquireReadStatement(
+        read_connection,
+        sql_query,
+        prepared_sql_statement
+        );
+
+    if(return_code != SQLITE_OK)
+    {
+        is_successful = false;
+        outcome_message = std::string(sqlite3_errmsg(read_connection != nullptr ? read_connection->handle : m_sqlite3));
+
+        releaseReadConnection(read_connection);
+
+        return;
+    }
+
+    // NOTE (SAVIZ): There is one cached statement per query, so two cursors over the same query at once would step on each other:
+    const std::vector<sqlite3_stmt*>& lent_statements = read_connection != nullptr ? read_connection->lent_statements : m_lent_statements;
+
+    if(std::find(lent_statements.begin(), lent_statements.end(), prepared_sql_statement) != lent_statements.end())
+    {
+        is_successful = false;
+        outcome_message = std::string("another cursor over this query is still open.");
+
+        releaseReadConnection(read_connection);
+
+        return;
+    }
+
+    cursor.open(this, prepared_sql_statement);
+
+    is_successful = true;
+    outcome_message = std::string("Cursor opened");
+}
+
+void Database::lendStatement(
+    sqlite3_stmt* prepared_sql_statement
+    )
+{
+    sqlite3* handle = sqlite3_db_handle(prepared_sql_statement);
+
+    for(std::unique_ptr<ReadConnection>& read_connection : m_read_connections)
+    {
+        if(read_connection->handle == handle)
+        {
+            read_connection->lent_statements.push_back(prepared_sql_statement);
+
+            return;
+        }
+    }
+
+    m_lent_statements.push_back(prepared_sql_statement);
+}
+
+void Database::returnStatement(
+    sqlite3_stmt* prepared_sql_statement
+    )
+{
+    releaseStatement(prepared_sql_statement);
+
+    sqlite3* handle = sqlite3_db_handle(prepared_sql_statement);
+
+    // A statement of a read connection also hands back the lease taken in 'openCursor()':
+    for(std::unique_ptr<ReadConnection>& read_connection : m_read_connections)
+    {
+        if(read_connection->handle == handle)
+        {
+            std::vector<sqlite3_stmt*>& lent_statements = read_connection->lent_statements;
+
+            lent_statements.erase(std::remove(lent_statements.begin(), lent_statements.end(), prepared_sql_statement), lent_statements.end());
+
+            releaseReadConnection(read_connection.get());
+
+            return;
+        }
+    }
+
+    m_lent_statements.erase(std::remove(m_lent_statements.begin(), m_lent_statements.end(), prepared_sql_statement), m_lent_statements.end());
+}
+
+void Database::openReadConnections(
+    const std::string& path,
+    const ConnectionProfile& profile,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // 1) Only a WAL database lets readers run beside a writer (and an in-memory one cannot be shared at all):
+    std::string journal_mode = "";
+
+    queryPragma(m_sqlite3, "PRAGMA journal_mode;", journal_mode);
+
+    if(path.empty() || path == ":memory:" || toUpperKeyword(journal_mode) != "WAL")
+    {
+        is_successful = false;
+        outcome_message = std::string("read connections need a database file in WAL mode (journal_mode is '") + journal_mode + "').";
+
+        return;
+    }
+
+    // 2) Open them, with the same cache settings as the writing connection:
+    const std::string sql_query =
+        "PRAGMA cache_size = " + std::to_string(profile.cache_size) + ";"
+        "PRAGMA mmap_size = " + std::to_string(profile.mmap_size) + ";"
+        "PRAGMA temp_store = " + toUpperKeyword(profile.temp_store) + ";";
+
+    for(int index = 0; index < profile.read_connections; ++index)
+    {
+        std::unique_ptr<ReadConnection> read_connection = std::make_unique<ReadConnection>();
+
+        // NOTE (SAVIZ): A connection is only ever used by the thread holding its lease, so SQLite's own locking can be left out.
+        int return_code = sqlite3_open_v2(path.c_str(), &read_connection->handle, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, nullptr);
+
+        if(return_code == SQLITE_OK)
+        {
+            return_code = sqlite3_exec(read_connection->handle, sql_query.c_str(), nullptr, nullptr, nullptr);
+        }
+
+        if(return_code != SQLITE_OK)
+        {
+            is_successful = false;
+            outcome_message = std::string("read connection failed: ") + sqlite3_errmsg(read_connection->handle);
+
+            sqlite3_close(read_connection->handle);
+
+            return;
+        }
+
+        sqlite3_busy_timeout(read_connection->handle, profile.busy_timeout);
+
+        m_read_connections.push_back(std::move(read_connection));
+    }
+
+    is_successful = true;
+    outcome_message = std::string("Read connections opened");
+}
+
+Database::ReadConnection* Database::leaseReadConnection()
+{
+    if(m_read_connections.empty())
+    {
+        return(nullptr);
+    }
+
+    std::thread::id this_thread = std::this_thread::get_id();
+
+    // Writes that are not committed yet can only be seen on the writing connection:
+    if(m_writing_thread.load() == this_thread && sqlite3_get_autocommit(m_sqlite3) == 0)
+    {
+        return(nullptr);
+    }
+
+    ReadConnection* read_connection = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(m_read_pool_mutex);
+
+        // A thread that already reads (e.g. with a cursor open) keeps its connection, so it never waits on itself and stays on one snapshot:
+        for(std::unique_ptr<ReadConnection>& leased_connection : m_read_connections)
+        {
+            if(leased_connection->lease_count > 0 && leased_connection->lessee == this_thread)
+            {
+                ++leased_connection->lease_count;
+
+                return(leased_connection.get());
+            }
+        }
+
+        m_read_pool_condition.wait(lock, [this, &read_connection]()
+        {
+            for(std::unique_ptr<ReadConnection>& idle_connection : m_read_connections)
+            {
+                if(idle_connection->lease_count == 0)
+                {
+                    read_connection = idle_connection.get();
+
+                    return(true);
+                }
+            }
+
+            return(false);
+        });
+
+        read_connection->lessee = this_thread;
+        read_connection->lease_count = 1;
+    }
+
+    // The snapshot is taken by the first read after this, and kept until the last lease is released:
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    if(acquireReadStatement(read_connection, DatabaseQueries::c_begin_read_transaction, prepared_sql_statement) == SQLITE_OK)
+    {
+        sqlite3_step(prepared_sql_statement);
+        sqlite3_reset(prepared_sql_statement);
+    }
+
+    return(read_connection);
+}
+
+void Database::releaseReadConnection(
+    ReadConnection* read_connection
+    )
+{
+    if(read_connection == nullptr)
+    {
+        return;
+    }
+
+    // Only the lessee changes the count, so it can be read here without the lock:
+    if(read_connection->lease_count == 1)
+    {
+        sqlite3_stmt* prepared_sql_statement = nullptr;
+
+        if(acquireReadStatement(read_connection, DatabaseQueries::c_commit_transaction, prepared_sql_statement) == SQLITE_OK)
+        {
+            sqlite3_step(prepared_sql_statement);
+            sqlite3_reset(prepared_sql_statement);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_read_pool_mutex);
+
+        --read_connection->lease_count;
+
+        if(read_connection->lease_count > 0)
+        {
+            return;
+        }
+    }
+
+    m_read_pool_condition.notify_one();
+}
+
+int Database::acquireReadStatement(
+    ReadConnection* read_connection,
+    const char* sql_query,
+    sqlite3_stmt*& prepared_sql_statement
+    )
+{
+    if(read_connection == nullptr)
+    {
+        return(acquireStatement(sql_query, prepared_sql_statement));
+    }
+
+    auto iterator = read_connection->prepared_statements.find(sql_query);
+
+    if(iterator != read_connection->prepared_statements.end())
+    {
+        prepared_sql_statement = iterator->second;
+
+        return(SQLITE_OK);
+    }
+
+    prepared_sql_statement = nullptr;
+
+    int return_code = sqlite3_prepare_v3(
+        read_connection->handle,
+        sql_query,
+        -1,
+        SQLITE_PREPARE_PERSISTENT,
+        &prepared_sql_statement,
+        nullptr
+        );
+
+    if(return_code != SQLITE_OK)
+    {
+        return(return_code);
+    }
+
+    read_connection->prepared_statements.emplace(sql_query, prepared_sql_statement);
+
+    return(SQLITE_OK);
+}
+
+int Database::acquireStatement(
+    const char* sql_query,
+    sqlite3_stmt*& prepared_sql_statement
+    )
+{
+    auto iterator = m_prepared_statements.find(sql_query);
+
+    // Cache hit: the statement was left reset by 'releaseStatement()', so it is ready for new bindings:
+    if(iterator != m_prepared_statements.end())
+    {
+        prepared_sql_statement = iterator->second;
+
+        ++m_statement_cache_statistics.reused_count;
+
+        return(SQLITE_OK);
+    }
+
+    // Cache miss: compile the SQL once and keep it for the lifetime of the connection:
+    prepared_sql_statement = nullptr;
+
+    int return_code = sqlite3_prepare_v3(
+        m_sqlite3,
+        sql_query,
+        -1,
+        SQLITE_PREPARE_PERSISTENT, // Hints SQLite that the statement will be retained and reused many times
+        &prepared_sql_statement,
+        nullptr
+        );
+
+    if(return_code != SQLITE_OK)
+    {
+        return(return_code);
+    }
+
+    m_prepared_statements.emplace(sql_query, prepared_sql_statement);
+
+    ++m_statement_cache_statistics.prepared_count;
+
+    return(SQLITE_OK);
+}
+
+void Database::releaseStatement(
+    sqlite3_stmt* prepared_sql_statement
+    )
+{
+    if(prepared_sql_statement == nullptr)
+    {
+        return;
+    }
+
+    // NOTE (SAVIZ): Resetting is what ends the implicit read transaction of a SELECT, so this must happen even when we stop stepping early.
+    sqlite3_reset(prepared_sql_statement);
+    sqlite3_clear_bindings(prepared_sql_statement);
+}
+
+void Database::finalizeStatements()
+{
+    for(auto& [sql_query, prepared_sql_statement] : m_prepared_statements)
+    {
+        sqlite3_finalize(prepared_sql_statement);
+    }
+
+    m_prepared_statements.clear();
 }
@@ -0,0 +1,131 @@
+#include "database_cursor.hpp"
+#include "database.hpp"
+
+// Returns a text column as a view into the statement's memory (empty for NULL).
+static std::string_view columnText(
+    sqlite3_stmt* prepared_sql_statement,
+    int column
+    )
+{
+    const unsigned char* column_data = sqlite3_column_text(prepared_sql_statement, column);
+
+    if(column_data == nullptr)
+    {
+        return(std::string_view());
+    }
+
+    // NOTE (SAVIZ): 'sqlite3_column_bytes()' must be called after 'sqlite3_column_text()', since the conversion to text may change the size.
+    return(std::string_view(reinterpret_cast<const char*>(column_data), sqlite3_column_bytes(prepared_sql_statement, column)));
+}
+
+void VesselView::read(
+    sqlite3_stmt* prepared_sql_statement
+    )
+{
+    vessel_id = sqlite3_column_int(prepared_sql_statement, 0);
+    vessel_name = columnText(prepared_sql_statement, 1);
+    low_ceiling_lane_length = sqlite3_column_double(prepared_sql_statement, 2);
+    high_ceiling_lane_length = sqlite3_column_double(prepared_sql_statement, 3);
+}
+
+void SailingReportView::read(
+    sqlite3_stmt* prepared_sql_statement
+    )
+{
+    sailing_id = sqlite3_column_int(prepared_sql_statement, 0);
+    departure_terminal = columnText(prepared_sql_statement, 1);
+    departure_day = sqlite3_column_int(prepared_sql_statement, 2);
+    departure_hour = sqlite3_column_int(prepared_sql_statement, 3);
+    low_remaining_length = sqlite3_column_double(prepared_sql_statement, 4);
+    high_remaining_length = sqlite3_column_double(prepared_sql_statement, 5);
+    vessel_name = columnText(prepared_sql_statement, 6);
+    vehicle_count = sqlite3_column_int(prepared_sql_statement, 7);
+    occupancy_percentage = sqlite3_column_double(prepared_sql_statement, 8);
+}
+
+StatementCursor::StatementCursor() :
+    m_database(nullptr),
+    m_prepared_sql_statement(nullptr),
+    m_is_successful(false),
+    m_outcome_message("Cursor is not open")
+{
+}
+
+StatementCursor::~StatementCursor()
+{
+    close();
+}
+
+void StatementCursor::open(
+    Database* database,
+    sqlite3_stmt* prepared_sql_statement
+    )
+{
+    close();
+
+    m_database = database;
+    m_prepared_sql_statement = prepared_sql_statement;
+    m_is_successful = true;
+    m_outcome_message = std::string("Cursor is open");
+
+    m_database->lendStatement(m_prepared_sql_statement);
+}
+
+bool StatementCursor::step()
+{
+    if(m_prepared_sql_statement == nullptr)
+    {
+        return(false);
+    }
+
+    int return_code = sqlite3_step(m_prepared_sql_statement);
+
+    if(return_code == SQLITE_ROW)
+    {
+        return(true);
+    }
+
+    if(return_code == SQLITE_DONE)
+    {
+        m_is_successful = true;
+        m_outcome_message = std::string("Read all rows");
+    }
+
+    else
+    {
+        m_is_successful = false;
+        m_outcome_message = std::string("Reading rows failed: ") + sqlite3_errmsg(sqlite3_db_handle(m_prepared_sql_statement));
+    }
+
+    // The rows ran out, so there is no reason to keep the read transaction open until the cursor is destroyed:
+    close();
+
+    return(false);
+}
+
+void StatementCursor::close()
+{
+    if(m_prepared_sql_statement == nullptr)
+    {
+        return;
+    }
+
+    m_database->returnStatement(m_prepared_sql_statement);
+
+    m_prepared_sql_statement = nullptr;
+    m_database = nullptr;
+}
+
+void StatementCursor::getOutcome(
+    bool& is_successful,
+    std::string& outcome_message
+    ) const
+{
+    is_successful = m_is_successful;
+    outcome_message = m_outcome_message;
+}
+
+sqlite3_stmt* StatementCursor::getStatement() const
+{
+    return(m_prepared_sql_statement);
+}
@@ -0,0 +1,410 @@
+#include <algorithm>
+#include "entity_cache.hpp"
+
+EntityCache::EntityCache(
+    const EntityCacheSettings& settings
+    ) :
+    m_settings(settings),
+    m_statistics(),
+    m_vehicles(static_cast<std::size_t>(std::max(0, settings.vehicle_capacity))),
+    m_sailings(static_cast<std::size_t>(std::max(0, settings.sailing_capacity))),
+    m_has_vessels(false),
+    m_is_vessel_catalog_too_large(false),
+    m_generation(0),
+    m_writer_count(0)
+{
+}
+
+EntityCache::~EntityCache()
+{
+}
+
+void EntityCache::getStatistics(
+    EntityCacheStatistics& statistics
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    statistics = m_statistics;
+}
+
+bool EntityCache::findVehicle(
+    std::int64_t license_plate_key,
+    Vehicle& vehicle
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Vehicle* cached_vehicle = m_vehicles.find(license_plate_key);
+
+    if(cached_vehicle == nullptr)
+    {
+        m_statistics.vehicle_misses += 1;
+
+        return(false);
+    }
+
+    m_statistics.vehicle_hits += 1;
+    vehicle = *cached_vehicle;
+
+    return(true);
+}
+
+bool EntityCache::findSailing(
+    SailingKey sailing_key,
+    Sailing& sailing
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Sailing* cached_sailing = m_sailings.find(sailing_key);
+
+    if(cached_sailing == nullptr)
+    {
+        m_statistics.sailing_misses += 1;
+
+        return(false);
+    }
+
+    m_statistics.sailing_hits += 1;
+    sailing = *cached_sailing;
+
+    return(true);
+}
+
+bool EntityCache::findVessel(
+    int vessel_id,
+    Vessel& vessel,
+    bool& is_found
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(!m_has_vessels)
+    {
+        m_statistics.vessel_misses += 1;
+
+        return(false);
+    }
+
+    m_statistics.vessel_hits += 1;
+    is_found = findInCatalog(m_vessels, vessel_id, vessel);
+
+    return(true);
+}
+
+bool EntityCache::findVessels(
+    int key,
+    int count,
+    bool is_previous,
+    std::vector<Vessel>& vessels
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(!m_has_vessels)
+    {
+        m_statistics.vessel_misses += 1;
+
+        return(false);
+    }
+
+    m_statistics.vessel_hits += 1;
+    pageCatalog(m_vessels, key, count, is_previous, vessels);
+
+    return(true);
+}
+
+bool EntityCache::findInCatalog(
+    const std::vector<Vessel>& catalog,
+    int vessel_id,
+    Vessel& vessel
+    )
+{
+    auto position = std::lower_bound(catalog.begin(), catalog.end(), vessel_id, [](const Vessel& candidate, int id) { return(candidate.vessel_id < id); });
+
+    if(position == catalog.end() || position->vessel_id != vessel_id)
+    {
+        return(false);
+    }
+
+    vessel = *position;
+
+    return(true);
+}
+
+void EntityCache::pageCatalog(
+    const std::vector<Vessel>& catalog,
+    int key,
+    int count,
+    bool is_previous,
+    std::vector<Vessel>& vessels
+    )
+{
+    auto by_id = [](const Vessel& candidate, int id) { return(candidate.vessel_id < id); };
+
+    vessels.clear();
+
+    if(is_previous)
+    {
+        auto end = std::lower_bound(catalog.begin(), catalog.end(), key, by_id);
+        auto begin = end - std::min<std::ptrdiff_t>(count, end - catalog.begin());
+
+        vessels.assign(begin, end);
+    }
+
+    else
+    {
+        auto begin = std::lower_bound(catalog.begin(), catalog.end(), key + 1, by_id);
+        auto end = begin + std::min<std::ptrdiff_t>(count, catalog.end() - begin);
+
+        vessels.assign(begin, end);
+    }
+}
+
+std::uint64_t EntityCache::getGeneration()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return(m_generation);
+}
+
+void EntityCache::insertVehicle(
+    std::int64_t license_plate_key,
+    const Vehicle& vehicle,
+    std::uint64_t read_generation
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(!isInsertAllowed(read_generation) || m_vehicles.getCapacity() == 0)
+    {
+        return;
+    }
+
+    Vehicle evicted_vehicle;
+
+    if(m_vehicles.insert(license_plate_key, vehicle, evicted_vehicle))
+    {
+        m_statistics.eviction_count += 1;
+    }
+}
+
+void EntityCache::insertSailing(
+    SailingKey sailing_key,
+    const Sailing& sailing,
+    std::uint64_t read_generation
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(!isInsertAllowed(read_generation) || m_sailings.getCapacity() == 0)
+    {
+        return;
+    }
+
+    Sailing evicted_sailing;
+
+    if(m_sailings.insert(sailing_key, sailing, evicted_sailing))
+    {
+        m_statistics.eviction_count += 1;
+
+        m_sailing_keys.erase(evicted_sailing.sailing_id);
+    }
+
+    m_sailing_keys[sailing.sailing_id] = sailing_key;
+}
+
+void EntityCache::insertVessels(
+    const std::vector<Vessel>& vessels,
+    std::uint64_t read_generation
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(!isInsertAllowed(read_generation))
+    {
+        return;
+    }
+
+    // Trying again on every lookup would read the whole table each time, so a catalog that does not fit is not tried again until it changes:
+    if(vessels.size() > static_cast<std::size_t>(std::max(0, m_settings.vessel_capacity)))
+    {
+        m_is_vessel_catalog_too_large = true;
+
+        return;
+    }
+
+    m_vessels = vessels;
+    m_has_vessels = true;
+}
+
+std::uint64_t EntityCache::beginWrite()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_writer_count += 1;
+    m_generation += 1;
+
+    return(m_generation);
+}
+
+void EntityCache::endWrite()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_writer_count -= 1;
+    m_generation += 1;
+}
+
+void EntityCache::invalidateVehicle(
+    std::int64_t license_plate_key
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(m_vehicles.erase(license_plate_key))
+    {
+        m_statistics.invalidation_count += 1;
+    }
+}
+
+void EntityCache::invalidateSailing(
+    int sailing_id
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto position = m_sailing_keys.find(sailing_id);
+
+    if(position == m_sailing_keys.end())
+    {
+        return;
+    }
+
+    m_sailings.erase(position->second);
+    m_sailing_keys.erase(position);
+
+    m_statistics.invalidation_count += 1;
+}
+
+void EntityCache::invalidateSailing(
+    SailingKey sailing_key
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Sailing* cached_sailing = m_sailings.find(sailing_key);
+
+    if(cached_sailing == nullptr)
+    {
+        return;
+    }
+
+    m_sailing_keys.erase(cached_sailing->sailing_id);
+    m_sailings.erase(sailing_key);
+
+    m_statistics.invalidation_count += 1;
+}
+
+void EntityCache::invalidateVessels()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_is_vessel_catalog_too_large = false;
+
+    if(!m_has_vessels)
+    {
+        return;
+    }
+
+    m_has_vessels = false;
+    m_vessels.clear();
+
+    m_statistics.invalidation_count += 1;
+}
+
+void EntityCache::invalidateAll()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_vehicles.clear();
+    m_sailings.clear();
+    m_sailing_keys.clear();
+    m_has_vessels = false;
+    m_is_vessel_catalog_too_large = false;
+    m_vessels.clear();
+
+    m_statistics.invalidation_count += 1;
+}
+
+bool EntityCache::takeSailing(
+    int sailing_id,
+    SailingKey& sailing_key,
+    Sailing& sailing
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto position = m_sailing_keys.find(sailing_id);
+
+    if(position == m_sailing_keys.end())
+    {
+        return(false);
+    }
+
+    sailing_key = position->second;
+    sailing = *m_sailings.find(sailing_key);
+
+    m_sailings.erase(sailing_key);
+    m_sailing_keys.erase(position);
+
+    m_statistics.invalidation_count += 1;
+
+    return(true);
+}
+
+void EntityCache::insertWrittenSailing(
+    SailingKey sailing_key,
+    const Sailing& sailing,
+    std::uint64_t write_generation
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // NOTE (SAVIZ): The writer itself is still counted here, as 'endWrite()' comes after this.
+    if(m_writer_count != 1 || m_generation != write_generation || m_sailings.getCapacity() == 0)
+    {
+        return;
+    }
+
+    Sailing evicted_sailing;
+
+    if(m_sailings.insert(sailing_key, sailing, evicted_sailing))
+    {
+        m_statistics.eviction_count += 1;
+
+        m_sailing_keys.erase(evicted_sailing.sailing_id);
+    }
+
+    m_sailing_keys[sailing.sailing_id] = sailing_key;
+}
+
+std::size_t EntityCache::getVesselCapacity()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(m_is_vessel_catalog_too_large)
+    {
+        return(0);
+    }
+
+    return(static_cast<std::size_t>(std::max(0, m_settings.vessel_capacity)));
+}
+
+bool EntityCache::isInsertAllowed(
+    std::uint64_t read_generation
+    ) const
+{
+    return(m_writer_count == 0 && m_generation == read_generation);
+}
@@ -22,3 +22,13 @@ double g_vehicle_min_length = 0;
 double g_vehicle_max_length = 100;
 double g_vehicle_min_height = 0;
 double g_vehicle_max_height = 10;
+
+// Vessel lane ranges
+double g_lane_min_length = 0;
+double g_lane_max_length = 1200;
+
+// Input patterns (shared by the prompts and the importer)
+const std::regex g_sailing_id_pattern(R"([A-Z]{3}-\d{2}-\d{2})");
+const std::regex g_vessel_name_pattern(R"([\w ]{1,25})");
+const std::regex g_license_plate_pattern(R"([A-Z\d -]{2,10})");
+const std::regex g_phone_number_pattern(R"(\d{8,14})");
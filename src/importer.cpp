@@ -0,0 +1,895 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <climits>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include "importer.hpp"
+#include "ordered_queue.hpp"
+#include "database_queries.hpp"
+#include "global.hpp"
+#include "utilities.hpp"
+
+// Splits a CSV line into its fields. Unquoted fields are trimmed, quoted ones are kept as they are (with "" read as a quote).
+static bool splitFields(
+    const std::string& line,
+    std::vector<std::string>& fields
+    )
+{
+    fields.clear();
+
+    std::size_t position = 0;
+
+    while(true)
+    {
+        std::string field;
+
+        while(position < line.size() && (line[position] == ' ' || line[position] == '\t'))
+        {
+            ++position;
+        }
+
+        if(position < line.size() && line[position] == '"')
+        {
+            ++position;
+
+            while(true)
+            {
+                // The quote is never closed:
+                if(position >= line.size())
+                {
+                    return(false);
+                }
+
+                if(line[position] == '"')
+                {
+                    if(position + 1 < line.size() && line[position + 1] == '"')
+                    {
+                        field += '"';
+                        position += 2;
+
+                        continue;
+                    }
+
+                    ++position;
+
+                    break;
+                }
+
+                field += line[position++];
+            }
+
+            while(position < line.size() && (line[position] == ' ' || line[position] == '\t' || line[position] == '\r'))
+            {
+                ++position;
+            }
+
+            // Only a separator may follow the closing quote:
+            if(position < line.size() && line[position] != ',')
+            {
+                return(false);
+            }
+        }
+
+        else
+        {
+            std::size_t separator = line.find(',', position);
+            std::size_t end = separator == std::string::npos ? line.size() : separator;
+
+            field = line.substr(position, end - position);
+            field.erase(field.find_last_not_of(" \t\r") + 1);
+
+            position = end;
+        }
+
+        fields.push_back(field);
+
+        if(position >= line.size())
+        {
+            return(true);
+        }
+
+        // Skip the separator:
+        ++position;
+    }
+}
+
+Importer::Importer(
+    Database* database,
+    std::ostream& report_stream,
+    const ImportSettings& settings
+    ) :
+    m_database(database),
+    m_report_stream(report_stream),
+    m_settings(settings),
+    m_pending_kind(RecordKind::None),
+    m_pending_vessels(),
+    m_pending_sailings(),
+    m_pending_vehicles(),
+    m_pending_reservations(),
+    m_pending_line_numbers(),
+    m_statistics(),
+    m_start_time(),
+    m_uncommitted_count(0)
+{
+}
+
+Importer::~Importer()
+{
+}
+
+void Importer::importFile(
+    const std::string& path,
+    ImportStatistics& statistics,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if(!file.is_open())
+    {
+        statistics = ImportStatistics();
+
+        is_successful = false;
+        outcome_message = std::string("Import failed: ") + "could not open '" + path + "'.";
+
+        return;
+    }
+
+    long long file_size = static_cast<long long>(file.tellg());
+
+    // Nothing to share out for a single parser, or a file that fits in one chunk:
+    if(m_settings.parser_count <= 1 || file_size <= static_cast<long long>(m_settings.chunk_bytes))
+    {
+        file.seekg(0);
+
+        importStream(file, statistics, is_successful, outcome_message);
+
+        return;
+    }
+
+    file.close();
+
+    beginImport(is_successful, outcome_message);
+
+    if(is_successful)
+    {
+        importFileInParallel(path, file_size, is_successful, outcome_message);
+    }
+
+    endImport(statistics, is_successful, outcome_message);
+}
+
+void Importer::importStream(
+    std::istream& stream,
+    ImportStatistics& statistics,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    beginImport(is_successful, outcome_message);
+
+    // Read, check and take one record at a time:
+    std::string line;
+    std::vector<std::string> fields;
+    long long line_number = 0;
+
+    while(is_successful && std::getline(stream, line))
+    {
+        ++line_number;
+
+        if(!isRecordLine(line))
+        {
+            m_statistics.line_count = line_number;
+
+            continue;
+        }
+
+        ImportRecord record;
+
+        std::string rejection_reason = parseLine(line, fields, record);
+
+        acceptRecord(record, rejection_reason, line_number, is_successful, outcome_message);
+    }
+
+    endImport(statistics, is_successful, outcome_message);
+}
+
+void Importer::importFileInParallel(
+    const std::string& path,
+    long long file_size,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    long long chunk_bytes = static_cast<long long>(m_settings.chunk_bytes);
+    long long chunk_count = (file_size + chunk_bytes - 1) / chunk_bytes;
+
+    // NOTE (SAVIZ): Two chunks per parser keeps every parser busy while the writer works through a chunk, without letting them run far ahead.
+    OrderedQueue<ParsedChunk> parsed_chunks(static_cast<std::size_t>(2 * m_settings.parser_count));
+
+    std::atomic<long long> next_chunk(0);
+
+    // 1) The parsers take the chunks in order, so the chunk the writer needs next is always being worked on:
+    std::vector<std::thread> parsers;
+
+    for(int index = 0; index < m_settings.parser_count && index < chunk_count; ++index)
+    {
+        parsers.emplace_back([&path, &parsed_chunks, &next_chunk, chunk_bytes, chunk_count, file_size]()
+        {
+            while(true)
+            {
+                long long chunk_index = next_chunk.fetch_add(1);
+
+                if(chunk_index >= chunk_count)
+                {
+                    return;
+                }
+
+                ParsedChunk chunk;
+
+                parseChunk(path, chunk_index * chunk_bytes, std::min(file_size, (chunk_index + 1) * chunk_bytes), chunk);
+
+                // The writer gave up:
+                if(!parsed_chunks.push(chunk_index, std::move(chunk)))
+                {
+                    return;
+                }
+            }
+        });
+    }
+
+    // 2) The writer takes the chunks back in file order:
+    long long first_line_number = 1;
+
+    for(long long chunk_index = 0; chunk_index < chunk_count && is_successful; ++chunk_index)
+    {
+        ParsedChunk chunk;
+
+        parsed_chunks.pop(chunk_index, chunk);
+
+        if(!chunk.is_read)
+        {
+            is_successful = false;
+            outcome_message = std::string("could not read '") + path + "'.";
+
+            break;
+        }
+
+        for(const ParsedLine& parsed_line : chunk.lines)
+        {
+            acceptRecord(parsed_line.record, parsed_line.rejection_reason, first_line_number + parsed_line.line_index, is_successful, outcome_message);
+
+            if(!is_successful)
+            {
+                break;
+            }
+        }
+
+        if(is_successful)
+        {
+            first_line_number += chunk.line_count;
+
+            m_statistics.line_count = first_line_number - 1;
+        }
+    }
+
+    // 3) Release the parsers (they may be waiting for room) and wait for them:
+    parsed_chunks.close();
+
+    for(std::thread& parser : parsers)
+    {
+        parser.join();
+    }
+}
+
+void Importer::beginImport(
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    m_statistics = ImportStatistics();
+    m_start_time = std::chrono::steady_clock::now();
+    m_uncommitted_count = 0;
+
+    // Every write from here on joins one open transaction, until 'commitRecords()' ends it:
+    GroupCommitSettings import_group_commit;
+    import_group_commit.max_operations = INT_MAX;
+    import_group_commit.max_delay_milliseconds = INT_MAX;
+
+    m_database->setGroupCommit(import_group_commit, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("could not start the import: ") + outcome_message;
+    }
+}
+
+void Importer::acceptRecord(
+    const ImportRecord& record,
+    const std::string& rejection_reason,
+    long long line_number,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    m_statistics.line_count = line_number;
+
+    ++m_statistics.record_count;
+
+    if(!rejection_reason.empty())
+    {
+        reportRejection(line_number, rejection_reason);
+    }
+
+    else
+    {
+        // Records are written in file order, so a new kind first sends out the records of the previous one:
+        if(record.kind != m_pending_kind && !m_pending_line_numbers.empty())
+        {
+            writeRecords(is_successful, outcome_message);
+
+            if(!is_successful)
+            {
+                return;
+            }
+        }
+
+        bufferRecord(record, line_number);
+    }
+
+    if(m_statistics.record_count % sc_progress_records == 0)
+    {
+        reportProgress();
+    }
+
+    if(m_statistics.record_count % sc_records_per_transaction == 0)
+    {
+        commitRecords(is_successful, outcome_message);
+    }
+
+    // A full batch goes out right away, so the buffers stay small:
+    else if(m_pending_line_numbers.size() >= static_cast<std::size_t>(DatabaseQueries::c_import_batch_rows))
+    {
+        writeRecords(is_successful, outcome_message);
+    }
+}
+
+void Importer::endImport(
+    ImportStatistics& statistics,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // 1) Write and commit whatever is left:
+    if(is_successful)
+    {
+        commitRecords(is_successful, outcome_message);
+    }
+
+    // 2) Back to committing every write on its own. After a failure, this commits what was written before it (unless the failure already lost the group):
+    bool is_group_lost = false;
+
+    if(m_uncommitted_count > 0 && !m_database->hasPendingWrites())
+    {
+        bool is_committed = false;
+        std::string commit_message = "";
+
+        m_database->getLastGroupCommitOutcome(is_committed, commit_message);
+
+        is_group_lost = !is_committed;
+    }
+
+    bool is_reset = false;
+    std::string reset_message = "";
+
+    m_database->setGroupCommit(GroupCommitSettings(), is_reset, reset_message);
+
+    if(is_group_lost || !is_reset)
+    {
+        m_statistics.imported_count -= m_uncommitted_count;
+    }
+
+    m_uncommitted_count = 0;
+
+    // Whatever a failure left buffered is dropped:
+    m_pending_kind = RecordKind::None;
+    m_pending_vessels.clear();
+    m_pending_sailings.clear();
+    m_pending_vehicles.clear();
+    m_pending_reservations.clear();
+    m_pending_line_numbers.clear();
+
+    m_statistics.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start_time).count();
+
+    statistics = m_statistics;
+
+    if(!is_successful)
+    {
+        outcome_message = std::string("Import failed at line ") + std::to_string(m_statistics.line_count) + ": " + outcome_message;
+
+        return;
+    }
+
+    std::ostringstream summary;
+
+    summary << "Import succeeded: " << m_statistics.record_count << " record(s) read, " << m_statistics.imported_count << " imported, " << m_statistics.rejected_count << " rejected in "
+            << std::fixed << std::setprecision(2) << m_statistics.elapsed_seconds << " s (" << std::setprecision(0) << getRate() << " records/s)";
+
+    is_successful = true;
+    outcome_message = summary.str();
+}
+
+bool Importer::isRecordLine(
+    const std::string& line
+    )
+{
+    std::size_t first = line.find_first_not_of(" \t\r");
+
+    // Blank lines and comments:
+    return(first != std::string::npos && line[first] != '#');
+}
+
+std::string Importer::parseLine(
+    const std::string& line,
+    std::vector<std::string>& fields,
+    ImportRecord& record
+    )
+{
+    if(!splitFields(line, fields))
+    {
+        return("a quoted field is not closed.");
+    }
+
+    return(readRecord(fields, record));
+}
+
+void Importer::parseChunk(
+    const std::string& path,
+    long long begin,
+    long long end,
+    ParsedChunk& chunk
+    )
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if(!file.is_open())
+    {
+        return;
+    }
+
+    // 1) Read the chunk, with the byte before it (to tell whether a line starts right at 'begin'):
+    long long read_from = begin > 0 ? begin - 1 : 0;
+
+    std::string buffer(static_cast<std::size_t>(end - read_from), '\0');
+
+    file.seekg(read_from);
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+    buffer.resize(static_cast<std::size_t>(file.gcount()));
+
+    // ...and the rest of the last line that starts in it, however far that goes:
+    if(!buffer.empty() && buffer.back() != '\n' && file)
+    {
+        std::string rest;
+
+        std::getline(file, rest);
+
+        buffer += rest;
+    }
+
+    chunk.is_read = true;
+
+    // 2) The line that started in the previous chunk belongs to it:
+    std::size_t position = 0;
+
+    if(begin > 0)
+    {
+        std::size_t newline = buffer.find('\n');
+
+        if(newline == std::string::npos)
+        {
+            return;
+        }
+
+        position = newline + 1;
+    }
+
+    // 3) Parse every line that starts in the chunk:
+    std::size_t owned_end = static_cast<std::size_t>(end - read_from);
+
+    std::string line;
+    std::vector<std::string> fields;
+
+    while(position < owned_end && position < buffer.size())
+    {
+        std::size_t newline = buffer.find('\n', position);
+        std::size_t line_end = newline == std::string::npos ? buffer.size() : newline;
+
+        line.assign(buffer, position, line_end - position);
+
+        if(isRecordLine(line))
+        {
+            ParsedLine parsed_line;
+
+            parsed_line.line_index = chunk.line_count;
+            parsed_line.rejection_reason = parseLine(line, fields, parsed_line.record);
+
+            chunk.lines.push_back(std::move(parsed_line));
+        }
+
+        ++chunk.line_count;
+
+        position = line_end + 1;
+    }
+}
+
+std::string Importer::readRecord(
+    const std::vector<std::string>& fields,
+    ImportRecord& record
+    )
+{
+    std::string kind_name = fields[0];
+
+    std::transform(kind_name.begin(), kind_name.end(), kind_name.begin(), [](unsigned char character) { return(static_cast<char>(std::tolower(character))); });
+
+    RecordKind kind = RecordKind::None;
+    std::size_t field_count = 0;
+
+    if(kind_name == "vessel")
+    {
+        kind = RecordKind::Vessel;
+        field_count = 4;
+    }
+
+    else if(kind_name == "sailing")
+    {
+        kind = RecordKind::Sailing;
+        field_count = 3;
+    }
+
+    else if(kind_name == "vehicle")
+    {
+        kind = RecordKind::Vehicle;
+        field_count = 5;
+    }
+
+    else if(kind_name == "reservation")
+    {
+        kind = RecordKind::Reservation;
+        field_count = 3;
+    }
+
+    else
+    {
+        return("unknown record kind '" + fields[0] + "' (expected vessel, sailing, vehicle or reservation).");
+    }
+
+    if(fields.size() != field_count)
+    {
+        return("a " + kind_name + " record has " + std::to_string(field_count) + " fields, found " + std::to_string(fields.size()) + ".");
+    }
+
+    // NOTE (SAVIZ): The same rules (and limits) as the prompts, from 'global.hpp'.
+    // ****************************************************************************
+
+    Vessel& vessel = record.vessel;
+    NamedSailing& sailing = record.sailing;
+    Vehicle& vehicle = record.vehicle;
+    PendingReservation& reservation = record.reservation;
+
+    record.kind = kind;
+
+    switch(kind)
+    {
+        case RecordKind::Vessel:
+        {
+            vessel.vessel_name = fields[1];
+
+            if(!std::regex_match(vessel.vessel_name, g_vessel_name_pattern))
+            {
+                return("invalid vessel name '" + fields[1] + "'.");
+            }
+
+            if(!Utilities::parseReal(fields[2], vessel.low_ceiling_lane_length) || !Utilities::isInRange(vessel.low_ceiling_lane_length, g_lane_min_length, g_lane_max_length))
+            {
+                return("the low ceiling lane length '" + fields[2] + "' is not a number in the allowed range.");
+            }
+
+            if(!Utilities::parseReal(fields[3], vessel.high_ceiling_lane_length) || !Utilities::isInRange(vessel.high_ceiling_lane_length, g_lane_min_length, g_lane_max_length))
+            {
+                return("the high ceiling lane length '" + fields[3] + "' is not a number in the allowed range.");
+            }
+
+            break;
+        }
+
+        case RecordKind::Sailing:
+        case RecordKind::Reservation:
+        {
+            std::string sailing_id = fields[1];
+
+            if(!std::regex_match(sailing_id, g_sailing_id_pattern))
+            {
+                return("invalid sailing ID '" + fields[1] + "' (expected TTT-dd-hh).");
+            }
+
+            Utilities::extractSailingID(sailing_id, sailing.departure_terminal, sailing.departure_day, sailing.departure_hour);
+
+            if(kind == RecordKind::Sailing)
+            {
+                sailing.vessel_name = fields[2];
+
+                if(!std::regex_match(sailing.vessel_name, g_vessel_name_pattern))
+                {
+                    return("invalid vessel name '" + fields[2] + "'.");
+                }
+
+                break;
+            }
+
+            reservation.departure_terminal = sailing.departure_terminal;
+            reservation.departure_day = sailing.departure_day;
+            reservation.departure_hour = sailing.departure_hour;
+            reservation.license_plate = fields[2];
+
+            if(!std::regex_match(reservation.license_plate, g_license_plate_pattern))
+            {
+                return("invalid license plate '" + fields[2] + "'.");
+            }
+
+            break;
+        }
+
+        case RecordKind::Vehicle:
+        {
+            vehicle.license_plate = fields[1];
+            vehicle.phone_number = fields[2];
+
+            if(!std::regex_match(vehicle.license_plate, g_license_plate_pattern))
+            {
+                return("invalid license plate '" + fields[1] + "'.");
+            }
+
+            if(!std::regex_match(vehicle.phone_number, g_phone_number_pattern))
+            {
+                return("invalid phone number '" + fields[2] + "'.");
+            }
+
+            if(!Utilities::parseReal(fields[3], vehicle.length) || !Utilities::isInRange(vehicle.length, g_vehicle_min_length, g_vehicle_max_length))
+            {
+                return("the vehicle length '" + fields[3] + "' is not a number in the allowed range.");
+            }
+
+            if(!Utilities::parseReal(fields[4], vehicle.height) || !Utilities::isInRange(vehicle.height, g_vehicle_min_height, g_vehicle_max_height))
+            {
+                return("the vehicle height '" + fields[4] + "' is not a number in the allowed range.");
+            }
+
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    // ****************************************************************************
+
+    return("");
+}
+
+void Importer::bufferRecord(
+    const ImportRecord& record,
+    long long line_number
+    )
+{
+    m_pending_kind = record.kind;
+    m_pending_line_numbers.push_back(line_number);
+
+    switch(record.kind)
+    {
+        case RecordKind::Vessel: m_pending_vessels.push_back(record.vessel); break;
+        case RecordKind::Sailing: m_pending_sailings.push_back(record.sailing); break;
+        case RecordKind::Vehicle: m_pending_vehicles.push_back(record.vehicle); break;
+        case RecordKind::Reservation: m_pending_reservations.push_back(record.reservation); break;
+        default: break;
+    }
+}
+
+void Importer::writeRecords(
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    std::vector<bool> is_imported;
+
+    is_successful = true;
+    outcome_message = "";
+
+    switch(m_pending_kind)
+    {
+        case RecordKind::Vessel:
+        {
+            m_database->importVessels(m_pending_vessels, is_imported, is_successful, outcome_message);
+
+            if(is_successful)
+            {
+                countRecords(is_imported, "the vessel name is already taken.");
+            }
+
+            break;
+        }
+
+        case RecordKind::Sailing:
+        {
+            m_database->importSailings(m_pending_sailings, is_imported, is_successful, outcome_message);
+
+            if(is_successful)
+            {
+                countRecords(is_imported, "the sailing ID is already taken, or the vessel does not exist.");
+            }
+
+            break;
+        }
+
+        case RecordKind::Vehicle:
+        {
+            m_database->importVehicles(m_pending_vehicles, is_imported, is_successful, outcome_message);
+
+            if(is_successful)
+            {
+                countRecords(is_imported, "the license plate is already taken.");
+            }
+
+            break;
+        }
+
+        case RecordKind::Reservation:
+        {
+            writeReservations(is_successful, outcome_message);
+
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    m_pending_vessels.clear();
+    m_pending_sailings.clear();
+    m_pending_vehicles.clear();
+    m_pending_reservations.clear();
+    m_pending_line_numbers.clear();
+}
+
+void Importer::writeReservations(
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    for(std::size_t index = 0; index < m_pending_reservations.size(); ++index)
+    {
+        const PendingReservation& pending_reservation = m_pending_reservations[index];
+
+        Sailing sailing;
+        Vehicle vehicle;
+        Reservation reservation;
+
+        std::string rejection_reason = "";
+
+        m_database->getSailingByID(pending_reservation.departure_terminal, pending_reservation.departure_day, pending_reservation.departure_hour, sailing, is_successful, outcome_message);
+
+        if(is_successful)
+        {
+            m_database->getVehicleByID(pending_reservation.license_plate, vehicle, is_successful, outcome_message);
+
+            if(is_successful)
+            {
+                m_database->addReservation(sailing, vehicle, reservation, is_successful, outcome_message);
+
+                // The reservation may have failed in a way that took the whole group with it:
+                if(!m_database->hasPendingWrites())
+                {
+                    m_database->getLastGroupCommitOutcome(is_successful, outcome_message);
+
+                    if(!is_successful)
+                    {
+                        return;
+                    }
+                }
+            }
+
+            else
+            {
+                outcome_message = "the vehicle does not exist.";
+            }
+        }
+
+        else
+        {
+            outcome_message = "the sailing does not exist.";
+        }
+
+        if(is_successful)
+        {
+            ++m_statistics.imported_count;
+            ++m_uncommitted_count;
+        }
+
+        else
+        {
+            reportRejection(m_pending_line_numbers[index], outcome_message);
+        }
+    }
+
+    is_successful = true;
+    outcome_message = "";
+}
+
+void Importer::countRecords(
+    const std::vector<bool>& is_imported,
+    const std::string& reason
+    )
+{
+    for(std::size_t index = 0; index < is_imported.size(); ++index)
+    {
+        if(is_imported[index])
+        {
+            ++m_statistics.imported_count;
+            ++m_uncommitted_count;
+        }
+
+        else
+        {
+            reportRejection(m_pending_line_numbers[index], reason);
+        }
+    }
+}
+
+void Importer::commitRecords(
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    writeRecords(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    m_database->flushGroupCommit(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    m_uncommitted_count = 0;
+}
+
+void Importer::reportRejection(
+    long long line_number,
+    const std::string& reason
+    )
+{
+    ++m_statistics.rejected_count;
+
+    m_report_stream << "Line " << line_number << " rejected: " << reason << "\n";
+}
+
+void Importer::reportProgress()
+{
+    m_report_stream << "Progress: " << m_statistics.record_count << " record(s) read, " << m_statistics.imported_count << " imported, " << m_statistics.rejected_count << " rejected ("
+                    << std::fixed << std::setprecision(0) << getRate() << " records/s)" << std::endl;
+}
+
+double Importer::getRate() const
+{
+    double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start_time).count();
+
+    return(elapsed_seconds > 0.0 ? static_cast<double>(m_statistics.record_count) / elapsed_seconds : 0.0);
+}
@@ -0,0 +1,589 @@
+#include <charconv>
+#include <cmath>
+#include "json.hpp"
+
+static bool isJsonSpace(
+    char character
+    )
+{
+    return(character == ' ' || character == '\t' || character == '\n' || character == '\r');
+}
+
+static void skipSpace(
+    std::string_view text,
+    std::size_t& position
+    )
+{
+    while(position < text.size() && isJsonSpace(text[position]))
+    {
+        ++position;
+    }
+}
+
+// Appends a code point in UTF-8.
+static void appendUtf8(
+    std::string& text,
+    unsigned int code_point
+    )
+{
+    if(code_point < 0x80)
+    {
+        text += static_cast<char>(code_point);
+    }
+
+    else if(code_point < 0x800)
+    {
+        text += static_cast<char>(0xC0 | (code_point >> 6));
+        text += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+
+    else if(code_point < 0x10000)
+    {
+        text += static_cast<char>(0xE0 | (code_point >> 12));
+        text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        text += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+
+    else
+    {
+        text += static_cast<char>(0xF0 | (code_point >> 18));
+        text += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        text += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+}
+
+// Reads the four hex digits of a '\u' escape.
+static bool readHex(
+    std::string_view text,
+    std::size_t position,
+    unsigned int& value
+    )
+{
+    if(position + 4 > text.size())
+    {
+        return(false);
+    }
+
+    std::from_chars_result result = std::from_chars(text.data() + position, text.data() + position + 4, value, 16);
+
+    return(result.ec == std::errc() && result.ptr == text.data() + position + 4);
+}
+
+JsonObject::JsonObject() :
+    m_fields(),
+    m_scratch()
+{
+}
+
+JsonObject::~JsonObject()
+{
+}
+
+// ----------------------------------------------------------------------------
+bool JsonObject::parse(
+    std::string_view text,
+    std::string& error_message
+    )
+{
+    m_fields.clear();
+    m_scratch.clear();
+
+    // An unescaped string is never longer than its escaped form, so the scratch space never moves:
+    if(m_scratch.capacity() < text.size())
+    {
+        m_scratch.reserve(text.size());
+    }
+
+    error_message.clear();
+
+    std::size_t position = 0;
+
+    auto fail = [&error_message, &position](const char* reason)
+    {
+        error_message = std::string(reason) + " (at character " + std::to_string(position + 1) + ").";
+
+        return(false);
+    };
+
+    skipSpace(text, position);
+
+    if(position >= text.size() || text[position] != '{')
+    {
+        return(fail("expected a JSON object"));
+    }
+
+    ++position;
+    skipSpace(text, position);
+
+    if(position < text.size() && text[position] == '}')
+    {
+        ++position;
+    }
+
+    else
+    {
+        while(true)
+        {
+            skipSpace(text, position);
+
+            if(position >= text.size() || text[position] != '"')
+            {
+                return(fail("expected a field name"));
+            }
+
+            ++position;
+
+            std::string_view key;
+
+            if(!parseString(text, position, key, error_message))
+            {
+                return(false);
+            }
+
+            skipSpace(text, position);
+
+            if(position >= text.size() || text[position] != ':')
+            {
+                return(fail("expected ':'"));
+            }
+
+            ++position;
+            skipSpace(text, position);
+
+            if(position >= text.size())
+            {
+                return(fail("expected a value"));
+            }
+
+            JsonValue value;
+            char first = text[position];
+
+            if(first == '"')
+            {
+                ++position;
+
+                value.type = JsonType::String;
+
+                if(!parseString(text, position, value.text, error_message))
+                {
+                    return(false);
+                }
+            }
+
+            else if(first == '-' || (first >= '0' && first <= '9'))
+            {
+                std::size_t end = position;
+
+                while(end < text.size() && (text[end] == '-' || text[end] == '+' || text[end] == '.' || text[end] == 'e' || text[end] == 'E' || (text[end] >= '0' && text[end] <= '9')))
+                {
+                    ++end;
+                }
+
+                std::from_chars_result result = std::from_chars(text.data() + position, text.data() + end, value.number);
+
+                if(result.ec != std::errc() || result.ptr != text.data() + end || !std::isfinite(value.number))
+                {
+                    return(fail("invalid number"));
+                }
+
+                value.type = JsonType::Number;
+                value.text = text.substr(position, end - position);
+                position = end;
+            }
+
+            else if(text.substr(position, 4) == "true" || text.substr(position, 5) == "false")
+            {
+                value.type = JsonType::Boolean;
+                value.boolean = first == 't';
+                value.text = text.substr(position, value.boolean ? 4 : 5);
+                position += value.text.size();
+            }
+
+            else if(text.substr(position, 4) == "null")
+            {
+                value.type = JsonType::Null;
+                value.text = text.substr(position, 4);
+                position += 4;
+            }
+
+            else if(first == '{' || first == '[')
+            {
+                return(fail("nested objects and arrays are not supported"));
+            }
+
+            else
+            {
+                return(fail("invalid value"));
+            }
+
+            m_fields.emplace_back(key, value);
+
+            skipSpace(text, position);
+
+            if(position < text.size() && text[position] == ',')
+            {
+                ++position;
+
+                continue;
+            }
+
+            if(position < text.size() && text[position] == '}')
+            {
+                ++position;
+
+                break;
+            }
+
+            return(fail("expected ',' or '}'"));
+        }
+    }
+
+    skipSpace(text, position);
+
+    if(position != text.size())
+    {
+        return(fail("unexpected text after the object"));
+    }
+
+    return(true);
+}
+
+// ----------------------------------------------------------------------------
+const JsonValue* JsonObject::find(
+    std::string_view key
+    ) const
+{
+    for(auto field = m_fields.rbegin(); field != m_fields.rend(); ++field)
+    {
+        if(field->first == key)
+        {
+            return(&field->second);
+        }
+    }
+
+    return(nullptr);
+}
+
+// ----------------------------------------------------------------------------
+bool JsonObject::parseString(
+    std::string_view text,
+    std::size_t& position,
+    std::string_view& value,
+    std::string& error_message
+    )
+{
+    std::size_t start = position;
+
+    // Most strings have no escapes, and are then handed out in place:
+    while(position < text.size() && text[position] != '"' && text[position] != '\\' && static_cast<unsigned char>(text[position]) >= 0x20)
+    {
+        ++position;
+    }
+
+    if(position < text.size() && text[position] == '"')
+    {
+        value = text.substr(start, position - start);
+        ++position;
+
+        return(true);
+    }
+
+    std::size_t scratch_start = m_scratch.size();
+
+    m_scratch.append(text.substr(start, position - start));
+
+    while(position < text.size() && text[position] != '"')
+    {
+        unsigned char character = static_cast<unsigned char>(text[position]);
+
+        if(character < 0x20)
+        {
+            error_message = "control character in a string (at character " + std::to_string(position + 1) + ").";
+
+            return(false);
+        }
+
+        if(character != '\\')
+        {
+            m_scratch += static_cast<char>(character);
+            ++position;
+
+            continue;
+        }
+
+        if(position + 1 >= text.size())
+        {
+            break;
+        }
+
+        char escape = text[position + 1];
+
+        position += 2;
+
+        switch(escape)
+        {
+            case '"':  m_scratch += '"';  break;
+            case '\\': m_scratch += '\\'; break;
+            case '/':  m_scratch += '/';  break;
+            case 'b':  m_scratch += '\b'; break;
+            case 'f':  m_scratch += '\f'; break;
+            case 'n':  m_scratch += '\n'; break;
+            case 'r':  m_scratch += '\r'; break;
+            case 't':  m_scratch += '\t'; break;
+
+            case 'u':
+            {
+                unsigned int code_point = 0;
+
+                if(!readHex(text, position, code_point))
+                {
+                    error_message = "invalid \\u escape (at character " + std::to_string(position + 1) + ").";
+
+                    return(false);
+                }
+
+                position += 4;
+
+                // A surrogate pair stands for one code point outside the basic plane:
+                unsigned int low_surrogate = 0;
+
+                if(code_point >= 0xD800 && code_point <= 0xDBFF && text.substr(position, 2) == "\\u" && readHex(text, position + 2, low_surrogate) && low_surrogate >= 0xDC00 && low_surrogate <= 0xDFFF)
+                {
+                    code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low_surrogate - 0xDC00);
+                    position += 6;
+                }
+
+                appendUtf8(m_scratch, code_point);
+
+                break;
+            }
+
+            default:
+                error_message = "invalid escape (at character " + std::to_string(position) + ").";
+
+                return(false);
+        }
+    }
+
+    if(position >= text.size())
+    {
+        error_message = "a string is never closed.";
+
+        return(false);
+    }
+
+    ++position;
+
+    value = std::string_view(m_scratch).substr(scratch_start);
+
+    return(true);
+}
+
+JsonWriter::JsonWriter(
+    std::string& output
+    ) :
+    m_output(output),
+    m_depth(0),
+    m_has_items(),
+    m_is_after_key(false)
+{
+}
+
+void JsonWriter::beginObject()
+{
+    open('{');
+}
+
+void JsonWriter::endObject()
+{
+    close('}');
+}
+
+void JsonWriter::beginArray()
+{
+    open('[');
+}
+
+void JsonWriter::endArray()
+{
+    close(']');
+}
+
+void JsonWriter::key(
+    std::string_view name
+    )
+{
+    separate();
+    appendString(name);
+
+    m_output += ':';
+    m_is_after_key = true;
+}
+
+void JsonWriter::string(
+    std::string_view value
+    )
+{
+    separate();
+    appendString(value);
+}
+
+void JsonWriter::appendString(
+    std::string_view value
+    )
+{
+    m_output += '"';
+
+    // Copy the runs that need no escaping in one go:
+    std::size_t run_start = 0;
+
+    for(std::size_t index = 0; index < value.size(); ++index)
+    {
+        unsigned char character = static_cast<unsigned char>(value[index]);
+
+        if(character >= 0x20 && character != '"' && character != '\\')
+        {
+            continue;
+        }
+
+        m_output.append(value.substr(run_start, index - run_start));
+
+        switch(character)
+        {
+            case '"':  m_output += "\\\""; break;
+            case '\\': m_output += "\\\\"; break;
+            case '\n': m_output += "\\n";  break;
+            case '\r': m_output += "\\r";  break;
+            case '\t': m_output += "\\t";  break;
+
+            default:
+            {
+                static const char sc_hex_digits[] = "0123456789abcdef";
+
+                m_output += "\\u00";
+                m_output += sc_hex_digits[character >> 4];
+                m_output += sc_hex_digits[character & 0xF];
+
+                break;
+            }
+        }
+
+        run_start = index + 1;
+    }
+
+    m_output.append(value.substr(run_start));
+    m_output += '"';
+}
+
+void JsonWriter::number(
+    double value
+    )
+{
+    separate();
+
+    // JSON has no infinities or NaN:
+    if(!std::isfinite(value))
+    {
+        m_output += "null";
+
+        return;
+    }
+
+    char digits[32];
+
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+
+    m_output.append(digits, result.ptr);
+}
+
+void JsonWriter::integer(
+    long long value
+    )
+{
+    separate();
+
+    char digits[24];
+
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+
+    m_output.append(digits, result.ptr);
+}
+
+void JsonWriter::boolean(
+    bool value
+    )
+{
+    separate();
+
+    m_output += value ? "true" : "false";
+}
+
+void JsonWriter::null()
+{
+    separate();
+
+    m_output += "null";
+}
+
+void JsonWriter::raw(
+    std::string_view json
+    )
+{
+    separate();
+
+    m_output.append(json);
+}
+
+void JsonWriter::separate()
+{
+    if(m_is_after_key)
+    {
+        m_is_after_key = false;
+
+        return;
+    }
+
+    // NOTE (SAVIZ): Deeper than 'sc_max_depth' the commas are no longer tracked, which no response comes close to.
+    if(m_depth == 0 || m_depth > sc_max_depth)
+    {
+        return;
+    }
+
+    if(m_has_items[m_depth - 1])
+    {
+        m_output += ',';
+    }
+
+    m_has_items[m_depth - 1] = true;
+}
+
+void JsonWriter::open(
+    char bracket
+    )
+{
+    separate();
+
+    m_output += bracket;
+
+    if(m_depth < sc_max_depth)
+    {
+        m_has_items[m_depth] = false;
+    }
+
+    ++m_depth;
+}
+
+void JsonWriter::close(
+    char bracket
+    )
+{
+    m_output += bracket;
+
+    if(m_depth > 0)
+    {
+        --m_depth;
+    }
+
+    m_is_after_key = false;
+}
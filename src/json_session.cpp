@@ -0,0 +1,841 @@
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include "json_session.hpp"
+#include "database_cursor.hpp"
+#include "global.hpp"
+#include "utilities.hpp"
+
+JsonSession::JsonSession(
+    Database* database
+    ) :
+    m_database(database),
+    m_responses(),
+    m_request()
+{
+}
+
+JsonSession::~JsonSession()
+{
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::run(
+    std::istream& request_stream,
+    std::ostream& response_stream,
+    JsonSessionStatistics& statistics,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    statistics = JsonSessionStatistics();
+
+    m_responses.clear();
+    m_responses.reserve(sc_response_buffer_bytes + 1024);
+
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+    std::string line;
+
+    while(true)
+    {
+        // NOTE (SAVIZ): Nothing more to read without waiting, so the parent may be waiting on these responses:
+        if(request_stream.rdbuf()->in_avail() <= 0)
+        {
+            flushResponses(response_stream);
+        }
+
+        if(!std::getline(request_stream, line))
+        {
+            break;
+        }
+
+        if(line.find_first_not_of(" \t\r") == std::string::npos)
+        {
+            continue;
+        }
+
+        ++statistics.request_count;
+
+        if(!handleRequest(line, m_responses))
+        {
+            ++statistics.failed_count;
+        }
+
+        if(m_responses.size() >= sc_response_buffer_bytes)
+        {
+            flushResponses(response_stream);
+        }
+    }
+
+    // NOTE (SAVIZ): 'flushResponses()' commits what is still grouped, so a group that fails here is answered with an error line like any other:
+    flushResponses(response_stream);
+
+    m_database->getLastGroupCommitOutcome(is_successful, outcome_message);
+
+    statistics.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    if(!is_successful)
+    {
+        outcome_message = "Session failed: " + outcome_message;
+
+        return;
+    }
+
+    double rate = statistics.elapsed_seconds > 0.0 ? static_cast<double>(statistics.request_count) / statistics.elapsed_seconds : 0.0;
+
+    std::ostringstream summary;
+
+    summary << "Session finished: " << statistics.request_count << " request(s), " << statistics.failed_count << " failed in "
+            << std::fixed << std::setprecision(2) << statistics.elapsed_seconds << " s (" << std::setprecision(0) << rate << " requests/s)";
+
+    outcome_message = summary.str();
+}
+
+// ----------------------------------------------------------------------------
+bool JsonSession::handleRequest(
+    std::string_view request,
+    std::string& response
+    )
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    std::size_t response_start = response.size();
+
+    is_successful = m_request.parse(request, outcome_message);
+
+    if(is_successful)
+    {
+        JsonWriter writer(response);
+
+        beginResponse(writer, true);
+
+        std::string_view op;
+
+        if(!getString("op", op, outcome_message))
+        {
+            is_successful = false;
+        }
+
+        else if(op == "addVessel")
+        {
+            addVessel(writer, is_successful, outcome_message);
+        }
+
+        else if(op == "getVessels")
+        {
+            getVessels(writer, is_successful, outcome_message);
+        }
+
+        else if(op == "addSailing")
+        {
+            addSailing(writer, is_successful, outcome_message);
+        }
+
+        else if(op == "removeSailing")
+        {
+            removeSailing(writer, is_successful, outcome_message);
+        }
+
+        else if(op == "getSailingReports")
+        {
+            getSailingReports(writer, is_successful, outcome_message);
+        }
+
+        else if(op == "getSailingReportByID")
+        {
+            getSailingReportByID(writer, is_successful, outcome_message);
+        }
+
+        else if(op == "addVehicle")
+        {
+            addVehicle(writer, is_successful, outcome_message);
+        }
+
+        else if(op == "getVehicleByID")
+        {
+            getVehicleByID(writer, is_successful, outcome_message);
+        }
+
+        else if(op == "addReservation")
+        {
+            addReservation(writer, is_successful, outcome_message);
+        }
+
+        else if(op == "removeReservation")
+        {
+            removeReservation(writer, is_successful, outcome_message);
+        }
+
+        else if(op == "completeBoarding")
+        {
+            completeBoarding(writer, is_successful, outcome_message);
+        }
+
+        else if(op == "flushGroupCommit")
+        {
+            flushGroupCommit(writer, is_successful, outcome_message);
+        }
+
+        else
+        {
+            is_successful = false;
+            outcome_message = "unknown op '" + std::string(op) + "'.";
+        }
+
+        if(is_successful)
+        {
+            writer.endObject();
+        }
+    }
+
+    // Whatever was written for a failed request is replaced by the error:
+    if(!is_successful)
+    {
+        response.resize(response_start);
+
+        answerWithError(request, outcome_message, response);
+
+        return(false);
+    }
+
+    response += '\n';
+
+    return(true);
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::answerWithError(
+    std::string_view request,
+    const std::string& outcome_message,
+    std::string& response
+    )
+{
+    std::string parse_message = "";
+
+    // Without a readable request, the error is still given (just without an "id"):
+    if(!m_request.parse(request, parse_message))
+    {
+        m_request.parse("{}", parse_message);
+    }
+
+    JsonWriter writer(response);
+
+    beginResponse(writer, false);
+
+    writer.key("error");
+    writer.string(outcome_message);
+    writer.endObject();
+
+    response += '\n';
+}
+
+// ----------------------------------------------------------------------------
+bool JsonSession::isWriteOperation(
+    std::string_view op
+    )
+{
+    return(op == "addVessel" ||
+           op == "addSailing" ||
+           op == "removeSailing" ||
+           op == "addVehicle" ||
+           op == "addReservation" ||
+           op == "removeReservation" ||
+           op == "completeBoarding" ||
+           op == "flushGroupCommit");
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::beginResponse(
+    JsonWriter& writer,
+    bool is_ok
+    ) const
+{
+    writer.beginObject();
+
+    const JsonValue* id = m_request.find("id");
+
+    if(id != nullptr)
+    {
+        writer.key("id");
+
+        if(id->type == JsonType::String)
+        {
+            writer.string(id->text);
+        }
+
+        else
+        {
+            writer.raw(id->text);
+        }
+    }
+
+    writer.key("ok");
+    writer.boolean(is_ok);
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::addVessel(
+    JsonWriter& /* writer */, // Unused: this request is only answered with "ok" (see 'beginResponse()').
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+
+    Vessel vessel;
+    std::string_view vessel_name;
+
+    if(!getString("vessel_name", vessel_name, outcome_message) ||
+       !getNumber("low_ceiling_lane_length", vessel.low_ceiling_lane_length, outcome_message) ||
+       !getNumber("high_ceiling_lane_length", vessel.high_ceiling_lane_length, outcome_message))
+    {
+        return;
+    }
+
+    vessel.vessel_name = vessel_name;
+
+    // NOTE (SAVIZ): The same rules (and limits) as the prompts, from 'global.hpp'.
+    if(!std::regex_match(vessel.vessel_name, g_vessel_name_pattern))
+    {
+        outcome_message = "invalid vessel name '" + vessel.vessel_name + "'.";
+
+        return;
+    }
+
+    if(!Utilities::isInRange(vessel.low_ceiling_lane_length, g_lane_min_length, g_lane_max_length) || !Utilities::isInRange(vessel.high_ceiling_lane_length, g_lane_min_length, g_lane_max_length))
+    {
+        outcome_message = "the lane lengths must be in the allowed range.";
+
+        return;
+    }
+
+    m_database->addVessel(vessel, is_successful, outcome_message);
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::getVessels(
+    JsonWriter& writer,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    RowCursor<VesselView> cursor;
+
+    m_database->openVesselCursor(cursor, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    writer.key("vessels");
+    writer.beginArray();
+
+    for(const VesselView& vessel : cursor)
+    {
+        writer.beginObject();
+        writer.key("vessel_id");
+        writer.integer(vessel.vessel_id);
+        writer.key("vessel_name");
+        writer.string(vessel.vessel_name);
+        writer.key("low_ceiling_lane_length");
+        writer.number(vessel.low_ceiling_lane_length);
+        writer.key("high_ceiling_lane_length");
+        writer.number(vessel.high_ceiling_lane_length);
+        writer.endObject();
+    }
+
+    writer.endArray();
+
+    cursor.getOutcome(is_successful, outcome_message);
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::addSailing(
+    JsonWriter& /* writer */, // Unused: this request is only answered with "ok" (see 'beginResponse()').
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+
+    std::string_view sailing_id;
+    double vessel_id = 0.0;
+
+    if(!getString("sailing_id", sailing_id, outcome_message) || !getNumber("vessel_id", vessel_id, outcome_message))
+    {
+        return;
+    }
+
+    std::string sailing_id_text(sailing_id);
+
+    if(!std::regex_match(sailing_id_text, g_sailing_id_pattern))
+    {
+        outcome_message = "invalid sailing ID '" + sailing_id_text + "' (expected TTT-dd-hh).";
+
+        return;
+    }
+
+    // A new sailing starts with the whole of its vessel's lanes free:
+    Vessel vessel;
+
+    m_database->getVesselByID(static_cast<int>(vessel_id), vessel, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    Sailing sailing;
+
+    Utilities::extractSailingID(sailing_id_text, sailing.departure_terminal, sailing.departure_day, sailing.departure_hour);
+
+    sailing.vessel_id = vessel.vessel_id;
+    sailing.low_remaining_length = vessel.low_ceiling_lane_length;
+    sailing.high_remaining_length = vessel.high_ceiling_lane_length;
+
+    m_database->addSailing(sailing, is_successful, outcome_message);
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::removeSailing(
+    JsonWriter& /* writer */, // Unused: this request is only answered with "ok" (see 'beginResponse()').
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    Sailing sailing;
+
+    findSailing(sailing, is_successful, outcome_message);
+
+    if(is_successful)
+    {
+        m_database->removeSailing(sailing, is_successful, outcome_message);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::getSailingReports(
+    JsonWriter& writer,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    RowCursor<SailingReportView> cursor;
+
+    m_database->openSailingReportCursor(cursor, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    writer.key("sailing_reports");
+    writer.beginArray();
+
+    std::string sailing_id;
+
+    for(const SailingReportView& row : cursor)
+    {
+        Utilities::createSailingID(row.departure_terminal, row.departure_day, row.departure_hour, sailing_id);
+
+        writer.beginObject();
+        writer.key("sailing_id");
+        writer.string(sailing_id);
+        writer.key("vessel_name");
+        writer.string(row.vessel_name);
+        writer.key("vehicle_count");
+        writer.integer(row.vehicle_count);
+        writer.key("occupancy_percentage");
+        writer.number(row.occupancy_percentage);
+        writer.key("low_remaining_length");
+        writer.number(row.low_remaining_length);
+        writer.key("high_remaining_length");
+        writer.number(row.high_remaining_length);
+        writer.endObject();
+    }
+
+    writer.endArray();
+
+    cursor.getOutcome(is_successful, outcome_message);
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::getSailingReportByID(
+    JsonWriter& writer,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    Sailing sailing;
+    SailingReport sailing_report;
+
+    findSailing(sailing, is_successful, outcome_message);
+
+    if(is_successful)
+    {
+        m_database->getSailingReportByID(sailing, sailing_report, is_successful, outcome_message);
+    }
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    std::string sailing_id;
+
+    Utilities::createSailingID(sailing.departure_terminal, sailing.departure_day, sailing.departure_hour, sailing_id);
+
+    writer.key("sailing_report");
+    writer.beginObject();
+    writer.key("sailing_id");
+    writer.string(sailing_id);
+    writer.key("vessel_name");
+    writer.string(sailing_report.vessel.vessel_name);
+    writer.key("vehicle_count");
+    writer.integer(sailing_report.vehicle_count);
+    writer.key("occupancy_percentage");
+    writer.number(sailing_report.occupancy_percentage);
+    writer.key("low_remaining_length");
+    writer.number(sailing.low_remaining_length);
+    writer.key("high_remaining_length");
+    writer.number(sailing.high_remaining_length);
+    writer.endObject();
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::addVehicle(
+    JsonWriter& writer,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    Vehicle vehicle;
+
+    outcome_message = readVehicle(vehicle);
+
+    if(!outcome_message.empty())
+    {
+        is_successful = false;
+
+        return;
+    }
+
+    int vehicle_id = 0;
+
+    m_database->addVehicle(vehicle, vehicle_id, is_successful, outcome_message);
+
+    if(is_successful)
+    {
+        writer.key("vehicle_id");
+        writer.integer(vehicle_id);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::getVehicleByID(
+    JsonWriter& writer,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    Vehicle vehicle;
+
+    findVehicle(vehicle, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    writer.key("vehicle");
+    writer.beginObject();
+    writer.key("vehicle_id");
+    writer.integer(vehicle.vehicle_id);
+    writer.key("license_plate");
+    writer.string(vehicle.license_plate);
+    writer.key("phone_number");
+    writer.string(vehicle.phone_number);
+    writer.key("length");
+    writer.number(vehicle.length);
+    writer.key("height");
+    writer.number(vehicle.height);
+    writer.endObject();
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::addReservation(
+    JsonWriter& writer,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    Sailing sailing;
+    Vehicle vehicle;
+
+    findSailing(sailing, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    findVehicle(vehicle, is_successful, outcome_message);
+
+    // Not known yet, so create it if its details are given:
+    if(!is_successful && m_request.find("phone_number") != nullptr)
+    {
+        outcome_message = readVehicle(vehicle);
+
+        if(!outcome_message.empty())
+        {
+            return;
+        }
+
+        m_database->addVehicle(vehicle, vehicle.vehicle_id, is_successful, outcome_message);
+    }
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    Reservation reservation;
+
+    m_database->addReservation(sailing, vehicle, reservation, is_successful, outcome_message);
+
+    if(is_successful)
+    {
+        writer.key("reserved_for_low_lane");
+        writer.boolean(reservation.reserved_for_low_lane);
+        writer.key("low_remaining_length");
+        writer.number(sailing.low_remaining_length);
+        writer.key("high_remaining_length");
+        writer.number(sailing.high_remaining_length);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::removeReservation(
+    JsonWriter& /* writer */, // Unused: this request is only answered with "ok" (see 'beginResponse()').
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    Sailing sailing;
+    Vehicle vehicle;
+
+    findSailing(sailing, is_successful, outcome_message);
+
+    if(is_successful)
+    {
+        findVehicle(vehicle, is_successful, outcome_message);
+    }
+
+    if(is_successful)
+    {
+        m_database->removeReservation(sailing, vehicle, is_successful, outcome_message);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::completeBoarding(
+    JsonWriter& /* writer */, // Unused: this request is only answered with "ok" (see 'beginResponse()').
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    Sailing sailing;
+    Vehicle vehicle;
+
+    findSailing(sailing, is_successful, outcome_message);
+
+    if(is_successful)
+    {
+        findVehicle(vehicle, is_successful, outcome_message);
+    }
+
+    if(is_successful)
+    {
+        m_database->completeBoarding(sailing, vehicle, is_successful, outcome_message);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::flushGroupCommit(
+    JsonWriter& /* writer */, // Unused: this request is only answered with "ok" (see 'beginResponse()').
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    m_database->flushGroupCommit(is_successful, outcome_message);
+}
+
+// ----------------------------------------------------------------------------
+bool JsonSession::getString(
+    std::string_view key,
+    std::string_view& value,
+    std::string& outcome_message
+    ) const
+{
+    const JsonValue* field = m_request.find(key);
+
+    if(field == nullptr || field->type != JsonType::String)
+    {
+        outcome_message = "expected a string field '" + std::string(key) + "'.";
+
+        return(false);
+    }
+
+    value = field->text;
+
+    return(true);
+}
+
+// ----------------------------------------------------------------------------
+bool JsonSession::getNumber(
+    std::string_view key,
+    double& value,
+    std::string& outcome_message
+    ) const
+{
+    const JsonValue* field = m_request.find(key);
+
+    if(field == nullptr || field->type != JsonType::Number)
+    {
+        outcome_message = "expected a number field '" + std::string(key) + "'.";
+
+        return(false);
+    }
+
+    value = field->number;
+
+    return(true);
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::findSailing(
+    Sailing& sailing,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    std::string_view sailing_id;
+
+    is_successful = getString("sailing_id", sailing_id, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    // NOTE (SAVIZ): Packing accepts exactly what 'g_sailing_id_pattern' does, so the ID is checked and parsed in one pass (without copying it).
+    SailingKey sailing_key;
+
+    if(!SailingKey::parse(sailing_id, sailing_key))
+    {
+        is_successful = false;
+        outcome_message = "invalid sailing ID '" + std::string(sailing_id) + "' (expected TTT-dd-hh).";
+
+        return;
+    }
+
+    m_database->getSailingByID(sailing_key, sailing, is_successful, outcome_message);
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::findVehicle(
+    Vehicle& vehicle,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    std::string_view license_plate;
+
+    is_successful = getString("license_plate", license_plate, outcome_message);
+
+    if(is_successful)
+    {
+        m_database->getVehicleByID(std::string(license_plate), vehicle, is_successful, outcome_message);
+    }
+}
+
+// ----------------------------------------------------------------------------
+std::string JsonSession::readVehicle(
+    Vehicle& vehicle
+    ) const
+{
+    std::string_view license_plate;
+    std::string_view phone_number;
+    std::string outcome_message;
+
+    if(!getString("license_plate", license_plate, outcome_message) ||
+       !getString("phone_number", phone_number, outcome_message) ||
+       !getNumber("length", vehicle.length, outcome_message) ||
+       !getNumber("height", vehicle.height, outcome_message))
+    {
+        return(outcome_message);
+    }
+
+    vehicle.license_plate = license_plate;
+    vehicle.phone_number = phone_number;
+
+    // NOTE (SAVIZ): The same rules (and limits) as the prompts, from 'global.hpp'.
+    if(!std::regex_match(vehicle.license_plate, g_license_plate_pattern))
+    {
+        return("invalid license plate '" + vehicle.license_plate + "'.");
+    }
+
+    if(!std::regex_match(vehicle.phone_number, g_phone_number_pattern))
+    {
+        return("invalid phone number '" + vehicle.phone_number + "'.");
+    }
+
+    if(!Utilities::isInRange(vehicle.length, g_vehicle_min_length, g_vehicle_max_length) || !Utilities::isInRange(vehicle.height, g_vehicle_min_height, g_vehicle_max_height))
+    {
+        return("the vehicle length and height must be in the allowed range.");
+    }
+
+    return("");
+}
+
+// ----------------------------------------------------------------------------
+void JsonSession::flushResponses(
+    std::ostream& response_stream
+    )
+{
+    // A write is only answered once it is durable (see the top of 'json_session.hpp'):
+    if(m_database->hasPendingWrites())
+    {
+        bool is_successful = false;
+        std::string outcome_message = "";
+
+        m_database->flushGroupCommit(is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            JsonWriter writer(m_responses);
+
+            writer.beginObject();
+            writer.key("ok");
+            writer.boolean(false);
+            writer.key("error");
+            writer.string(outcome_message);
+            writer.endObject();
+
+            m_responses += '\n';
+        }
+    }
+
+    if(m_responses.empty())
+    {
+        return;
+    }
+
+    response_stream.write(m_responses.data(), static_cast<std::streamsize>(m_responses.size()));
+    response_stream.flush();
+
+    m_responses.clear();
+}
@@ -29,25 +29,227 @@
 
 #include "state_manager.hpp"
 #include "database.hpp"
+#include "async_database.hpp"
+#include "capacity_engine.hpp"
+#include "command_line.hpp"
+#include "importer.hpp"
+#include "script_runner.hpp"
+#include "json_session.hpp"
+#include "server.hpp"
+#include "report_builder.hpp"
+#include "entity_cache.hpp"
+#include "plate_filter.hpp"
 #include <iostream>
+#include <algorithm>
+#include <csignal>
+#include <thread>
+
+// The server being run, for the signal handler to stop:
+static Server* s_running_server = nullptr;
+
+static void stopServer(int /* signal_number */)
+{
+    if(s_running_server != nullptr)
+    {
+        s_running_server->requestStop();
+    }
+}
 
 int main(int argc, char *argv[])
 {
     bool is_successful = false;
     std::string outcome_message = "";
 
+    //  Section: Command line
+    // ------------------------------------------------------------------------
+
+    CommandLineOptions options;
+
+    parseCommandLine(argc, argv, options, is_successful, outcome_message);
+
+    // If the arguments are not valid, then show how to use them and abort:
+    if(!is_successful)
+    {
+        std::cout << outcome_message << "\n\n" << getUsage() << std::endl;
+
+        return(0);
+    }
+
+    if(options.show_usage)
+    {
+        std::cout << getUsage() << std::endl;
+
+        return(0);
+    }
+
+    // ------------------------------------------------------------------------
+
+
+
     //  Section: Database setup
     // ------------------------------------------------------------------------
 
+    // NOTE (SAVIZ): The AsyncDatabase works on the same file through a second connection, so each connection must wait for the other's lock instead of failing straight away.
+    // A timeout that was set (even to 0) is kept as it is; '--show-profile' says when this default was used.
+    bool is_busy_timeout_defaulted = !options.is_busy_timeout_given;
+
+    if(is_busy_timeout_defaulted)
+    {
+        options.connection_profile.busy_timeout = 5000;
+    }
+
+    // The server's readers run beside its writer, on read connections of their own (which need WAL mode):
+    if(!options.server_socket_path.empty())
+    {
+        if(options.server_reader_count < 1)
+        {
+            options.server_reader_count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+
+        options.connection_profile.journal_mode = "WAL";
+        options.connection_profile.read_connections = std::max(options.connection_profile.read_connections, options.server_reader_count);
+    }
+
+    // Likewise, each worker of the report reads on a read connection of its own:
+    if(!options.report_partitioning.empty())
+    {
+        if(options.report_thread_count < 1)
+        {
+            options.report_thread_count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+
+        options.connection_profile.journal_mode = "WAL";
+        options.connection_profile.read_connections = std::max(options.connection_profile.read_connections, options.report_thread_count);
+    }
+
     Database *database = new Database();
 
-    database->openConnection("database.db", is_successful, outcome_message);
+    database->openConnection(options.database_path, options.connection_profile, is_successful, outcome_message);
 
     // If the operation is not successful, then just abort:
     if(!is_successful)
     {
         std::cout << outcome_message << std::endl;
 
+        delete database;
+
+        return(0);
+    }
+
+    if(options.show_connection_profile)
+    {
+        ConnectionProfile effective_profile;
+
+        database->getConnectionProfile(effective_profile, is_successful, outcome_message);
+
+        std::cout << (is_successful ? "Connection profile: " + describeConnectionProfile(effective_profile) : outcome_message) << "\n";
+
+        if(is_successful && is_busy_timeout_defaulted)
+        {
+            std::cout << "(busy_timeout was not set, so it defaults to 5000 milliseconds for the connections sharing the file)\n";
+        }
+
+        std::cout << "\n";
+    }
+
+    // Lookups are answered from memory where they can be. The cache outlives every Database using it, as they are all deleted before returning from here:
+    EntityCache entity_cache(options.entity_cache);
+
+    bool is_entity_cache_on = options.entity_cache.vehicle_capacity > 0 || options.entity_cache.sailing_capacity > 0;
+
+    if(is_entity_cache_on)
+    {
+        database->setEntityCache(&entity_cache, is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            std::cout << outcome_message << std::endl;
+        }
+    }
+
+    // Unknown plates are ruled out in memory. The filter is saved as soon as it is loaded, as the next run only needs the vehicles created after that:
+    PlateFilter plate_filter;
+
+    bool is_plate_filter_on = false;
+
+    if(options.use_plate_filter)
+    {
+        bool is_file_backed = options.database_path != ":memory:" && !options.database_path.empty();
+
+        if(is_file_backed)
+        {
+            plate_filter.load(*database, PlateFilter::getFilePath(options.database_path), is_successful, outcome_message);
+        }
+
+        else
+        {
+            plate_filter.build(*database, is_successful, outcome_message);
+        }
+
+#ifdef DEBUG_MODE
+        std::cout << "[Debug] " << outcome_message << "\n";
+#endif
+
+        if(is_successful)
+        {
+            is_plate_filter_on = true;
+
+            database->setPlateFilter(&plate_filter, is_successful, outcome_message);
+        }
+
+        if(is_successful && is_file_backed)
+        {
+            plate_filter.save(PlateFilter::getFilePath(options.database_path), is_successful, outcome_message);
+        }
+
+        if(!is_successful)
+        {
+            std::cout << outcome_message << std::endl;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+
+
+
+    //  Section: Import (instead of the menus)
+    // ------------------------------------------------------------------------
+
+    if(!options.import_paths.empty())
+    {
+        // NOTE (SAVIZ): The parsers only check text, the calling thread does every write, so this scales until SQLite becomes the limit.
+        ImportSettings import_settings;
+
+        import_settings.parser_count = options.import_thread_count > 0 ? options.import_thread_count : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+        Importer importer(database, std::cout, import_settings);
+
+        for(const std::string& import_path : options.import_paths)
+        {
+            ImportStatistics statistics;
+
+            std::cout << "Importing " << import_path << "\n";
+
+            importer.importFile(import_path, statistics, is_successful, outcome_message);
+
+            std::cout << outcome_message << "\n\n";
+
+            // Later files may refer to what this one should have created, so stop here:
+            if(!is_successful)
+            {
+                break;
+            }
+        }
+
+        database->cutConnection(is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            std::cout << outcome_message << std::endl;
+        }
+
+        delete database;
+
         return(0);
     }
 
@@ -55,12 +257,271 @@ int main(int argc, char *argv[])
 
 
 
+    //  Section: Script or JSON requests (instead of the menus)
+    // ------------------------------------------------------------------------
+
+    if(!options.script_path.empty() || options.json_mode)
+    {
+        // NOTE (SAVIZ): The standard output carries the answers, so every other message goes to the standard error.
+        // Every command runs on this connection, so with '--group-commit' its writes are grouped here (what is left is committed when the input ends).
+        if(options.group_commit.max_operations > 1)
+        {
+            database->setGroupCommit(options.group_commit, is_successful, outcome_message);
+
+            if(!is_successful)
+            {
+                std::cerr << outcome_message << std::endl;
+            }
+        }
+
+        if(options.json_mode)
+        {
+            // Responses are only written once no request is waiting, which the standard input can only tell when it is not synchronized with C I/O:
+            std::ios::sync_with_stdio(false);
+            std::cin.tie(nullptr);
+
+            JsonSessionStatistics statistics;
+            JsonSession json_session(database);
+
+            json_session.run(std::cin, std::cout, statistics, is_successful, outcome_message);
+        }
+
+        else
+        {
+            ScriptStatistics statistics;
+            ScriptRunner script_runner(database, std::cout);
+
+            script_runner.runFile(options.script_path, statistics, is_successful, outcome_message);
+        }
+
+        std::cerr << outcome_message << std::endl;
+
+        database->cutConnection(is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            std::cerr << outcome_message << std::endl;
+        }
+
+        delete database;
+
+        return(0);
+    }
+
+    // ------------------------------------------------------------------------
+
+
+
+    //  Section: End-of-day report (instead of the menus)
+    // ------------------------------------------------------------------------
+
+    if(!options.report_partitioning.empty())
+    {
+        ReportSettings report_settings;
+
+        report_settings.partitioning = (options.report_partitioning == "terminal") ? ReportPartitioning::ByTerminal : ReportPartitioning::ByDayRange;
+        report_settings.worker_count = options.report_thread_count;
+
+        EndOfDayReport report;
+        ReportBuilder report_builder(database, report_settings);
+
+        report_builder.build(report, is_successful, outcome_message);
+
+        if(is_successful)
+        {
+            ReportBuilder::printReport(report, std::cout);
+        }
+
+        else
+        {
+            std::cerr << outcome_message << std::endl;
+        }
+
+        database->cutConnection(is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            std::cerr << outcome_message << std::endl;
+        }
+
+        delete database;
+
+        return(0);
+    }
+
+    // ------------------------------------------------------------------------
+
+
+
+    //  Section: Server (instead of the menus)
+    // ------------------------------------------------------------------------
+
+    if(!options.server_socket_path.empty())
+    {
+        // NOTE (SAVIZ): This connection becomes the server's writer, so with '--group-commit' the writes of every client are grouped here.
+        if(options.group_commit.max_operations > 1)
+        {
+            database->setGroupCommit(options.group_commit, is_successful, outcome_message);
+
+            if(!is_successful)
+            {
+                std::cerr << outcome_message << std::endl;
+            }
+        }
+
+        ServerSettings server_settings;
+
+        server_settings.socket_path = options.server_socket_path;
+        server_settings.reader_count = options.server_reader_count;
+
+        Server *server = new Server();
+
+        server->open(database, server_settings, is_successful, outcome_message);
+
+        std::cerr << outcome_message << std::endl;
+
+        if(is_successful)
+        {
+            ServerStatistics statistics;
+
+            // Serve until interrupted (Ctrl+C) or asked to terminate:
+            s_running_server = server;
+
+            std::signal(SIGINT, stopServer);
+            std::signal(SIGTERM, stopServer);
+
+            server->run(statistics, is_successful, outcome_message);
+
+            std::signal(SIGINT, SIG_DFL);
+            std::signal(SIGTERM, SIG_DFL);
+
+            s_running_server = nullptr;
+
+            std::cerr << outcome_message << std::endl;
+
+            server->close(is_successful, outcome_message);
+
+            if(!is_successful)
+            {
+                std::cerr << outcome_message << std::endl;
+            }
+        }
+
+        delete server;
+
+        // Whatever the writer left grouped is committed with the connection:
+        database->cutConnection(is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            std::cerr << outcome_message << std::endl;
+        }
+
+        delete database;
+
+        return(0);
+    }
+
+    // ------------------------------------------------------------------------
+
+
+
+    //  Section: In-memory state
+    // ------------------------------------------------------------------------
+
+    // Every sailing's lane capacity is kept in memory from here on (reservations write through it):
+    CapacityEngine *capacity_engine = new CapacityEngine();
+
+    capacity_engine->load(*database, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        std::cout << outcome_message << std::endl;
+
+        delete capacity_engine;
+
+        database->cutConnection(is_successful, outcome_message);
+
+        delete database;
+
+        return(0);
+    }
+
+    // An in-memory database only exists inside its own connection, so there is nothing for a second connection to share (the states then do all the work directly):
+    AsyncDatabase *async_database = nullptr;
+
+    if(options.database_path != ":memory:" && !options.database_path.empty())
+    {
+        async_database = new AsyncDatabase();
+
+        async_database->openConnection(options.database_path, options.connection_profile, is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            std::cout << outcome_message << std::endl;
+
+            delete async_database;
+            async_database = nullptr;
+        }
+    }
+
+    // The AsyncDatabase shares the cache, so that the boardings it writes invalidate what the menus read:
+    if(async_database != nullptr && is_entity_cache_on)
+    {
+        OperationResult result = async_database->submit([&entity_cache](Database& worker_database)
+        {
+            OperationResult worker_result;
+
+            worker_database.setEntityCache(&entity_cache, worker_result.is_successful, worker_result.outcome_message);
+
+            return(worker_result);
+        }).get();
+
+        if(!result.is_successful)
+        {
+            std::cout << result.outcome_message << std::endl;
+        }
+    }
+
+    // Likewise for the filter, so that the vehicles it creates are never ruled out:
+    if(async_database != nullptr && is_plate_filter_on)
+    {
+        OperationResult result = async_database->submit([&plate_filter](Database& worker_database)
+        {
+            OperationResult worker_result;
+
+            worker_database.setPlateFilter(&plate_filter, worker_result.is_successful, worker_result.outcome_message);
+
+            return(worker_result);
+        }).get();
+
+        if(!result.is_successful)
+        {
+            std::cout << result.outcome_message << std::endl;
+        }
+    }
+
+    // NOTE (SAVIZ): Only the AsyncDatabase groups its writes. It commits an open group on its own once the queue runs dry, which the states' own connection has no way to do.
+    if(async_database != nullptr && options.group_commit.max_operations > 1)
+    {
+        async_database->setGroupCommit(options.group_commit, is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            std::cout << outcome_message << std::endl;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+
+
+
     //  Section: State setup
     // ------------------------------------------------------------------------
     
     StateManager state_manager;
 
-    state_manager.init(database);
+    state_manager.init(database, async_database, capacity_engine);
     state_manager.run();
 
     // ------------------------------------------------------------------------
@@ -70,6 +531,48 @@ int main(int argc, char *argv[])
     //  Section: Cleanup
     // ------------------------------------------------------------------------
 
+#ifdef DEBUG_MODE
+    StatementCacheStatistics statement_cache_statistics;
+
+    database->getStatementCacheStatistics(statement_cache_statistics);
+
+    std::cout << "[Debug] Statements prepared: " << statement_cache_statistics.prepared_count << ", prepares avoided: " << statement_cache_statistics.reused_count << "\n";
+
+    EntityCacheStatistics entity_cache_statistics;
+
+    entity_cache.getStatistics(entity_cache_statistics);
+
+    std::cout
+        << "[Debug] Entity cache hits/misses: vehicles " << entity_cache_statistics.vehicle_hits << "/" << entity_cache_statistics.vehicle_misses
+        << ", sailings " << entity_cache_statistics.sailing_hits << "/" << entity_cache_statistics.sailing_misses
+        << ", vessels " << entity_cache_statistics.vessel_hits << "/" << entity_cache_statistics.vessel_misses
+        << " (" << entity_cache_statistics.eviction_count << " evicted, " << entity_cache_statistics.invalidation_count << " invalidated)\n";
+
+    PlateFilterStatistics plate_filter_statistics;
+
+    plate_filter.getStatistics(plate_filter_statistics);
+
+    std::cout
+        << "[Debug] Plate filter: " << plate_filter_statistics.ruled_out_count << " lookups ruled out, " << plate_filter_statistics.found_count << " found, "
+        << plate_filter_statistics.false_positive_count << " false positives (rate " << plate_filter_statistics.getFalsePositiveRate()
+        << ", estimated " << plate_filter_statistics.estimated_false_positive_rate << ")\n";
+#endif
+
+    // Finish whatever the states left queued first:
+    if(async_database != nullptr)
+    {
+        async_database->cutConnection(is_successful, outcome_message);
+
+        if(!is_successful)
+        {
+            std::cout << outcome_message << std::endl;
+        }
+
+        delete async_database;
+    }
+
+    delete capacity_engine;
+
     database->cutConnection(is_successful, outcome_message);
 
     // If the operation is not successful, then just print message:
@@ -0,0 +1,434 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include "plate_filter.hpp"
+#include "database.hpp"
+
+// Identifies a saved filter (and its layout, should it ever change):
+static constexpr char s_file_magic[8] = {'F', 'F', 'P', 'L', 'A', 'T', 'E', '1'};
+
+PlateFilter::PlateFilter() :
+    m_words(),
+    m_plate_capacity(0),
+    m_last_vehicle_id(0),
+    m_last_license_plate(),
+    m_statistics()
+{
+}
+
+PlateFilter::~PlateFilter()
+{
+}
+
+void PlateFilter::build(
+    Database& database,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    std::vector<int> vehicle_ids;
+    std::vector<std::string> license_plates;
+
+    database.getVehiclePlates(0, vehicle_ids, license_plates, is_successful, outcome_message);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Room for the table to double before the false positive rate goes up:
+    reset(is_successful ? license_plates.size() * 2 : 0);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    for(const std::string& license_plate : license_plates)
+    {
+        setBits(license_plate);
+    }
+
+    m_statistics.plate_count = static_cast<long long>(license_plates.size());
+
+    if(!vehicle_ids.empty())
+    {
+        m_last_vehicle_id = vehicle_ids.back();
+        m_last_license_plate = license_plates.back();
+    }
+
+    is_successful = true;
+    outcome_message = std::string("Plate filter built: ") + std::to_string(license_plates.size()) + " plate(s)";
+}
+
+void PlateFilter::load(
+    Database& database,
+    const std::string& file_path,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // 1) Read the saved filter:
+    std::ifstream file(file_path, std::ios::binary);
+
+    char magic[sizeof(s_file_magic)] = {};
+    std::uint64_t bit_count = 0;
+    std::uint64_t plate_capacity = 0;
+    std::uint64_t plate_count = 0;
+    std::int64_t last_vehicle_id = 0;
+    std::uint64_t last_license_plate_size = 0;
+
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&bit_count), sizeof(bit_count));
+    file.read(reinterpret_cast<char*>(&plate_capacity), sizeof(plate_capacity));
+    file.read(reinterpret_cast<char*>(&plate_count), sizeof(plate_count));
+    file.read(reinterpret_cast<char*>(&last_vehicle_id), sizeof(last_vehicle_id));
+    file.read(reinterpret_cast<char*>(&last_license_plate_size), sizeof(last_license_plate_size));
+
+    bool is_file_valid =
+        file &&
+        std::equal(magic, magic + sizeof(magic), s_file_magic) &&
+        std::has_single_bit(bit_count) && bit_count >= 64 &&
+        last_vehicle_id >= 0 &&
+        last_license_plate_size <= 64;
+
+    std::string last_license_plate(is_file_valid ? last_license_plate_size : 0, '\0');
+    std::vector<std::uint64_t> words;
+
+    if(is_file_valid)
+    {
+        file.read(last_license_plate.data(), static_cast<std::streamsize>(last_license_plate.size()));
+
+        words.resize(bit_count / 64);
+        file.read(reinterpret_cast<char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(std::uint64_t)));
+
+        is_file_valid = file && file.peek() == std::ifstream::traits_type::eof();
+    }
+
+    if(!is_file_valid)
+    {
+        build(database, is_successful, outcome_message);
+
+        if(is_successful)
+        {
+            outcome_message += " (no saved filter was found)";
+        }
+
+        return;
+    }
+
+    // 2) Read the vehicles created since, starting from the last one it knew of (the row that proves it is the same database):
+    std::vector<int> vehicle_ids;
+    std::vector<std::string> license_plates;
+
+    database.getVehiclePlates(static_cast<int>(last_vehicle_id), vehicle_ids, license_plates, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        reset(0);
+
+        return;
+    }
+
+    std::size_t first_new_row = 0;
+
+    if(last_vehicle_id > 0)
+    {
+        if(vehicle_ids.empty() || vehicle_ids.front() != last_vehicle_id || license_plates.front() != last_license_plate)
+        {
+            build(database, is_successful, outcome_message);
+
+            if(is_successful)
+            {
+                outcome_message += " (the saved filter was for another database)";
+            }
+
+            return;
+        }
+
+        first_new_row = 1;
+    }
+
+    if(plate_count + (license_plates.size() - first_new_row) > plate_capacity)
+    {
+        build(database, is_successful, outcome_message);
+
+        if(is_successful)
+        {
+            outcome_message += " (the table outgrew the saved filter)";
+        }
+
+        return;
+    }
+
+    // 3) Take the saved filter over, and add the new plates to it:
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_words = std::move(words);
+    m_plate_capacity = static_cast<std::size_t>(plate_capacity);
+    m_last_vehicle_id = static_cast<int>(last_vehicle_id);
+    m_last_license_plate = last_license_plate;
+    m_statistics = PlateFilterStatistics();
+    m_statistics.plate_count = static_cast<long long>(plate_count);
+    m_statistics.bit_count = static_cast<long long>(bit_count);
+
+    for(std::size_t row = first_new_row; row < license_plates.size(); ++row)
+    {
+        setBits(license_plates[row]);
+
+        m_statistics.plate_count += 1;
+    }
+
+    if(!vehicle_ids.empty())
+    {
+        m_last_vehicle_id = vehicle_ids.back();
+        m_last_license_plate = license_plates.back();
+    }
+
+    is_successful = true;
+    outcome_message = std::string("Plate filter loaded: ") + std::to_string(m_statistics.plate_count) + " plate(s), " + std::to_string(license_plates.size() - first_new_row) + " read from the database";
+}
+
+void PlateFilter::save(
+    const std::string& file_path,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    std::string temporary_file_path = file_path + ".tmp";
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        std::ofstream file(temporary_file_path, std::ios::binary | std::ios::trunc);
+
+        std::uint64_t bit_count = static_cast<std::uint64_t>(m_words.size()) * 64;
+        std::uint64_t plate_capacity = static_cast<std::uint64_t>(m_plate_capacity);
+        std::uint64_t plate_count = static_cast<std::uint64_t>(m_statistics.plate_count);
+        std::int64_t last_vehicle_id = m_last_vehicle_id;
+        std::uint64_t last_license_plate_size = static_cast<std::uint64_t>(m_last_license_plate.size());
+
+        file.write(s_file_magic, sizeof(s_file_magic));
+        file.write(reinterpret_cast<const char*>(&bit_count), sizeof(bit_count));
+        file.write(reinterpret_cast<const char*>(&plate_capacity), sizeof(plate_capacity));
+        file.write(reinterpret_cast<const char*>(&plate_count), sizeof(plate_count));
+        file.write(reinterpret_cast<const char*>(&last_vehicle_id), sizeof(last_vehicle_id));
+        file.write(reinterpret_cast<const char*>(&last_license_plate_size), sizeof(last_license_plate_size));
+        file.write(m_last_license_plate.data(), static_cast<std::streamsize>(m_last_license_plate.size()));
+        file.write(reinterpret_cast<const char*>(m_words.data()), static_cast<std::streamsize>(m_words.size() * sizeof(std::uint64_t)));
+        file.close();
+
+        if(!file)
+        {
+            std::remove(temporary_file_path.c_str());
+
+            is_successful = false;
+            outcome_message = std::string("Plate filter save failed: ") + "could not write '" + temporary_file_path + "'";
+
+            return;
+        }
+    }
+
+    if(std::rename(temporary_file_path.c_str(), file_path.c_str()) != 0)
+    {
+        std::remove(temporary_file_path.c_str());
+
+        is_successful = false;
+        outcome_message = std::string("Plate filter save failed: ") + "could not replace '" + file_path + "'";
+
+        return;
+    }
+
+    is_successful = true;
+    outcome_message = std::string("Plate filter save succeeded");
+}
+
+void PlateFilter::getStatistics(
+    PlateFilterStatistics& statistics
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    statistics = m_statistics;
+
+    long long set_bit_count = 0;
+
+    for(std::uint64_t word : m_words)
+    {
+        set_bit_count += std::popcount(word);
+    }
+
+    // A missing plate passes when all of its bits happen to be set:
+    if(m_statistics.bit_count > 0)
+    {
+        statistics.estimated_false_positive_rate = std::pow(static_cast<double>(set_bit_count) / static_cast<double>(m_statistics.bit_count), sc_hash_count);
+    }
+}
+
+void PlateFilter::insert(
+    const std::string& license_plate
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    setBits(license_plate);
+
+    m_statistics.plate_count += 1;
+}
+
+bool PlateFilter::mayContain(
+    const std::string& license_plate
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return(testBits(license_plate));
+}
+
+void PlateFilter::catchUp(
+    Database& database,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    int last_vehicle_id = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        last_vehicle_id = m_last_vehicle_id;
+    }
+
+    // NOTE (SAVIZ): A range of the primary key past the last vehicle it read, usually empty. The lock is not held across it, so other threads keep using the filter meanwhile.
+    std::vector<int> vehicle_ids;
+    std::vector<std::string> license_plates;
+
+    database.getVehiclePlates(last_vehicle_id + 1, vehicle_ids, license_plates, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for(const std::string& license_plate : license_plates)
+    {
+        setBits(license_plate);
+
+        m_statistics.plate_count += 1;
+    }
+
+    // Another thread may have caught up further in the meantime:
+    if(!vehicle_ids.empty() && vehicle_ids.back() > m_last_vehicle_id)
+    {
+        m_last_vehicle_id = vehicle_ids.back();
+        m_last_license_plate = license_plates.back();
+    }
+
+    is_successful = true;
+    outcome_message = std::string("Plate filter caught up: ") + std::to_string(license_plates.size()) + " plate(s) read from the database";
+}
+
+void PlateFilter::recordRuledOut()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_statistics.ruled_out_count += 1;
+}
+
+void PlateFilter::recordLookup(
+    bool is_found
+    )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(is_found)
+    {
+        m_statistics.found_count += 1;
+    }
+
+    else
+    {
+        m_statistics.false_positive_count += 1;
+    }
+}
+
+void PlateFilter::reset(
+    std::size_t plate_capacity
+    )
+{
+    m_plate_capacity = std::max(plate_capacity, sc_minimum_capacity);
+
+    m_words.assign(std::bit_ceil(m_plate_capacity * sc_bits_per_plate) / 64, 0);
+    m_last_vehicle_id = 0;
+    m_last_license_plate.clear();
+
+    m_statistics = PlateFilterStatistics();
+    m_statistics.bit_count = static_cast<long long>(m_words.size()) * 64;
+}
+
+void PlateFilter::setBits(
+    const std::string& license_plate
+    )
+{
+    if(m_words.empty())
+    {
+        return;
+    }
+
+    std::uint64_t bit_mask = static_cast<std::uint64_t>(m_words.size()) * 64 - 1;
+    std::uint64_t hash = hashPlate(license_plate);
+    std::uint64_t step = (std::rotl(hash, 32) * 0x9E3779B97F4A7C15ULL) | 1;
+
+    // NOTE (SAVIZ): Two hashes stand in for all of them (h1 + i * h2), which is known to cost next to nothing in false positives.
+    for(int index = 0; index < sc_hash_count; ++index)
+    {
+        std::uint64_t bit = (hash + static_cast<std::uint64_t>(index) * step) & bit_mask;
+
+        m_words[bit / 64] |= std::uint64_t(1) << (bit % 64);
+    }
+}
+
+bool PlateFilter::testBits(
+    const std::string& license_plate
+    ) const
+{
+    if(m_words.empty())
+    {
+        return(false);
+    }
+
+    std::uint64_t bit_mask = static_cast<std::uint64_t>(m_words.size()) * 64 - 1;
+    std::uint64_t hash = hashPlate(license_plate);
+    std::uint64_t step = (std::rotl(hash, 32) * 0x9E3779B97F4A7C15ULL) | 1;
+
+    for(int index = 0; index < sc_hash_count; ++index)
+    {
+        std::uint64_t bit = (hash + static_cast<std::uint64_t>(index) * step) & bit_mask;
+
+        if((m_words[bit / 64] & (std::uint64_t(1) << (bit % 64))) == 0)
+        {
+            return(false);
+        }
+    }
+
+    return(true);
+}
+
+std::uint64_t PlateFilter::hashPlate(
+    const std::string& license_plate
+    )
+{
+    // 64-bit FNV-1a:
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+
+    for(char character : license_plate)
+    {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= 0x100000001B3ULL;
+    }
+
+    return(hash);
+}
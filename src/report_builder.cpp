@@ -0,0 +1,326 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include "report_builder.hpp"
+#include "utilities.hpp"
+
+// The order of a report: by departure day, hour and sailing.
+static bool isEarlier(
+    const EndOfDayReportRow& left,
+    const EndOfDayReportRow& right
+    )
+{
+    const Sailing& left_sailing = left.sailing_report.sailing;
+    const Sailing& right_sailing = right.sailing_report.sailing;
+
+    if(left_sailing.departure_day != right_sailing.departure_day)
+    {
+        return(left_sailing.departure_day < right_sailing.departure_day);
+    }
+
+    if(left_sailing.departure_hour != right_sailing.departure_hour)
+    {
+        return(left_sailing.departure_hour < right_sailing.departure_hour);
+    }
+
+    return(left_sailing.sailing_id < right_sailing.sailing_id);
+}
+
+ReportBuilder::ReportBuilder(
+    Database* database,
+    const ReportSettings& settings
+    ) :
+    m_database(database),
+    m_settings(settings)
+{
+}
+
+ReportBuilder::~ReportBuilder()
+{
+}
+
+void ReportBuilder::build(
+    EndOfDayReport& report,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+    report = EndOfDayReport();
+    report.total.label = "Total";
+
+    // 1) Split the sailings:
+    std::vector<std::string> departure_terminals;
+    int first_day = 0;
+    int last_day = -1;
+
+    m_database->getReportBounds(departure_terminals, first_day, last_day, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    int requested_worker_count = std::max(1, m_settings.worker_count);
+
+    std::vector<ReportPartition> partitions;
+
+    if(m_settings.partitioning == ReportPartitioning::ByTerminal)
+    {
+        for(const std::string& departure_terminal : departure_terminals)
+        {
+            ReportPartition partition;
+            partition.departure_terminal = departure_terminal;
+            partition.first_day = first_day;
+            partition.last_day = last_day;
+
+            partitions.push_back(partition);
+        }
+    }
+
+    else if(last_day >= first_day)
+    {
+        int day_count = last_day - first_day + 1;
+        int range_count = std::min(day_count, requested_worker_count * sc_day_ranges_per_worker);
+
+        for(int range_index = 0; range_index < range_count; ++range_index)
+        {
+            ReportPartition partition;
+            partition.first_day = first_day + (day_count * range_index) / range_count;
+            partition.last_day = first_day + (day_count * (range_index + 1)) / range_count - 1;
+
+            partitions.push_back(partition);
+        }
+    }
+
+    // 2) Never run more workers than there are partitions, or connections to read them on:
+    ConnectionProfile profile;
+
+    m_database->getConnectionProfile(profile, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    int worker_count = std::min(requested_worker_count, static_cast<int>(partitions.size()));
+
+    worker_count = std::min(worker_count, std::max(1, profile.read_connections));
+
+    // 3) The workers take the partitions in order, each one reading on a read connection of its own:
+    std::vector<std::vector<EndOfDayReportRow>> partition_rows(partitions.size());
+    std::vector<std::string> partition_failures(partitions.size());
+    std::atomic<std::size_t> next_partition(0);
+    std::atomic<bool> has_failed(false);
+
+    auto run_worker = [this, &partitions, &partition_rows, &partition_failures, &next_partition, &has_failed]()
+    {
+        while(!has_failed.load())
+        {
+            std::size_t partition_index = next_partition.fetch_add(1);
+
+            if(partition_index >= partitions.size())
+            {
+                return;
+            }
+
+            bool is_partition_successful = true;
+
+            m_database->getEndOfDayReport(partitions[partition_index], partition_rows[partition_index], is_partition_successful, partition_failures[partition_index]);
+
+            if(!is_partition_successful)
+            {
+                has_failed.store(true);
+            }
+        }
+    };
+
+    if(worker_count > 1)
+    {
+        std::vector<std::thread> workers;
+
+        for(int index = 0; index < worker_count; ++index)
+        {
+            workers.emplace_back(run_worker);
+        }
+
+        for(std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    else
+    {
+        run_worker();
+    }
+
+    // A partition that was never read leaves an empty message, so the first one set is the failure:
+    if(has_failed.load())
+    {
+        for(const std::string& partition_failure : partition_failures)
+        {
+            if(!partition_failure.empty())
+            {
+                is_successful = false;
+                outcome_message = partition_failure;
+
+                return;
+            }
+        }
+    }
+
+    // 4) Sum up each partition, then merge them back into departure order:
+    std::vector<std::size_t> partition_ends;
+
+    for(std::size_t partition_index = 0; partition_index < partitions.size(); ++partition_index)
+    {
+        ReportSummary summary;
+
+        if(m_settings.partitioning == ReportPartitioning::ByTerminal)
+        {
+            summary.label = partitions[partition_index].departure_terminal;
+        }
+
+        else
+        {
+            summary.label = "Days " + std::to_string(partitions[partition_index].first_day) + "-" + std::to_string(partitions[partition_index].last_day);
+        }
+
+        addToSummary(partition_rows[partition_index], summary);
+        addToSummary(partition_rows[partition_index], report.total);
+        finishSummary(summary);
+
+        report.partitions.push_back(summary);
+
+        report.rows.insert(report.rows.end(), std::make_move_iterator(partition_rows[partition_index].begin()), std::make_move_iterator(partition_rows[partition_index].end()));
+
+        partition_ends.push_back(report.rows.size());
+    }
+
+    finishSummary(report.total);
+
+    // NOTE (SAVIZ): Ranges of days follow each other already. Terminals overlap in time, so each sorted run is merged with its neighbour, doubling the run length every pass.
+    if(m_settings.partitioning == ReportPartitioning::ByTerminal)
+    {
+        while(partition_ends.size() > 1)
+        {
+            std::vector<std::size_t> merged_ends;
+            std::size_t run_begin = 0;
+
+            for(std::size_t run_index = 0; run_index < partition_ends.size(); run_index += 2)
+            {
+                if(run_index + 1 < partition_ends.size())
+                {
+                    std::inplace_merge(report.rows.begin() + run_begin, report.rows.begin() + partition_ends[run_index], report.rows.begin() + partition_ends[run_index + 1], isEarlier);
+
+                    run_begin = partition_ends[run_index + 1];
+                }
+
+                else
+                {
+                    run_begin = partition_ends[run_index];
+                }
+
+                merged_ends.push_back(run_begin);
+            }
+
+            partition_ends.swap(merged_ends);
+        }
+    }
+
+    report.worker_count = worker_count;
+    report.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    is_successful = true;
+    outcome_message = "Report built successfully!";
+}
+
+void ReportBuilder::printReport(
+    const EndOfDayReport& report,
+    std::ostream& output_stream
+    )
+{
+    output_stream << "End-of-Day Report\n";
+    output_stream << " Sailing ID  Vessel Name                       LCLR    HCLR  Vehicles  \%Occupied  Boarded    Revenue\n";
+
+    for(const EndOfDayReportRow& row : report.rows)
+    {
+        const SailingReport& sailing_report = row.sailing_report;
+
+        std::string sailing_id_str;
+        Utilities::createSailingID(sailing_report.sailing.departure_terminal, sailing_report.sailing.departure_day, sailing_report.sailing.departure_hour, sailing_id_str);
+
+        output_stream
+            << std::setw(10) << std::left << sailing_id_str << " "
+            << std::setw(30) << std::left << sailing_report.vessel.vessel_name
+            << std::fixed << std::setprecision(1)
+            << std::setw(7) << std::right << sailing_report.sailing.low_remaining_length
+            << std::setw(7) << std::right << sailing_report.sailing.high_remaining_length
+            << std::setw(9) << std::right << sailing_report.vehicle_count
+            << std::setw(10) << std::right << sailing_report.occupancy_percentage << "%"
+            << std::setw(9) << std::right << row.boarded_count
+            << std::setprecision(2)
+            << std::setw(11) << std::right << row.revenue
+            << "\n";
+    }
+
+    output_stream << "\n Partition                   Sailings  Vehicles  \%Occupied  Boarded    Revenue\n";
+
+    std::vector<const ReportSummary*> summaries;
+
+    for(const ReportSummary& summary : report.partitions)
+    {
+        summaries.push_back(&summary);
+    }
+
+    summaries.push_back(&report.total);
+
+    for(const ReportSummary* summary : summaries)
+    {
+        output_stream
+            << " " << std::setw(27) << std::left << summary->label
+            << std::setw(9) << std::right << summary->sailing_count
+            << std::setw(10) << std::right << summary->vehicle_count
+            << std::fixed << std::setprecision(1)
+            << std::setw(10) << std::right << summary->average_occupancy_percentage << "%"
+            << std::setw(9) << std::right << summary->boarded_count
+            << std::setprecision(2)
+            << std::setw(11) << std::right << summary->revenue
+            << "\n";
+    }
+
+    output_stream
+        << "\n"
+        << report.rows.size() << " sailing(s) in " << report.partitions.size() << " partition(s), read by " << report.worker_count << " worker(s) in "
+        << std::setprecision(3) << report.elapsed_seconds << " s.\n";
+}
+
+void ReportBuilder::addToSummary(
+    const std::vector<EndOfDayReportRow>& rows,
+    ReportSummary& summary
+    )
+{
+    // The occupancy is summed here, and divided by the sailings in 'finishSummary()':
+    for(const EndOfDayReportRow& row : rows)
+    {
+        summary.sailing_count += 1;
+        summary.vehicle_count += row.sailing_report.vehicle_count;
+        summary.boarded_count += row.boarded_count;
+        summary.revenue += row.revenue;
+        summary.average_occupancy_percentage += row.sailing_report.occupancy_percentage;
+    }
+}
+
+void ReportBuilder::finishSummary(
+    ReportSummary& summary
+    )
+{
+    if(summary.sailing_count > 0)
+    {
+        summary.average_occupancy_percentage /= summary.sailing_count;
+    }
+}
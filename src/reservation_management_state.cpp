@@ -7,6 +7,7 @@
 
 #include <vector>
 #include <iostream>
+#include <iomanip>
 #include "state.hpp"
 #include <regex>
 #include "reservation_management_state.hpp"
@@ -14,7 +15,9 @@
 #include "input.hpp"
 #include "containers.hpp"
 #include "database.hpp"
+#include "capacity_engine.hpp"
 #include "global.hpp"
+#include "utilities.hpp"
 
 // static container for storing Reservation info when creating a reservation
 static Reservation s_reservation;
@@ -50,6 +53,7 @@ void ReservationManagementState::onEnter()
         "RESERVATION MANAGEMENT MENU\n"
         "1) Make a new reservation\n"
         "2) Cancel a reservation\n"
+        "3) Find available sailings\n"
         "0) Exit to main menu\n"
         "\n";
 }
@@ -62,8 +66,8 @@ void ReservationManagementState::onProcess()
     do
     {
         promptForCharacter(
-            "Please enter your selection [0-2]: ",
-            std::vector<char>{'0', '1', '2'},
+            "Please enter your selection [0-3]: ",
+            std::vector<char>{'0', '1', '2', '3'},
             s_user_choice,
             g_is_successful,
             g_outcome_message
@@ -86,6 +90,10 @@ void ReservationManagementState::onProcess()
         deleteReservation();
         m_state_manager->selectNextState(States::ReservationManagementState);
         break;
+    case '3':
+        findAvailableSailings();
+        m_state_manager->selectNextState(States::ReservationManagementState);
+        break;
     case '0':
         m_state_manager->selectNextState(States::MainMenuState);
         break;
@@ -104,17 +112,13 @@ void ReservationManagementState::createReservation()
     std::string sailing_data;
 
       //Sailing ID (assuming format: 3 letters-2 digits-2 digits like "AHS-22-10")
-    std::regex sailing_pattern("[A-Z]{3}-\\d{2}-\\d{2}");
-    continuouslyPromptForString("Please enter the ID of the sailing [TTT-dd-hh]: ", sailing_pattern,sailing_data); 
-
-    // Parse components
-    std::string terminal = sailing_data.substr(0, 3);
-    int day = std::stoi(sailing_data.substr(4, 2));
-    int hour = std::stoi(sailing_data.substr(7, 2));
+    continuouslyPromptForString("Please enter the ID of the sailing [TTT-dd-hh]: ", g_sailing_id_pattern,sailing_data); 
 
-    //savis is xhanging this
+    // Parse components (the prompt only accepts what packs):
+    SailingKey sailing_key;
+    SailingKey::parse(sailing_data, sailing_key);
 
-    m_database->getSailingByID(terminal, day, hour, s_sailing, g_is_successful, g_outcome_message);
+    m_database->getSailingByID(sailing_key, s_sailing, g_is_successful, g_outcome_message);
 
     if (!g_is_successful) {
         std::cout << g_outcome_message << "\n\n";
@@ -152,7 +156,12 @@ void ReservationManagementState::createReservation()
 
     // Final message
     if (confirm == 'y') {
-        m_database->addReservation(s_sailing,s_vehicle,g_is_successful,g_outcome_message);
+        // decide on the in-memory capacity, then write the reservation through to the database
+        CapacityDecision decision;
+        m_capacity_engine->decide(s_sailing.sailing_id, s_vehicle.length, s_vehicle.height, decision, g_is_successful, g_outcome_message);
+        if (g_is_successful) {
+        m_capacity_engine->reserve(*m_database, decision, s_sailing, s_vehicle, s_reservation, g_is_successful, g_outcome_message);
+        }
         if (!g_is_successful) {
         std::cout << g_outcome_message << "\n\n";
         m_state_manager->selectNextState(States::ReservationManagementState);
@@ -171,15 +180,13 @@ void ReservationManagementState::deleteReservation()
     std::string sailing_data;
 
       //Sailing ID (assuming format: 3 letters-2 digits-2 digits like "AHS-22-10")
-    std::regex sailing_pattern("[A-Z]{3}-\\d{2}-\\d{2}");
-    continuouslyPromptForString("Please enter the ID of the sailing [TTT-dd-hh]: ", sailing_pattern,sailing_data); 
+    continuouslyPromptForString("Please enter the ID of the sailing [TTT-dd-hh]: ", g_sailing_id_pattern,sailing_data); 
 
-    // Parse components
-    std::string terminal = sailing_data.substr(0, 3);
-    int day = std::stoi(sailing_data.substr(4, 2));
-    int hour = std::stoi(sailing_data.substr(7, 2));
+    // Parse components (the prompt only accepts what packs):
+    SailingKey sailing_key;
+    SailingKey::parse(sailing_data, sailing_key);
 
-    m_database->getSailingByID(terminal, day, hour, s_sailing, g_is_successful, g_outcome_message);
+    m_database->getSailingByID(sailing_key, s_sailing, g_is_successful, g_outcome_message);
 
     if (!g_is_successful) {
         std::cout << g_outcome_message << "\n\n";
@@ -208,6 +215,10 @@ void ReservationManagementState::deleteReservation()
         std::cout << g_outcome_message << "\n\n";
         m_state_manager->selectNextState(States::ReservationManagementState);
         } 
+        else {
+        // the returned length is back in the database, so pick it up
+        m_capacity_engine->refresh(*m_database, s_sailing, g_is_successful, g_outcome_message);
+        }
         std::cout << "\nReservation successfully cancelled!\n";
         
     } else {
@@ -216,4 +227,49 @@ void ReservationManagementState::deleteReservation()
     m_state_manager->selectNextState(States::MainMenuState);
     
     
-}
\ No newline at end of file
+}
+
+// ----------------------------------------------------------------------------
+void ReservationManagementState::findAvailableSailings()
+{
+    std::string sailing_data;
+
+    //the terminal and the earliest departure to look from, in the same form as a sailing ID
+    continuouslyPromptForString("Please enter the terminal and earliest departure [TTT-dd-hh]: ", g_sailing_id_pattern, sailing_data);
+
+    std::string terminal;
+    int day;
+    int hour;
+    Utilities::extractSailingID(sailing_data, terminal, day, hour);
+
+    double length;
+    double height;
+    continuouslyPromptForReal("Please enter the length of the vehicle [0-99.9]: ", g_vehicle_min_length, g_vehicle_max_length, length);
+    continuouslyPromptForReal("Please enter the height of the vehicle [0-9.9]: ", g_vehicle_min_height, g_vehicle_max_height, height);
+
+    std::vector<AvailableSailing> sailings;
+    m_capacity_engine->findAvailableSailings(terminal, day, hour, length, height, g_list_length, sailings, g_is_successful, g_outcome_message);
+
+    if (!g_is_successful) {
+        std::cout << "\n" << g_outcome_message << "\n\n";
+        return;
+    }
+
+    std::cout << "\n    Sailing ID  Lane    LCLR    HCLR\n";
+
+    int current = 1;
+    for (const AvailableSailing& sailing : sailings) {
+        std::string sailing_id_str;
+        Utilities::createSailingID(terminal, sailing.departure_day, sailing.departure_hour, sailing_id_str);
+        std::cout
+            << std::setw(2) << std::right << current << ") "
+            << std::setw(10) << std::left << sailing_id_str << "  "
+            << std::setw(4) << std::left << (sailing.is_low_lane ? "Low" : "High")
+            << std::fixed << std::setprecision(1)
+            << std::setw(8) << std::right << sailing.low_remaining_length
+            << std::setw(8) << std::right << sailing.high_remaining_length
+            << "\n";
+        ++current;
+    }
+    std::cout << "\n";
+}
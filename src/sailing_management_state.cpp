@@ -12,6 +12,7 @@
 #include "input.hpp"
 #include "containers.hpp"
 #include "database.hpp"
+#include "capacity_engine.hpp"
 #include "global.hpp"
 #include "utilities.hpp"
 
@@ -138,7 +139,7 @@ void SailingManagementState::createSailing()
     do {
         promptForString(
             "Please enter the ID of the sailing [TTT-dd-hh]: ",
-            std::regex(R"([A-Z]{3}-\d{2}-\d{2})"), //TTT-dd-hh pattern
+            g_sailing_id_pattern, //TTT-dd-hh pattern
             sailing_id_str, 
             g_is_successful, 
             g_outcome_message
@@ -183,6 +184,9 @@ void SailingManagementState::createSailing()
 
             if (g_is_successful)
             {
+                // the new sailing gets its ID from the database, so read it back into the capacity engine
+                m_capacity_engine->refresh(*m_database, new_sailing, g_is_successful, g_outcome_message);
+
                 std::cout << "Sailing created with ID of " << sailing_id_str << std::endl;
             }
 
@@ -243,6 +247,8 @@ void SailingManagementState::deleteSailing()
 
             if(g_is_successful)
             {
+                m_capacity_engine->forget(referred_sailing.sailing_id);
+
                 std::cout << "Sailing successfully deleted!" << "\n";
             }
 
@@ -272,7 +278,10 @@ void SailingManagementState::listSailingReports()
 
     // Display variables
     int current = 1;
-    int offset = 0; 
+
+    // Remember the page on display, so that the next and previous pages can be found from it:
+    PageCursor cursor;
+    PageDirection direction = PageDirection::First;
 
 
     // Beginning display
@@ -282,7 +291,7 @@ void SailingManagementState::listSailingReports()
 
 
     do {
-        m_database->getSailingReports(g_list_length, offset, sailing_reports, g_is_successful, g_outcome_message);
+        m_database->getSailingReports(g_list_length, direction, cursor, sailing_reports, g_is_successful, g_outcome_message);
         for (const SailingReport& report : sailing_reports) {
             std::string sailing_id_str;
             Utilities::createSailingID(report.sailing.departure_terminal, report.sailing.departure_day, report.sailing.departure_hour, sailing_id_str);
@@ -320,11 +329,11 @@ void SailingManagementState::listSailingReports()
         } 
         else if (std::tolower(user_choice) == 'n') {
             stop = false; 
-            offset += g_list_length; 
+            direction = PageDirection::Next;
         }
         else if (std::tolower(user_choice) == 'p') {    
             stop = false; 
-            offset = (offset >= g_list_length) ? (offset - g_list_length) : 0;  // Lower bound of 0
+            direction = PageDirection::Previous; // From the first page, this shows the first page again.
              
         }
     } while(stop == false); 
@@ -0,0 +1,161 @@
+#include <utility>
+#include "sailing_manifest.hpp"
+#include "packed_key.hpp"
+
+SailingManifest::SailingManifest() :
+    m_sailing_id(0),
+    m_entries(),
+    m_keys(),
+    m_slots()
+{
+}
+
+SailingManifest::~SailingManifest()
+{
+}
+
+void SailingManifest::load(
+    Database& database,
+    const Sailing& sailing,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    clear();
+
+    std::vector<ManifestEntry> entries;
+
+    database.getSailingManifest(sailing.sailing_id, entries, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return;
+    }
+
+    m_sailing_id = sailing.sailing_id;
+
+    // Sized once for the whole manifest, so loading never rehashes:
+    std::size_t slot_count = 16;
+
+    while(slot_count < entries.size() * 2)
+    {
+        slot_count *= 2;
+    }
+
+    m_entries.reserve(entries.size());
+    m_keys.reserve(entries.size());
+    m_slots.assign(slot_count, sc_empty_slot);
+
+    for(ManifestEntry& entry : entries)
+    {
+        std::int64_t license_plate_key = 0;
+
+        // NOTE (SAVIZ): Only a plate written outside the program fails to pack, and it could not be looked up in the database either.
+        if(PackedKey::packLicensePlate(entry.vehicle.license_plate, license_plate_key))
+        {
+            insert(license_plate_key, std::move(entry));
+        }
+    }
+
+    is_successful = true;
+    outcome_message = std::string("Manifest loaded: ") + std::to_string(m_entries.size()) + " reservation(s)";
+}
+
+const ManifestEntry* SailingManifest::find(
+    const std::string& license_plate
+    ) const
+{
+    std::int64_t license_plate_key = 0;
+
+    if(m_slots.empty() || !PackedKey::packLicensePlate(license_plate, license_plate_key))
+    {
+        return(nullptr);
+    }
+
+    std::int32_t entry_index = m_slots[findSlot(license_plate_key)];
+
+    return(entry_index == sc_empty_slot ? nullptr : &m_entries[entry_index]);
+}
+
+void SailingManifest::setBoarded(
+    const Vehicle& vehicle
+    )
+{
+    std::int64_t license_plate_key = 0;
+
+    if(!PackedKey::packLicensePlate(vehicle.license_plate, license_plate_key))
+    {
+        return;
+    }
+
+    if(!m_slots.empty())
+    {
+        std::int32_t entry_index = m_slots[findSlot(license_plate_key)];
+
+        if(entry_index != sc_empty_slot)
+        {
+            m_entries[entry_index].is_boarded = true;
+
+            return;
+        }
+    }
+
+    ManifestEntry entry;
+
+    entry.vehicle = vehicle;
+    entry.is_boarded = true;
+
+    insert(license_plate_key, std::move(entry));
+}
+
+void SailingManifest::clear()
+{
+    m_sailing_id = 0;
+    m_entries.clear();
+    m_keys.clear();
+    m_slots.clear();
+}
+
+void SailingManifest::insert(
+    std::int64_t license_plate_key,
+    ManifestEntry entry
+    )
+{
+    // Kept at most half full, so a probe rarely goes past a slot or two:
+    if((m_entries.size() + 1) * 2 > m_slots.size())
+    {
+        grow();
+    }
+
+    std::size_t slot = findSlot(license_plate_key);
+
+    m_slots[slot] = static_cast<std::int32_t>(m_entries.size());
+    m_entries.push_back(std::move(entry));
+    m_keys.push_back(license_plate_key);
+}
+
+std::size_t SailingManifest::findSlot(
+    std::int64_t license_plate_key
+    ) const
+{
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = static_cast<std::size_t>(PackedKey::hashKey(license_plate_key)) & mask;
+
+    // NOTE (SAVIZ): There is always an empty slot (the table is never full), so the probe ends.
+    while(m_slots[slot] != sc_empty_slot && m_keys[m_slots[slot]] != license_plate_key)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    return(slot);
+}
+
+void SailingManifest::grow()
+{
+    m_slots.assign(m_slots.empty() ? 16 : m_slots.size() * 2, sc_empty_slot);
+
+    for(std::size_t entry_index = 0; entry_index < m_entries.size(); ++entry_index)
+    {
+        m_slots[findSlot(m_keys[entry_index])] = static_cast<std::int32_t>(entry_index);
+    }
+}
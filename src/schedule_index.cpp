@@ -0,0 +1,261 @@
+#include <algorithm>
+#include "schedule_index.hpp"
+
+ScheduleIndex::ScheduleIndex(
+    const std::string& departure_terminal
+    ) :
+    m_departure_terminal(departure_terminal),
+    m_sailings(),
+    m_pending_low_lengths(),
+    m_pending_high_lengths(),
+    m_leaf_count(0),
+    m_max_low_lengths(),
+    m_max_high_lengths()
+{
+}
+
+void ScheduleIndex::insert(
+    int sailing_id,
+    int departure_day,
+    int departure_hour,
+    double low_remaining_length,
+    double high_remaining_length
+    )
+{
+    // 1) Take the remaining lengths back out of the leaves, so the whole index can be rebuilt with the new sailing in its place:
+    std::size_t position = findPosition(departure_day, departure_hour);
+
+    m_pending_low_lengths.assign(m_max_low_lengths.begin() + m_leaf_count, m_max_low_lengths.begin() + m_leaf_count + m_sailings.size());
+    m_pending_high_lengths.assign(m_max_high_lengths.begin() + m_leaf_count, m_max_high_lengths.begin() + m_leaf_count + m_sailings.size());
+
+    m_sailings.insert(m_sailings.begin() + position, ScheduledSailing{ sailing_id, departure_day, departure_hour });
+    m_pending_low_lengths.insert(m_pending_low_lengths.begin() + position, low_remaining_length);
+    m_pending_high_lengths.insert(m_pending_high_lengths.begin() + position, high_remaining_length);
+
+    // 2) Rebuild:
+    build();
+}
+
+void ScheduleIndex::update(
+    int departure_day,
+    int departure_hour,
+    double low_remaining_length,
+    double high_remaining_length
+    )
+{
+    std::size_t position = findPosition(departure_day, departure_hour);
+
+    if(position == m_sailings.size() || m_sailings[position].departure_day != departure_day || m_sailings[position].departure_hour != departure_hour)
+    {
+        return;
+    }
+
+    // Set the leaf, then walk up to the root fixing the maximum of every range that contains it:
+    std::size_t node = m_leaf_count + position;
+
+    m_max_low_lengths[node] = low_remaining_length;
+    m_max_high_lengths[node] = high_remaining_length;
+
+    for(node /= 2; node >= 1; node /= 2)
+    {
+        m_max_low_lengths[node] = std::max(m_max_low_lengths[2 * node], m_max_low_lengths[2 * node + 1]);
+        m_max_high_lengths[node] = std::max(m_max_high_lengths[2 * node], m_max_high_lengths[2 * node + 1]);
+    }
+}
+
+void ScheduleIndex::erase(
+    int departure_day,
+    int departure_hour
+    )
+{
+    std::size_t position = findPosition(departure_day, departure_hour);
+
+    if(position == m_sailings.size() || m_sailings[position].departure_day != departure_day || m_sailings[position].departure_hour != departure_hour)
+    {
+        return;
+    }
+
+    m_pending_low_lengths.assign(m_max_low_lengths.begin() + m_leaf_count, m_max_low_lengths.begin() + m_leaf_count + m_sailings.size());
+    m_pending_high_lengths.assign(m_max_high_lengths.begin() + m_leaf_count, m_max_high_lengths.begin() + m_leaf_count + m_sailings.size());
+
+    m_sailings.erase(m_sailings.begin() + position);
+    m_pending_low_lengths.erase(m_pending_low_lengths.begin() + position);
+    m_pending_high_lengths.erase(m_pending_high_lengths.begin() + position);
+
+    build();
+}
+
+void ScheduleIndex::findAvailable(
+    int from_day,
+    int from_hour,
+    double length,
+    double height,
+    int count,
+    std::vector<int>& sailing_ids
+    ) const
+{
+    sailing_ids.clear();
+
+    if(m_sailings.empty())
+    {
+        return;
+    }
+
+    std::size_t from = findPosition(from_day, from_hour);
+
+    // NOTE (SAVIZ): Each search resumes right after the last hit, and only walks into ranges that have a sailing with enough room.
+    while(static_cast<int>(sailing_ids.size()) < count && from < m_sailings.size())
+    {
+        int position = findFirst(1, 0, m_leaf_count - 1, from, length, height);
+
+        if(position < 0)
+        {
+            break;
+        }
+
+        sailing_ids.push_back(m_sailings[position].sailing_id);
+
+        from = static_cast<std::size_t>(position) + 1;
+    }
+}
+
+void ScheduleIndex::reserve(
+    std::size_t sailing_count
+    )
+{
+    m_sailings.reserve(sailing_count);
+    m_pending_low_lengths.reserve(sailing_count);
+    m_pending_high_lengths.reserve(sailing_count);
+}
+
+void ScheduleIndex::append(
+    int sailing_id,
+    int departure_day,
+    int departure_hour,
+    double low_remaining_length,
+    double high_remaining_length
+    )
+{
+    m_sailings.push_back(ScheduledSailing{ sailing_id, departure_day, departure_hour });
+    m_pending_low_lengths.push_back(low_remaining_length);
+    m_pending_high_lengths.push_back(high_remaining_length);
+}
+
+void ScheduleIndex::build()
+{
+    // 1) Put the sailings in departure order (already the case when called from 'insert()' and 'erase()'):
+    std::vector<std::size_t> order(m_sailings.size());
+
+    for(std::size_t index = 0; index < order.size(); ++index)
+    {
+        order[index] = index;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t left, std::size_t right)
+    {
+        return(m_sailings[left].departure_day != m_sailings[right].departure_day ? m_sailings[left].departure_day < m_sailings[right].departure_day : m_sailings[left].departure_hour < m_sailings[right].departure_hour);
+    });
+
+    std::vector<ScheduledSailing> sorted_sailings;
+
+    sorted_sailings.reserve(m_sailings.size());
+
+    for(std::size_t index : order)
+    {
+        sorted_sailings.push_back(m_sailings[index]);
+    }
+
+    // 2) Size the tree to the next power of two, so every node splits its range evenly:
+    m_leaf_count = 1;
+
+    while(m_leaf_count < m_sailings.size())
+    {
+        m_leaf_count *= 2;
+    }
+
+    m_max_low_lengths.assign(2 * m_leaf_count, -1.0);
+    m_max_high_lengths.assign(2 * m_leaf_count, -1.0);
+
+    // 3) Fill the leaves, then every parent from the bottom up:
+    for(std::size_t position = 0; position < order.size(); ++position)
+    {
+        m_max_low_lengths[m_leaf_count + position] = m_pending_low_lengths[order[position]];
+        m_max_high_lengths[m_leaf_count + position] = m_pending_high_lengths[order[position]];
+    }
+
+    for(std::size_t node = m_leaf_count - 1; node >= 1; --node)
+    {
+        m_max_low_lengths[node] = std::max(m_max_low_lengths[2 * node], m_max_low_lengths[2 * node + 1]);
+        m_max_high_lengths[node] = std::max(m_max_high_lengths[2 * node], m_max_high_lengths[2 * node + 1]);
+    }
+
+    m_sailings.swap(sorted_sailings);
+
+    m_pending_low_lengths.clear();
+    m_pending_high_lengths.clear();
+}
+
+const std::string& ScheduleIndex::getDepartureTerminal() const
+{
+    return(m_departure_terminal);
+}
+
+std::size_t ScheduleIndex::getSailingCount() const
+{
+    return(m_sailings.size());
+}
+
+std::size_t ScheduleIndex::findPosition(
+    int departure_day,
+    int departure_hour
+    ) const
+{
+    auto position = std::lower_bound(m_sailings.begin(), m_sailings.end(), ScheduledSailing{ 0, departure_day, departure_hour }, [](const ScheduledSailing& left, const ScheduledSailing& right)
+    {
+        return(left.departure_day != right.departure_day ? left.departure_day < right.departure_day : left.departure_hour < right.departure_hour);
+    });
+
+    return(static_cast<std::size_t>(position - m_sailings.begin()));
+}
+
+int ScheduleIndex::findFirst(
+    std::size_t node,
+    std::size_t node_first,
+    std::size_t node_last,
+    std::size_t from,
+    double length,
+    double height
+    ) const
+{
+    // The whole range is before the start, or nothing in it has room:
+    if(node_last < from || !canTake(node, length, height))
+    {
+        return(-1);
+    }
+
+    if(node_first == node_last)
+    {
+        return(static_cast<int>(node_first));
+    }
+
+    std::size_t middle = node_first + (node_last - node_first) / 2;
+
+    int position = findFirst(2 * node, node_first, middle, from, length, height);
+
+    if(position >= 0)
+    {
+        return(position);
+    }
+
+    return(findFirst(2 * node + 1, middle + 1, node_last, from, length, height));
+}
+
+bool ScheduleIndex::canTake(
+    std::size_t node,
+    double length,
+    double height
+    ) const
+{
+    // NOTE (SAVIZ): Must match 'DatabaseQueries::c_insert_reservation' (and 'CapacityEngine::decide()').
+    return((height <= 2.0 && m_max_low_lengths[node] >= length + 0.5) || m_max_high_lengths[node] >= length + 0.5);
+}
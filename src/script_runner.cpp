@@ -0,0 +1,811 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "script_runner.hpp"
+#include "database_cursor.hpp"
+#include "global.hpp"
+#include "utilities.hpp"
+
+// Appends a number in its shortest exact form ("89.5", "14").
+static void appendNumber(
+    std::string& text,
+    double number
+    )
+{
+    char digits[32];
+
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+
+    text.append(digits, result.ptr);
+}
+
+// Appends a word, quoted if it holds spaces (so the answer can be split the same way as a command).
+static void appendWord(
+    std::string& text,
+    std::string_view word
+    )
+{
+    if(word.find(' ') == std::string_view::npos)
+    {
+        text.append(word);
+
+        return;
+    }
+
+    text += '"';
+    text.append(word);
+    text += '"';
+}
+
+ScriptRunner::ScriptRunner(
+    Database* database,
+    std::ostream& output_stream
+    ) :
+    m_database(database),
+    m_output_stream(output_stream),
+    m_output(),
+    m_words()
+{
+    m_output.reserve(sc_output_buffer_bytes + 1024);
+}
+
+ScriptRunner::~ScriptRunner()
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    flushOutput(is_successful, outcome_message);
+}
+
+// ----------------------------------------------------------------------------
+void ScriptRunner::runFile(
+    const std::string& path,
+    ScriptStatistics& statistics,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    if(path == "-")
+    {
+        runStream(std::cin, statistics, is_successful, outcome_message);
+
+        return;
+    }
+
+    std::ifstream file(path);
+
+    if(!file.is_open())
+    {
+        is_successful = false;
+        outcome_message = "Script failed: cannot open '" + path + "'.";
+
+        return;
+    }
+
+    runStream(file, statistics, is_successful, outcome_message);
+}
+
+// ----------------------------------------------------------------------------
+void ScriptRunner::runStream(
+    std::istream& stream,
+    ScriptStatistics& statistics,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    statistics = ScriptStatistics();
+
+    is_successful = true;
+
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+    std::string line;
+
+    while(std::getline(stream, line))
+    {
+        ++statistics.line_count;
+
+        std::size_t answer_size = m_output.size();
+
+        if(!runCommand(line, statistics.line_count, m_output))
+        {
+            ++statistics.failed_count;
+        }
+
+        // Blank lines and comments give no answer:
+        if(m_output.size() != answer_size)
+        {
+            ++statistics.command_count;
+        }
+
+        if(m_output.size() >= sc_output_buffer_bytes)
+        {
+            flushOutput(is_successful, outcome_message);
+
+            if(!is_successful)
+            {
+                break;
+            }
+        }
+    }
+
+    // NOTE (SAVIZ): The answers above already said "ok", so a group that cannot be committed fails the whole run.
+    if(is_successful)
+    {
+        flushOutput(is_successful, outcome_message);
+    }
+
+    statistics.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    if(!is_successful)
+    {
+        outcome_message = "Script failed: " + outcome_message;
+
+        return;
+    }
+
+    double rate = statistics.elapsed_seconds > 0.0 ? static_cast<double>(statistics.command_count) / statistics.elapsed_seconds : 0.0;
+
+    std::ostringstream summary;
+
+    summary << "Script finished: " << statistics.command_count << " command(s), " << statistics.failed_count << " failed in "
+            << std::fixed << std::setprecision(2) << statistics.elapsed_seconds << " s (" << std::setprecision(0) << rate << " commands/s)";
+
+    outcome_message = summary.str();
+}
+
+// ----------------------------------------------------------------------------
+bool ScriptRunner::runCommand(
+    const std::string& line,
+    long long line_number,
+    std::string& answer
+    )
+{
+    bool is_successful = true;
+    std::string outcome_message = "";
+
+    if(!splitWords(line, m_words))
+    {
+        is_successful = false;
+        outcome_message = "a quote is never closed.";
+    }
+
+    // Blank lines and comments:
+    if(is_successful && (m_words.empty() || m_words[0][0] == '#'))
+    {
+        return(true);
+    }
+
+    std::string result;
+
+    if(is_successful)
+    {
+        std::string& command = m_words[0];
+
+        std::transform(command.begin(), command.end(), command.begin(), [](unsigned char character) { return(static_cast<char>(std::tolower(character))); });
+
+        if(command == "vessel")
+        {
+            result = addVessel(m_words, is_successful, outcome_message);
+        }
+
+        else if(command == "vessels")
+        {
+            result = listVessels(answer, is_successful, outcome_message);
+        }
+
+        else if(command == "sailing")
+        {
+            result = addSailing(m_words, is_successful, outcome_message);
+        }
+
+        else if(command == "remove-sailing")
+        {
+            result = removeSailing(m_words, is_successful, outcome_message);
+        }
+
+        else if(command == "vehicle")
+        {
+            result = addVehicle(m_words, is_successful, outcome_message);
+        }
+
+        else if(command == "reserve")
+        {
+            result = reserve(m_words, is_successful, outcome_message);
+        }
+
+        else if(command == "cancel")
+        {
+            result = cancel(m_words, is_successful, outcome_message);
+        }
+
+        else if(command == "board")
+        {
+            result = board(m_words, is_successful, outcome_message);
+        }
+
+        else if(command == "report")
+        {
+            result = report(m_words, answer, is_successful, outcome_message);
+        }
+
+        else
+        {
+            is_successful = false;
+            outcome_message = "unknown command '" + m_words[0] + "'.";
+        }
+    }
+
+    if(!is_successful)
+    {
+        answer += "error line ";
+        answer += std::to_string(line_number);
+        answer += ": ";
+        answer += outcome_message;
+        answer += '\n';
+
+        return(false);
+    }
+
+    answer += "ok ";
+    answer += result;
+    answer += '\n';
+
+    return(true);
+}
+
+// ----------------------------------------------------------------------------
+bool ScriptRunner::splitWords(
+    const std::string& line,
+    std::vector<std::string>& words
+    )
+{
+    std::size_t word_count = 0;
+    std::size_t position = 0;
+
+    while(true)
+    {
+        while(position < line.size() && std::isspace(static_cast<unsigned char>(line[position])))
+        {
+            ++position;
+        }
+
+        if(position >= line.size())
+        {
+            break;
+        }
+
+        if(word_count == words.size())
+        {
+            words.emplace_back();
+        }
+
+        std::string& word = words[word_count++];
+
+        word.clear();
+
+        if(line[position] == '"')
+        {
+            std::size_t closing_quote = line.find('"', position + 1);
+
+            if(closing_quote == std::string::npos)
+            {
+                words.resize(word_count);
+
+                return(false);
+            }
+
+            word.assign(line, position + 1, closing_quote - position - 1);
+            position = closing_quote + 1;
+
+            continue;
+        }
+
+        std::size_t end = position;
+
+        while(end < line.size() && !std::isspace(static_cast<unsigned char>(line[end])))
+        {
+            ++end;
+        }
+
+        word.assign(line, position, end - position);
+        position = end;
+    }
+
+    words.resize(word_count);
+
+    return(true);
+}
+
+// ----------------------------------------------------------------------------
+std::string ScriptRunner::addVessel(
+    const std::vector<std::string>& words,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+
+    if(words.size() != 4)
+    {
+        outcome_message = "usage: vessel <name> <low lane length> <high lane length>";
+
+        return("");
+    }
+
+    Vessel vessel;
+
+    vessel.vessel_name = words[1];
+
+    if(!std::regex_match(vessel.vessel_name, g_vessel_name_pattern))
+    {
+        outcome_message = "invalid vessel name '" + words[1] + "'.";
+
+        return("");
+    }
+
+    if(!Utilities::parseReal(words[2], vessel.low_ceiling_lane_length) || !Utilities::isInRange(vessel.low_ceiling_lane_length, g_lane_min_length, g_lane_max_length) ||
+       !Utilities::parseReal(words[3], vessel.high_ceiling_lane_length) || !Utilities::isInRange(vessel.high_ceiling_lane_length, g_lane_min_length, g_lane_max_length))
+    {
+        outcome_message = "the lane lengths must be numbers in the allowed range.";
+
+        return("");
+    }
+
+    m_database->addVessel(vessel, is_successful, outcome_message);
+
+    std::string result = "vessel ";
+
+    appendWord(result, vessel.vessel_name);
+
+    return(result);
+}
+
+// ----------------------------------------------------------------------------
+std::string ScriptRunner::listVessels(
+    std::string& answer,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    RowCursor<VesselView> cursor;
+
+    m_database->openVesselCursor(cursor, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return("");
+    }
+
+    long long vessel_count = 0;
+
+    // One row per vessel: <ID> <name> <low lane length> <high lane length>
+    for(const VesselView& vessel : cursor)
+    {
+        answer += std::to_string(vessel.vessel_id);
+        answer += ' ';
+        appendWord(answer, vessel.vessel_name);
+        answer += ' ';
+        appendNumber(answer, vessel.low_ceiling_lane_length);
+        answer += ' ';
+        appendNumber(answer, vessel.high_ceiling_lane_length);
+        answer += '\n';
+
+        ++vessel_count;
+    }
+
+    cursor.getOutcome(is_successful, outcome_message);
+
+    return("vessels " + std::to_string(vessel_count));
+}
+
+// ----------------------------------------------------------------------------
+std::string ScriptRunner::addSailing(
+    const std::vector<std::string>& words,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+
+    int vessel_id = 0;
+
+    if(words.size() != 3 || !std::regex_match(words[1], g_sailing_id_pattern) || std::from_chars(words[2].data(), words[2].data() + words[2].size(), vessel_id).ptr != words[2].data() + words[2].size())
+    {
+        outcome_message = "usage: sailing <sailing ID> <vessel ID>";
+
+        return("");
+    }
+
+    // A new sailing starts with the whole of its vessel's lanes free:
+    Vessel vessel;
+
+    m_database->getVesselByID(vessel_id, vessel, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return("");
+    }
+
+    Sailing sailing;
+    std::string sailing_id = words[1];
+
+    Utilities::extractSailingID(sailing_id, sailing.departure_terminal, sailing.departure_day, sailing.departure_hour);
+
+    sailing.vessel_id = vessel_id;
+    sailing.low_remaining_length = vessel.low_ceiling_lane_length;
+    sailing.high_remaining_length = vessel.high_ceiling_lane_length;
+
+    m_database->addSailing(sailing, is_successful, outcome_message);
+
+    return("sailing " + words[1]);
+}
+
+// ----------------------------------------------------------------------------
+std::string ScriptRunner::removeSailing(
+    const std::vector<std::string>& words,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+
+    if(words.size() != 2)
+    {
+        outcome_message = "usage: remove-sailing <sailing ID>";
+
+        return("");
+    }
+
+    Sailing sailing;
+
+    findSailing(words[1], sailing, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return("");
+    }
+
+    m_database->removeSailing(sailing, is_successful, outcome_message);
+
+    return("remove-sailing " + words[1]);
+}
+
+// ----------------------------------------------------------------------------
+std::string ScriptRunner::addVehicle(
+    const std::vector<std::string>& words,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+
+    if(words.size() != 5)
+    {
+        outcome_message = "usage: vehicle <license plate> <phone number> <length> <height>";
+
+        return("");
+    }
+
+    Vehicle vehicle;
+
+    outcome_message = readVehicle(words, 1, vehicle);
+
+    if(!outcome_message.empty())
+    {
+        return("");
+    }
+
+    int vehicle_id = 0;
+
+    m_database->addVehicle(vehicle, vehicle_id, is_successful, outcome_message);
+
+    return("vehicle " + words[1]);
+}
+
+// ----------------------------------------------------------------------------
+std::string ScriptRunner::reserve(
+    const std::vector<std::string>& words,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+
+    if(words.size() != 3 && words.size() != 6)
+    {
+        outcome_message = "usage: reserve <sailing ID> <license plate> [<phone number> <length> <height>]";
+
+        return("");
+    }
+
+    Sailing sailing;
+    Vehicle vehicle;
+    Reservation reservation;
+
+    findSailing(words[1], sailing, is_successful, outcome_message);
+
+    if(is_successful)
+    {
+        findOrAddVehicle(words, vehicle, is_successful, outcome_message);
+    }
+
+    if(is_successful)
+    {
+        m_database->addReservation(sailing, vehicle, reservation, is_successful, outcome_message);
+    }
+
+    return("reserve " + words[1] + " " + words[2] + (reservation.reserved_for_low_lane ? " low" : " high"));
+}
+
+// ----------------------------------------------------------------------------
+std::string ScriptRunner::cancel(
+    const std::vector<std::string>& words,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+
+    if(words.size() != 3)
+    {
+        outcome_message = "usage: cancel <sailing ID> <license plate>";
+
+        return("");
+    }
+
+    Sailing sailing;
+    Vehicle vehicle;
+
+    findSailing(words[1], sailing, is_successful, outcome_message);
+
+    if(is_successful)
+    {
+        m_database->getVehicleByID(words[2], vehicle, is_successful, outcome_message);
+    }
+
+    if(is_successful)
+    {
+        m_database->removeReservation(sailing, vehicle, is_successful, outcome_message);
+    }
+
+    return("cancel " + words[1] + " " + words[2]);
+}
+
+// ----------------------------------------------------------------------------
+std::string ScriptRunner::board(
+    const std::vector<std::string>& words,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+
+    if(words.size() != 3 && words.size() != 6)
+    {
+        outcome_message = "usage: board <sailing ID> <license plate> [<phone number> <length> <height>]";
+
+        return("");
+    }
+
+    Sailing sailing;
+    Vehicle vehicle;
+
+    findSailing(words[1], sailing, is_successful, outcome_message);
+
+    if(is_successful)
+    {
+        findOrAddVehicle(words, vehicle, is_successful, outcome_message);
+    }
+
+    if(!is_successful)
+    {
+        return("");
+    }
+
+    // NOTE (SAVIZ): Walk-up vehicles have no reservation yet. If one already exists this simply fails, which is fine since boarding is what matters (as in 'AsyncDatabase::boardVehicle()'):
+    Reservation reservation;
+
+    m_database->addReservation(sailing, vehicle, reservation, is_successful, outcome_message);
+
+    m_database->completeBoarding(sailing, vehicle, is_successful, outcome_message);
+
+    return("board " + words[1] + " " + words[2]);
+}
+
+// ----------------------------------------------------------------------------
+std::string ScriptRunner::report(
+    const std::vector<std::string>& words,
+    std::string& answer,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+
+    if(words.size() > 2)
+    {
+        outcome_message = "usage: report [<sailing ID>]";
+
+        return("");
+    }
+
+    // One row per sailing: <sailing ID> <vessel name> <vehicle count> <occupancy %> <low remaining length> <high remaining length>
+    auto append_row = [&answer](const std::string& sailing_id, std::string_view vessel_name, int vehicle_count, double occupancy_percentage, double low_remaining_length, double high_remaining_length)
+    {
+        answer += sailing_id;
+        answer += ' ';
+        appendWord(answer, vessel_name);
+        answer += ' ';
+        answer += std::to_string(vehicle_count);
+        answer += ' ';
+        appendNumber(answer, occupancy_percentage);
+        answer += ' ';
+        appendNumber(answer, low_remaining_length);
+        answer += ' ';
+        appendNumber(answer, high_remaining_length);
+        answer += '\n';
+    };
+
+    if(words.size() == 2)
+    {
+        Sailing sailing;
+        SailingReport sailing_report;
+
+        findSailing(words[1], sailing, is_successful, outcome_message);
+
+        if(is_successful)
+        {
+            m_database->getSailingReportByID(sailing, sailing_report, is_successful, outcome_message);
+        }
+
+        if(!is_successful)
+        {
+            return("");
+        }
+
+        append_row(words[1], sailing_report.vessel.vessel_name, sailing_report.vehicle_count, sailing_report.occupancy_percentage, sailing.low_remaining_length, sailing.high_remaining_length);
+
+        return("report 1");
+    }
+
+    RowCursor<SailingReportView> cursor;
+
+    m_database->openSailingReportCursor(cursor, is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        return("");
+    }
+
+    long long sailing_count = 0;
+    std::string sailing_id;
+
+    for(const SailingReportView& row : cursor)
+    {
+        Utilities::createSailingID(row.departure_terminal, row.departure_day, row.departure_hour, sailing_id);
+
+        append_row(sailing_id, row.vessel_name, row.vehicle_count, row.occupancy_percentage, row.low_remaining_length, row.high_remaining_length);
+
+        ++sailing_count;
+    }
+
+    cursor.getOutcome(is_successful, outcome_message);
+
+    return("report " + std::to_string(sailing_count));
+}
+
+// ----------------------------------------------------------------------------
+void ScriptRunner::findSailing(
+    const std::string& sailing_id,
+    Sailing& sailing,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // NOTE (SAVIZ): Packing accepts exactly what 'g_sailing_id_pattern' does, so the ID is checked and parsed in one pass.
+    SailingKey sailing_key;
+
+    if(!SailingKey::parse(sailing_id, sailing_key))
+    {
+        is_successful = false;
+        outcome_message = "invalid sailing ID '" + sailing_id + "' (expected TTT-dd-hh).";
+
+        return;
+    }
+
+    m_database->getSailingByID(sailing_key, sailing, is_successful, outcome_message);
+}
+
+// ----------------------------------------------------------------------------
+void ScriptRunner::findOrAddVehicle(
+    const std::vector<std::string>& words,
+    Vehicle& vehicle,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    m_database->getVehicleByID(words[2], vehicle, is_successful, outcome_message);
+
+    // Not known yet, and no details to create it from:
+    if(is_successful || words.size() < 6)
+    {
+        return;
+    }
+
+    outcome_message = readVehicle(words, 2, vehicle);
+
+    if(!outcome_message.empty())
+    {
+        is_successful = false;
+
+        return;
+    }
+
+    m_database->addVehicle(vehicle, vehicle.vehicle_id, is_successful, outcome_message);
+}
+
+// ----------------------------------------------------------------------------
+std::string ScriptRunner::readVehicle(
+    const std::vector<std::string>& words,
+    std::size_t first,
+    Vehicle& vehicle
+    )
+{
+    // NOTE (SAVIZ): The same rules (and limits) as the prompts, from 'global.hpp'.
+    vehicle.license_plate = words[first];
+    vehicle.phone_number = words[first + 1];
+
+    if(!std::regex_match(vehicle.license_plate, g_license_plate_pattern))
+    {
+        return("invalid license plate '" + words[first] + "'.");
+    }
+
+    if(!std::regex_match(vehicle.phone_number, g_phone_number_pattern))
+    {
+        return("invalid phone number '" + words[first + 1] + "'.");
+    }
+
+    if(!Utilities::parseReal(words[first + 2], vehicle.length) || !Utilities::isInRange(vehicle.length, g_vehicle_min_length, g_vehicle_max_length))
+    {
+        return("the vehicle length '" + words[first + 2] + "' is not a number in the allowed range.");
+    }
+
+    if(!Utilities::parseReal(words[first + 3], vehicle.height) || !Utilities::isInRange(vehicle.height, g_vehicle_min_height, g_vehicle_max_height))
+    {
+        return("the vehicle height '" + words[first + 3] + "' is not a number in the allowed range.");
+    }
+
+    return("");
+}
+
+// ----------------------------------------------------------------------------
+void ScriptRunner::flushOutput(
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    // A write is only answered once it is durable, so the open group is committed before its answers go out:
+    m_database->flushGroupCommit(is_successful, outcome_message);
+
+    if(!is_successful)
+    {
+        m_output += "error ";
+        m_output += outcome_message;
+        m_output += '\n';
+    }
+
+    if(m_output.empty())
+    {
+        return;
+    }
+
+    m_output_stream.write(m_output.data(), static_cast<std::streamsize>(m_output.size()));
+    m_output_stream.flush();
+
+    m_output.clear();
+}
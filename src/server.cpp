@@ -0,0 +1,895 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include "server.hpp"
+
+#ifdef TARGET_IS_LINUX
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+Server::Server() :
+    m_is_open(false),
+    m_socket_path(""),
+    m_listener(-1),
+    m_epoll(-1),
+    m_wake_event(-1),
+    m_is_stop_requested(false),
+    m_database(nullptr),
+    m_writer_queue(),
+    m_reader_queue(),
+    m_writer(),
+    m_readers(),
+    m_completed_mutex(),
+    m_completed_jobs(),
+    m_clients(),
+    m_next_client_key(sc_first_client_key),
+    m_request()
+{
+}
+
+Server::~Server()
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    close(is_successful, outcome_message);
+}
+
+#ifdef TARGET_IS_LINUX
+
+// ----------------------------------------------------------------------------
+void Server::open(
+    Database* database,
+    const ServerSettings& settings,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+
+    if(m_is_open)
+    {
+        outcome_message = "Server start failed: the server is already open.";
+
+        return;
+    }
+
+    // NOTE (SAVIZ): The readers run at the same time as the writer, which is only safe on read connections of their own.
+    ConnectionProfile profile;
+
+    database->getConnectionProfile(profile, is_successful, outcome_message);
+
+    if(!is_successful || profile.read_connections < 1)
+    {
+        is_successful = false;
+        outcome_message = "Server start failed: the database has no read connections (see 'read_connections').";
+
+        return;
+    }
+
+    sockaddr_un address = {};
+
+    address.sun_family = AF_UNIX;
+
+    if(settings.socket_path.empty() || settings.socket_path.size() >= sizeof(address.sun_path))
+    {
+        outcome_message = "Server start failed: the socket path must hold 1 to " + std::to_string(sizeof(address.sun_path) - 1) + " characters.";
+
+        return;
+    }
+
+    std::memcpy(address.sun_path, settings.socket_path.c_str(), settings.socket_path.size() + 1);
+
+    m_database = database;
+    m_is_stop_requested.store(false);
+
+    // On failure from here on, give everything back and report the system's reason:
+    auto fail = [this, &is_successful, &outcome_message](const std::string& reason)
+    {
+        std::string close_message = "";
+
+        close(is_successful, close_message);
+
+        is_successful = false;
+        outcome_message = "Server start failed: " + reason;
+    };
+
+    // 1) The socket. A socket file nobody listens on any more was left behind by a server that is gone, so it is replaced:
+    struct stat status = {};
+
+    if(stat(settings.socket_path.c_str(), &status) == 0)
+    {
+        if(!S_ISSOCK(status.st_mode))
+        {
+            fail("'" + settings.socket_path + "' exists and is not a socket.");
+
+            return;
+        }
+
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        bool is_in_use = probe >= 0 && connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+
+        if(probe >= 0)
+        {
+            ::close(probe);
+        }
+
+        if(is_in_use)
+        {
+            fail("another server is listening on '" + settings.socket_path + "'.");
+
+            return;
+        }
+
+        unlink(settings.socket_path.c_str());
+    }
+
+    m_listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if(m_listener < 0 || bind(m_listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        fail("cannot create the socket '" + settings.socket_path + "' (" + std::strerror(errno) + ").");
+
+        return;
+    }
+
+    // From here on the socket file is ours to remove:
+    m_socket_path = settings.socket_path;
+
+    if(listen(m_listener, SOMAXCONN) != 0)
+    {
+        fail(std::string("cannot listen on the socket (") + std::strerror(errno) + ").");
+
+        return;
+    }
+
+    // 2) The event loop's descriptors:
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+    m_wake_event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    epoll_event listener_event = {};
+    epoll_event wake_event = {};
+
+    listener_event.events = EPOLLIN;
+    listener_event.data.u64 = sc_listener_key;
+    wake_event.events = EPOLLIN;
+    wake_event.data.u64 = sc_wake_key;
+
+    if(m_epoll < 0 || m_wake_event < 0 ||
+       epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listener, &listener_event) != 0 ||
+       epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wake_event, &wake_event) != 0)
+    {
+        fail(std::string("cannot set up the event loop (") + std::strerror(errno) + ").");
+
+        return;
+    }
+
+    // 3) The workers:
+    m_writer = std::thread(&Server::runWriter, this);
+
+    for(int index = 0; index < std::max(1, settings.reader_count); ++index)
+    {
+        m_readers.emplace_back(&Server::runReader, this);
+    }
+
+    m_is_open = true;
+
+    is_successful = true;
+    outcome_message = "Listening on '" + m_socket_path + "' with 1 writer and " + std::to_string(m_readers.size()) + " reader(s) on " + std::to_string(profile.read_connections) + " read connection(s).";
+}
+
+// ----------------------------------------------------------------------------
+void Server::run(
+    ServerStatistics& statistics,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    statistics = ServerStatistics();
+
+    if(!m_is_open)
+    {
+        is_successful = false;
+        outcome_message = "Server failed: the server is not open.";
+
+        return;
+    }
+
+    constexpr int c_max_events = 64;
+
+    epoll_event events[c_max_events];
+
+    while(!m_is_stop_requested.load())
+    {
+        int event_count = epoll_wait(m_epoll, events, c_max_events, -1);
+
+        if(event_count < 0)
+        {
+            // Interrupted by a signal (possibly the one asking us to stop):
+            if(errno == EINTR)
+            {
+                continue;
+            }
+
+            is_successful = false;
+            outcome_message = std::string("Server failed: ") + std::strerror(errno);
+
+            return;
+        }
+
+        for(int index = 0; index < event_count; ++index)
+        {
+            unsigned long long key = events[index].data.u64;
+            std::uint32_t flags = events[index].events;
+
+            if(key == sc_listener_key)
+            {
+                acceptClients(statistics);
+            }
+
+            else if(key == sc_wake_key)
+            {
+                std::uint64_t count = 0;
+
+                // NOTE (SAVIZ): Reading resets the counter, however many times it was signalled.
+                if(read(m_wake_event, &count, sizeof(count)) < 0)
+                {
+                    count = 0;
+                }
+
+                deliverCompletions(statistics);
+            }
+
+            // The client is gone altogether (not just done sending), so there is nobody left to answer:
+            else if(flags & (EPOLLHUP | EPOLLERR))
+            {
+                closeClient(key);
+            }
+
+            else
+            {
+                if(flags & (EPOLLIN | EPOLLRDHUP))
+                {
+                    readFromClient(key);
+                }
+
+                if(flags & EPOLLOUT)
+                {
+                    sendToClient(key);
+                }
+            }
+        }
+    }
+
+    is_successful = true;
+    outcome_message = "Server stopped: " + std::to_string(statistics.connection_count) + " connection(s), " + std::to_string(statistics.request_count) + " request(s) answered.";
+}
+
+// ----------------------------------------------------------------------------
+void Server::requestStop()
+{
+    // NOTE (SAVIZ): Only an atomic store and a 'write()', both safe in a signal handler.
+    m_is_stop_requested.store(true);
+
+    if(m_wake_event >= 0)
+    {
+        std::uint64_t one = 1;
+
+        if(write(m_wake_event, &one, sizeof(one)) < 0)
+        {
+            // The counter is already signalled, which wakes the loop all the same.
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Server::close(
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = true;
+    outcome_message = "Server closed.";
+
+    // 1) Stop listening and disconnect every client:
+    for(auto& [key, client] : m_clients)
+    {
+        ::close(client.socket);
+    }
+
+    m_clients.clear();
+
+    if(m_listener >= 0)
+    {
+        ::close(m_listener);
+        m_listener = -1;
+    }
+
+    if(!m_socket_path.empty())
+    {
+        unlink(m_socket_path.c_str());
+        m_socket_path.clear();
+    }
+
+    // 2) Let the workers finish what they were given (the writer commits what it still has grouped):
+    for(JobQueue* queue : { &m_writer_queue, &m_reader_queue })
+    {
+        {
+            std::lock_guard<std::mutex> lock(queue->mutex);
+
+            queue->is_stopping = true;
+        }
+
+        queue->condition.notify_all();
+    }
+
+    if(m_writer.joinable())
+    {
+        m_writer.join();
+    }
+
+    for(std::thread& reader : m_readers)
+    {
+        reader.join();
+    }
+
+    m_readers.clear();
+    m_completed_jobs.clear();
+
+    m_writer_queue.is_stopping = false;
+    m_reader_queue.is_stopping = false;
+
+    if(m_epoll >= 0)
+    {
+        ::close(m_epoll);
+        m_epoll = -1;
+    }
+
+    if(m_wake_event >= 0)
+    {
+        ::close(m_wake_event);
+        m_wake_event = -1;
+    }
+
+    m_database = nullptr;
+    m_is_open = false;
+}
+
+// ----------------------------------------------------------------------------
+void Server::runWriter()
+{
+    JsonSession session(m_database);
+
+    // Writes answered while their group is still open. They are held back until it is committed, so that a client never reads an answer that could still be lost:
+    std::vector<Job> awaiting_commit;
+
+    auto settle_awaiting_commits = [this, &session, &awaiting_commit]()
+    {
+        if(awaiting_commit.empty() || m_database->hasPendingWrites())
+        {
+            return;
+        }
+
+        bool is_successful = false;
+        std::string outcome_message = "";
+
+        m_database->getLastGroupCommitOutcome(is_successful, outcome_message);
+
+        for(Job& job : awaiting_commit)
+        {
+            // The write itself went through, but it was lost with its group:
+            if(!is_successful)
+            {
+                job.response.clear();
+
+                session.answerWithError(job.request, outcome_message, job.response);
+            }
+
+            complete(std::move(job));
+        }
+
+        awaiting_commit.clear();
+    };
+
+    while(true)
+    {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock(m_writer_queue.mutex);
+
+            auto has_work = [this]() { return(m_writer_queue.is_stopping || !m_writer_queue.jobs.empty()); };
+
+            // An open group waits for more writes only until its deadline:
+            if(m_database->hasPendingWrites())
+            {
+                m_writer_queue.condition.wait_until(lock, m_database->getGroupCommitDeadline(), has_work);
+            }
+
+            else
+            {
+                m_writer_queue.condition.wait(lock, has_work);
+            }
+
+            if(m_writer_queue.jobs.empty())
+            {
+                // The queue ran dry (the deadline passed, or we are stopping), so nothing else will join the group. Commit it:
+                if(m_database->hasPendingWrites())
+                {
+                    lock.unlock();
+
+                    bool is_successful = false;
+                    std::string outcome_message = "";
+
+                    m_database->flushGroupCommit(is_successful, outcome_message);
+
+                    settle_awaiting_commits();
+
+                    continue;
+                }
+
+                // Stop only once the queue is empty, so that no accepted request is lost:
+                if(m_writer_queue.is_stopping)
+                {
+                    return;
+                }
+
+                continue;
+            }
+
+            job = std::move(m_writer_queue.jobs.front());
+            m_writer_queue.jobs.pop_front();
+        }
+
+        session.handleRequest(job.request, job.response);
+
+        if(m_database->hasPendingWrites())
+        {
+            awaiting_commit.push_back(std::move(job));
+
+            continue;
+        }
+
+        // The write may have filled (and so committed) a group that earlier writes are waiting on:
+        settle_awaiting_commits();
+
+        complete(std::move(job));
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Server::runReader()
+{
+    // NOTE (SAVIZ): Every read is routed to a read connection by the Database itself, so the readers share it with the writer.
+    JsonSession session(m_database);
+
+    Job job;
+
+    while(takeJob(m_reader_queue, job))
+    {
+        session.handleRequest(job.request, job.response);
+
+        complete(std::move(job));
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Server::complete(
+    Job&& job
+    )
+{
+    {
+        std::lock_guard<std::mutex> lock(m_completed_mutex);
+
+        m_completed_jobs.push_back(std::move(job));
+    }
+
+    std::uint64_t one = 1;
+
+    if(write(m_wake_event, &one, sizeof(one)) < 0)
+    {
+        // The counter is already signalled, which wakes the loop all the same.
+    }
+}
+
+// ----------------------------------------------------------------------------
+bool Server::takeJob(
+    JobQueue& queue,
+    Job& job
+    )
+{
+    std::unique_lock<std::mutex> lock(queue.mutex);
+
+    queue.condition.wait(lock, [&queue]() { return(queue.is_stopping || !queue.jobs.empty()); });
+
+    if(queue.jobs.empty())
+    {
+        return(false);
+    }
+
+    job = std::move(queue.jobs.front());
+    queue.jobs.pop_front();
+
+    return(true);
+}
+
+// ----------------------------------------------------------------------------
+void Server::acceptClients(
+    ServerStatistics& statistics
+    )
+{
+    while(true)
+    {
+        int client_socket = accept4(m_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if(client_socket < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+
+            // No more waiting clients (or no room for another descriptor, in which case they wait in the backlog):
+            return;
+        }
+
+        unsigned long long key = m_next_client_key++;
+
+        epoll_event client_event = {};
+
+        client_event.events = EPOLLIN | EPOLLRDHUP;
+        client_event.data.u64 = key;
+
+        if(epoll_ctl(m_epoll, EPOLL_CTL_ADD, client_socket, &client_event) != 0)
+        {
+            ::close(client_socket);
+
+            continue;
+        }
+
+        Client client;
+
+        client.socket = client_socket;
+
+        m_clients.emplace(key, std::move(client));
+
+        ++statistics.connection_count;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Server::readFromClient(
+    unsigned long long client_key
+    )
+{
+    auto found = m_clients.find(client_key);
+
+    if(found == m_clients.end())
+    {
+        return;
+    }
+
+    Client& client = found->second;
+
+    char buffer[1 << 16];
+
+    while(!client.is_peer_closed)
+    {
+        ssize_t byte_count = recv(client.socket, buffer, sizeof(buffer), 0);
+
+        if(byte_count > 0)
+        {
+            client.input.append(buffer, static_cast<std::size_t>(byte_count));
+
+            continue;
+        }
+
+        if(byte_count == 0)
+        {
+            client.is_peer_closed = true;
+
+            break;
+        }
+
+        if(errno == EINTR)
+        {
+            continue;
+        }
+
+        if(errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            break;
+        }
+
+        closeClient(client_key);
+
+        return;
+    }
+
+    // NOTE (SAVIZ): The events are level-triggered, so a client that is done sending must no longer be watched for input (it would wake the loop forever).
+    if(client.is_peer_closed)
+    {
+        epoll_event client_event = {};
+
+        client_event.events = client.is_waiting_to_send ? static_cast<std::uint32_t>(EPOLLOUT) : 0;
+        client_event.data.u64 = client_key;
+
+        epoll_ctl(m_epoll, EPOLL_CTL_MOD, client.socket, &client_event);
+    }
+
+    dispatchNextRequest(client_key);
+}
+
+// ----------------------------------------------------------------------------
+void Server::deliverCompletions(
+    ServerStatistics& statistics
+    )
+{
+    std::vector<Job> completed_jobs;
+
+    {
+        std::lock_guard<std::mutex> lock(m_completed_mutex);
+
+        completed_jobs.swap(m_completed_jobs);
+    }
+
+    for(Job& job : completed_jobs)
+    {
+        ++statistics.request_count;
+
+        auto found = m_clients.find(job.client_key);
+
+        // The client left while its request was running:
+        if(found == m_clients.end())
+        {
+            continue;
+        }
+
+        found->second.output += job.response;
+        found->second.is_busy = false;
+
+        dispatchNextRequest(job.client_key);
+        sendToClient(job.client_key);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Server::dispatchNextRequest(
+    unsigned long long client_key
+    )
+{
+    auto found = m_clients.find(client_key);
+
+    if(found == m_clients.end())
+    {
+        return;
+    }
+
+    Client& client = found->second;
+
+    while(!client.is_busy)
+    {
+        std::size_t newline = client.input.find('\n');
+
+        if(newline == std::string::npos)
+        {
+            if(client.input.size() > sc_max_request_bytes)
+            {
+                std::string outcome_message = "the request is longer than " + std::to_string(sc_max_request_bytes) + " bytes.";
+
+                JsonWriter writer(client.output);
+
+                writer.beginObject();
+                writer.key("ok");
+                writer.boolean(false);
+                writer.key("error");
+                writer.string(outcome_message);
+                writer.endObject();
+
+                client.output += '\n';
+
+                // Nothing more is read from this client, which is disconnected once the error is sent:
+                client.input.clear();
+                client.is_peer_closed = true;
+
+                epoll_event client_event = {};
+
+                client_event.events = 0;
+                client_event.data.u64 = client_key;
+
+                epoll_ctl(m_epoll, EPOLL_CTL_MOD, client.socket, &client_event);
+                client.is_waiting_to_send = false;
+
+                break;
+            }
+
+            // The last request may end without a newline:
+            if(!client.is_peer_closed || client.input.empty())
+            {
+                break;
+            }
+
+            newline = client.input.size();
+        }
+
+        std::string request = client.input.substr(0, newline);
+
+        client.input.erase(0, std::min(newline + 1, client.input.size()));
+
+        if(!request.empty() && request.back() == '\r')
+        {
+            request.pop_back();
+        }
+
+        if(request.find_first_not_of(" \t") == std::string::npos)
+        {
+            continue;
+        }
+
+        // Only the writer may write. Anything else (including requests that cannot be read, which only get an error) goes to a reader:
+        std::string parse_message = "";
+        bool is_write = false;
+
+        if(m_request.parse(request, parse_message))
+        {
+            const JsonValue* op = m_request.find("op");
+
+            is_write = op != nullptr && op->type == JsonType::String && JsonSession::isWriteOperation(op->text);
+        }
+
+        JobQueue& queue = is_write ? m_writer_queue : m_reader_queue;
+
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            Job job;
+
+            job.client_key = client_key;
+            job.request = std::move(request);
+
+            queue.jobs.push_back(std::move(job));
+        }
+
+        queue.condition.notify_one();
+
+        client.is_busy = true;
+    }
+
+    // A client that is done sending is let go once everything it asked for is answered and sent:
+    if(client.is_peer_closed && !client.is_busy && client.input.empty() && client.output_offset == client.output.size())
+    {
+        closeClient(client_key);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Server::sendToClient(
+    unsigned long long client_key
+    )
+{
+    auto found = m_clients.find(client_key);
+
+    if(found == m_clients.end())
+    {
+        return;
+    }
+
+    Client& client = found->second;
+
+    while(client.output_offset < client.output.size())
+    {
+        ssize_t byte_count = send(client.socket, client.output.data() + client.output_offset, client.output.size() - client.output_offset, MSG_NOSIGNAL);
+
+        if(byte_count > 0)
+        {
+            client.output_offset += static_cast<std::size_t>(byte_count);
+
+            continue;
+        }
+
+        if(byte_count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if(byte_count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+
+        // The client is gone:
+        closeClient(client_key);
+
+        return;
+    }
+
+    bool is_sent = client.output_offset == client.output.size();
+
+    if(is_sent)
+    {
+        client.output.clear();
+        client.output_offset = 0;
+    }
+
+    // Watch for room to send only while something is left to send:
+    if(client.is_waiting_to_send == is_sent)
+    {
+        client.is_waiting_to_send = !is_sent;
+
+        epoll_event client_event = {};
+
+        client_event.events = (client.is_peer_closed ? 0 : static_cast<std::uint32_t>(EPOLLIN | EPOLLRDHUP)) | (client.is_waiting_to_send ? static_cast<std::uint32_t>(EPOLLOUT) : 0);
+        client_event.data.u64 = client_key;
+
+        epoll_ctl(m_epoll, EPOLL_CTL_MOD, client.socket, &client_event);
+    }
+
+    if(is_sent && client.is_peer_closed && !client.is_busy && client.input.empty())
+    {
+        closeClient(client_key);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Server::closeClient(
+    unsigned long long client_key
+    )
+{
+    auto found = m_clients.find(client_key);
+
+    if(found == m_clients.end())
+    {
+        return;
+    }
+
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, found->second.socket, nullptr);
+
+    ::close(found->second.socket);
+
+    m_clients.erase(found);
+}
+
+#else
+
+void Server::open(
+    Database* database,
+    const ServerSettings& settings,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+    outcome_message = "Server start failed: the server mode needs Linux (epoll).";
+}
+
+void Server::run(
+    ServerStatistics& statistics,
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = false;
+    outcome_message = "Server failed: the server is not open.";
+}
+
+void Server::requestStop()
+{
+    m_is_stop_requested.store(true);
+}
+
+void Server::close(
+    bool& is_successful,
+    std::string& outcome_message
+    )
+{
+    is_successful = true;
+    outcome_message = "Server closed.";
+}
+
+#endif
@@ -3,6 +3,8 @@
 State::State()
 { 
     this->m_database = nullptr;
+    this->m_async_database = nullptr;
+    this->m_capacity_engine = nullptr;
     this->m_state_manager = nullptr;
 }
 
@@ -10,8 +12,10 @@ State::~State()
 {
 }
 
-void State::init(StateManager* state_manager, Database* database)
+void State::init(StateManager* state_manager, Database* database, AsyncDatabase* async_database, CapacityEngine* capacity_engine)
 {
     this->m_state_manager = state_manager;
     this->m_database = database;
+    this->m_async_database = async_database;
+    this->m_capacity_engine = capacity_engine;
 }
@@ -10,7 +10,9 @@ StateManager::~StateManager()
 }
 
 void StateManager::init(
-    Database* database
+    Database* database,
+    AsyncDatabase* async_database,
+    CapacityEngine* capacity_engine
     )
 {
     // Selecting starting state:
@@ -18,27 +20,37 @@ void StateManager::init(
 
     m_main_menu_state.init(
         this,
-        database
+        database,
+        async_database,
+        capacity_engine
         );
 
     m_vessel_management_state.init(
         this,
-        database
+        database,
+        async_database,
+        capacity_engine
         );
 
     m_sailing_management_state.init(
         this,
-        database
+        database,
+        async_database,
+        capacity_engine
         );
 
     m_reservation_management_state.init(
         this,
-        database
+        database,
+        async_database,
+        capacity_engine
         );
 
     m_boarding_state.init(
         this,
-        database
+        database,
+        async_database,
+        capacity_engine
         );
 }
 
@@ -2,28 +2,64 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
 #include "utilities.hpp"
+#include "sailing_key.hpp"
 
-void Utilities::extractSailingID(std::string& sailing_id, std::string& terminal, int& departure_day, int& departure_hour) {
-    // String stream
-    std::stringstream string_stream(sailing_id);
+void Utilities::extractSailingID(std::string_view sailing_id, std::string& terminal, int& departure_day, int& departure_hour) {
+    // The terminal is everything up to the first dash:
+    std::size_t first_dash = sailing_id.find('-');
 
-    // Other variables
-    char dummy; 
+    terminal.assign(sailing_id.substr(0, first_dash));
 
-    std::getline(string_stream, terminal, '-'); // Get string and put in terminal up until first dash
-    string_stream >> departure_day >> dummy >> departure_hour; // Uses dummy to consume the 2nd dash
+    if(first_dash == std::string_view::npos)
+    {
+        return;
+    }
+
+    // Then the day and the hour, each followed by a dash or the end:
+    const char* end = sailing_id.data() + sailing_id.size();
+    std::from_chars_result day_result = std::from_chars(sailing_id.data() + first_dash + 1, end, departure_day);
+
+    if(day_result.ec == std::errc() && day_result.ptr != end)
+    {
+        std::from_chars(day_result.ptr + 1, end, departure_hour);
+    }
 }
 
-void Utilities::createSailingID(const std::string& terminal, const int departure_day, const int departure_hour, std::string& output_sailing_id)
+void Utilities::createSailingID(std::string_view terminal, const int departure_day, const int departure_hour, std::string& output_sailing_id)
 {
-    std::ostringstream oss;
-    oss << terminal
-        << '-'
-        << std::setw(2) << std::setfill('0') << departure_day
-        << '-'
-        << std::setw(2) << std::setfill('0') << departure_hour;
-    output_sailing_id = oss.str();
+    char sailing_id[SailingKey::c_text_length];
+    SailingKey sailing_key;
+
+    // Every sailing the program creates packs, and is formatted straight from the key:
+    if(SailingKey::create(terminal, departure_day, departure_hour, sailing_key))
+    {
+        sailing_key.format(sailing_id);
+        output_sailing_id.assign(sailing_id, SailingKey::c_text_length);
+
+        return;
+    }
+
+    // Anything else is written as it is, numbers below 10 padded with a zero:
+    output_sailing_id.assign(terminal);
+
+    for(int number : {departure_day, departure_hour})
+    {
+        char digits[16];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+
+        output_sailing_id += '-';
+
+        if(number >= 0 && number < 10)
+        {
+            output_sailing_id += '0';
+        }
+
+        output_sailing_id.append(digits, result.ptr);
+    }
 }
 
 bool Utilities::almostEqual(
@@ -35,6 +71,32 @@ bool Utilities::almostEqual(
     return(std::abs(first_number - second_number) < epsilon);
 }
 
+bool Utilities::parseReal(
+    const std::string& text,
+    double& number
+    )
+{
+    if(text.empty())
+    {
+        return(false);
+    }
+
+    char* end = nullptr;
+
+    number = std::strtod(text.c_str(), &end);
+
+    return(end == text.c_str() + text.size() && std::isfinite(number));
+}
+
+bool Utilities::isInRange(
+    double number,
+    double min,
+    double max
+    )
+{
+    return(number >= min && number <= max);
+}
+
 std::string Utilities::getLocalDateAndTime()
 {
     std::time_t time = std::time(
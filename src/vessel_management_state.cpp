@@ -78,21 +78,21 @@ void VesselManagementState::createVessel()
 
     continuouslyPromptForString(
         "Please enter the name of the new vessel: ",
-        std::regex(R"([\w ]{1,25})"), // Regular expression >> match 1-25 letters, numbers, digits, case insensitive
+        g_vessel_name_pattern, // Regular expression >> match 1-25 letters, numbers, digits, case insensitive
         vessel.vessel_name
         );
 
     continuouslyPromptForReal(
         "Please enter the high-ceiling lane length [0-1200]: ",
-        0,
-        1200,
+        g_lane_min_length,
+        g_lane_max_length,
         vessel.high_ceiling_lane_length
         );
 
     continuouslyPromptForReal(
         "Please enter the low-ceiling lane length [0-1200]: ",
-        0,
-        1200,
+        g_lane_min_length,
+        g_lane_max_length,
         vessel.low_ceiling_lane_length
         );
 
@@ -135,8 +135,9 @@ void VesselManagementState::createVessel()
 // ----------------------------------------------------------------------------
 void VesselManagementState::listVessels()
 {
-    // Offset the starting record by the length amount:
-    int offset = 0;
+    // Remember the page on display, so that the next and previous pages can be found from it:
+    PageCursor cursor;
+    PageDirection direction = PageDirection::First;
 
     // Continue listing vessels forever until the user exits:
     while(true)
@@ -147,7 +148,8 @@ void VesselManagementState::listVessels()
 
         m_database->getVessels(
             g_list_length,
-            offset,
+            direction,
+            cursor,
             vessels,
             g_is_successful,
             g_outcome_message
@@ -163,25 +165,15 @@ void VesselManagementState::listVessels()
             break; // Go back to menu.
         }
 
-        // If there are no more records to show based on offset:
+        // If there are no more records to show in that direction (the cursor still points at the page shown before):
         if(vessels.empty())
         {
-            if (offset < 0) 
-            {
-#ifdef DEBUG_MODE
-                std::cout << "[Debug] list offset < 0" << "\n\n";
-#endif
-                break;
-            }
-            else if(offset == 0) // If we are at the start of the list.
+            if(!cursor.has_page) // If the list itself is empty.
             {
                 std::cout << "No records available for displaying!" << "\n\n";
             }
             else // If we are at the end of the list.
             {
-                // Clamp top:
-                offset -= g_list_length;
-
                 std::cout << "No more next records available for displaying!" << "\n\n";
             }
         }
@@ -239,17 +231,12 @@ void VesselManagementState::listVessels()
         {
         case 'p':
         case 'P':
-            offset -= g_list_length;
-
-            // Clamp bottom:
-            if(offset <= 0)
-            {
-                offset = 0;
-            }
+            // NOTE (SAVIZ): Going back from the first page simply shows the first page again.
+            direction = PageDirection::Previous;
             break;
         case 'n':
         case 'N':
-            offset += g_list_length;
+            direction = PageDirection::Next;
             break;
         case 'e':
         case 'E':
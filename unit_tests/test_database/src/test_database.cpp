@@ -0,0 +1,1565 @@
+#include <catch2/catch_all.hpp>
+#include <sqlite3.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <string>
+#include <vector>
+#include "database.hpp"
+#include "async_database.hpp"
+#include "capacity_engine.hpp"
+#include "importer.hpp"
+#include "script_runner.hpp"
+#include "report_builder.hpp"
+#include "entity_cache.hpp"
+#include "database_queries.hpp"
+
+// Opens an in-memory database with the real schema and enough rows that the planner has a choice to make.
+static sqlite3* openSeededDatabase()
+{
+    sqlite3* sqlite = nullptr;
+
+    REQUIRE(sqlite3_open(":memory:", &sqlite) == SQLITE_OK);
+    REQUIRE(sqlite3_exec(sqlite, DatabaseQueries::c_create_schema, nullptr, nullptr, nullptr) == SQLITE_OK);
+
+    for(const char* migration : DatabaseQueries::c_schema_migrations)
+    {
+        REQUIRE(sqlite3_exec(sqlite, migration, nullptr, nullptr, nullptr) == SQLITE_OK);
+    }
+
+    std::string seed = "BEGIN;";
+
+    for(int index = 1; index <= 20; ++index)
+    {
+        seed += "INSERT INTO vessels (vessel_name, low_ceiling_lane_length, high_ceiling_lane_length) VALUES ('Vessel " + std::to_string(index) + "', 100, 100);";
+    }
+
+    for(int index = 0; index < 200; ++index)
+    {
+        seed += "INSERT INTO sailings (vessel_id_fk, departure_terminal, departure_day, departure_hour, low_remaining_length, high_remaining_length) VALUES (" +
+            std::to_string(index % 20 + 1) + ", 'T" + std::to_string(index % 7) + "', " + std::to_string(index % 31 + 1) + ", " + std::to_string(index % 24) + ", 100, 100);";
+    }
+
+    for(int index = 1; index <= 500; ++index)
+    {
+        seed += "INSERT INTO vehicles (license_plate, phone_number, length, height) VALUES ('P" + std::to_string(index) + "', '5550000000', 5, 1.5);";
+        seed += "INSERT INTO reservations (sailing_id_fk, vehicle_id_fk, amount_paid, reserved_for_low_lane) VALUES (" + std::to_string(index % 200 + 1) + ", " + std::to_string(index) + ", 0, 1);";
+    }
+
+    seed += "COMMIT;";
+
+    REQUIRE(sqlite3_exec(sqlite, seed.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK);
+
+    return(sqlite);
+}
+
+// Returns the 'detail' column of every step of the query plan.
+static std::vector<std::string> explainQueryPlan(
+    sqlite3* sqlite,
+    const char* sql_query
+    )
+{
+    std::vector<std::string> plan;
+
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    std::string explain_query = std::string("EXPLAIN QUERY PLAN ") + sql_query;
+
+    REQUIRE(sqlite3_prepare_v2(sqlite, explain_query.c_str(), -1, &prepared_sql_statement, nullptr) == SQLITE_OK);
+
+    while(sqlite3_step(prepared_sql_statement) == SQLITE_ROW)
+    {
+        const unsigned char* detail = sqlite3_column_text(prepared_sql_statement, 3);
+
+        plan.push_back(detail ? reinterpret_cast<const char*>(detail) : "");
+    }
+
+    sqlite3_finalize(prepared_sql_statement);
+
+    return(plan);
+}
+
+// Returns the first column of the first row of a query as a number.
+static double queryNumber(
+    sqlite3* sqlite,
+    const std::string& sql_query
+    )
+{
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    REQUIRE(sqlite3_prepare_v2(sqlite, sql_query.c_str(), -1, &prepared_sql_statement, nullptr) == SQLITE_OK);
+    REQUIRE(sqlite3_step(prepared_sql_statement) == SQLITE_ROW);
+
+    double number = sqlite3_column_double(prepared_sql_statement, 0);
+
+    sqlite3_finalize(prepared_sql_statement);
+
+    return(number);
+}
+
+static bool planContains(
+    const std::vector<std::string>& plan,
+    const std::string& text
+    )
+{
+    for(const std::string& step : plan)
+    {
+        if(step.find(text) != std::string::npos)
+        {
+            return(true);
+        }
+    }
+
+    return(false);
+}
+
+TEST_CASE("Statement cache: a repeated call reuses its statement, and cutting the connection finalizes them", "[Database]")
+{
+    const std::string path = "test_statement_cache.db";
+
+    std::remove(path.c_str());
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(path, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addVessel(Vessel(0, "Vessel", 100.0, 100.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // Without read connections or an entity cache, a vessel lookup is one statement on the writing connection:
+    Vessel vessel;
+
+    database.getVesselByID(1, vessel, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    StatementCacheStatistics before;
+
+    database.getStatementCacheStatistics(before);
+
+    for(int index = 0; index < 10; ++index)
+    {
+        database.getVesselByID(1, vessel, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(vessel.vessel_name == "Vessel");
+    }
+
+    StatementCacheStatistics after;
+
+    database.getStatementCacheStatistics(after);
+
+    REQUIRE(after.prepared_count == before.prepared_count);
+    REQUIRE(after.reused_count == before.reused_count + 10);
+
+    // 'sqlite3_close()' refuses a connection with statements left, so a clean cut means the cache was finalized:
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // ...and a new connection compiles the statement again instead of reusing one from the old connection:
+    database.openConnection(path, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.getStatementCacheStatistics(before);
+
+    database.getVesselByID(1, vessel, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(vessel.vessel_name == "Vessel");
+
+    database.getStatementCacheStatistics(after);
+
+    REQUIRE(after.prepared_count == before.prepared_count + 1);
+    REQUIRE(after.reused_count == before.reused_count);
+
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Reservations: a lane takes a vehicle only with room for its gap, low lane first", "[Database]")
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(":memory:", is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // Room for two 5 meter vehicles (with their 0.5 meter gaps) and then exactly one vehicle length in the low lane, one and a vehicle length in the high lane:
+    database.addVessel(Vessel(0, "Vessel", 16.0, 10.5), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addSailing(Sailing(0, 1, "AHS", 1, 10, 16.0, 10.5), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // A high lane that is an exact fit with the gap, beside a roomy low lane:
+    database.addVessel(Vessel(0, "Narrow", 100.0, 5.5), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addSailing(Sailing(0, 2, "AHS", 2, 10, 100.0, 5.5), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    CapacityEngine capacity_engine;
+
+    capacity_engine.load(database, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    Sailing sailing;
+    Sailing narrow_sailing;
+
+    database.getSailingByID("AHS", 1, 10, sailing, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.getSailingByID("AHS", 2, 10, narrow_sailing, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // Books a vehicle, checking that the capacity engine chose the lane the database did:
+    int vehicle_number = 0;
+
+    auto book = [&](Sailing& target_sailing, double height, bool& is_low_lane)
+    {
+        Vehicle vehicle(0, "GAP-" + std::to_string(++vehicle_number), "5550000000", 5.0, height);
+
+        database.addVehicle(vehicle, vehicle.vehicle_id, is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        CapacityDecision decision;
+
+        capacity_engine.decide(target_sailing.sailing_id, vehicle.length, vehicle.height, decision, is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        Reservation reservation;
+
+        database.addReservation(target_sailing, vehicle, reservation, is_successful, outcome_message);
+        REQUIRE(is_successful == decision.fits);
+
+        if(is_successful)
+        {
+            REQUIRE(reservation.reserved_for_low_lane == decision.is_low_lane);
+
+            is_low_lane = reservation.reserved_for_low_lane;
+
+            bool is_refreshed = false;
+            std::string refresh_message;
+
+            capacity_engine.refresh(database, target_sailing, is_refreshed, refresh_message);
+            REQUIRE(is_refreshed);
+        }
+
+        return(is_successful);
+    };
+
+    bool is_low_lane = false;
+
+    // Low vehicles fill the low lane first:
+    REQUIRE(book(sailing, 1.5, is_low_lane));
+    REQUIRE(is_low_lane);
+
+    REQUIRE(book(sailing, 1.5, is_low_lane));
+    REQUIRE(is_low_lane);
+    REQUIRE(sailing.low_remaining_length == 5.0);
+
+    // The low lane now fits the vehicle but not its gap, so the next one goes to the high lane:
+    REQUIRE(book(sailing, 1.5, is_low_lane));
+    REQUIRE_FALSE(is_low_lane);
+    REQUIRE(sailing.high_remaining_length == 5.0);
+
+    // Both lanes are an exact fit without the gap: refused, rather than left at -0.5 meters:
+    REQUIRE_FALSE(book(sailing, 1.5, is_low_lane));
+    REQUIRE(outcome_message.find("not enough space") != std::string::npos);
+
+    REQUIRE_FALSE(book(sailing, 2.5, is_low_lane));
+
+    database.getSailingByID("AHS", 1, 10, sailing, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(sailing.low_remaining_length == 5.0);
+    REQUIRE(sailing.high_remaining_length == 5.0);
+
+    // A tall vehicle takes an exact fit with the gap, and never the low lane:
+    REQUIRE(book(narrow_sailing, 2.5, is_low_lane));
+    REQUIRE_FALSE(is_low_lane);
+    REQUIRE(narrow_sailing.high_remaining_length == 0.0);
+
+    REQUIRE_FALSE(book(narrow_sailing, 2.5, is_low_lane));
+    REQUIRE(narrow_sailing.low_remaining_length == 100.0);
+
+    // The search agrees with both:
+    std::vector<AvailableSailing> available_sailings;
+
+    capacity_engine.findAvailableSailings("AHS", 1, 0, 5.0, 1.5, 5, available_sailings, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(available_sailings.size() == 1);
+    REQUIRE(available_sailings[0].sailing_id == narrow_sailing.sailing_id);
+    REQUIRE(available_sailings[0].is_low_lane);
+
+    capacity_engine.findAvailableSailings("AHS", 1, 0, 5.0, 2.5, 5, available_sailings, is_successful, outcome_message);
+    REQUIRE_FALSE(is_successful);
+
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+}
+
+TEST_CASE("Boarding: the fare follows the length and height, and is charged only once", "[Database]")
+{
+    const std::string path = "test_boarding.db";
+
+    std::remove(path.c_str());
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(path, ConnectionProfile(), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addVessel(Vessel(0, "Vessel", 100.0, 100.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addSailing(Sailing(0, 1, "AHS", 1, 10, 100.0, 100.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    Sailing sailing;
+
+    database.getSailingByID("AHS", 1, 10, sailing, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // A second connection reads what was charged:
+    sqlite3* observer = nullptr;
+
+    REQUIRE(sqlite3_open(path.c_str(), &observer) == SQLITE_OK);
+
+    auto amountPaid = [observer](const Vehicle& vehicle)
+    {
+        return(queryNumber(observer, "SELECT amount_paid FROM reservations WHERE vehicle_id_fk = " + std::to_string(vehicle.vehicle_id) + ";"));
+    };
+
+    // Books a vehicle and boards it, returning the amount charged:
+    auto board = [&](const std::string& license_plate, double length, double height, Vehicle& vehicle)
+    {
+        vehicle = Vehicle(0, license_plate, "5550000000", length, height);
+
+        database.addVehicle(vehicle, vehicle.vehicle_id, is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        Reservation reservation;
+
+        database.addReservation(sailing, vehicle, reservation, is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        database.completeBoarding(sailing, vehicle, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(outcome_message.rfind("Boarding complete: amount_paid = ", 0) == 0);
+
+        return(amountPaid(vehicle));
+    };
+
+    Vehicle vehicle;
+
+    // Short and low vehicles pay the flat fee, up to and including 7 meters long and 2 meters high:
+    REQUIRE(board("AAA-111", 5.0, 1.5, vehicle) == 14.0);
+    REQUIRE(board("AAA-222", 7.0, 2.0, vehicle) == 14.0);
+
+    // Long vehicles pay $2 per meter:
+    REQUIRE(board("BBB-111", 8.0, 1.5, vehicle) == 16.0);
+
+    // Tall vehicles pay $3 per meter, on top of the long vehicle charge:
+    REQUIRE(board("CCC-111", 5.0, 2.5, vehicle) == 15.0);
+    REQUIRE(board("CCC-222", 8.0, 2.5, vehicle) == 40.0);
+
+    // Boarding again is refused, and the vehicle is not charged twice:
+    database.completeBoarding(sailing, vehicle, is_successful, outcome_message);
+    REQUIRE_FALSE(is_successful);
+    REQUIRE(outcome_message.find("already been boarded") != std::string::npos);
+    REQUIRE(amountPaid(vehicle) == 40.0);
+
+    // A vehicle without a reservation on the sailing is refused without charging anyone:
+    Vehicle unbooked_vehicle(0, "DDD-111", "5550000000", 5.0, 1.5);
+
+    database.addVehicle(unbooked_vehicle, unbooked_vehicle.vehicle_id, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.completeBoarding(sailing, unbooked_vehicle, is_successful, outcome_message);
+    REQUIRE_FALSE(is_successful);
+    REQUIRE(outcome_message.rfind("Boarding failed: ", 0) == 0);
+    REQUIRE(outcome_message.find("already been boarded") == std::string::npos);
+    REQUIRE(queryNumber(observer, "SELECT COUNT(*) FROM reservations WHERE vehicle_id_fk = " + std::to_string(unbooked_vehicle.vehicle_id) + ";") == 0);
+    REQUIRE(queryNumber(observer, "SELECT SUM(amount_paid) FROM reservations;") == 14.0 + 14.0 + 16.0 + 15.0 + 40.0);
+
+    sqlite3_close(observer);
+
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Paging: vessels and sailing reports are paged forwards and backwards by key", "[Database]")
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(":memory:", is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // Twelve vessels (IDs 1 to 12), each with its own lane lengths:
+    for(int index = 1; index <= 12; ++index)
+    {
+        database.addVessel(Vessel(0, "Vessel " + std::to_string(index), index * 10.0, index * 10.0 + 5.0), is_successful, outcome_message);
+        REQUIRE(is_successful);
+    }
+
+    auto vesselIDs = [](const std::vector<Vessel>& vessels)
+    {
+        std::vector<int> vessel_ids;
+
+        for(const Vessel& vessel : vessels)
+        {
+            vessel_ids.push_back(vessel.vessel_id);
+        }
+
+        return(vessel_ids);
+    };
+
+    // The same pages come from the database and from the catalog in the entity cache:
+    auto checkVesselPages = [&]()
+    {
+        PageCursor cursor;
+        std::vector<Vessel> vessels;
+
+        // Previous without a page yet is the first page:
+        database.getVessels(5, PageDirection::Previous, cursor, vessels, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(vesselIDs(vessels) == std::vector<int>{ 1, 2, 3, 4, 5 });
+
+        database.getVessels(5, PageDirection::Next, cursor, vessels, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(vesselIDs(vessels) == std::vector<int>{ 6, 7, 8, 9, 10 });
+
+        // Every column is read into its field:
+        REQUIRE(vessels[0].vessel_name == "Vessel 6");
+        REQUIRE(vessels[0].low_ceiling_lane_length == 60.0);
+        REQUIRE(vessels[0].high_ceiling_lane_length == 65.0);
+
+        // The last page is short, and going past it returns nothing and keeps the cursor on it:
+        database.getVessels(5, PageDirection::Next, cursor, vessels, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(vesselIDs(vessels) == std::vector<int>{ 11, 12 });
+
+        database.getVessels(5, PageDirection::Next, cursor, vessels, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(vessels.empty());
+
+        database.getVessels(5, PageDirection::Previous, cursor, vessels, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(vesselIDs(vessels) == std::vector<int>{ 6, 7, 8, 9, 10 });
+
+        database.getVessels(5, PageDirection::Previous, cursor, vessels, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(vesselIDs(vessels) == std::vector<int>{ 1, 2, 3, 4, 5 });
+
+        // Previous from the first page is the first page again:
+        database.getVessels(5, PageDirection::Previous, cursor, vessels, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(vesselIDs(vessels) == std::vector<int>{ 1, 2, 3, 4, 5 });
+
+        // A page that does not start on a page boundary leaves fewer than a page before it, so Previous returns the first page:
+        database.getVessels(3, PageDirection::First, cursor, vessels, is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        database.getVessels(5, PageDirection::Next, cursor, vessels, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(vesselIDs(vessels) == std::vector<int>{ 4, 5, 6, 7, 8 });
+
+        database.getVessels(5, PageDirection::Previous, cursor, vessels, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(vesselIDs(vessels) == std::vector<int>{ 1, 2, 3, 4, 5 });
+    };
+
+    checkVesselPages();
+
+    EntityCache entity_cache{EntityCacheSettings()};
+
+    database.setEntityCache(&entity_cache, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    checkVesselPages();
+
+    database.setEntityCache(nullptr, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // Twelve sailings on two terminals, added terminal by terminal so that the IDs (1 to 6, then 7 to 12) do not follow the departure order:
+    for(const char* departure_terminal : { "AHS", "DPR" })
+    {
+        for(int departure_day = 1; departure_day <= 3; ++departure_day)
+        {
+            for(int departure_hour : { 8, 20 })
+            {
+                database.addSailing(Sailing(0, 1, departure_terminal, departure_day, departure_hour, 10.0, 15.0), is_successful, outcome_message);
+                REQUIRE(is_successful);
+            }
+        }
+    }
+
+    // One car on the first DPR sailing:
+    Sailing booked_sailing;
+
+    database.getSailingByID("DPR", 1, 8, booked_sailing, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    Vehicle vehicle(0, "AAA-111", "5550000000", 5.0, 1.5);
+    Reservation reservation;
+
+    database.addVehicle(vehicle, vehicle.vehicle_id, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addReservation(booked_sailing, vehicle, reservation, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    auto sailingIDs = [](const std::vector<SailingReport>& sailing_reports)
+    {
+        std::vector<int> sailing_ids;
+
+        for(const SailingReport& sailing_report : sailing_reports)
+        {
+            sailing_ids.push_back(sailing_report.sailing.sailing_id);
+        }
+
+        return(sailing_ids);
+    };
+
+    // Ordered by day, then hour, then ID:
+    PageCursor cursor;
+    std::vector<SailingReport> sailing_reports;
+
+    database.getSailingReports(5, PageDirection::First, cursor, sailing_reports, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(sailingIDs(sailing_reports) == std::vector<int>{ 1, 7, 2, 8, 3 });
+
+    // Every column is read into its field:
+    const SailingReport& first_report = sailing_reports[0];
+
+    REQUIRE(first_report.sailing.departure_terminal == "AHS");
+    REQUIRE(first_report.sailing.departure_day == 1);
+    REQUIRE(first_report.sailing.departure_hour == 8);
+    REQUIRE(first_report.sailing.low_remaining_length == 10.0);
+    REQUIRE(first_report.sailing.high_remaining_length == 15.0);
+    REQUIRE(first_report.vessel.vessel_name == "Vessel 1");
+    REQUIRE(first_report.vehicle_count == 0);
+    REQUIRE(first_report.occupancy_percentage == 0.0);
+
+    const SailingReport& booked_report = sailing_reports[1];
+
+    REQUIRE(booked_report.sailing.departure_terminal == "DPR");
+    REQUIRE(booked_report.sailing.low_remaining_length == booked_sailing.low_remaining_length);
+    REQUIRE(booked_report.sailing.high_remaining_length == booked_sailing.high_remaining_length);
+    REQUIRE(booked_report.vehicle_count == 1);
+    REQUIRE(booked_report.occupancy_percentage == 22.0); // 5.5 of 25 meters, truncated.
+
+    database.getSailingReports(5, PageDirection::Next, cursor, sailing_reports, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(sailingIDs(sailing_reports) == std::vector<int>{ 9, 4, 10, 5, 11 });
+
+    database.getSailingReports(5, PageDirection::Next, cursor, sailing_reports, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(sailingIDs(sailing_reports) == std::vector<int>{ 6, 12 });
+
+    database.getSailingReports(5, PageDirection::Next, cursor, sailing_reports, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(sailing_reports.empty());
+
+    database.getSailingReports(5, PageDirection::Previous, cursor, sailing_reports, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(sailingIDs(sailing_reports) == std::vector<int>{ 9, 4, 10, 5, 11 });
+
+    database.getSailingReports(5, PageDirection::Previous, cursor, sailing_reports, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(sailingIDs(sailing_reports) == std::vector<int>{ 1, 7, 2, 8, 3 });
+
+    database.getSailingReports(5, PageDirection::Previous, cursor, sailing_reports, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(sailingIDs(sailing_reports) == std::vector<int>{ 1, 7, 2, 8, 3 });
+
+    // A short page before the cursor returns the first page:
+    database.getSailingReports(2, PageDirection::First, cursor, sailing_reports, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.getSailingReports(5, PageDirection::Next, cursor, sailing_reports, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(sailingIDs(sailing_reports) == std::vector<int>{ 2, 8, 3, 9, 4 });
+
+    database.getSailingReports(5, PageDirection::Previous, cursor, sailing_reports, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(sailingIDs(sailing_reports) == std::vector<int>{ 1, 7, 2, 8, 3 });
+
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+}
+
+TEST_CASE("Database queries: every query compiles against the schema", "[Database]")
+{
+    sqlite3* sqlite = openSeededDatabase();
+
+    for(const DatabaseQueries::NamedQuery& query : DatabaseQueries::c_all_queries)
+    {
+        INFO(query.name);
+
+        sqlite3_stmt* prepared_sql_statement = nullptr;
+
+        CHECK(sqlite3_prepare_v2(sqlite, query.sql, -1, &prepared_sql_statement, nullptr) == SQLITE_OK);
+
+        sqlite3_finalize(prepared_sql_statement);
+    }
+
+    sqlite3_close(sqlite);
+}
+
+TEST_CASE("Database queries: no query scans a table or sorts into a temporary B-tree", "[Database]")
+{
+    sqlite3* sqlite = openSeededDatabase();
+
+    for(const DatabaseQueries::NamedQuery& query : DatabaseQueries::c_all_queries)
+    {
+        std::vector<std::string> plan = explainQueryPlan(sqlite, query.sql);
+
+        for(const std::string& step : plan)
+        {
+            INFO(query.name << ": " << step);
+
+            // Queries that are meant to read everything may scan, but only in index order (checked by the next line):
+            if(!query.reads_whole_table)
+            {
+                CHECK(step.rfind("SCAN", 0) != 0);
+            }
+
+            CHECK(step.find("TEMP B-TREE") == std::string::npos);
+        }
+    }
+
+    sqlite3_close(sqlite);
+}
+
+TEST_CASE("Database queries: the expected indexes are used", "[Database]")
+{
+    sqlite3* sqlite = openSeededDatabase();
+
+    SECTION("Sailing report pages seek on the departure index")
+    {
+        REQUIRE(planContains(explainQueryPlan(sqlite, DatabaseQueries::c_select_sailing_reports_next), "USING INDEX sailings_by_departure"));
+        REQUIRE(planContains(explainQueryPlan(sqlite, DatabaseQueries::c_select_sailing_reports_previous), "USING INDEX sailings_by_departure"));
+    }
+
+    SECTION("Sailing report pages do not read reservations (the counts are stored on the sailing)")
+    {
+        REQUIRE_FALSE(planContains(explainQueryPlan(sqlite, DatabaseQueries::c_select_sailing_reports_next), "reservations"));
+        REQUIRE_FALSE(planContains(explainQueryPlan(sqlite, DatabaseQueries::c_select_sailing_report_by_id), "reservations"));
+    }
+
+    SECTION("Vehicles are found through the index on the packed plate")
+    {
+        REQUIRE(planContains(explainQueryPlan(sqlite, DatabaseQueries::c_select_vehicle_by_license_plate), "USING INDEX vehicles_by_license_plate_key"));
+    }
+
+    SECTION("Sailings are found through the index on the packed sailing ID")
+    {
+        REQUIRE(planContains(explainQueryPlan(sqlite, DatabaseQueries::c_select_sailing_by_id), "USING INDEX sailings_by_key"));
+        REQUIRE(planContains(explainQueryPlan(sqlite, DatabaseQueries::c_select_sailing_report_by_id), "USING INDEX sailings_by_key"));
+    }
+
+    SECTION("Reservations of a vehicle are found through the covering vehicle index")
+    {
+        REQUIRE(planContains(explainQueryPlan(sqlite, "SELECT sailing_id_fk FROM reservations WHERE vehicle_id_fk = ?;"), "USING COVERING INDEX reservations_by_vehicle"));
+    }
+
+    sqlite3_close(sqlite);
+}
+
+TEST_CASE("Database schema: sailing aggregates follow the reservations", "[Database]")
+{
+    sqlite3* sqlite = openSeededDatabase();
+
+    // The seed spreads 500 reservations over 200 sailings:
+    REQUIRE(queryNumber(sqlite, "SELECT SUM(reserved_vehicle_count) FROM sailings;") == 500);
+    REQUIRE(queryNumber(sqlite, "SELECT COUNT(*) FROM sailings WHERE reserved_vehicle_count != (SELECT COUNT(*) FROM reservations WHERE sailing_id_fk = sailing_id_pk);") == 0);
+
+    SECTION("Counts follow inserts and deletes")
+    {
+        REQUIRE(sqlite3_exec(sqlite, "DELETE FROM reservations WHERE sailing_id_fk = 2;", nullptr, nullptr, nullptr) == SQLITE_OK);
+        REQUIRE(queryNumber(sqlite, "SELECT reserved_vehicle_count FROM sailings WHERE sailing_id_pk = 2;") == 0);
+
+        REQUIRE(sqlite3_exec(sqlite, "INSERT INTO reservations VALUES (2, 1, 0, 1);", nullptr, nullptr, nullptr) == SQLITE_OK);
+        REQUIRE(queryNumber(sqlite, "SELECT reserved_vehicle_count FROM sailings WHERE sailing_id_pk = 2;") == 1);
+    }
+
+    SECTION("Occupancy follows the remaining lengths (truncated to a whole percentage)")
+    {
+        REQUIRE(queryNumber(sqlite, "SELECT occupancy_percentage FROM sailings WHERE sailing_id_pk = 1;") == 0);
+
+        // 200 meters in total, 55.5 taken:
+        REQUIRE(sqlite3_exec(sqlite, "UPDATE sailings SET low_remaining_length = 50, high_remaining_length = 94.5 WHERE sailing_id_pk = 1;", nullptr, nullptr, nullptr) == SQLITE_OK);
+        REQUIRE(queryNumber(sqlite, "SELECT occupancy_percentage FROM sailings WHERE sailing_id_pk = 1;") == 27);
+    }
+
+    sqlite3_close(sqlite);
+}
+
+TEST_CASE("Database cursor: streams every vessel in order and hands the statement back", "[Database]")
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(":memory:", is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    for(int index = 1; index <= 3; ++index)
+    {
+        database.addVessel(Vessel(0, "Vessel " + std::to_string(index), 10.0 * index, 20.0 * index), is_successful, outcome_message);
+        REQUIRE(is_successful);
+    }
+
+    RowCursor<VesselView> cursor;
+
+    database.openVesselCursor(cursor, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    SECTION("Rows are read in ID order with their text in place")
+    {
+        int row_count = 0;
+
+        for(const VesselView& vessel : cursor)
+        {
+            ++row_count;
+
+            REQUIRE(vessel.vessel_id == row_count);
+            REQUIRE(vessel.vessel_name == "Vessel " + std::to_string(row_count));
+            REQUIRE(vessel.high_ceiling_lane_length == 20.0 * row_count);
+        }
+
+        cursor.getOutcome(is_successful, outcome_message);
+
+        REQUIRE(row_count == 3);
+        REQUIRE(is_successful);
+
+        // The rows ran out, so the statement is back in the cache and the connection can be cut:
+        database.cutConnection(is_successful, outcome_message);
+        REQUIRE(is_successful);
+    }
+
+    SECTION("An open cursor blocks a second cursor over the same query and cutting the connection")
+    {
+        RowCursor<VesselView> second_cursor;
+
+        database.openVesselCursor(second_cursor, is_successful, outcome_message);
+        REQUIRE_FALSE(is_successful);
+
+        database.cutConnection(is_successful, outcome_message);
+        REQUIRE_FALSE(is_successful);
+
+        cursor.close();
+
+        database.cutConnection(is_successful, outcome_message);
+        REQUIRE(is_successful);
+    }
+}
+
+TEST_CASE("Async database: requests run in order and are all finished before the connection is cut", "[Database]")
+{
+    const std::string path = "test_async_database.db";
+
+    std::remove(path.c_str());
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    AsyncDatabase async_database;
+
+    async_database.openConnection(path, ConnectionProfile(), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    std::vector<std::future<OperationResult>> futures;
+
+    for(int index = 1; index <= 20; ++index)
+    {
+        futures.push_back(async_database.submit([index](Database& database)
+        {
+            OperationResult result;
+
+            database.addVessel(Vessel(0, "Vessel " + std::to_string(index), 10.0, 10.0), result.is_successful, result.outcome_message);
+
+            return(result);
+        }));
+    }
+
+    // Queued last, so it sees every vessel above:
+    std::future<int> vessel_count = async_database.submit([](Database& database)
+    {
+        RowCursor<VesselView> cursor;
+        bool is_cursor_successful = false;
+        std::string cursor_message = "";
+        int count = 0;
+
+        database.openVesselCursor(cursor, is_cursor_successful, cursor_message);
+
+        for(const VesselView& vessel : cursor)
+        {
+            // IDs follow the order the requests were made in:
+            count = (vessel.vessel_name == "Vessel " + std::to_string(vessel.vessel_id)) ? count + 1 : -1000;
+        }
+
+        return(count);
+    });
+
+    async_database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    for(std::future<OperationResult>& future : futures)
+    {
+        REQUIRE(future.get().is_successful);
+    }
+
+    REQUIRE(vessel_count.get() == 20);
+
+    // Once cut, requests are refused through a broken promise instead of hanging:
+    std::future<int> refused = async_database.submit([](Database&) { return(0); });
+
+    REQUIRE_THROWS_AS(refused.get(), std::future_error);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Group commit: writes are committed together and a failed write undoes only itself", "[Database]")
+{
+    const std::string path = "test_group_commit.db";
+
+    std::remove(path.c_str());
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(path, ConnectionProfile(), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addVessel(Vessel(0, "Vessel", 100.0, 100.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addSailing(Sailing(0, 1, "AHS", 1, 10, 100.0, 100.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // Groups of three boardings, with a deadline far enough away that only the count matters:
+    GroupCommitSettings settings;
+    settings.max_operations = 3;
+    settings.max_delay_milliseconds = 60000;
+
+    database.setGroupCommit(settings, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // A second connection only sees what has been committed:
+    sqlite3* observer = nullptr;
+
+    REQUIRE(sqlite3_open(path.c_str(), &observer) == SQLITE_OK);
+
+    Sailing sailing(1, 1, "AHS", 1, 10, 100.0, 100.0);
+    Vehicle vehicle(0, "AAA-111", "5550000000", 5.0, 1.5);
+
+    database.addVehicle(vehicle, vehicle.vehicle_id, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(database.hasPendingWrites());
+
+    Reservation reservation;
+
+    database.addReservation(sailing, vehicle, reservation, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // The same reservation again fails, and its savepoint takes nothing else with it:
+    database.addReservation(sailing, vehicle, reservation, is_successful, outcome_message);
+    REQUIRE_FALSE(is_successful);
+    REQUIRE(database.hasPendingWrites());
+    REQUIRE(queryNumber(observer, "SELECT COUNT(*) FROM vehicles;") == 0);
+
+    // The third successful write fills the group:
+    database.completeBoarding(sailing, vehicle, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE_FALSE(database.hasPendingWrites());
+    REQUIRE(queryNumber(observer, "SELECT COUNT(*) FROM vehicles;") == 1);
+    REQUIRE(queryNumber(observer, "SELECT amount_paid FROM reservations;") == 14);
+
+    database.getLastGroupCommitOutcome(is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // A remove that fails on the sailing row after deleting its reservations undoes only itself, and the write before it is still committed with the group:
+    REQUIRE(sqlite3_exec(observer, "CREATE TRIGGER refuse_sailing_deletion BEFORE DELETE ON sailings BEGIN SELECT RAISE(ABORT, 'refused'); END;", nullptr, nullptr, nullptr) == SQLITE_OK);
+
+    database.addVessel(Vessel(0, "Second", 50.0, 50.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.removeSailing(sailing, is_successful, outcome_message);
+    REQUIRE_FALSE(is_successful);
+    REQUIRE(database.hasPendingWrites());
+
+    database.flushGroupCommit(is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(queryNumber(observer, "SELECT COUNT(*) FROM vessels;") == 2);
+    REQUIRE(queryNumber(observer, "SELECT COUNT(*) FROM reservations;") == 1);
+    REQUIRE(queryNumber(observer, "SELECT reserved_vehicle_count FROM sailings;") == 1);
+
+    REQUIRE(sqlite3_exec(observer, "DROP TRIGGER refuse_sailing_deletion;", nullptr, nullptr, nullptr) == SQLITE_OK);
+
+    // A partial group is committed when the connection is cut:
+    database.addVehicle(Vehicle(0, "BBB-222", "5550000000", 5.0, 1.5), vehicle.vehicle_id, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(queryNumber(observer, "SELECT COUNT(*) FROM vehicles;") == 1);
+
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(queryNumber(observer, "SELECT COUNT(*) FROM vehicles;") == 2);
+
+    sqlite3_close(observer);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Read connections: reads see committed snapshots while the writing thread sees its own writes", "[Database]")
+{
+    const std::string path = "test_read_connections.db";
+
+    for(const std::string& file : { path, path + "-wal", path + "-shm" })
+    {
+        std::remove(file.c_str());
+    }
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    ConnectionProfile profile;
+
+    profile.journal_mode = "WAL";
+    profile.read_connections = 2;
+
+    // An in-memory database cannot be shared with other connections:
+    {
+        Database memory_database;
+
+        memory_database.openConnection(":memory:", profile, is_successful, outcome_message);
+        REQUIRE_FALSE(is_successful);
+    }
+
+    Database database;
+
+    database.openConnection(path, profile, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    ConnectionProfile effective_profile;
+
+    database.getConnectionProfile(effective_profile, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(effective_profile.read_connections == 2);
+
+    database.addVessel(Vessel(0, "Vessel", 100.0, 100.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addSailing(Sailing(0, 1, "AHS", 1, 10, 100.0, 100.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // Keep a group open, so that the reservation below is written but not committed:
+    GroupCommitSettings group_commit;
+
+    group_commit.max_operations = 100;
+    group_commit.max_delay_milliseconds = 60000;
+
+    database.setGroupCommit(group_commit, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    Sailing sailing(1, 1, "AHS", 1, 10, 100.0, 100.0);
+    Vehicle vehicle(0, "AAA-111", "5550000000", 5.0, 1.5);
+    Reservation reservation;
+
+    database.addVehicle(vehicle, vehicle.vehicle_id, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addReservation(sailing, vehicle, reservation, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(database.hasPendingWrites());
+
+    // The writing thread reads its own writes...
+    Vehicle found_vehicle;
+
+    database.getVehicleByID("AAA-111", found_vehicle, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // ...while another thread reads the last commit, without waiting on the open group:
+    auto read_report = [&database](SailingReport& sailing_report, bool& is_read)
+    {
+        std::string read_message = "";
+
+        database.getSailingReportByID(Sailing(1, 1, "AHS", 1, 10, 100.0, 100.0), sailing_report, is_read, read_message);
+    };
+
+    SailingReport sailing_report;
+    bool is_read = false;
+
+    std::thread(read_report, std::ref(sailing_report), std::ref(is_read)).join();
+
+    REQUIRE(is_read);
+    REQUIRE(sailing_report.vehicle_count == 0);
+
+    database.flushGroupCommit(is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    std::thread(read_report, std::ref(sailing_report), std::ref(is_read)).join();
+
+    REQUIRE(is_read);
+    REQUIRE(sailing_report.vehicle_count == 1);
+
+    // An open cursor reads one snapshot, even as the writes go on:
+    database.setGroupCommit(GroupCommitSettings(), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    int vessel_count = 0;
+
+    {
+        RowCursor<VesselView> cursor;
+
+        database.openVesselCursor(cursor, is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        // A cursor holds its read connection, so the database cannot be cut under it:
+        database.cutConnection(is_successful, outcome_message);
+        REQUIRE_FALSE(is_successful);
+
+        for(const VesselView& vessel : cursor)
+        {
+            REQUIRE(vessel.vessel_name == "Vessel");
+            REQUIRE(vessel.low_ceiling_lane_length == 100.0);
+
+            if(vessel_count == 0)
+            {
+                database.addVessel(Vessel(0, "Late Vessel", 100.0, 100.0), is_successful, outcome_message);
+                REQUIRE(is_successful);
+            }
+
+            ++vessel_count;
+        }
+
+        cursor.getOutcome(is_successful, outcome_message);
+        REQUIRE(is_successful);
+    }
+
+    REQUIRE(vessel_count == 1);
+
+    Vessel late_vessel;
+
+    database.getVesselByID(2, late_vessel, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(late_vessel.vessel_name == "Late Vessel");
+
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+}
+
+TEST_CASE("End-of-day report: partitions read in parallel add up to the whole report", "[Database]")
+{
+    const std::string path = "test_end_of_day_report.db";
+
+    for(const std::string& file : { path, path + "-wal", path + "-shm" })
+    {
+        std::remove(file.c_str());
+    }
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    ConnectionProfile profile;
+
+    profile.journal_mode = "WAL";
+    profile.read_connections = 2;
+
+    Database database;
+
+    database.openConnection(path, profile, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addVessel(Vessel(0, "Vessel", 100.0, 100.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // Three terminals over five days, with one car booked on every sailing and boarded on those of even days:
+    const std::vector<std::string> departure_terminals = { "AHS", "DPR", "SWB" };
+
+    int vehicle_number = 0;
+
+    for(int departure_day = 1; departure_day <= 5; ++departure_day)
+    {
+        for(const std::string& departure_terminal : departure_terminals)
+        {
+            Sailing sailing(0, 1, departure_terminal, departure_day, 10, 100.0, 100.0);
+
+            database.addSailing(sailing, is_successful, outcome_message);
+            REQUIRE(is_successful);
+
+            database.getSailingByID(departure_terminal, departure_day, 10, sailing, is_successful, outcome_message);
+            REQUIRE(is_successful);
+
+            Vehicle vehicle(0, "CAR-" + std::to_string(++vehicle_number), "5550000000", 5.0, 1.5);
+            Reservation reservation;
+
+            database.addVehicle(vehicle, vehicle.vehicle_id, is_successful, outcome_message);
+            REQUIRE(is_successful);
+
+            database.addReservation(sailing, vehicle, reservation, is_successful, outcome_message);
+            REQUIRE(is_successful);
+
+            if(departure_day % 2 == 0)
+            {
+                database.completeBoarding(sailing, vehicle, is_successful, outcome_message);
+                REQUIRE(is_successful);
+            }
+        }
+    }
+
+    auto build_report = [&database](ReportPartitioning partitioning, int worker_count, EndOfDayReport& report)
+    {
+        ReportSettings settings;
+
+        settings.partitioning = partitioning;
+        settings.worker_count = worker_count;
+
+        bool is_built = false;
+        std::string build_message = "";
+
+        ReportBuilder(&database, settings).build(report, is_built, build_message);
+        REQUIRE(is_built);
+    };
+
+    EndOfDayReport single_report;
+    EndOfDayReport terminal_report;
+    EndOfDayReport day_report;
+
+    build_report(ReportPartitioning::ByDayRange, 1, single_report);
+    build_report(ReportPartitioning::ByTerminal, 2, terminal_report);
+    build_report(ReportPartitioning::ByDayRange, 2, day_report);
+
+    REQUIRE(single_report.worker_count == 1);
+    REQUIRE(terminal_report.worker_count == 2);
+    REQUIRE(terminal_report.partitions.size() == 3);
+    REQUIRE(terminal_report.partitions[0].label == "AHS");
+
+    for(const EndOfDayReport* report : { &single_report, &terminal_report, &day_report })
+    {
+        REQUIRE(report->rows.size() == 15);
+        REQUIRE(report->total.sailing_count == 15);
+        REQUIRE(report->total.vehicle_count == 15);
+        REQUIRE(report->total.boarded_count == 6);
+        REQUIRE(report->total.revenue == 6 * 14.0);
+
+        // However it was partitioned, the report is in departure order:
+        for(std::size_t index = 0; index < report->rows.size(); ++index)
+        {
+            REQUIRE(report->rows[index].sailing_report.sailing.sailing_id == single_report.rows[index].sailing_report.sailing.sailing_id);
+        }
+    }
+
+    REQUIRE(single_report.rows[0].sailing_report.sailing.departure_terminal == "AHS");
+    REQUIRE(single_report.rows[1].sailing_report.sailing.departure_terminal == "DPR");
+    REQUIRE(single_report.rows[3].boarded_count == 1);
+    REQUIRE(single_report.rows[3].revenue == 14.0);
+
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+}
+
+TEST_CASE("Capacity engine: decides like the database and refuses stale decisions", "[Database]")
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(":memory:", is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addVessel(Vessel(0, "Vessel", 10.0, 20.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addSailing(Sailing(0, 1, "AHS", 1, 10, 10.0, 20.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    CapacityEngine capacity_engine;
+
+    capacity_engine.load(database, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(capacity_engine.getSailingCount() == 1);
+
+    Sailing sailing;
+
+    database.getSailingByID("AHS", 1, 10, sailing, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    Vehicle car(0, "AAA-111", "5550000000", 8.0, 1.5);
+    Vehicle truck(0, "BBB-222", "5550000000", 15.0, 3.0);
+
+    database.addVehicle(car, car.vehicle_id, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addVehicle(truck, truck.vehicle_id, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // A low vehicle goes in the low lane, a tall one in the high lane:
+    CapacityDecision car_decision;
+    CapacityDecision truck_decision;
+
+    capacity_engine.decide(sailing.sailing_id, car.length, car.height, car_decision, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(car_decision.fits);
+    REQUIRE(car_decision.is_low_lane);
+
+    capacity_engine.decide(sailing.sailing_id, truck.length, truck.height, truck_decision, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(truck_decision.fits);
+    REQUIRE_FALSE(truck_decision.is_low_lane);
+
+    // The first reservation changes the sailing, so the second decision was made on a stale snapshot:
+    Reservation reservation;
+
+    capacity_engine.reserve(database, car_decision, sailing, car, reservation, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(reservation.reserved_for_low_lane);
+    REQUIRE(sailing.low_remaining_length == 1.5);
+
+    capacity_engine.reserve(database, truck_decision, sailing, truck, reservation, is_successful, outcome_message);
+    REQUIRE_FALSE(is_successful);
+
+    // Deciding again on fresh numbers goes through, and the table follows what was committed:
+    capacity_engine.decide(sailing.sailing_id, truck.length, truck.height, truck_decision, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    capacity_engine.reserve(database, truck_decision, sailing, truck, reservation, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    capacity_engine.decide(sailing.sailing_id, 8.0, 1.5, car_decision, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE_FALSE(car_decision.fits);
+
+    // The search follows the reservations: only a short vehicle still fits, and only in the low lane:
+    std::vector<AvailableSailing> available_sailings;
+
+    capacity_engine.findAvailableSailings("AHS", 1, 0, 1.0, 1.5, 5, available_sailings, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(available_sailings.size() == 1);
+    REQUIRE(available_sailings[0].is_low_lane);
+
+    capacity_engine.findAvailableSailings("AHS", 1, 0, 5.0, 1.5, 5, available_sailings, is_successful, outcome_message);
+    REQUIRE_FALSE(is_successful);
+
+    // Unknown sailings are reported, removed ones are forgotten:
+    capacity_engine.decide(sailing.sailing_id + 1, 1.0, 1.0, car_decision, is_successful, outcome_message);
+    REQUIRE_FALSE(is_successful);
+
+    capacity_engine.forget(sailing.sailing_id);
+    REQUIRE(capacity_engine.getSailingCount() == 0);
+
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+}
+
+TEST_CASE("Importer: imports valid records in batches and reports the rest", "[Database]")
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(":memory:", is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    std::string records =
+        "# A season\n"
+        "vessel,Sea Owl,100,200\n"
+        "vessel,\"Sea Owl\",50,50\n"          // Name already taken
+        "vessel,Bad Lanes,100,5000\n"           // Lane too long
+        "\n"
+        "sailing,AHS-22-10,Sea Owl\n"
+        "sailing,AHS-22-11,No Such Vessel\n"    // Unknown vessel
+        "sailing,AHS-2-10,Sea Owl\n";           // Not TTT-dd-hh
+
+    // More vehicles than fit in one statement, so both the batch and the single row queries run:
+    const int vehicle_count = 2 * DatabaseQueries::c_import_batch_rows + 7;
+
+    for(int index = 0; index < vehicle_count; ++index)
+    {
+        records += "vehicle,P" + std::to_string(index) + ",5550000000,10,1.5\n";
+    }
+
+    records +=
+        "vehicle,P0,5550000000,10,1.5\n"       // Plate already taken
+        "vehicle,LONG-1,5550000000,500,1.5\n"  // Too long
+        "reservation,AHS-22-10,P0\n"
+        "reservation,AHS-22-10,P0\n"           // Already reserved
+        "reservation,AHS-22-10,NOPE\n"         // Unknown vehicle
+        "ferry,AHS-22-10\n";                   // Unknown kind
+
+    std::istringstream stream(records);
+    std::ostringstream report;
+
+    Importer importer(&database, report, ImportSettings());
+    ImportStatistics statistics;
+
+    importer.importStream(stream, statistics, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    REQUIRE(statistics.record_count == vehicle_count + 12);
+    REQUIRE(statistics.imported_count == vehicle_count + 3);
+    REQUIRE(statistics.rejected_count == 9);
+    REQUIRE(report.str().find("Line 3 rejected") != std::string::npos);
+
+    // What went in is the same as what the menus would have created:
+    Sailing sailing;
+
+    database.getSailingByID("AHS", 22, 10, sailing, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(sailing.low_remaining_length == 89.5);
+    REQUIRE(sailing.high_remaining_length == 200.0);
+
+    Vehicle vehicle;
+
+    database.getVehicleByID("P" + std::to_string(vehicle_count - 1), vehicle, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // The connection commits every write on its own again:
+    REQUIRE_FALSE(database.hasPendingWrites());
+}
+
+TEST_CASE("Importer: parsing on several threads gives the same result as one", "[Database]")
+{
+    const std::string path = "test_parallel_import.csv";
+
+    // Small chunks, so that many lines (and a quoted field) straddle chunk boundaries:
+    {
+        std::ofstream file(path, std::ios::binary);
+
+        file << "vessel,Sea Owl,1200,1200\n";
+
+        for(int day = 1; day <= 5; ++day)
+        {
+            file << "sailing,AHS-0" << day << "-10,\"Sea Owl\"\n";
+        }
+
+        for(int index = 0; index < 1500; ++index)
+        {
+            // Every 97th record is invalid, every 101st line is a comment:
+            file << (index % 101 == 0 ? "# comment\n" : "");
+            file << "vehicle,P" << index << ",5550000000," << (index % 97 == 0 ? "abc" : "5") << ",1.5\r\n";
+            file << "reservation,AHS-0" << (index % 5 + 1) << "-10,P" << index << "\n";
+        }
+
+        file << "vehicle,LAST,5550000000,5,1.5";
+    }
+
+    auto import = [&path](int parser_count, ImportStatistics& statistics, std::string& report)
+    {
+        bool is_successful = false;
+        std::string outcome_message = "";
+
+        Database database;
+
+        database.openConnection(":memory:", is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        ImportSettings settings;
+        settings.parser_count = parser_count;
+        settings.chunk_bytes = 512;
+
+        std::ostringstream report_stream;
+
+        Importer importer(&database, report_stream, settings);
+
+        importer.importFile(path, statistics, is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        Vehicle vehicle;
+
+        database.getVehicleByID("LAST", vehicle, is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        report = report_stream.str();
+    };
+
+    ImportStatistics sequential_statistics;
+    ImportStatistics parallel_statistics;
+    std::string sequential_report;
+    std::string parallel_report;
+
+    import(1, sequential_statistics, sequential_report);
+    import(4, parallel_statistics, parallel_report);
+
+    REQUIRE(parallel_statistics.line_count == sequential_statistics.line_count);
+    REQUIRE(parallel_statistics.record_count == sequential_statistics.record_count);
+    REQUIRE(parallel_statistics.imported_count == sequential_statistics.imported_count);
+    REQUIRE(parallel_statistics.rejected_count == sequential_statistics.rejected_count);
+    REQUIRE(parallel_statistics.rejected_count > 0);
+
+    // Rejections come out in file order, with the same line numbers:
+    REQUIRE(parallel_report == sequential_report);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Script runner: each command answers with one line and goes straight to the database", "[Database]")
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(":memory:", is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    std::istringstream script(
+        "# A sailing with one reservation and one walk-up\n"
+        "vessel \"Sea Owl\" 100 200\n"
+        "sailing AHS-22-10 1\n"
+        "\n"
+        "reserve AHS-22-10 A76-2H4 5551234567 5 1.5\n"
+        "reserve AHS-22-10 A76-2H4\n"                   // Already reserved
+        "board AHS-22-10 A76-2H4\n"
+        "board AHS-22-10 WALK-1 5551234567 8 2.5\n"     // Walk-up, too tall for the low lane
+        "cancel AHS-22-10 NOPE\n"                       // Unknown vehicle
+        "fly AHS-22-10\n"                               // Unknown command
+        "report AHS-22-10\n");
+
+    std::ostringstream output;
+    ScriptStatistics statistics;
+
+    {
+        ScriptRunner script_runner(&database, output);
+
+        script_runner.runStream(script, statistics, is_successful, outcome_message);
+    }
+
+    REQUIRE(is_successful);
+    REQUIRE(statistics.line_count == 11);
+    REQUIRE(statistics.command_count == 9);
+    REQUIRE(statistics.failed_count == 3);
+
+    std::istringstream answers(output.str());
+    std::vector<std::string> lines;
+
+    for(std::string line; std::getline(answers, line);)
+    {
+        lines.push_back(line);
+    }
+
+    REQUIRE(lines.size() == 10);
+    REQUIRE(lines[0] == "ok vessel \"Sea Owl\"");
+    REQUIRE(lines[2] == "ok reserve AHS-22-10 A76-2H4 low");
+    REQUIRE(lines[3].rfind("error line 6: ", 0) == 0);
+    REQUIRE(lines[4] == "ok board AHS-22-10 A76-2H4");
+    REQUIRE(lines[5] == "ok board AHS-22-10 WALK-1");
+    REQUIRE(lines[6].rfind("error line 9: ", 0) == 0);
+    REQUIRE(lines[7].rfind("error line 10: unknown command", 0) == 0);
+    REQUIRE(lines[8].rfind("AHS-22-10 \"Sea Owl\" 2 ", 0) == 0);
+    REQUIRE(lines[8].find(" 94.5 191.5") != std::string::npos);
+    REQUIRE(lines[9] == "ok report 1");
+
+    // The walk-up vehicle was created along the way:
+    Vehicle vehicle;
+
+    database.getVehicleByID("WALK-1", vehicle, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(vehicle.height == 2.5);
+}
+
+TEST_CASE("Script runner: answers are only written once their writes are committed", "[Database]")
+{
+    const std::string path = "test_script_group_commit.db";
+
+    std::remove(path.c_str());
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(path, ConnectionProfile(), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // One group for the whole script, so only the output buffer filling up ends it early:
+    GroupCommitSettings settings;
+    settings.max_operations = 1000000;
+    settings.max_delay_milliseconds = 600000;
+
+    database.setGroupCommit(settings, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    sqlite3* observer = nullptr;
+
+    REQUIRE(sqlite3_open(path.c_str(), &observer) == SQLITE_OK);
+
+    // Each time the answers are written, every vessel they report must already be committed:
+    struct CommittedOutput : public std::stringbuf
+    {
+        sqlite3* observer = nullptr;
+        int flush_count = 0;
+        bool is_consistent = true;
+
+        int sync() override
+        {
+            std::string written = str();
+            long long answered_count = 0;
+
+            for(std::size_t position = written.find("ok vessel"); position != std::string::npos; position = written.find("ok vessel", position + 1))
+            {
+                ++answered_count;
+            }
+
+            is_consistent = is_consistent && queryNumber(observer, "SELECT COUNT(*) FROM vessels;") == static_cast<double>(answered_count);
+            ++flush_count;
+
+            return(0);
+        }
+    };
+
+    CommittedOutput output_buffer;
+    output_buffer.observer = observer;
+
+    std::ostream output(&output_buffer);
+
+    std::string script_text;
+
+    for(int index = 0; index < 10000; ++index)
+    {
+        script_text += "vessel V" + std::to_string(index) + " 10 10\n";
+    }
+
+    std::istringstream script(script_text);
+    ScriptStatistics statistics;
+
+    {
+        ScriptRunner script_runner(&database, output);
+
+        script_runner.runStream(script, statistics, is_successful, outcome_message);
+    }
+
+    REQUIRE(is_successful);
+    REQUIRE(statistics.failed_count == 0);
+    REQUIRE(output_buffer.flush_count >= 2);
+    REQUIRE(output_buffer.is_consistent);
+    REQUIRE(queryNumber(observer, "SELECT COUNT(*) FROM vessels;") == 10000);
+
+    sqlite3_close(observer);
+
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    std::remove(path.c_str());
+}
+
@@ -0,0 +1,125 @@
+#include <catch2/catch_all.hpp>
+#include <string>
+#include <vector>
+#include "database.hpp"
+#include "entity_cache.hpp"
+
+TEST_CASE("Entity cache: lookups are served from memory until a write changes them", "[EntityCache]")
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(":memory:", is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addVessel(Vessel(0, "Vessel", 100.0, 100.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addSailing(Sailing(0, 1, "AHS", 3, 10, 100.0, 100.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    for(const char* license_plate : { "CAR-1", "CAR-2", "CAR-3" })
+    {
+        int vehicle_id = 0;
+
+        database.addVehicle(Vehicle(0, license_plate, "5550000000", 5.0, 1.5), vehicle_id, is_successful, outcome_message);
+        REQUIRE(is_successful);
+    }
+
+    EntityCacheSettings settings;
+
+    settings.vehicle_capacity = 2;
+    settings.sailing_capacity = 2;
+    settings.vessel_capacity = 4;
+
+    EntityCache entity_cache(settings);
+
+    database.setEntityCache(&entity_cache, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    EntityCacheStatistics statistics;
+
+    // Vehicles: the first lookup reads the database, the second does not, and the least recently used one is dropped for a third:
+    Vehicle vehicle;
+
+    database.getVehicleByID("CAR-1", vehicle, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.getVehicleByID("CAR-1", vehicle, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(vehicle.license_plate == "CAR-1");
+
+    database.getVehicleByID("CAR-2", vehicle, is_successful, outcome_message);
+    database.getVehicleByID("CAR-3", vehicle, is_successful, outcome_message);
+    database.getVehicleByID("CAR-1", vehicle, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    entity_cache.getStatistics(statistics);
+    REQUIRE(statistics.vehicle_hits == 1);
+    REQUIRE(statistics.vehicle_misses == 4);
+    REQUIRE(statistics.eviction_count == 2);
+
+    // Sailings: a reservation puts the sailing back with its new remaining lengths once committed:
+    Sailing sailing;
+
+    database.getSailingByID("AHS", 3, 10, sailing, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    Reservation reservation;
+
+    database.addReservation(sailing, vehicle, reservation, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    Sailing cached_sailing;
+
+    database.getSailingByID("AHS", 3, 10, cached_sailing, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(cached_sailing.low_remaining_length == sailing.low_remaining_length);
+    REQUIRE(cached_sailing.high_remaining_length == sailing.high_remaining_length);
+    REQUIRE(cached_sailing.low_remaining_length < 100.0);
+
+    entity_cache.getStatistics(statistics);
+    REQUIRE(statistics.sailing_hits == 1);
+    REQUIRE(statistics.sailing_misses == 1);
+
+    // ...and removing it leaves nothing behind to be found:
+    database.removeSailing(cached_sailing, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.getSailingByID("AHS", 3, 10, cached_sailing, is_successful, outcome_message);
+    REQUIRE_FALSE(is_successful);
+
+    // Vessels: the catalog is loaded once, answers for vessels that do not exist, and is dropped when a vessel is added:
+    Vessel vessel;
+
+    database.getVesselByID(1, vessel, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(vessel.vessel_name == "Vessel");
+
+    database.getVesselByID(2, vessel, is_successful, outcome_message);
+    REQUIRE_FALSE(is_successful);
+
+    database.addVessel(Vessel(0, "Second Vessel", 80.0, 80.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    PageCursor cursor;
+    std::vector<Vessel> vessels;
+
+    database.getVessels(10, PageDirection::First, cursor, vessels, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(vessels.size() == 2);
+    REQUIRE(vessels[1].vessel_name == "Second Vessel");
+
+    entity_cache.getStatistics(statistics);
+    REQUIRE(statistics.vessel_hits == 1);
+    REQUIRE(statistics.vessel_misses == 2);
+    REQUIRE(statistics.invalidation_count >= 3);
+
+    database.setEntityCache(nullptr, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+}
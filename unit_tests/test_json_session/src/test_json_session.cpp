@@ -0,0 +1,152 @@
+#include <catch2/catch_all.hpp>
+#include <sqlite3.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "database.hpp"
+#include "json_session.hpp"
+
+// Returns the first column of the first row of a query as a number.
+static double queryNumber(
+    sqlite3* sqlite,
+    const std::string& sql_query
+    )
+{
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    REQUIRE(sqlite3_prepare_v2(sqlite, sql_query.c_str(), -1, &prepared_sql_statement, nullptr) == SQLITE_OK);
+    REQUIRE(sqlite3_step(prepared_sql_statement) == SQLITE_ROW);
+
+    double number = sqlite3_column_double(prepared_sql_statement, 0);
+
+    sqlite3_finalize(prepared_sql_statement);
+
+    return(number);
+}
+
+TEST_CASE("JSON session: one response line per request, in order", "[JsonSession]")
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(":memory:", is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    std::istringstream requests(
+        R"({"id": 1, "op": "addVessel", "vessel_name": "Sea Owl", "low_ceiling_lane_length": 100, "high_ceiling_lane_length": 200})" "\n"
+        R"({"id": "two", "op": "addSailing", "sailing_id": "AHS-22-10", "vessel_id": 1})" "\n"
+        "\n"
+        R"({"id": 3, "op": "addReservation", "sailing_id": "AHS-22-10", "license_plate": "A76-2H4", "phone_number": "5551234567", "length": 5, "height": 1.5})" "\n"
+        R"({"id": 4, "op": "completeBoarding", "sailing_id": "AHS-22-10", "license_plate": "A76-2H4"})" "\n"
+        R"({"id": 5, "op": "getSailingReports"})" "\n"
+        R"({"id": 6, "op": "removeSailing", "sailing_id": "XYZ-01-01"})" "\n"
+        R"({"id": 7, "op": "getVessels", "oops": [1]})" "\n"
+        R"({"id": 8, "op": "addVessel", "vessel_name": "Tab\tName", "low_ceiling_lane_length": 1, "high_ceiling_lane_length": 1})" "\n");
+
+    std::ostringstream responses;
+    JsonSessionStatistics statistics;
+
+    {
+        JsonSession json_session(&database);
+
+        json_session.run(requests, responses, statistics, is_successful, outcome_message);
+    }
+
+    REQUIRE(is_successful);
+    REQUIRE(statistics.request_count == 8);
+    REQUIRE(statistics.failed_count == 3);
+
+    std::istringstream lines(responses.str());
+    std::vector<std::string> response_lines;
+
+    for(std::string line; std::getline(lines, line);)
+    {
+        response_lines.push_back(line);
+    }
+
+    REQUIRE(response_lines.size() == 8);
+    REQUIRE(response_lines[0] == R"({"id":1,"ok":true})");
+    REQUIRE(response_lines[1] == R"({"id":"two","ok":true})");
+    REQUIRE(response_lines[2] == R"({"id":3,"ok":true,"reserved_for_low_lane":true,"low_remaining_length":94.5,"high_remaining_length":200})");
+    REQUIRE(response_lines[3] == R"({"id":4,"ok":true})");
+    REQUIRE(response_lines[4].rfind(R"({"id":5,"ok":true,"sailing_reports":[{"sailing_id":"AHS-22-10","vessel_name":"Sea Owl","vehicle_count":1,)", 0) == 0);
+    REQUIRE(response_lines[4].find(R"("low_remaining_length":94.5,"high_remaining_length":200}]})") != std::string::npos);
+    REQUIRE(response_lines[5].rfind(R"({"id":6,"ok":false,"error":)", 0) == 0);
+
+    // A request that is not a flat object has no readable "id":
+    REQUIRE(response_lines[6].rfind(R"({"ok":false,"error":"nested objects and arrays are not supported)", 0) == 0);
+
+    // Escapes are read, and written back where an error quotes them:
+    REQUIRE(response_lines[7] == R"({"id":8,"ok":false,"error":"invalid vessel name 'Tab\tName'."})");
+}
+
+TEST_CASE("JSON session: a group that cannot be committed is answered with an error line and fails the session", "[JsonSession]")
+{
+    const std::string path = "test_json_group_commit.db";
+
+    std::remove(path.c_str());
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(path, ConnectionProfile(), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    GroupCommitSettings settings;
+    settings.max_operations = 1000;
+    settings.max_delay_milliseconds = 600000;
+
+    database.setGroupCommit(settings, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // A reader that stays in its transaction keeps the group from being committed (with no busy timeout, and no WAL):
+    sqlite3* observer = nullptr;
+
+    REQUIRE(sqlite3_open(path.c_str(), &observer) == SQLITE_OK);
+    REQUIRE(sqlite3_exec(observer, "BEGIN; SELECT COUNT(*) FROM vessels;", nullptr, nullptr, nullptr) == SQLITE_OK);
+
+    std::istringstream requests(
+        R"({"id": 1, "op": "addVessel", "vessel_name": "First", "low_ceiling_lane_length": 100, "high_ceiling_lane_length": 200})" "\n"
+        R"({"id": 2, "op": "addVessel", "vessel_name": "Second", "low_ceiling_lane_length": 100, "high_ceiling_lane_length": 200})" "\n");
+
+    std::ostringstream responses;
+    JsonSessionStatistics statistics;
+
+    {
+        JsonSession json_session(&database);
+
+        json_session.run(requests, responses, statistics, is_successful, outcome_message);
+    }
+
+    REQUIRE_FALSE(is_successful);
+    REQUIRE(outcome_message.find("Group commit failed") != std::string::npos);
+
+    std::istringstream lines(responses.str());
+    std::vector<std::string> response_lines;
+
+    for(std::string line; std::getline(lines, line);)
+    {
+        response_lines.push_back(line);
+    }
+
+    // The "ok" given to both requests is taken back by the error line that follows them:
+    REQUIRE(response_lines.size() == 3);
+    REQUIRE(response_lines[0] == R"({"id":1,"ok":true})");
+    REQUIRE(response_lines[1] == R"({"id":2,"ok":true})");
+    REQUIRE(response_lines[2].rfind(R"({"ok":false,"error":"Group commit failed)", 0) == 0);
+
+    REQUIRE(sqlite3_exec(observer, "COMMIT;", nullptr, nullptr, nullptr) == SQLITE_OK);
+    REQUIRE(queryNumber(observer, "SELECT COUNT(*) FROM vessels;") == 0);
+
+    sqlite3_close(observer);
+
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    std::remove(path.c_str());
+}
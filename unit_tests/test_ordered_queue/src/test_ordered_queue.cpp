@@ -0,0 +1,62 @@
+#include <catch2/catch_all.hpp>
+#include <thread>
+#include "ordered_queue.hpp"
+
+TEST_CASE("Ordered queue: items pushed out of order are popped in order", "[OrderedQueue]")
+{
+    OrderedQueue<int> queue(4);
+
+    const int item_count = 1000;
+
+    // Two producers, one taking the even items and the other the odd ones. NOTE (SAVIZ): Catch2 assertions are only made on the main thread.
+    bool is_pushed[2] = { true, true };
+
+    auto produce = [&queue, &is_pushed](int first)
+    {
+        for(int sequence = first; sequence < item_count; sequence += 2)
+        {
+            int item = sequence * 10;
+
+            is_pushed[first] = queue.push(sequence, std::move(item)) && is_pushed[first];
+        }
+    };
+
+    std::thread even_producer(produce, 0);
+    std::thread odd_producer(produce, 1);
+
+    for(int sequence = 0; sequence < item_count; ++sequence)
+    {
+        int item = -1;
+
+        REQUIRE(queue.pop(sequence, item));
+        REQUIRE(item == sequence * 10);
+    }
+
+    even_producer.join();
+    odd_producer.join();
+
+    REQUIRE(is_pushed[0]);
+    REQUIRE(is_pushed[1]);
+
+    // Closing wakes a producer that is waiting for room:
+    for(int sequence = item_count; sequence < item_count + 4; ++sequence)
+    {
+        int item = sequence;
+
+        REQUIRE(queue.push(sequence, std::move(item)));
+    }
+
+    bool is_blocked_push_accepted = true;
+
+    std::thread blocked_producer([&queue, &is_blocked_push_accepted]()
+    {
+        int item = 0;
+
+        is_blocked_push_accepted = queue.push(item_count + 4, std::move(item));
+    });
+
+    queue.close();
+    blocked_producer.join();
+
+    REQUIRE_FALSE(is_blocked_push_accepted);
+}
@@ -0,0 +1,176 @@
+#include <catch2/catch_all.hpp>
+#include <sqlite3.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "database.hpp"
+#include "packed_key.hpp"
+#include "database_queries.hpp"
+
+// Returns the first column of the first row of a query as a number.
+static double queryNumber(
+    sqlite3* sqlite,
+    const std::string& sql_query
+    )
+{
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    REQUIRE(sqlite3_prepare_v2(sqlite, sql_query.c_str(), -1, &prepared_sql_statement, nullptr) == SQLITE_OK);
+    REQUIRE(sqlite3_step(prepared_sql_statement) == SQLITE_ROW);
+
+    double number = sqlite3_column_double(prepared_sql_statement, 0);
+
+    sqlite3_finalize(prepared_sql_statement);
+
+    return(number);
+}
+
+TEST_CASE("Packed key: plates pack into integers that keep their order, like the key the database computes", "[PackedKey]")
+{
+    static_assert(PackedKey::c_license_plate_base == 39);
+
+    std::int64_t key = 0;
+
+    REQUIRE(PackedKey::packLicensePlate("ABC-123", key));
+    REQUIRE(PackedKey::unpackLicensePlate(key) == "ABC-123");
+
+    REQUIRE(PackedKey::packLicensePlate("ZZZZZZZZZZ", key));
+    REQUIRE(PackedKey::unpackLicensePlate(key) == "ZZZZZZZZZZ");
+
+    for(const char* license_plate : { "", "abc", "TOO-LONG-123", "A.B" })
+    {
+        REQUIRE_FALSE(PackedKey::packLicensePlate(license_plate, key));
+    }
+
+    REQUIRE(PackedKey::unpackLicensePlate(0).empty());
+    REQUIRE(PackedKey::unpackLicensePlate(-1).empty());
+
+    // Every symbol in every position, with keys in the same order as the text:
+    std::vector<std::string> license_plates;
+
+    for(std::size_t index = 0; index < 400; ++index)
+    {
+        std::string license_plate;
+
+        for(std::size_t position = 0; position <= index % PackedKey::c_license_plate_max_length; ++position)
+        {
+            license_plate += PackedKey::c_license_plate_symbols[(index * 7 + position * 13) % PackedKey::c_license_plate_symbols.size()];
+        }
+
+        license_plates.push_back(license_plate);
+    }
+
+    std::sort(license_plates.begin(), license_plates.end());
+    license_plates.erase(std::unique(license_plates.begin(), license_plates.end()), license_plates.end());
+
+    std::int64_t previous_key = -1;
+
+    for(const std::string& license_plate : license_plates)
+    {
+        REQUIRE(PackedKey::packLicensePlate(license_plate, key));
+        REQUIRE(PackedKey::unpackLicensePlate(key) == license_plate);
+        REQUIRE(key > previous_key);
+
+        previous_key = key;
+    }
+
+    // An older database (schema version 1) with vehicles and reservations, migrated with foreign keys on:
+    const std::string path = "test_packed_key.db";
+
+    std::remove(path.c_str());
+
+    sqlite3* sqlite = nullptr;
+
+    REQUIRE(sqlite3_open(path.c_str(), &sqlite) == SQLITE_OK);
+    REQUIRE(sqlite3_exec(sqlite, DatabaseQueries::c_create_schema, nullptr, nullptr, nullptr) == SQLITE_OK);
+    REQUIRE(sqlite3_exec(sqlite, DatabaseQueries::c_schema_migrations[0], nullptr, nullptr, nullptr) == SQLITE_OK);
+
+    std::string seed = "PRAGMA user_version = 1; BEGIN;";
+
+    seed += "INSERT INTO vessels (vessel_name, low_ceiling_lane_length, high_ceiling_lane_length) VALUES ('Vessel', 1000, 1000);";
+    seed += "INSERT INTO sailings (vessel_id_fk, departure_terminal, departure_day, departure_hour, low_remaining_length, high_remaining_length) VALUES (1, 'AHS', 3, 10, 1000, 1000);";
+
+    for(const std::string& license_plate : license_plates)
+    {
+        seed += "INSERT INTO vehicles (license_plate, phone_number, length, height) VALUES ('" + license_plate + "', '5550000000', 5, 1.5);";
+        seed += "INSERT INTO reservations (sailing_id_fk, vehicle_id_fk, amount_paid, reserved_for_low_lane) VALUES (1, last_insert_rowid(), 0, 1);";
+    }
+
+    seed += "COMMIT;";
+
+    REQUIRE(sqlite3_exec(sqlite, seed.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK);
+
+    sqlite3_close(sqlite);
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    ConnectionProfile profile;
+
+    profile.foreign_keys = true;
+
+    {
+        Database database;
+
+        database.openConnection(path, profile, is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        Vehicle vehicle;
+
+        for(std::size_t index = 0; index < license_plates.size(); ++index)
+        {
+            database.getVehicleByID(license_plates[index], vehicle, is_successful, outcome_message);
+            REQUIRE(is_successful);
+            REQUIRE(vehicle.vehicle_id == static_cast<int>(index) + 1);
+            REQUIRE(vehicle.license_plate == license_plates[index]);
+        }
+
+        std::vector<ManifestEntry> entries;
+
+        database.getSailingManifest(1, entries, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(entries.size() == license_plates.size());
+
+        // The packed key is what keeps plates unique now, and new vehicles do not reuse an ID:
+        int vehicle_id = 0;
+
+        database.addVehicle(Vehicle(0, license_plates.front(), "5550000000", 5.0, 1.5), vehicle_id, is_successful, outcome_message);
+        REQUIRE_FALSE(is_successful);
+
+        database.addVehicle(Vehicle(0, "lowercase", "5550000000", 5.0, 1.5), vehicle_id, is_successful, outcome_message);
+        REQUIRE_FALSE(is_successful);
+
+        database.addVehicle(Vehicle(0, "NEW-1", "5550000000", 5.0, 1.5), vehicle_id, is_successful, outcome_message);
+        REQUIRE(is_successful);
+        REQUIRE(vehicle_id == static_cast<int>(license_plates.size()) + 1);
+
+        database.cutConnection(is_successful, outcome_message);
+        REQUIRE(is_successful);
+    }
+
+    // The key computed in SQL is the one computed here:
+    REQUIRE(sqlite3_open(path.c_str(), &sqlite) == SQLITE_OK);
+
+    REQUIRE(queryNumber(sqlite, "PRAGMA user_version;") == DatabaseQueries::c_schema_version);
+    REQUIRE(queryNumber(sqlite, "SELECT COUNT(*) FROM pragma_foreign_key_check;") == 0);
+
+    for(const std::string& license_plate : license_plates)
+    {
+        REQUIRE(PackedKey::packLicensePlate(license_plate, key));
+
+        sqlite3_stmt* prepared_sql_statement = nullptr;
+
+        REQUIRE(sqlite3_prepare_v2(sqlite, "SELECT license_plate_key FROM vehicles WHERE license_plate = ?;", -1, &prepared_sql_statement, nullptr) == SQLITE_OK);
+        sqlite3_bind_text(prepared_sql_statement, 1, license_plate.c_str(), -1, SQLITE_TRANSIENT);
+        REQUIRE(sqlite3_step(prepared_sql_statement) == SQLITE_ROW);
+        REQUIRE(sqlite3_column_int64(prepared_sql_statement, 0) == key);
+
+        sqlite3_finalize(prepared_sql_statement);
+    }
+
+    sqlite3_close(sqlite);
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch_all.hpp>
+#include <cstdio>
+#include <string>
+#include "database.hpp"
+#include "plate_filter.hpp"
+
+TEST_CASE("Plate filter: unknown plates are ruled out without a query, and known ones never are", "[PlateFilter]")
+{
+    const std::string path = "test_plate_filter.plates";
+
+    std::remove(path.c_str());
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(":memory:", is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    for(int index = 0; index < 500; ++index)
+    {
+        int vehicle_id = 0;
+
+        database.addVehicle(Vehicle(0, "KNOWN-" + std::to_string(index), "5550000000", 5.0, 1.5), vehicle_id, is_successful, outcome_message);
+        REQUIRE(is_successful);
+    }
+
+    // No saved filter yet, so it is built from the table:
+    PlateFilter plate_filter;
+
+    plate_filter.load(database, path, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(outcome_message.find("built") != std::string::npos);
+
+    database.setPlateFilter(&plate_filter, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    Vehicle vehicle;
+
+    for(int index = 0; index < 500; ++index)
+    {
+        database.getVehicleByID("KNOWN-" + std::to_string(index), vehicle, is_successful, outcome_message);
+        REQUIRE(is_successful);
+    }
+
+    for(int index = 0; index < 1000; ++index)
+    {
+        database.getVehicleByID("WALKUP-" + std::to_string(index), vehicle, is_successful, outcome_message);
+        REQUIRE_FALSE(is_successful);
+    }
+
+    PlateFilterStatistics statistics;
+
+    plate_filter.getStatistics(statistics);
+    REQUIRE(statistics.plate_count == 500);
+    REQUIRE(statistics.found_count == 500);
+    REQUIRE(statistics.ruled_out_count + statistics.false_positive_count == 1000);
+    REQUIRE(statistics.getFalsePositiveRate() < 0.05);
+    REQUIRE(statistics.estimated_false_positive_rate < 0.05);
+
+    // A vehicle created through the database joins the filter:
+    int vehicle_id = 0;
+
+    database.addVehicle(Vehicle(0, "WALKUP-0", "5550000000", 5.0, 1.5), vehicle_id, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.getVehicleByID("WALKUP-0", vehicle, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // Saved and loaded again, only the vehicles created since it was built are read (the walk-up above, and one made without the filter):
+    plate_filter.save(path, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.setPlateFilter(nullptr, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addVehicle(Vehicle(0, "LATE-1", "5550000000", 5.0, 1.5), vehicle_id, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // The filter was not told about that vehicle (as if another process had made it), but reads it before ruling the plate out:
+    REQUIRE_FALSE(plate_filter.mayContain("LATE-1"));
+
+    database.setPlateFilter(&plate_filter, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.getVehicleByID("LATE-1", vehicle, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(plate_filter.mayContain("LATE-1"));
+
+    database.setPlateFilter(nullptr, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    PlateFilter loaded_plate_filter;
+
+    loaded_plate_filter.load(database, path, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(outcome_message.find("2 read from the database") != std::string::npos);
+
+    for(const char* license_plate : { "KNOWN-0", "KNOWN-499", "WALKUP-0", "LATE-1" })
+    {
+        REQUIRE(loaded_plate_filter.mayContain(license_plate));
+    }
+
+    // A filter saved for another database is not used:
+    Database other_database;
+
+    other_database.openConnection(":memory:", is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    other_database.addVehicle(Vehicle(0, "OTHER-1", "5550000000", 5.0, 1.5), vehicle_id, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    PlateFilter other_plate_filter;
+
+    other_plate_filter.load(other_database, path, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(outcome_message.find("another database") != std::string::npos);
+    REQUIRE(other_plate_filter.mayContain("OTHER-1"));
+
+    other_plate_filter.getStatistics(statistics);
+    REQUIRE(statistics.plate_count == 1);
+
+    std::remove(path.c_str());
+}
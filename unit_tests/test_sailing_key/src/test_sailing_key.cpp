@@ -0,0 +1,176 @@
+#include <catch2/catch_all.hpp>
+#include <sqlite3.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <unordered_set>
+#include <string>
+#include <vector>
+#include "database.hpp"
+#include "sailing_key.hpp"
+#include "utilities.hpp"
+
+// Returns the first column of the first row of a query as a number.
+static double queryNumber(
+    sqlite3* sqlite,
+    const std::string& sql_query
+    )
+{
+    sqlite3_stmt* prepared_sql_statement = nullptr;
+
+    REQUIRE(sqlite3_prepare_v2(sqlite, sql_query.c_str(), -1, &prepared_sql_statement, nullptr) == SQLITE_OK);
+    REQUIRE(sqlite3_step(prepared_sql_statement) == SQLITE_ROW);
+
+    double number = sqlite3_column_double(prepared_sql_statement, 0);
+
+    sqlite3_finalize(prepared_sql_statement);
+
+    return(number);
+}
+
+TEST_CASE("Sailing key: sailing IDs pack into integers that keep their order, like the key the database computes", "[SailingKey]")
+{
+    static_assert(sizeof(SailingKey) == sizeof(std::uint32_t));
+
+    SailingKey sailing_key;
+
+    REQUIRE(sailing_key.isEmpty());
+
+    REQUIRE(SailingKey::parse("AHS-22-10", sailing_key));
+    REQUIRE(sailing_key.toString() == "AHS-22-10");
+    REQUIRE(sailing_key.getTerminal() == "AHS");
+    REQUIRE(sailing_key.getDepartureDay() == 22);
+    REQUIRE(sailing_key.getDepartureHour() == 10);
+
+    for(const char* sailing_id : { "", "AHS-22-1", "AHS-22-100", "ahs-22-10", "AH1-22-10", "AHS_22_10", "AHS-2x-10", "AHS--2-10" })
+    {
+        REQUIRE_FALSE(SailingKey::parse(sailing_id, sailing_key));
+    }
+
+    REQUIRE_FALSE(SailingKey::create("AHSX", 1, 1, sailing_key));
+    REQUIRE_FALSE(SailingKey::create("AHS", 100, 1, sailing_key));
+    REQUIRE_FALSE(SailingKey::create("AHS", 1, -1, sailing_key));
+
+    // Formatting goes through the key, and falls back to padding by hand for what does not pack:
+    std::string sailing_id;
+
+    Utilities::createSailingID("WWW", 1, 0, sailing_id);
+    REQUIRE(sailing_id == "WWW-01-00");
+
+    Utilities::createSailingID("T0", 3, 12, sailing_id);
+    REQUIRE(sailing_id == "T0-03-12");
+
+    // Every letter in every position, with keys in the same order as the text (and as distinct for hashing):
+    std::vector<std::string> sailing_ids;
+
+    for(int index = 0; index < 400; ++index)
+    {
+        std::string terminal = { static_cast<char>('A' + index % 26), static_cast<char>('A' + (index * 7) % 26), static_cast<char>('A' + (index * 11) % 26) };
+
+        Utilities::createSailingID(terminal, (index * 13) % 100, (index * 17) % 100, sailing_id);
+        sailing_ids.push_back(sailing_id);
+    }
+
+    std::sort(sailing_ids.begin(), sailing_ids.end());
+    sailing_ids.erase(std::unique(sailing_ids.begin(), sailing_ids.end()), sailing_ids.end());
+
+    SailingKey previous_key;
+    std::unordered_set<SailingKey> keys;
+
+    for(const std::string& text : sailing_ids)
+    {
+        REQUIRE(SailingKey::parse(text, sailing_key));
+        REQUIRE(sailing_key.toString() == text);
+        REQUIRE(sailing_key > previous_key);
+
+        keys.insert(sailing_key);
+        previous_key = sailing_key;
+    }
+
+    REQUIRE(keys.size() == sailing_ids.size());
+
+    // Sailings created and looked up through the key, beside one written outside the program:
+    const std::string path = "test_sailing_key.db";
+
+    std::remove(path.c_str());
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    {
+        Database database;
+
+        database.openConnection(path, is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        database.addVessel(Vessel(0, "Vessel", 100.0, 100.0), is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        for(const std::string& text : sailing_ids)
+        {
+            REQUIRE(SailingKey::parse(text, sailing_key));
+
+            database.addSailing(Sailing(0, 1, sailing_key.getTerminal(), sailing_key.getDepartureDay(), sailing_key.getDepartureHour(), 100.0, 100.0), is_successful, outcome_message);
+            REQUIRE(is_successful);
+        }
+
+        database.addSailing(Sailing(0, 1, "ahs", 1, 10, 100.0, 100.0), is_successful, outcome_message);
+        REQUIRE_FALSE(is_successful);
+
+        Sailing sailing;
+
+        for(const std::string& text : sailing_ids)
+        {
+            REQUIRE(SailingKey::parse(text, sailing_key));
+
+            database.getSailingByID(sailing_key, sailing, is_successful, outcome_message);
+            REQUIRE(is_successful);
+            REQUIRE(sailing.departure_terminal == sailing_key.getTerminal());
+            REQUIRE(sailing.departure_day == sailing_key.getDepartureDay());
+            REQUIRE(sailing.departure_hour == sailing_key.getDepartureHour());
+
+            SailingReport sailing_report;
+
+            database.getSailingReportByID(sailing, sailing_report, is_successful, outcome_message);
+            REQUIRE(is_successful);
+            REQUIRE(sailing_report.vessel.vessel_name == "Vessel");
+        }
+
+        database.getSailingByID(SailingKey(), sailing, is_successful, outcome_message);
+        REQUIRE_FALSE(is_successful);
+
+        database.getSailingByID("T0", 1, 10, sailing, is_successful, outcome_message);
+        REQUIRE_FALSE(is_successful);
+
+        database.cutConnection(is_successful, outcome_message);
+        REQUIRE(is_successful);
+    }
+
+    // The key computed in SQL is the one computed here (and NULL for what does not pack):
+    sqlite3* sqlite = nullptr;
+
+    REQUIRE(sqlite3_open(path.c_str(), &sqlite) == SQLITE_OK);
+    REQUIRE(sqlite3_exec(sqlite, "INSERT INTO sailings (vessel_id_fk, departure_terminal, departure_day, departure_hour, low_remaining_length, high_remaining_length) VALUES (1, 'T0', 1, 10, 100, 100);", nullptr, nullptr, nullptr) == SQLITE_OK);
+
+    REQUIRE(queryNumber(sqlite, "SELECT COUNT(*) FROM sailings WHERE sailing_key IS NULL;") == 1);
+
+    for(const std::string& text : sailing_ids)
+    {
+        REQUIRE(SailingKey::parse(text, sailing_key));
+
+        sqlite3_stmt* prepared_sql_statement = nullptr;
+
+        REQUIRE(sqlite3_prepare_v2(sqlite, "SELECT sailing_key FROM sailings WHERE departure_terminal = ? AND departure_day = ? AND departure_hour = ?;", -1, &prepared_sql_statement, nullptr) == SQLITE_OK);
+        sqlite3_bind_text(prepared_sql_statement, 1, sailing_key.getTerminal().c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(prepared_sql_statement, 2, sailing_key.getDepartureDay());
+        sqlite3_bind_int(prepared_sql_statement, 3, sailing_key.getDepartureHour());
+        REQUIRE(sqlite3_step(prepared_sql_statement) == SQLITE_ROW);
+        REQUIRE(sqlite3_column_int64(prepared_sql_statement, 0) == static_cast<sqlite3_int64>(sailing_key.getValue()));
+
+        sqlite3_finalize(prepared_sql_statement);
+    }
+
+    sqlite3_close(sqlite);
+
+    std::remove(path.c_str());
+}
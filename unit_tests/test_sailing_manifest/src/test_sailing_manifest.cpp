@@ -0,0 +1,81 @@
+#include <catch2/catch_all.hpp>
+#include <string>
+#include <vector>
+#include "database.hpp"
+#include "sailing_manifest.hpp"
+
+TEST_CASE("Sailing manifest: every reservation is found by plate without a query", "[SailingManifest]")
+{
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    Database database;
+
+    database.openConnection(":memory:", is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addVessel(Vessel(0, "Vessel", 1000.0, 1000.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    database.addSailing(Sailing(0, 1, "AHS", 3, 10, 1000.0, 1000.0), is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    Sailing sailing;
+
+    database.getSailingByID("AHS", 3, 10, sailing, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    // More reservations than the first 16 slots hold, so the table grows while loading:
+    std::vector<Vehicle> vehicles;
+
+    for(int index = 0; index < 40; ++index)
+    {
+        Vehicle vehicle(0, "CAR-" + std::to_string(index), "5550000000", 5.0, 1.5);
+        Reservation reservation;
+
+        database.addVehicle(vehicle, vehicle.vehicle_id, is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        database.addReservation(sailing, vehicle, reservation, is_successful, outcome_message);
+        REQUIRE(is_successful);
+
+        vehicles.push_back(vehicle);
+    }
+
+    database.completeBoarding(sailing, vehicles[7], is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    SailingManifest manifest;
+
+    manifest.load(database, sailing, is_successful, outcome_message);
+    REQUIRE(is_successful);
+    REQUIRE(manifest.getSailingID() == sailing.sailing_id);
+    REQUIRE(manifest.getSize() == 40);
+
+    for(const Vehicle& vehicle : vehicles)
+    {
+        const ManifestEntry* entry = manifest.find(vehicle.license_plate);
+
+        REQUIRE(entry != nullptr);
+        REQUIRE(entry->vehicle.vehicle_id == vehicle.vehicle_id);
+        REQUIRE(entry->vehicle.phone_number == "5550000000");
+        REQUIRE(entry->is_boarded == (vehicle.license_plate == "CAR-7"));
+    }
+
+    REQUIRE(manifest.find("NOT-BOOKED") == nullptr);
+
+    // Boarding at the gate is recorded, and a walk-up vehicle joins the manifest:
+    manifest.setBoarded(vehicles[0]);
+    REQUIRE(manifest.find("CAR-0")->is_boarded);
+
+    Vehicle walk_up(99, "WALK-UP", "5551111111", 4.0, 1.0);
+
+    manifest.setBoarded(walk_up);
+    REQUIRE(manifest.getSize() == 41);
+    REQUIRE(manifest.find("WALK-UP") != nullptr);
+    REQUIRE(manifest.find("WALK-UP")->is_boarded);
+
+    manifest.clear();
+    REQUIRE(manifest.getSize() == 0);
+    REQUIRE(manifest.find("CAR-0") == nullptr);
+}
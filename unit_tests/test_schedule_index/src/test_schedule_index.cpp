@@ -0,0 +1,101 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "schedule_index.hpp"
+
+TEST_CASE("Schedule index: finds the same sailings as a scan, in departure order", "[ScheduleIndex]")
+{
+    struct Row
+    {
+        int sailing_id;
+        int day;
+        int hour;
+        double low;
+        double high;
+    };
+
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> room(0.0, 30.0);
+
+    ScheduleIndex schedule("AHS");
+    std::vector<Row> rows;
+
+    // Added out of order, to make sure the index sorts by departure:
+    for(int index = 0; index < 300; ++index)
+    {
+        Row row{ index + 1, 31 - index % 31, (index * 7) % 24, room(generator), room(generator) };
+
+        bool is_taken = false;
+
+        for(const Row& other : rows)
+        {
+            is_taken = is_taken || (other.day == row.day && other.hour == row.hour);
+        }
+
+        if(!is_taken)
+        {
+            rows.push_back(row);
+            schedule.append(row.sailing_id, row.day, row.hour, row.low, row.high);
+        }
+    }
+
+    schedule.build();
+
+    std::sort(rows.begin(), rows.end(), [](const Row& left, const Row& right) { return(left.day != right.day ? left.day < right.day : left.hour < right.hour); });
+
+    auto scan = [&rows](int from_day, int from_hour, double length, double height, int count)
+    {
+        std::vector<int> sailing_ids;
+
+        for(const Row& row : rows)
+        {
+            bool is_upcoming = row.day > from_day || (row.day == from_day && row.hour >= from_hour);
+            bool fits = (height <= 2.0 && row.low >= length + 0.5) || row.high >= length + 0.5; // Room for the 0.5 meter gap as well.
+
+            if(is_upcoming && fits && static_cast<int>(sailing_ids.size()) < count)
+            {
+                sailing_ids.push_back(row.sailing_id);
+            }
+        }
+
+        return(sailing_ids);
+    };
+
+    std::vector<int> found;
+
+    for(int check = 0; check < 200; ++check)
+    {
+        int from_day = 1 + check % 31;
+        int from_hour = check % 24;
+        double length = room(generator);
+        double height = (check % 2 == 0) ? 1.5 : 3.0;
+
+        schedule.findAvailable(from_day, from_hour, length, height, 5, found);
+        REQUIRE(found == scan(from_day, from_hour, length, height, 5));
+
+        // Filling a sailing takes it out of later answers:
+        if(!found.empty())
+        {
+            for(Row& row : rows)
+            {
+                if(row.sailing_id == found.front())
+                {
+                    row.low = 0.0;
+                    row.high = 0.0;
+
+                    schedule.update(row.day, row.hour, 0.0, 0.0);
+                }
+            }
+        }
+    }
+
+    // Inserting and erasing keep the order:
+    schedule.insert(1000, 1, 0, 50.0, 50.0);
+    schedule.findAvailable(1, 0, 40.0, 1.0, 1, found);
+    REQUIRE(found == std::vector<int>{ 1000 });
+
+    schedule.erase(1, 0);
+    schedule.findAvailable(1, 0, 40.0, 1.0, 1, found);
+    REQUIRE(found == scan(1, 0, 40.0, 1.0, 1));
+}
@@ -0,0 +1,221 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <string>
+#include <vector>
+#include "database.hpp"
+#include "json_session.hpp"
+#include "server.hpp"
+
+#ifdef TARGET_IS_LINUX
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifdef TARGET_IS_LINUX
+
+// Sends every request to a server over one connection, then reads until each one is answered (or the server hangs up).
+static std::vector<std::string> exchangeWithServer(const std::string& socket_path, const std::vector<std::string>& requests)
+{
+    std::vector<std::string> response_lines;
+
+    sockaddr_un address = {};
+
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    int client_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if(connect(client_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(client_socket);
+
+        return(response_lines);
+    }
+
+    std::string output = "";
+
+    for(const std::string& request : requests)
+    {
+        output += request + "\n";
+    }
+
+    // Pipelined, the way a busy client would:
+    for(std::size_t offset = 0; offset < output.size();)
+    {
+        ssize_t byte_count = send(client_socket, output.data() + offset, output.size() - offset, MSG_NOSIGNAL);
+
+        if(byte_count <= 0)
+        {
+            break;
+        }
+
+        offset += static_cast<std::size_t>(byte_count);
+    }
+
+    std::string input = "";
+    char buffer[4096];
+
+    while(std::count(input.begin(), input.end(), '\n') < static_cast<long>(requests.size()))
+    {
+        ssize_t byte_count = recv(client_socket, buffer, sizeof(buffer), 0);
+
+        if(byte_count <= 0)
+        {
+            break;
+        }
+
+        input.append(buffer, static_cast<std::size_t>(byte_count));
+    }
+
+    close(client_socket);
+
+    std::istringstream lines(input);
+
+    for(std::string line; std::getline(lines, line);)
+    {
+        response_lines.push_back(line);
+    }
+
+    return(response_lines);
+}
+
+TEST_CASE("Server: clients are answered in order, and writes are seen once answered", "[Server]")
+{
+    const std::string path = "test_server.db";
+    const std::string socket_path = "test_server.sock";
+
+    for(const std::string& file : { path, path + "-wal", path + "-shm" })
+    {
+        std::remove(file.c_str());
+    }
+
+    bool is_successful = false;
+    std::string outcome_message = "";
+
+    ConnectionProfile profile;
+
+    profile.journal_mode = "WAL";
+    profile.busy_timeout = 5000;
+    profile.read_connections = 2;
+
+    Database database;
+
+    database.openConnection(path, profile, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    GroupCommitSettings group_commit;
+
+    group_commit.max_operations = 8;
+    group_commit.max_delay_milliseconds = 5;
+
+    database.setGroupCommit(group_commit, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    ServerSettings settings;
+
+    settings.socket_path = socket_path;
+    settings.reader_count = 2;
+
+    Server server;
+
+    server.open(&database, settings, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    ServerStatistics statistics;
+    bool is_run_successful = false;
+    std::string run_message = "";
+
+    std::thread server_thread([&]() { server.run(statistics, is_run_successful, run_message); });
+
+    std::vector<std::string> setup_lines = exchangeWithServer(socket_path, {
+        R"({"id": 1, "op": "addVessel", "vessel_name": "Sea Owl", "low_ceiling_lane_length": 500, "high_ceiling_lane_length": 500})",
+        R"({"id": 2, "op": "addSailing", "sailing_id": "AHS-22-10", "vessel_id": 1})",
+        R"({"id": 3, "op": "getSailingReportByID", "sailing_id": "AHS-22-10"})",
+        "not json"
+        });
+
+    // Two agents booking the same sailing at once, each reading its own bookings back:
+    auto book = [&socket_path](const std::string& prefix)
+    {
+        std::vector<std::string> requests;
+
+        for(int index = 0; index < 10; ++index)
+        {
+            requests.push_back(R"({"id": )" + std::to_string(index) + R"(, "op": "addReservation", "sailing_id": "AHS-22-10", "license_plate": ")" + prefix + std::to_string(index) + R"(", "phone_number": "5551234567", "length": 5, "height": 1.5})");
+        }
+
+        requests.push_back(R"({"id": 10, "op": "getVehicleByID", "license_plate": ")" + prefix + R"(9"})");
+
+        return(exchangeWithServer(socket_path, requests));
+    };
+
+    std::vector<std::string> first_agent_lines;
+    std::vector<std::string> second_agent_lines;
+
+    std::thread first_agent([&]() { first_agent_lines = book("B-"); });
+    std::thread second_agent([&]() { second_agent_lines = book("C-"); });
+
+    first_agent.join();
+    second_agent.join();
+
+    std::vector<std::string> report_lines = exchangeWithServer(socket_path, { R"({"id": 4, "op": "getSailingReportByID", "sailing_id": "AHS-22-10"})" });
+
+    server.requestStop();
+    server_thread.join();
+
+    REQUIRE(is_run_successful);
+    REQUIRE(statistics.connection_count == 4);
+    REQUIRE(statistics.request_count == 27);
+
+    server.close(is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    REQUIRE(setup_lines.size() == 4);
+    REQUIRE(setup_lines[0] == R"({"id":1,"ok":true})");
+    REQUIRE(setup_lines[1] == R"({"id":2,"ok":true})");
+    REQUIRE(setup_lines[2].rfind(R"({"id":3,"ok":true,"sailing_report":{"sailing_id":"AHS-22-10","vessel_name":"Sea Owl","vehicle_count":0,)", 0) == 0);
+    REQUIRE(setup_lines[3].rfind(R"({"ok":false,"error":)", 0) == 0);
+
+    for(const std::vector<std::string>* agent_lines : { &first_agent_lines, &second_agent_lines })
+    {
+        REQUIRE(agent_lines->size() == 11);
+
+        for(int index = 0; index < 10; ++index)
+        {
+            REQUIRE((*agent_lines)[index].rfind(R"({"id":)" + std::to_string(index) + R"(,"ok":true,)", 0) == 0);
+        }
+
+        REQUIRE((*agent_lines)[10].rfind(R"({"id":10,"ok":true,"vehicle":)", 0) == 0);
+    }
+
+    REQUIRE(report_lines.size() == 1);
+    REQUIRE(report_lines[0].find(R"("vehicle_count":20,)") != std::string::npos);
+
+    // The socket is gone, and every write is in the file:
+    REQUIRE(access(socket_path.c_str(), F_OK) != 0);
+
+    database.cutConnection(is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    Database reopened_database;
+
+    reopened_database.openConnection(path, is_successful, outcome_message);
+    REQUIRE(is_successful);
+
+    {
+        JsonSession json_session(&reopened_database);
+        std::string response = "";
+
+        REQUIRE(json_session.handleRequest(R"({"op": "getSailingReportByID", "sailing_id": "AHS-22-10"})", response));
+        REQUIRE(response.find(R"("vehicle_count":20,)") != std::string::npos);
+    }
+
+    reopened_database.cutConnection(is_successful, outcome_message);
+}
+
+#endif